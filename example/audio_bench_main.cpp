@@ -0,0 +1,198 @@
+// -*-c++-*-
+
+/*!
+  \file audio_bench_main.cpp
+  \brief benchmark of the say message encoding and the hear message decoding.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/audio_sensor.h>
+#include <rcsc/player/say_message_builder.h>
+#include <rcsc/common/audio_codec.h>
+#include <rcsc/common/audio_memory.h>
+#include <rcsc/common/say_message_parser.h>
+#include <rcsc/time/timer.h>
+#include <rcsc/game_time.h>
+
+#include <boost/random.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <iostream>
+#include <string>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace rcsc;
+
+namespace {
+
+//! the number of operator new calls
+long g_alloc_count = 0;
+
+}
+
+/*-------------------------------------------------------------------*/
+void *
+operator new( std::size_t size )
+{
+    ++g_alloc_count;
+    void * p = std::malloc( size == 0 ? 1 : size );
+    if ( ! p ) throw std::bad_alloc();
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+void
+operator delete( void * p ) throw()
+{
+    std::free( p );
+}
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief encode the messages of one cycle, and hear them
+  \return the number of decode errors
+*/
+int
+run_cycle( const long cycle,
+           boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > & rand,
+           std::string & say,
+           char * hear,
+           const std::size_t hear_size,
+           AudioSensor & sensor,
+           const AudioMemory & memory,
+           const bool verify )
+{
+    const Vector2D ball_pos( rand() * 52.0, rand() * 34.0 );
+    const Vector2D ball_vel( rand() * 2.0, rand() * 2.0 );
+    const Vector2D player_pos( rand() * 52.0, rand() * 34.0 );
+    const int unum = 2 + static_cast< int >( cycle % 10 );
+
+    say.erase();
+    switch ( cycle % 3 ) {
+    case 0:
+        BallMessage( ball_pos, ball_vel ).toStr( say );
+        StaminaMessage( 2000.0 + rand() * 1500.0 ).toStr( say );
+        break;
+    case 1:
+        PassMessage( unum, player_pos, ball_pos, ball_vel ).toStr( say );
+        break;
+    default:
+        OnePlayerMessage( unum + 11, player_pos ).toStr( say );
+        InterceptMessage( true, unum, static_cast< int >( cycle % 20 ) ).toStr( say );
+        break;
+    }
+
+    std::snprintf( hear, hear_size, "(hear %ld %.0f our %d \"%s\")",
+                   cycle, rand() * 180.0, unum, say.c_str() );
+
+    const GameTime current( cycle, 0 );
+    sensor.parsePlayerMessage( hear, current );
+
+    if ( ! verify )
+    {
+        return 0;
+    }
+
+    // compare with the values decoded from the copied string
+    int error = 0;
+    if ( sensor.teammateMessages().size() != 1
+         || sensor.teammateMessages().front().str_ != say )
+    {
+        ++error;
+    }
+
+    if ( say[0] == BallMessageParser::sheader()
+         || say[0] == PassMessageParser::sheader() )
+    {
+        const std::string str = ( say[0] == BallMessageParser::sheader()
+                                  ? say.substr( 1, 5 )
+                                  : say.substr( 5, 5 ) );
+        Vector2D pos, vel;
+        if ( ! AudioCodec::i().decodeStr5ToPosVel( str, &pos, &vel )
+             || memory.ballTime() != current
+             || memory.ball().empty()
+             || memory.ball().back().pos_ != pos
+             || memory.ball().back().vel_ != vel )
+        {
+            ++error;
+        }
+    }
+    else if ( memory.playerTime() != current
+              || memory.player().empty()
+              || memory.player().back().unum_ != unum + 11
+              || memory.player().back().pos_.dist( player_pos ) > 1.0
+              || memory.ourInterceptTime() != current )
+    {
+        ++error;
+    }
+
+    return error;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const long cycles = ( argc > 1 ? std::atol( argv[1] ) : 100000 );
+    if ( cycles <= 0 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [CYCLES]" << std::endl;
+        return 1;
+    }
+
+    boost::shared_ptr< AudioMemory > memory( new AudioMemory() );
+
+    AudioSensor sensor;
+    sensor.addParser( SayMessageParser::Ptr( new BallMessageParser( memory ) ) );
+    sensor.addParser( SayMessageParser::Ptr( new PassMessageParser( memory ) ) );
+    sensor.addParser( SayMessageParser::Ptr( new InterceptMessageParser( memory ) ) );
+    sensor.addParser( SayMessageParser::Ptr( new OnePlayerMessageParser( memory ) ) );
+    sensor.addParser( SayMessageParser::Ptr( new StaminaMessageParser( memory ) ) );
+
+    boost::mt19937 rng( 1 );
+    boost::uniform_real<> dist( -1.0, 1.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rand( rng, dist );
+
+    std::string say;
+    say.reserve( 32 );
+    char hear[256];
+
+    // the first cycles check the decoded values and warm up the containers
+    int errors = 0;
+    const long check_cycles = std::min( cycles, 1000L );
+    for ( long c = 0; c < check_cycles; ++c )
+    {
+        errors += run_cycle( c, rand, say, hear, sizeof( hear ), sensor, *memory, true );
+    }
+
+    const long alloc_start = g_alloc_count;
+    Timer timer;
+    for ( long c = check_cycles; c < check_cycles + cycles; ++c )
+    {
+        run_cycle( c, rand, say, hear, sizeof( hear ), sensor, *memory, false );
+    }
+    const double msec = timer.elapsedReal();
+    const long alloc_count = g_alloc_count - alloc_start;
+
+    std::cout << "cycles=" << cycles
+              << " elapsed=" << msec << "[ms] "
+              << msec * 1.0e6 / cycles << " [ns/cycle] "
+              << static_cast< double >( alloc_count ) / cycles << " [alloc/cycle]"
+              << '\n'
+              << "errors=" << errors
+              << " player_record=" << memory->playerRecord().size()
+              << std::endl;
+
+    return ( errors == 0 ? 0 : 1 );
+}
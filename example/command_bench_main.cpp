@@ -0,0 +1,225 @@
+// -*-c++-*-
+
+/*!
+  \file command_bench_main.cpp
+  \brief benchmark of the player command string composition.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/player_command.h>
+#include <rcsc/common/command_buffer.h>
+#include <rcsc/time/timer.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <new>
+#include <cstdlib>
+
+using namespace rcsc;
+
+namespace {
+
+//! the number of operator new calls
+long g_alloc_count = 0;
+
+}
+
+/*-------------------------------------------------------------------*/
+void *
+operator new( std::size_t size )
+{
+    ++g_alloc_count;
+    void * p = std::malloc( size == 0 ? 1 : size );
+    if ( ! p ) throw std::bad_alloc();
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+void
+operator delete( void * p ) throw()
+{
+    std::free( p );
+}
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief commands sent in one cycle
+*/
+struct CycleCommands {
+    PlayerDashCommand dash_;
+    PlayerKickCommand kick_;
+    PlayerTurnNeckCommand turn_neck_;
+    PlayerChangeViewCommand change_view_;
+    PlayerSayCommand say_;
+    PlayerPointtoCommand pointto_;
+    PlayerAttentiontoCommand attentionto_;
+    bool kick_cycle_;
+
+    CycleCommands( const double & power,
+                   const double & dir,
+                   const double & neck,
+                   const std::string & msg,
+                   const bool kick_cycle )
+        : dash_( power, dir ),
+          kick_( power, dir ),
+          turn_neck_( neck ),
+          change_view_( ViewWidth::NORMAL, ViewQuality::HIGH ),
+          say_( msg, 14.0 ),
+          pointto_( power * 0.1, neck ),
+          attentionto_( PlayerAttentiontoCommand::OUR, 10 ),
+          kick_cycle_( kick_cycle )
+      { }
+
+    const PlayerBodyCommand & body() const
+      {
+          if ( kick_cycle_ ) return kick_;
+          return dash_;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the random command sets
+*/
+void
+create_commands( std::vector< CycleCommands > & commands,
+                 const int size )
+{
+    boost::mt19937 rng( 1 );
+    boost::uniform_real<> dist( -180.0, 180.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rand_angle( rng, dist );
+
+    const char * messages[] = { "bXl;", "u)bF(1", "", "ab01-Q" };
+
+    commands.reserve( size );
+    for ( int i = 0; i < size; ++i )
+    {
+        commands.push_back( CycleCommands( std::abs( rand_angle() ) / 1.8,
+                                           rand_angle(),
+                                           rand_angle() * 0.5,
+                                           messages[i % 4],
+                                           i % 3 == 0 ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compose the command string by the output stream (previous implementation)
+*/
+std::string
+compose_stream( const CycleCommands & c )
+{
+    std::ostringstream ostr;
+    c.body().toStr( ostr );
+    c.turn_neck_.toStr( ostr );
+    c.change_view_.toStr( ostr );
+    c.say_.toStr( ostr );
+    c.pointto_.toStr( ostr );
+    c.attentionto_.toStr( ostr );
+    return ostr.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compose the command string into the preallocated buffer
+*/
+void
+compose_buffer( const CycleCommands & c,
+                CommandBuffer & buf )
+{
+    buf.clear();
+    c.body().toBuffer( buf );
+    c.turn_neck_.toBuffer( buf );
+    c.change_view_.toBuffer( buf );
+    c.say_.toBuffer( buf );
+    c.pointto_.toBuffer( buf );
+    c.attentionto_.toBuffer( buf );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const int cycles = ( argc > 1 ? std::atoi( argv[1] ) : 200000 );
+    if ( cycles <= 0 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [CYCLES]" << std::endl;
+        return 1;
+    }
+
+    std::vector< CycleCommands > commands;
+    create_commands( commands, cycles );
+
+    CommandBuffer buf;
+
+    // both methods must produce the same string
+    int mismatch = 0;
+    std::size_t bytes = 0;
+    for ( int i = 0; i < cycles; ++i )
+    {
+        const std::string str = compose_stream( commands[i] );
+        compose_buffer( commands[i], buf );
+        if ( str != buf.c_str() )
+        {
+            if ( mismatch == 0 )
+            {
+                std::cerr << "mismatch:\n  stream=" << str
+                          << "\n  buffer=" << buf.c_str() << std::endl;
+            }
+            ++mismatch;
+        }
+        bytes += str.length();
+    }
+
+    std::size_t checksum = 0;
+
+    long alloc_start = g_alloc_count;
+    Timer timer;
+    for ( int i = 0; i < cycles; ++i )
+    {
+        checksum += compose_stream( commands[i] ).length();
+    }
+    const double stream_msec = timer.elapsedReal();
+    const long stream_alloc = g_alloc_count - alloc_start;
+
+    alloc_start = g_alloc_count;
+    timer.restart();
+    for ( int i = 0; i < cycles; ++i )
+    {
+        compose_buffer( commands[i], buf );
+        checksum += buf.size();
+    }
+    const double buffer_msec = timer.elapsedReal();
+    const long buffer_alloc = g_alloc_count - alloc_start;
+
+    std::cout << "cycles=" << cycles
+              << " bytes/cycle=" << static_cast< double >( bytes ) / cycles
+              << '\n'
+              << "ostringstream: " << stream_msec * 1.0e6 / cycles << " [ns/cycle] "
+              << bytes / std::max( stream_msec * 1.0e6, 1.0 ) << " [bytes/ns] "
+              << static_cast< double >( stream_alloc ) / cycles << " [alloc/cycle]"
+              << '\n'
+              << "CommandBuffer: " << buffer_msec * 1.0e6 / cycles << " [ns/cycle] "
+              << bytes / std::max( buffer_msec * 1.0e6, 1.0 ) << " [bytes/ns] "
+              << static_cast< double >( buffer_alloc ) / cycles << " [alloc/cycle]"
+              << '\n'
+              << "checksum=" << checksum
+              << " mismatch=" << mismatch
+              << std::endl;
+
+    return ( mismatch == 0 ? 0 : 1 );
+}
@@ -0,0 +1,209 @@
+// -*-c++-*-
+
+/*!
+  \file intercept_bench_main.cpp
+  \brief benchmark of InterceptTable::update() in the serial and parallel mode.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/world_model.h>
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/player/fullstate_sensor.h>
+#include <rcsc/time/timer.h>
+#include <rcsc/game_mode.h>
+#include <rcsc/game_time.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class BenchAgent
+  \brief dummy agent that only provides ActionEffector to WorldModel
+*/
+class BenchAgent
+    : public PlayerAgent {
+protected:
+    void actionImpl()
+      { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create a random fullstate v14 message
+*/
+std::string
+create_fullstate( const long cycle,
+                  boost::mt19937 & rng )
+{
+    boost::uniform_real<> x_dist( -50.0, 50.0 );
+    boost::uniform_real<> y_dist( -32.0, 32.0 );
+    boost::uniform_real<> v_dist( -2.0, 2.0 );
+    boost::uniform_real<> p_dist( -0.4, 0.4 );
+    boost::uniform_real<> a_dist( -180.0, 180.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > x( rng, x_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > y( rng, y_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > v( rng, v_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > p( rng, p_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > a( rng, a_dist );
+
+    std::ostringstream os;
+    os << "(fullstate " << cycle
+       << " (pmode play_on) (vmode high normal)"
+       << " (count 0 0 0 0 0 0 0 0)"
+       << " (arm (movable 0) (expires 0) (target 0 0) (count 0))"
+       << " (score 0 0)"
+       << " ((b) " << x() << ' ' << y() << ' ' << v() << ' ' << v() << ')';
+
+    for ( int s = 0; s < 2; ++s )
+    {
+        for ( int unum = 1; unum <= 11; ++unum )
+        {
+            os << " ((p " << ( s == 0 ? 'l' : 'r' ) << ' ' << unum
+               << ( unum == 1 ? " g" : "" ) << " 0) "
+               << x() << ' ' << y() << ' ' << p() << ' ' << p() << ' '
+               << a() << " 0 (8000 1 1 130600))";
+        }
+    }
+    os << ')';
+
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if two tables have the same result
+*/
+bool
+same_result( const InterceptTable & lhs,
+             const InterceptTable & rhs )
+{
+    return ( lhs.teammateReachCycle() == rhs.teammateReachCycle()
+             && lhs.secondTeammateReachCycle() == rhs.secondTeammateReachCycle()
+             && lhs.goalieReachCycle() == rhs.goalieReachCycle()
+             && lhs.opponentReachCycle() == rhs.opponentReachCycle()
+             && lhs.secondOpponentReachCycle() == rhs.secondOpponentReachCycle()
+             && lhs.fastestTeammate() == rhs.fastestTeammate()
+             && lhs.secondTeammate() == rhs.secondTeammate()
+             && lhs.fastestOpponent() == rhs.fastestOpponent()
+             && lhs.secondOpponent() == rhs.secondOpponent() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief print latency statistics
+*/
+void
+print_stat( const char * name,
+            std::vector< double > & msec )
+{
+    if ( msec.empty() )
+    {
+        return;
+    }
+
+    std::sort( msec.begin(), msec.end() );
+
+    double sum = 0.0;
+    for ( std::vector< double >::const_iterator it = msec.begin(), end = msec.end();
+          it != end;
+          ++it )
+    {
+        sum += *it;
+    }
+
+    std::cout << name
+              << " mean=" << sum / msec.size()
+              << " median=" << msec[msec.size() / 2]
+              << " p99=" << msec[( msec.size() * 99 ) / 100]
+              << " max=" << msec.back()
+              << " [ms]" << std::endl;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const int n_threads = ( argc > 1 ? std::atoi( argv[1] ) : 4 );
+    const int n_cycles = ( argc > 2 ? std::atoi( argv[2] ) : 1000 );
+
+    if ( n_threads < 1 || n_cycles < 1 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [THREADS] [CYCLES]" << std::endl;
+        return 1;
+    }
+
+    BenchAgent agent;
+
+    WorldModel world;
+    if ( ! world.initTeamInfo( "bench", LEFT, 2, false ) )
+    {
+        std::cerr << "failed to initialize the world model." << std::endl;
+        return 1;
+    }
+
+    InterceptTable serial_table( world );
+    InterceptTable parallel_table( world );
+    parallel_table.setWorkerThreads( n_threads );
+
+    boost::mt19937 rng( 20090214 );
+
+    std::vector< double > serial_msec;
+    std::vector< double > parallel_msec;
+    serial_msec.reserve( n_cycles );
+    parallel_msec.reserve( n_cycles );
+
+    int mismatch = 0;
+
+    for ( int i = 1; i <= n_cycles; ++i )
+    {
+        const GameTime current( i, 0 );
+        const std::string msg = create_fullstate( i, rng );
+
+        FullstateSensor fullstate;
+        fullstate.parse( msg.c_str(), 14.0, current );
+
+        world.updateGameMode( GameMode( GameMode::PlayOn, NEUTRAL, current, 0, 0 ),
+                              current );
+        world.updateAfterFullstate( fullstate, agent.effector(), current );
+        world.updateJustBeforeDecision( agent.effector(), current );
+
+        Timer timer;
+        serial_table.update();
+        serial_msec.push_back( timer.elapsedReal() );
+
+        timer.restart();
+        parallel_table.update();
+        parallel_msec.push_back( timer.elapsedReal() );
+
+        if ( ! same_result( serial_table, parallel_table ) )
+        {
+            ++mismatch;
+        }
+    }
+
+    std::cout << "cycles=" << n_cycles
+              << " threads=" << parallel_table.workerThreads() << std::endl;
+    print_stat( "serial  ", serial_msec );
+    print_stat( "parallel", parallel_msec );
+    std::cout << "mismatch=" << mismatch << std::endl;
+
+    return ( mismatch == 0 ? 0 : 1 );
+}
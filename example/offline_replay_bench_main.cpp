@@ -0,0 +1,305 @@
+// -*-c++-*-
+
+/*!
+  \file offline_replay_bench_main.cpp
+  \brief benchmark of the decision loop driven by the offline client logs.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/phase_profiler.h>
+#include <rcsc/action/bhv_before_kick_off.h>
+#include <rcsc/action/bhv_scan_field.h>
+#include <rcsc/action/body_intercept.h>
+#include <rcsc/action/body_kick_one_step.h>
+#include <rcsc/action/neck_turn_to_ball_or_scan.h>
+#include <rcsc/common/basic_client.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/time/timer.h>
+#include <rcsc/game_time.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class ReplayPlayer
+  \brief simple player that records the CPU time of each cycle.
+
+  Replace actionImpl() with the decision of your team to measure it.
+*/
+class ReplayPlayer
+    : public PlayerAgent {
+private:
+    std::vector< double > M_cycle_usec; //!< CPU time of each cycle
+    double M_current_usec; //!< CPU time of the current cycle
+    GameTime M_current_time; //!< time of the current cycle
+
+public:
+
+    ReplayPlayer()
+        : M_current_usec( 0.0 ),
+          M_current_time( -1, 0 )
+      {
+          M_cycle_usec.reserve( 6000 );
+      }
+
+    const std::vector< double > & cycleUSec() const
+      {
+          return M_cycle_usec;
+      }
+
+    void flushCycle()
+      {
+          if ( M_current_usec > 0.0 )
+          {
+              M_cycle_usec.push_back( M_current_usec );
+          }
+          M_current_usec = 0.0;
+      }
+
+protected:
+
+    void handleMessageOffline()
+      {
+          const std::clock_t start = std::clock();
+          PlayerAgent::handleMessageOffline();
+          const double usec = double( std::clock() - start ) * 1000.0 * 1000.0 / CLOCKS_PER_SEC;
+
+          if ( world().time() != M_current_time )
+          {
+              // this message started the new cycle
+              flushCycle();
+              M_current_time = world().time();
+          }
+          M_current_usec += usec;
+      }
+
+    void actionImpl()
+      {
+          if ( world().gameMode().type() == GameMode::BeforeKickOff
+               || world().gameMode().type() == GameMode::AfterGoal_ )
+          {
+              Bhv_BeforeKickOff( Vector2D( -10.0, -30.0 + world().self().unum() * 5.0 ) ).execute( this );
+              return;
+          }
+
+          if ( world().self().isKickable() )
+          {
+              Body_KickOneStep( Vector2D( ServerParam::i().pitchHalfLength(), 0.0 ),
+                                ServerParam::i().ballSpeedMax() ).execute( this );
+          }
+          else if ( world().ball().posValid() )
+          {
+              Body_Intercept().execute( this );
+          }
+          else
+          {
+              Bhv_ScanField().execute( this );
+              return;
+          }
+
+          setNeckAction( new Neck_TurnToBallOrScan() );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief split the offline log path into the player options
+  \return false if the file name is not "<team>-<unum><ext>"
+*/
+bool
+parse_log_path( const std::string & path,
+                std::string * log_dir,
+                std::string * team_name,
+                std::string * unum,
+                std::string * ext )
+{
+    const std::string::size_type slash = path.rfind( '/' );
+    *log_dir = ( slash == std::string::npos ? "." : path.substr( 0, slash ) );
+    const std::string file = ( slash == std::string::npos ? path : path.substr( slash + 1 ) );
+
+    const std::string::size_type dot = file.find( '.', file.rfind( '-' ) );
+    const std::string::size_type hyphen = file.rfind( '-' );
+    if ( hyphen == std::string::npos
+         || dot == std::string::npos
+         || dot <= hyphen + 1 )
+    {
+        return false;
+    }
+
+    *team_name = file.substr( 0, hyphen );
+    *unum = file.substr( hyphen + 1, dot - hyphen - 1 );
+    *ext = file.substr( dot );
+
+    const int n = std::atoi( unum->c_str() );
+    return ( 1 <= n && n <= 11 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief print the distribution of the sorted values
+*/
+void
+print_distribution( const char * name,
+                    std::vector< double > usec )
+{
+    if ( usec.empty() )
+    {
+        std::cout << name << " no data" << std::endl;
+        return;
+    }
+
+    std::sort( usec.begin(), usec.end() );
+
+    double total = 0.0;
+    for ( std::vector< double >::const_iterator it = usec.begin(); it != usec.end(); ++it )
+    {
+        total += *it;
+    }
+
+    std::printf( "%s count=%lu mean=%.1f p50=%.1f p90=%.1f p99=%.1f max=%.1f [usec]\n",
+                 name,
+                 static_cast< unsigned long >( usec.size() ),
+                 total / usec.size(),
+                 usec[usec.size() / 2],
+                 usec[( usec.size() * 90 ) / 100],
+                 usec[( usec.size() * 99 ) / 100],
+                 usec.back() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief replay one offline log
+  \return the number of mismatched commands, or -1 on error
+*/
+int
+replay( const std::string & path,
+        const std::vector< std::string > & player_options,
+        std::vector< double > & all_cycle_usec )
+{
+    std::string log_dir, team_name, unum, ext;
+    if ( ! parse_log_path( path, &log_dir, &team_name, &unum, &ext ) )
+    {
+        std::cerr << path << ": the file name must be <TeamName>-<Unum><Ext>" << std::endl;
+        return -1;
+    }
+
+    std::vector< std::string > args;
+    args.push_back( "bench_offline_replay" );
+    args.push_back( "--team_name" ); args.push_back( team_name );
+    args.push_back( "--log_dir" ); args.push_back( log_dir );
+    args.push_back( "--offline_log_ext" ); args.push_back( ext );
+    args.push_back( "--offline_client_number" ); args.push_back( unum );
+    args.push_back( "--profile_phases" );
+    args.insert( args.end(), player_options.begin(), player_options.end() );
+
+    std::vector< const char * > argv;
+    for ( std::vector< std::string >::const_iterator it = args.begin(); it != args.end(); ++it )
+    {
+        argv.push_back( it->c_str() );
+    }
+
+    BasicClient client;
+    ReplayPlayer player;
+    if ( ! player.init( &client, argv.size(), &argv[0] ) )
+    {
+        return -1;
+    }
+
+    Timer timer;
+    client.run( &player );
+    const double msec = timer.elapsedReal();
+    player.flushCycle();
+
+    std::cout << "---------- " << path << '\n'
+              << "elapsed=" << msec << " [ms]"
+              << " commands: matched=" << client.offlineCommandMatched()
+              << " mismatched=" << client.offlineCommandMismatched()
+              << std::endl;
+    if ( client.offlineCommandMatched() + client.offlineCommandMismatched() == 0 )
+    {
+        std::cout << "no recorded command. record the log by the offline_logging option." << std::endl;
+    }
+
+    print_distribution( "cycle", player.cycleUSec() );
+    if ( player.phaseProfiler() )
+    {
+        player.phaseProfiler()->print( std::cout );
+    }
+
+    all_cycle_usec.insert( all_cycle_usec.end(),
+                           player.cycleUSec().begin(), player.cycleUSec().end() );
+
+    return client.offlineCommandMismatched();
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    std::vector< std::string > logs;
+    std::vector< std::string > player_options;
+
+    bool option = false;
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! option && std::string( argv[i] ) == "--" )
+        {
+            option = true;
+        }
+        else if ( option )
+        {
+            player_options.push_back( argv[i] );
+        }
+        else
+        {
+            logs.push_back( argv[i] );
+        }
+    }
+
+    if ( logs.empty() )
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <TeamName>-<Unum>.ocl... [-- <PlayerOptions>]\n"
+                  << "  the offline client logs are recorded by the offline_logging option.\n"
+                  << "  the phase profile is written to <TeamName>-<Unum>.prof in the log directory."
+                  << std::endl;
+        return 1;
+    }
+
+    int mismatch = 0;
+    std::vector< double > all_cycle_usec;
+
+    for ( std::vector< std::string >::const_iterator it = logs.begin(); it != logs.end(); ++it )
+    {
+        const int n = replay( *it, player_options, all_cycle_usec );
+        if ( n < 0 )
+        {
+            return 1;
+        }
+        mismatch += n;
+    }
+
+    std::cout << "---------- total" << std::endl;
+    print_distribution( "cycle", all_cycle_usec );
+    std::cout << "mismatched commands=" << mismatch << std::endl;
+
+    return ( mismatch == 0 ? 0 : 1 );
+}
@@ -0,0 +1,174 @@
+// -*-c++-*-
+
+/*!
+  \file pfilter_bench_main.cpp
+  \brief benchmark of LocalizationPFilter::localizeSelf().
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/localization_pfilter.h>
+#include <rcsc/player/object_table.h>
+#include <rcsc/player/visual_sensor.h>
+#include <rcsc/time/timer.h>
+#include <rcsc/game_time.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace rcsc;
+
+namespace {
+
+const char * TEAM_NAME = "bench";
+
+//! marker names in the order of MarkerID
+const char * MARKER_NAMES[] = {
+    "g l", "g r", "f c", "f c t", "f c b", "f l t", "f l b", "f r t", "f r b",
+    "f p l t", "f p l c", "f p l b", "f p r t", "f p r c", "f p r b",
+    "f g l t", "f g l b", "f g r t", "f g r b",
+    "f t l 50", "f t l 40", "f t l 30", "f t l 20", "f t l 10", "f t 0",
+    "f t r 10", "f t r 20", "f t r 30", "f t r 40", "f t r 50",
+    "f b l 50", "f b l 40", "f b l 30", "f b l 20", "f b l 10", "f b 0",
+    "f b r 10", "f b r 20", "f b r 30", "f b r 40", "f b r 50",
+    "f l t 30", "f l t 20", "f l t 10", "f l 0", "f l b 10", "f l b 20", "f l b 30",
+    "f r t 30", "f r t 20", "f r t 10", "f r 0", "f r b 10", "f r b 20", "f r b 30",
+};
+
+/*!
+  \brief true state and the see message observed from it
+*/
+struct Sample {
+    Vector2D pos_; //!< true position
+    double face_; //!< true face angle
+    std::string see_; //!< see message
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create a see message that contains the markers quantized in
+  the same way as rcssserver
+*/
+void
+create_samples( std::vector< Sample > & samples,
+                const int size )
+{
+    const ObjectTable table;
+
+    boost::mt19937 rng( 20100328 );
+    boost::uniform_real<> dist( -1.0, 1.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rand( rng, dist );
+
+    samples.reserve( size );
+    for ( int i = 0; i < size; ++i )
+    {
+        Sample s;
+        s.pos_.assign( rand() * 50.0, rand() * 32.0 );
+        s.face_ = rand() * 180.0;
+
+        std::ostringstream os;
+        os << "(see " << i + 1;
+        for ( std::map< MarkerID, Vector2D >::const_iterator it = table.landmarkMap().begin();
+              it != table.landmarkMap().end();
+              ++it )
+        {
+            const Vector2D rpos = it->second - s.pos_;
+            const double d = ObjectTable::quantize_dist( rpos.r(), 0.01 );
+            const double dir = ( rpos.th() - s.face_ ).degree();
+            if ( std::fabs( dir ) > 45.0 || d > 100.0 ) continue;
+
+            os << " ((" << MARKER_NAMES[it->first] << ") "
+               << d << ' ' << static_cast< int >( rint( dir ) ) << ')';
+        }
+        os << ')';
+        s.see_ = os.str();
+
+        samples.push_back( s );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief localize all samples
+  \return mean position error
+*/
+double
+run( LocalizationPFilter & localizer,
+     const std::vector< Sample > & samples,
+     const int n_loop,
+     double * usec_per_see )
+{
+    VisualSensor see;
+
+    double error = 0.0;
+    double msec = 0.0;
+    int count = 0;
+    for ( int loop = 0; loop < n_loop; ++loop )
+    {
+        for ( std::size_t i = 0; i < samples.size(); ++i )
+        {
+            const GameTime current( loop * samples.size() + i + 1, 0 );
+            see.parse( samples[i].see_.c_str(), TEAM_NAME, 15.0, current );
+            if ( see.markers().empty() ) continue;
+
+            const double face = static_cast< int >( rint( samples[i].face_ ) );
+            Vector2D pos, pos_err;
+
+            Timer timer;
+            const bool result = localizer.localizeSelf( see, face, 0.5, &pos, &pos_err );
+            msec += timer.elapsedReal();
+
+            if ( result )
+            {
+                error += pos.dist( samples[i].pos_ );
+                ++count;
+            }
+        }
+    }
+
+    *usec_per_see = msec * 1000.0 / std::max( 1, count );
+    return error / std::max( 1, count );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const int size = ( argc > 1 ? std::atoi( argv[1] ) : 2000 );
+    if ( size <= 0 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [SEE_COUNT]" << std::endl;
+        return 1;
+    }
+
+    std::vector< Sample > samples;
+    create_samples( samples, size );
+
+    const int counts[] = { LocalizationPFilter::DEFAULT_PARTICLE_COUNT, 200, 1000 };
+    for ( int c = 0; c < 3; ++c )
+    {
+        LocalizationPFilter localizer( counts[c] );
+        double usec = 0.0;
+        const double error = run( localizer, samples, 3, &usec );
+
+        std::cout << "particles=" << counts[c]
+                  << " " << usec << " [us/see]"
+                  << " error=" << error
+                  << std::endl;
+    }
+
+    return 0;
+}
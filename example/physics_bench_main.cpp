@@ -0,0 +1,137 @@
+// -*-c++-*-
+
+/*!
+  \file physics_bench_main.cpp
+  \brief benchmark of PhysicsStepper.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/physics_stepper.h>
+#include <rcsc/time/timer.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the kick off formation of 22 players
+*/
+void
+create_players( PhysicsStepper & sim )
+{
+    sim.setBall( Vector2D( 0.0, 0.0 ) );
+
+    for ( int side = 0; side < 2; ++side )
+    {
+        const double sign = ( side == 0 ? -1.0 : 1.0 );
+        for ( int unum = 1; unum <= 11; ++unum )
+        {
+            const Vector2D pos( sign * ( unum == 1 ? 50.0 : 5.0 + ( unum % 4 ) * 10.0 ),
+                                -30.0 + ( unum % 7 ) * 10.0 );
+            sim.addPlayer( ( side == 0 ? LEFT : RIGHT ), unum, Hetero_Default,
+                           ( unum == 1 ), pos, ( side == 0 ? 0.0 : 180.0 ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief run the rollout
+  \return the sum of the final positions to compare the results
+*/
+double
+rollout( PhysicsStepper & sim,
+         const long cycles,
+         const unsigned int seed )
+{
+    boost::mt19937 rng( seed );
+    boost::uniform_real<> dist( -180.0, 180.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rand_angle( rng, dist );
+
+    const int size = static_cast< int >( sim.players().size() );
+    for ( long c = 0; c < cycles; ++c )
+    {
+        for ( int i = 0; i < size; ++i )
+        {
+            const PhysicsStepper::Player & p = sim.player( i );
+            if ( sim.isKickable( i ) )
+            {
+                sim.setCommand( i, PlayerKickCommand( 100.0, rand_angle() ) );
+            }
+            else if ( ( c + i ) % 5 == 0 )
+            {
+                sim.setCommand( i, PlayerTurnCommand( ( sim.ball().pos_ - p.pos_ ).th().degree() - p.body_ ) );
+            }
+            else
+            {
+                sim.setCommand( i, PlayerDashCommand( 100.0 ) );
+            }
+            sim.setTurnNeck( i, rand_angle() * 0.5 );
+        }
+
+        sim.step();
+
+        if ( sim.ball().pos_.absX() > 52.5
+             || sim.ball().pos_.absY() > 34.0 )
+        {
+            sim.setBall( Vector2D( 0.0, 0.0 ) );
+        }
+    }
+
+    double sum = sim.ball().pos_.x + sim.ball().pos_.y;
+    for ( int i = 0; i < size; ++i )
+    {
+        sum += sim.player( i ).pos_.x + sim.player( i ).pos_.y + sim.player( i ).stamina_.stamina();
+    }
+    return sum;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const long cycles = ( argc > 1 ? std::atol( argv[1] ) : 100000 );
+    if ( cycles <= 0 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [CYCLES]" << std::endl;
+        return 1;
+    }
+
+    PhysicsStepper sim( 1 );
+    create_players( sim );
+
+    Timer timer;
+    const double sum = rollout( sim, cycles, 2 );
+    const double msec = timer.elapsedReal();
+
+    // the same seeds must reproduce the same result
+    PhysicsStepper sim2( 1 );
+    create_players( sim2 );
+    const double sum2 = rollout( sim2, cycles, 2 );
+
+    std::cout << "players=" << sim.players().size()
+              << " cycles=" << cycles
+              << " elapsed=" << msec << "[ms]"
+              << " " << cycles * 1000.0 / std::max( msec, 1.0e-3 ) << " [cycles/sec]"
+              << std::endl;
+    std::cout.precision( 17 );
+    std::cout << "checksum=" << sum
+              << ( sum == sum2 ? "" : " (not reproducible)" )
+              << std::endl;
+
+    return ( sum == sum2 ? 0 : 1 );
+}
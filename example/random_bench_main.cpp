@@ -0,0 +1,172 @@
+// -*-c++-*-
+
+/*!
+  \file random_bench_main.cpp
+  \brief benchmark of the random number streams.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/random.h>
+#include <rcsc/time/timer.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the stream properties
+  \return the number of failures
+*/
+int
+check_streams( const std::size_t n )
+{
+    int failure = 0;
+
+    // batch generation must be the same as the successive calls
+    {
+        RandomStream batch = RandomEngine::instance().stream( "bench", 1 );
+        RandomStream single = batch;
+        batch(); single(); // start from the middle of a block
+        std::vector< double > values( n );
+        batch.generateUniform( -1.0, 1.0, &values[0], n );
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            if ( values[i] != -1.0 + ( 2.0 / 4294967296.0 ) * single() )
+            {
+                ++failure;
+                break;
+            }
+        }
+        if ( batch.position() != single.position() )
+        {
+            ++failure;
+        }
+    }
+
+    // the same name and id must reproduce the same stream
+    {
+        RandomStream s0 = RandomEngine::instance().stream( "bench", 2 );
+        RandomStream s1 = RandomEngine::instance().stream( "bench", 2 );
+        s1.seek( n / 2 );
+        s0.seek( n / 2 );
+        if ( s0() != s1() )
+        {
+            ++failure;
+        }
+    }
+
+    // different streams must not be correlated
+    {
+        RandomStream s0 = RandomEngine::instance().stream( "bench", 3 );
+        RandomStream s1 = RandomEngine::instance().stream( "bench", 4 );
+        std::vector< double > v0( n ), v1( n );
+        s0.generateUniform( -1.0, 1.0, &v0[0], n );
+        s1.generateUniform( -1.0, 1.0, &v1[0], n );
+
+        double sum = 0.0;
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            sum += v0[i] * v1[i];
+        }
+        // the correlation of independent uniform values is about N(0, 1/n)
+        const double corr = sum / ( n / 3.0 );
+        std::cout << "stream correlation=" << corr << '\n';
+        if ( std::fabs( corr ) > 5.0 / std::sqrt( static_cast< double >( n ) ) )
+        {
+            ++failure;
+        }
+    }
+
+    return failure;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const long count = ( argc > 1 ? std::atol( argv[1] ) : 10000000 );
+    if ( count <= 0 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [COUNT]" << std::endl;
+        return 1;
+    }
+
+    const int failure = check_streams( 100000 );
+
+    const std::size_t batch_size = 1024;
+    std::vector< double > values( batch_size );
+    const long loops = std::max( 1L, count / static_cast< long >( batch_size ) );
+    const double n = static_cast< double >( loops ) * batch_size;
+
+    double sum_mt = 0.0;
+    Timer timer;
+    {
+        boost::mt19937 engine( 49827140 );
+        boost::uniform_real<> dst( -1.0, 1.0 );
+        boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rng( engine, dst );
+        for ( long l = 0; l < loops; ++l )
+        {
+            for ( std::size_t i = 0; i < batch_size; ++i )
+            {
+                values[i] = rng();
+            }
+            sum_mt += values[l % batch_size];
+        }
+    }
+    const double mt_msec = timer.elapsedReal();
+
+    double sum_single = 0.0;
+    timer.restart();
+    {
+        RandomStream stream = RandomEngine::instance().stream( "bench" );
+        boost::uniform_real<> dst( -1.0, 1.0 );
+        boost::variate_generator< RandomStream &, boost::uniform_real<> > rng( stream, dst );
+        for ( long l = 0; l < loops; ++l )
+        {
+            for ( std::size_t i = 0; i < batch_size; ++i )
+            {
+                values[i] = rng();
+            }
+            sum_single += values[l % batch_size];
+        }
+    }
+    const double single_msec = timer.elapsedReal();
+
+    double sum_batch = 0.0;
+    timer.restart();
+    {
+        RandomStream stream = RandomEngine::instance().stream( "bench" );
+        for ( long l = 0; l < loops; ++l )
+        {
+            stream.generateUniform( -1.0, 1.0, &values[0], batch_size );
+            sum_batch += values[l % batch_size];
+        }
+    }
+    const double batch_msec = timer.elapsedReal();
+
+    std::cout << "values=" << n << '\n'
+              << "mt19937 uniform_real: " << mt_msec * 1.0e6 / n << " [ns/value]\n"
+              << "RandomStream uniform_real: " << single_msec * 1.0e6 / n << " [ns/value]\n"
+              << "RandomStream generateUniform: " << batch_msec * 1.0e6 / n << " [ns/value]\n"
+              << "checksum=" << sum_mt + sum_single + sum_batch
+              << " failure=" << failure
+              << std::endl;
+
+    return ( failure == 0 ? 0 : 1 );
+}
@@ -0,0 +1,351 @@
+// -*-c++-*-
+
+/*!
+  \file rcg_parse_bench_main.cpp
+  \brief benchmark of rcsc::rcg::ParallelParser.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/parallel_parser.h>
+#include <rcsc/rcg/parser.h>
+#include <rcsc/rcg/types.h>
+#include <rcsc/time/timer.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class ChecksumHandler
+  \brief accumulate all received data in the callback order
+*/
+class ChecksumHandler
+    : public rcg::Handler {
+private:
+    unsigned long M_hash;
+    long M_n_shows;
+
+    void add( const void * data,
+              const std::size_t size )
+      {
+          const unsigned char * p = static_cast< const unsigned char * >( data );
+          for ( std::size_t i = 0; i < size; ++i )
+          {
+              M_hash = ( M_hash ^ p[i] ) * 1099511628211ul;
+          }
+      }
+
+    void add( const float value ) { add( &value, sizeof( float ) ); }
+    void add( const long value ) { add( &value, sizeof( long ) ); }
+    void add( const std::string & str ) { add( str.data(), str.length() ); }
+
+public:
+    ChecksumHandler()
+        : M_hash( 14695981039346656037ul ),
+          M_n_shows( 0 )
+      { }
+
+    unsigned long hash() const { return M_hash; }
+    long shows() const { return M_n_shows; }
+
+    bool handleLogVersion( int ver ) { add( long( ver ) ); return true; }
+    bool handleEOF() { add( long( -1 ) ); return true; }
+
+    bool handleShow( const int time,
+                     const rcg::ShowInfoT & show )
+      {
+          ++M_n_shows;
+          add( long( time ) );
+          add( long( show.time_ ) );
+          add( show.ball_.x_ ); add( show.ball_.y_ );
+          add( show.ball_.vx_ ); add( show.ball_.vy_ );
+          for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+          {
+              const rcg::PlayerT & p = show.player_[i];
+              add( long( p.side_ ) ); add( long( p.unum_ ) ); add( long( p.type_ ) );
+              add( long( p.view_quality_ ) ); add( long( p.focus_side_ ) ); add( long( p.focus_unum_ ) );
+              add( long( p.state_ ) );
+              add( p.x_ ); add( p.y_ ); add( p.vx_ ); add( p.vy_ );
+              add( p.body_ ); add( p.neck_ ); add( p.point_x_ ); add( p.point_y_ );
+              add( p.view_width_ );
+              add( p.stamina_ ); add( p.effort_ ); add( p.recovery_ ); add( p.stamina_capacity_ );
+              add( long( p.kick_count_ ) ); add( long( p.dash_count_ ) ); add( long( p.turn_count_ ) );
+              add( long( p.catch_count_ ) ); add( long( p.move_count_ ) ); add( long( p.turn_neck_count_ ) );
+              add( long( p.change_view_count_ ) ); add( long( p.say_count_ ) ); add( long( p.tackle_count_ ) );
+              add( long( p.pointto_count_ ) ); add( long( p.attentionto_count_ ) );
+          }
+          return true;
+      }
+
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg )
+      {
+          add( long( time ) ); add( long( board ) ); add( msg );
+          return true;
+      }
+
+    bool handlePlayMode( const int time,
+                         const PlayMode pm )
+      {
+          add( long( time ) ); add( long( pm ) );
+          return true;
+      }
+
+    bool handleTeam( const int time,
+                     const rcg::TeamT & team_l,
+                     const rcg::TeamT & team_r )
+      {
+          add( long( time ) );
+          add( team_l.name_ ); add( long( team_l.score_ ) );
+          add( team_r.name_ ); add( long( team_r.score_ ) );
+          return true;
+      }
+
+    bool handleServerParam( const std::string & msg ) { add( msg ); return true; }
+    bool handlePlayerParam( const std::string & msg ) { add( msg ); return true; }
+    bool handlePlayerType( const std::string & msg ) { add( msg ); return true; }
+
+    // old versions are not used
+    bool handleDispInfo( const rcg::dispinfo_t & ) { return true; }
+    bool handleShowInfo( const rcg::showinfo_t & ) { return true; }
+    bool handleShortShowInfo2( const rcg::short_showinfo_t2 & ) { return true; }
+    bool handleMsgInfo( rcg::Int16, const std::string & ) { return true; }
+    bool handlePlayMode( char ) { return true; }
+    bool handleTeamInfo( const rcg::team_t &, const rcg::team_t & ) { return true; }
+    bool handlePlayerType( const rcg::player_type_t & ) { return true; }
+    bool handleServerParam( const rcg::server_params_t & ) { return true; }
+    bool handlePlayerParam( const rcg::player_params_t & ) { return true; }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write a synthetic rcg v5 file of one game
+*/
+void
+create_log( const std::string & filepath,
+            const int n_cycles,
+            boost::mt19937 & rng )
+{
+    boost::uniform_real<> real_dist( 0.0, 1.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rand( rng, real_dist );
+
+    FILE * fp = std::fopen( filepath.c_str(), "w" );
+
+    std::fprintf( fp, "ULG5\n" );
+    std::fprintf( fp, "(server_param (goal_width 14.02) (inertia_moment 5) (player_size 0.3))\n" );
+    std::fprintf( fp, "(player_param (player_types 18) (subs_max 3) (pt_max 1))\n" );
+    for ( int i = 0; i < 18; ++i )
+    {
+        std::fprintf( fp, "(player_type (id %d) (player_speed_max 1.05) (stamina_inc_max 45))\n", i );
+    }
+
+    for ( int t = 0; t <= n_cycles; ++t )
+    {
+        if ( t % 600 == 0 )
+        {
+            std::fprintf( fp, "(playmode %d %s)\n", t, ( t == 0 ? "before_kick_off" : "kick_off_l" ) );
+            std::fprintf( fp, "(team %d bench_left bench_right %d %d)\n", t, t / 1200, t / 1800 );
+        }
+
+        std::fprintf( fp, "(show %d ((b) %.4f %.4f %.4f %.4f)",
+                      t,
+                      rand() * 105.0 - 52.5, rand() * 68.0 - 34.0,
+                      rand() * 3.0 - 1.5, rand() * 3.0 - 1.5 );
+        for ( int side = 0; side < 2; ++side )
+        {
+            for ( int unum = 1; unum <= MAX_PLAYER; ++unum )
+            {
+                std::fprintf( fp, " ((%c %d) %d 0x%x %.4f %.4f %.4f %.4f %.3f %.3f",
+                              ( side == 0 ? 'l' : 'r' ), unum, unum % 18,
+                              ( unum == 1 ? 0x9 : 0x1 ),
+                              rand() * 105.0 - 52.5, rand() * 68.0 - 34.0,
+                              rand() * 1.2 - 0.6, rand() * 1.2 - 0.6,
+                              rand() * 360.0 - 180.0, rand() * 180.0 - 90.0 );
+                if ( rand() < 0.02 )
+                {
+                    std::fprintf( fp, " %.4f %.4f", rand() * 105.0 - 52.5, rand() * 68.0 - 34.0 );
+                }
+                std::fprintf( fp, " (v %c %d) (s %.4f %.6f %.6f %.1f)",
+                              ( rand() < 0.5 ? 'h' : 'l' ), ( rand() < 0.7 ? 90 : 180 ),
+                              rand() * 8000.0, 0.6 + rand() * 0.4, 0.5 + rand() * 0.5,
+                              rand() * 130600.0 );
+                if ( rand() < 0.05 )
+                {
+                    std::fprintf( fp, " (f %c %d)", ( side == 0 ? 'r' : 'l' ), 1 + t % MAX_PLAYER );
+                }
+                std::fprintf( fp, " (c %d %d %d %d %d %d %d %d %d %d %d))",
+                              t / 7, t / 2, t / 3, 0, 1, t / 2, t / 100, t / 50, t / 200, 0, t / 11 );
+            }
+        }
+        std::fprintf( fp, ")\n" );
+
+        if ( t % 50 == 25 )
+        {
+            std::fprintf( fp, "(msg %d 1 \"(team_graphic_l (0 0) \\\"8 8 1 1\\\")\")\n", t );
+        }
+    }
+
+    std::fclose( fp );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief parse the file by the streaming parser
+*/
+bool
+parse_serial( const std::string & filepath,
+              ChecksumHandler & handler )
+{
+    std::ifstream fin( filepath.c_str(), std::ios_base::in | std::ios_base::binary );
+    rcg::Parser::Ptr parser = rcg::Parser::create( fin );
+    return parser
+        && parser->parse( fin, handler );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the file size in MB
+*/
+double
+file_mb( const std::string & filepath )
+{
+    struct stat st;
+    if ( ::stat( filepath.c_str(), &st ) != 0 )
+    {
+        return 0.0;
+    }
+    return st.st_size / ( 1024.0 * 1024.0 );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    std::vector< std::string > files;
+    std::string tmpfile;
+
+    if ( argc > 1 )
+    {
+        for ( int i = 1; i < argc; ++i )
+        {
+            files.push_back( argv[i] );
+        }
+    }
+    else
+    {
+        char name[] = "/tmp/rcg_parse_bench_XXXXXX";
+        const int fd = ::mkstemp( name );
+        if ( fd < 0 )
+        {
+            std::cerr << "could not create a temporary file." << std::endl;
+            return 1;
+        }
+        ::close( fd );
+
+        tmpfile = name;
+        boost::mt19937 rng( 20100501 );
+        create_log( tmpfile, 6000, rng );
+        files.push_back( tmpfile );
+    }
+
+    double total_mb = 0.0;
+    for ( std::vector< std::string >::const_iterator f = files.begin(); f != files.end(); ++f )
+    {
+        total_mb += file_mb( *f );
+    }
+
+    int mismatch = 0;
+    std::vector< unsigned long > hashes;
+
+    // streaming parser
+    {
+        double best = 1.0e10;
+        for ( int loop = 0; loop < 3; ++loop )
+        {
+            hashes.clear();
+            Timer timer;
+            for ( std::vector< std::string >::const_iterator f = files.begin(); f != files.end(); ++f )
+            {
+                ChecksumHandler handler;
+                if ( ! parse_serial( *f, handler ) )
+                {
+                    std::cerr << "failed to parse " << *f << std::endl;
+                }
+                hashes.push_back( handler.hash() );
+            }
+            best = std::min( best, timer.elapsedReal() );
+        }
+
+        std::cout << "serial    threads=1"
+                  << " MB/s=" << total_mb / ( best * 0.001 )
+                  << " games/s=" << files.size() / ( best * 0.001 )
+                  << std::endl;
+    }
+
+    // parallel parser
+    const int n_threads[] = { 1, 2, 4, 0 };
+    for ( std::size_t n = 0; n < sizeof( n_threads ) / sizeof( int ); ++n )
+    {
+        rcg::ParallelParser parser( n_threads[n] );
+
+        double best = 1.0e10;
+        for ( int loop = 0; loop < 3; ++loop )
+        {
+            Timer timer;
+            for ( std::size_t i = 0; i < files.size(); ++i )
+            {
+                ChecksumHandler handler;
+                if ( ! parser.parse( files[i], handler ) )
+                {
+                    std::cerr << "failed to parse " << files[i] << std::endl;
+                }
+                if ( handler.hash() != hashes[i] )
+                {
+                    ++mismatch;
+                }
+            }
+            best = std::min( best, timer.elapsedReal() );
+        }
+
+        std::cout << "parallel  threads=" << parser.threads()
+                  << " MB/s=" << total_mb / ( best * 0.001 )
+                  << " games/s=" << files.size() / ( best * 0.001 )
+                  << std::endl;
+    }
+
+    std::cout << "files=" << files.size()
+              << " size=" << total_mb << "MB"
+              << " mismatch=" << mismatch
+              << std::endl;
+
+    if ( ! tmpfile.empty() )
+    {
+        std::remove( tmpfile.c_str() );
+    }
+
+    return ( mismatch == 0 ? 0 : 1 );
+}
@@ -0,0 +1,280 @@
+// -*-c++-*-
+
+/*!
+  \file see_parse_bench_main.cpp
+  \brief benchmark of VisualSensor::parse().
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/visual_sensor.h>
+#include <rcsc/time/timer.h>
+#include <rcsc/game_time.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+using namespace rcsc;
+
+namespace {
+
+const char * TEAM_NAME = "bench";
+
+const char * MARKER_NAMES[] = {
+    "g l", "g r", "f c", "f c t", "f c b", "f l t", "f l b", "f r t", "f r b",
+    "f p l t", "f p l c", "f p l b", "f p r t", "f p r c", "f p r b",
+    "f g l t", "f g l b", "f g r t", "f g r b",
+    "f t l 50", "f t l 40", "f t l 30", "f t l 20", "f t l 10", "f t 0",
+    "f t r 10", "f t r 20", "f t r 30", "f t r 40", "f t r 50",
+    "f b l 50", "f b l 40", "f b l 30", "f b l 20", "f b l 10", "f b 0",
+    "f b r 10", "f b r 20", "f b r 30", "f b r 40", "f b r 50",
+    "f l t 30", "f l t 20", "f l t 10", "f l 0", "f l b 10", "f l b 20", "f l b 30",
+    "f r t 30", "f r t 20", "f r t 10", "f r 0", "f r b 10", "f r b 20", "f r b 30",
+};
+
+const char * LINE_NAMES[] = { "l l", "l r", "l t", "l b" };
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create a see message in the format of rcssserver protocol version 14+
+*/
+std::string
+create_see( const long cycle,
+            boost::mt19937 & rng )
+{
+    boost::uniform_int<> int_dist( 0, 1 << 20 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_int<> > rand_int( rng, int_dist );
+
+    std::ostringstream os;
+    os << "(see " << cycle;
+
+    const int n_markers = sizeof( MARKER_NAMES ) / sizeof( const char * );
+    for ( int i = 0; i < n_markers; ++i )
+    {
+        if ( rand_int() % 3 != 0 ) continue;
+        os << " ((" << MARKER_NAMES[i] << ") "
+           << ( rand_int() % 1000 ) / 10.0 << ' '
+           << ( rand_int() % 91 ) - 45;
+        if ( rand_int() % 4 == 0 )
+        {
+            os << ' ' << ( rand_int() % 200 - 100 ) / 100.0
+               << ' ' << ( rand_int() % 100 - 50 ) / 10.0;
+        }
+        os << ')';
+    }
+
+    os << " ((F) " << ( rand_int() % 30 ) / 10.0 << ' ' << ( rand_int() % 360 ) - 180 << ')';
+
+    for ( int i = 0; i < 2; ++i )
+    {
+        os << " ((" << LINE_NAMES[rand_int() % 4] << ") "
+           << ( rand_int() % 600 ) / 10.0 << ' '
+           << ( rand_int() % 181 ) - 90 << ')';
+    }
+
+    os << " ((b) " << ( rand_int() % 400 ) / 10.0 << ' ' << ( rand_int() % 91 ) - 45
+       << ' ' << ( rand_int() % 200 - 100 ) / 1000.0
+       << ' ' << ( rand_int() % 100 - 50 ) / 10.0 << ')';
+
+    for ( int side = 0; side < 2; ++side )
+    {
+        const char * team = ( side == 0 ? TEAM_NAME : "opponent" );
+        for ( int unum = 1; unum <= 11; ++unum )
+        {
+            const int r = rand_int() % 6;
+            if ( r == 0 ) continue;
+
+            os << " ((p";
+            if ( r >= 2 )
+            {
+                os << " \"" << team << '"';
+                if ( r >= 3 )
+                {
+                    os << ' ' << unum;
+                    if ( unum == 1 ) os << " goalie";
+                }
+            }
+            os << ") " << ( rand_int() % 600 ) / 10.0 << ' ' << ( rand_int() % 91 ) - 45;
+            if ( r >= 4 )
+            {
+                os << ' ' << ( rand_int() % 200 - 100 ) / 100.0
+                   << ' ' << ( rand_int() % 100 - 50 ) / 10.0
+                   << ' ' << ( rand_int() % 360 ) - 180
+                   << ' ' << ( rand_int() % 181 ) - 90;
+                if ( r == 5 )
+                {
+                    os << ' ' << ( rand_int() % 360 ) - 180;
+                }
+            }
+            switch ( rand_int() % 8 ) {
+            case 0: os << " k"; break;
+            case 1: os << " t"; break;
+            default: break;
+            }
+            os << ')';
+        }
+    }
+
+    os << " ((P) " << ( rand_int() % 20 ) / 10.0 << ' ' << ( rand_int() % 360 ) - 180 << ')';
+    os << ')';
+
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief accumulate the parsed values to compare the parser results
+*/
+double
+checksum( const VisualSensor & see )
+{
+    double sum = 0.0;
+
+    for ( VisualSensor::BallCont::const_iterator it = see.balls().begin();
+          it != see.balls().end();
+          ++it )
+    {
+        sum += it->dist_ + it->dir_ * 3 + it->dist_chng_ * 5 + it->dir_chng_ * 7;
+    }
+
+    for ( VisualSensor::MarkerCont::const_iterator it = see.markers().begin();
+          it != see.markers().end();
+          ++it )
+    {
+        sum += it->dist_ + it->dir_ * 3 + it->id_ * 5;
+    }
+
+    for ( VisualSensor::MarkerCont::const_iterator it = see.behindMarkers().begin();
+          it != see.behindMarkers().end();
+          ++it )
+    {
+        sum += it->dist_ + it->dir_ * 3 + it->object_type_ * 5;
+    }
+
+    for ( VisualSensor::LineCont::const_iterator it = see.lines().begin();
+          it != see.lines().end();
+          ++it )
+    {
+        sum += it->dist_ + it->dir_ * 3 + it->id_ * 5;
+    }
+
+    const VisualSensor::PlayerCont * players[] = { &see.teammates(),
+                                                   &see.unknownTeammates(),
+                                                   &see.opponents(),
+                                                   &see.unknownOpponents(),
+                                                   &see.unknownPlayers() };
+    for ( int i = 0; i < 5; ++i )
+    {
+        double w = i + 1;
+        for ( VisualSensor::PlayerCont::const_iterator it = players[i]->begin();
+              it != players[i]->end();
+              ++it )
+        {
+            sum += w * ( it->dist_ + it->dir_ * 3
+                         + it->dist_chng_ * 5 + it->dir_chng_ * 7
+                         + it->body_ * 11 + it->face_ * 13 + it->arm_ * 17
+                         + it->unum_ * 19 + it->goalie_ * 23
+                         + it->kicked_ * 29 + it->tackle_ * 31 );
+        }
+    }
+
+    return sum;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    std::vector< std::string > messages;
+
+    if ( argc > 1 )
+    {
+        // read see messages, one message per line
+        std::ifstream fin( argv[1] );
+        if ( ! fin )
+        {
+            std::cerr << "Usage: " << argv[0] << " [SEE_MESSAGE_FILE]" << std::endl;
+            return 1;
+        }
+
+        std::string line;
+        while ( std::getline( fin, line ) )
+        {
+            std::string::size_type pos = line.find( "(see " );
+            if ( pos != std::string::npos )
+            {
+                messages.push_back( line.substr( pos ) );
+            }
+        }
+    }
+    else
+    {
+        boost::mt19937 rng( 20100328 );
+        for ( int i = 1; i <= 6000; ++i )
+        {
+            messages.push_back( create_see( i, rng ) );
+        }
+    }
+
+    if ( messages.empty() )
+    {
+        std::cerr << "no see message." << std::endl;
+        return 1;
+    }
+
+    VisualSensor see;
+
+    double sum = 0.0;
+    std::vector< double > usec;
+    usec.reserve( messages.size() );
+
+    const int n_loop = 10;
+    for ( int loop = 0; loop < n_loop; ++loop )
+    {
+        for ( std::size_t i = 0; i < messages.size(); ++i )
+        {
+            const GameTime current( loop * messages.size() + i + 1, 0 );
+
+            Timer timer;
+            see.parse( messages[i].c_str(), TEAM_NAME, 15.0, current );
+            const double msec = timer.elapsedReal();
+
+            if ( loop == n_loop - 1 )
+            {
+                usec.push_back( msec * 1000.0 );
+                sum += checksum( see );
+            }
+        }
+    }
+
+    std::sort( usec.begin(), usec.end() );
+
+    double total = 0.0;
+    for ( std::vector< double >::const_iterator it = usec.begin(); it != usec.end(); ++it )
+    {
+        total += *it;
+    }
+
+    std::cout << "messages=" << messages.size()
+              << " mean=" << total / usec.size()
+              << " median=" << usec[usec.size() / 2]
+              << " p99=" << usec[( usec.size() * 99 ) / 100]
+              << " [usec/message]" << std::endl;
+    std::cout.precision( 17 );
+    std::cout << "checksum=" << sum << std::endl;
+
+    return 0;
+}
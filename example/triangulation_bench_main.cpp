@@ -0,0 +1,280 @@
+// -*-c++-*-
+
+/*!
+  \file triangulation_bench_main.cpp
+  \brief benchmark of the point location in DelaunayTriangulation.
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/formation/formation_dt.h>
+#include <rcsc/geom/delaunay_triangulation.h>
+#include <rcsc/time/timer.h>
+
+#include <boost/random.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+
+using namespace rcsc;
+
+namespace {
+
+typedef DelaunayTriangulation DT;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief the linear search used before the point location index.
+*/
+bool
+linear_contains( const DT::Triangle * tri,
+                 const Vector2D & pos )
+{
+    if ( std::fabs( tri->circumcenter().x - pos.x ) > tri->circumradius()
+         || std::fabs( tri->circumcenter().y - pos.y ) > tri->circumradius() )
+    {
+        return false;
+    }
+
+    const Vector2D rel0( tri->vertex( 0 )->pos() - pos );
+    const Vector2D rel1( tri->vertex( 1 )->pos() - pos );
+    const Vector2D rel2( tri->vertex( 2 )->pos() - pos );
+
+    const double outer0 = rel0.outerProduct( rel1 );
+    const double outer1 = rel1.outerProduct( rel2 );
+    const double outer2 = rel2.outerProduct( rel0 );
+
+    if ( std::fabs( outer0 ) <= DT::EPSILON )
+    {
+        return ! ( rel0.x * rel1.x > DT::EPSILON || rel0.y * rel1.y > DT::EPSILON );
+    }
+    if ( std::fabs( outer1 ) <= DT::EPSILON )
+    {
+        return ! ( rel1.x * rel2.x > DT::EPSILON || rel1.y * rel2.y > DT::EPSILON );
+    }
+    if ( std::fabs( outer2 ) <= DT::EPSILON )
+    {
+        return ! ( rel2.x * rel0.x > DT::EPSILON || rel2.y * rel0.y > DT::EPSILON );
+    }
+
+    return ( ( outer0 >= 0.0 && outer1 >= 0.0 && outer2 >= 0.0 )
+             || ( outer0 <= 0.0 && outer1 <= 0.0 && outer2 <= 0.0 ) );
+}
+
+const DT::Triangle *
+linear_find_triangle( const DT & dt,
+                      const Vector2D & pos )
+{
+    for ( DT::TriangleCont::const_iterator it = dt.triangles().begin(), end = dt.triangles().end();
+          it != end;
+          ++it )
+    {
+        if ( linear_contains( it->second, pos ) )
+        {
+            return it->second;
+        }
+    }
+    return static_cast< const DT::Triangle * >( 0 );
+}
+
+const DT::Vertex *
+linear_find_vertex( const DT & dt,
+                    const Vector2D & pos )
+{
+    const DT::Vertex * candidate = static_cast< const DT::Vertex * >( 0 );
+    double min_dist2 = 10000000.0;
+    for ( DT::VertexCont::const_iterator it = dt.vertices().begin(), end = dt.vertices().end();
+          it != end;
+          ++it )
+    {
+        const double d2 = it->pos().dist2( pos );
+        if ( d2 < min_dist2 )
+        {
+            candidate = &(*it);
+            min_dist2 = d2;
+        }
+    }
+    return candidate;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the ball positions of the formation samples.
+  the half are on the regular grid and the rest are random.
+*/
+std::vector< Vector2D >
+create_samples( const int n,
+                boost::mt19937 & rng )
+{
+    boost::uniform_real<> x_dist( -52.5, 52.5 );
+    boost::uniform_real<> y_dist( -34.0, 34.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > x( rng, x_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > y( rng, y_dist );
+
+    std::vector< Vector2D > samples;
+
+    const int cols = static_cast< int >( std::sqrt( n / 2.0 * 1.5 ) ) + 1;
+    const int rows = std::max( 1, n / 2 / cols );
+    for ( int c = 0; c < cols; ++c )
+    {
+        for ( int r = 0; r < rows; ++r )
+        {
+            samples.push_back( Vector2D( -52.5 + 105.0 * c / std::max( 1, cols - 1 ),
+                                         -34.0 + 68.0 * r / std::max( 1, rows - 1 ) ) );
+        }
+    }
+
+    while ( static_cast< int >( samples.size() ) < n )
+    {
+        samples.push_back( Vector2D( x(), y() ) );
+    }
+
+    return samples;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief run the benchmark for one triangulation
+  \return the number of mismatched results
+*/
+int
+run( const std::string & name,
+     const DT & dt,
+     boost::mt19937 & rng )
+{
+    boost::uniform_real<> x_dist( -60.0, 60.0 );
+    boost::uniform_real<> y_dist( -45.0, 45.0 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > x( rng, x_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > y( rng, y_dist );
+
+    // random points, the vertices and the edge midpoints
+    std::vector< Vector2D > queries;
+    for ( int i = 0; i < 20000; ++i )
+    {
+        queries.push_back( Vector2D( x(), y() ) );
+    }
+    for ( DT::VertexCont::const_iterator it = dt.vertices().begin(), end = dt.vertices().end();
+          it != end;
+          ++it )
+    {
+        queries.push_back( it->pos() );
+    }
+    for ( DT::EdgeCont::const_iterator it = dt.edges().begin(), end = dt.edges().end();
+          it != end;
+          ++it )
+    {
+        queries.push_back( ( it->second->vertex( 0 )->pos() + it->second->vertex( 1 )->pos() ) * 0.5 );
+    }
+
+    long linear_sum = 0;
+    Timer timer;
+    for ( std::vector< Vector2D >::const_iterator p = queries.begin(), end = queries.end();
+          p != end;
+          ++p )
+    {
+        const DT::Triangle * tri = linear_find_triangle( dt, *p );
+        if ( tri ) linear_sum += tri->id();
+        else linear_sum += linear_find_vertex( dt, *p )->id();
+    }
+    const double linear_msec = timer.elapsedReal();
+
+    long index_sum = 0;
+    timer.restart();
+    for ( std::vector< Vector2D >::const_iterator p = queries.begin(), end = queries.end();
+          p != end;
+          ++p )
+    {
+        const DT::Triangle * tri = dt.findTriangleContains( *p );
+        if ( tri ) index_sum += tri->id();
+        else index_sum += dt.findNearestVertex( *p )->id();
+    }
+    const double index_msec = timer.elapsedReal();
+
+    int mismatch = ( linear_sum == index_sum ? 0 : 1 );
+    for ( std::vector< Vector2D >::const_iterator p = queries.begin(), end = queries.end();
+          p != end;
+          ++p )
+    {
+        if ( dt.findTriangleContains( *p ) != linear_find_triangle( dt, *p )
+             || dt.findNearestVertex( *p ) != linear_find_vertex( dt, *p ) )
+        {
+            ++mismatch;
+        }
+    }
+
+    std::cout << name
+              << " vertices=" << dt.vertices().size()
+              << " triangles=" << dt.triangles().size()
+              << " queries=" << queries.size()
+              << " linear=" << linear_msec * 1000.0 / queries.size()
+              << " index=" << index_msec * 1000.0 / queries.size()
+              << " [usec/query]"
+              << " mismatch=" << mismatch
+              << std::endl;
+
+    return mismatch;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    boost::mt19937 rng( 20100401 );
+
+    int mismatch = 0;
+
+    if ( argc > 1 )
+    {
+        // formation files
+        for ( int i = 1; i < argc; ++i )
+        {
+            std::ifstream fin( argv[i] );
+            Formation::Ptr f = Formation::create( fin );
+            if ( ! f
+                 || ! f->read( fin ) )
+            {
+                std::cerr << "failed to read the formation " << argv[i] << std::endl;
+                return 1;
+            }
+
+            const FormationDT * dt = dynamic_cast< const FormationDT * >( f.get() );
+            if ( ! dt )
+            {
+                std::cerr << argv[i] << " is not a " << FormationDT::NAME << " formation." << std::endl;
+                continue;
+            }
+
+            mismatch += run( argv[i], dt->triangulation(), rng );
+        }
+    }
+    else
+    {
+        const int sizes[] = { 30, 100, 300, 1000 };
+        for ( std::size_t i = 0; i < sizeof( sizes ) / sizeof( int ); ++i )
+        {
+            DT dt( Rect2D( Vector2D( -60.0, -45.0 ), Size2D( 120.0, 90.0 ) ) );
+            const std::vector< Vector2D > samples = create_samples( sizes[i], rng );
+            for ( std::vector< Vector2D >::const_iterator p = samples.begin(); p != samples.end(); ++p )
+            {
+                dt.addVertex( *p );
+            }
+            dt.compute();
+
+            std::ostringstream name;
+            name << "samples=" << sizes[i];
+            mismatch += run( name.str(), dt, rng );
+        }
+    }
+
+    return ( mismatch == 0 ? 0 : 1 );
+}
@@ -0,0 +1,185 @@
+// -*-c++-*-
+
+/*!
+  \file view_grid_bench_main.cpp
+  \brief benchmark of ViewGridMap::update().
+*/
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/view_grid_map.h>
+#include <rcsc/player/view_area.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/time/timer.h>
+#include <rcsc/game_time.h>
+
+#include <boost/random.hpp>
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+using namespace rcsc;
+
+namespace {
+
+typedef ViewGridMap VGM;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief the per cell loop used before the precomputed grid geometry.
+*/
+void
+linear_update( std::vector< int > & grid_map,
+               const ViewArea & view_area )
+{
+    const AngleDeg left_angle = view_area.angle() - view_area.viewWidth() * 0.5;
+    const AngleDeg right_angle = view_area.angle() + view_area.viewWidth() * 0.5;
+
+    const double VISIBLE_DIST = ServerParam::i().visibleDistance() - VGM::GRID_RADIUS;
+
+    int i = 0;
+    const std::vector< int >::iterator end = grid_map.end();
+    for ( std::vector< int >::iterator v = grid_map.begin();
+          v != end;
+          ++v, ++i )
+    {
+        Vector2D pos( ( i / VGM::GRID_Y_SIZE ) * VGM::GRID_LENGTH + VGM::PITCH_MIN_X,
+                      ( i % VGM::GRID_Y_SIZE ) * VGM::GRID_LENGTH + VGM::PITCH_MIN_Y );
+
+        double dist = view_area.origin().dist( pos );
+        if ( dist > VISIBLE_DIST )
+        {
+            AngleDeg angle = ( pos - view_area.origin() ).th();
+            if ( angle.isRightOf( left_angle )
+                 && angle.isLeftOf( right_angle ) )
+            {
+                double angle_thr = AngleDeg::asin_deg( VGM::GRID_RADIUS / dist );
+                if ( ( angle - left_angle ).abs() > angle_thr
+                     && ( angle - right_angle ).abs() > angle_thr )
+                {
+                    *v = 0;
+                }
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create random view areas
+*/
+std::vector< ViewArea >
+create_view_areas( const int n )
+{
+    boost::mt19937 rng( 20100501 );
+    boost::uniform_real<> x_dist( -52.5, 52.5 );
+    boost::uniform_real<> y_dist( -34.0, 34.0 );
+    boost::uniform_real<> dir_dist( -180.0, 180.0 );
+    boost::uniform_int<> width_dist( 0, 2 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > x( rng, x_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > y( rng, y_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > dir( rng, dir_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_int<> > width( rng, width_dist );
+
+    const double widths[] = { 60.0, 120.0, 180.0 };
+
+    std::vector< ViewArea > areas;
+    areas.reserve( n );
+    for ( int i = 0; i < n; ++i )
+    {
+        areas.push_back( ViewArea( widths[width()], Vector2D( x(), y() ), dir(),
+                                   GameTime( i + 1, 0 ) ) );
+    }
+    return areas;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const int n = ( argc > 1 ? std::atoi( argv[1] ) : 10000 );
+    if ( n <= 0 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [UPDATES]" << std::endl;
+        return 1;
+    }
+
+    const std::vector< ViewArea > areas = create_view_areas( n );
+
+    //
+    // the previous loop
+    //
+    std::vector< int > linear_map( VGM::GRID_X_SIZE * VGM::GRID_Y_SIZE, 0 );
+    Timer timer;
+    for ( int i = 0; i < n; ++i )
+    {
+        linear_update( linear_map, areas[i] );
+    }
+    const double linear_msec = timer.elapsedReal();
+
+    //
+    // ViewGridMap
+    //
+    ViewGridMap grid_map;
+    timer.restart();
+    for ( int i = 0; i < n; ++i )
+    {
+        grid_map.update( areas[i].time(), areas[i] );
+    }
+    const double grid_msec = timer.elapsedReal();
+
+    //
+    // finer grid
+    //
+    ViewGridMap fine_map( VGM::GRID_LENGTH * 0.5 );
+    timer.restart();
+    for ( int i = 0; i < n; ++i )
+    {
+        fine_map.update( areas[i].time(), areas[i] );
+    }
+    const double fine_msec = timer.elapsedReal();
+
+    //
+    // compare the results after each update
+    //
+    std::vector< int > check_map( linear_map.size(), 0 );
+    ViewGridMap check_grid;
+    int mismatch = 0;
+    for ( int i = 0; i < n; ++i )
+    {
+        for ( std::vector< int >::iterator v = check_map.begin(); v != check_map.end(); ++v ) *v += 1;
+        check_grid.incrementAll();
+
+        linear_update( check_map, areas[i] );
+        check_grid.update( areas[i].time(), areas[i] );
+
+        for ( int c = 0; c < static_cast< int >( check_map.size() ); ++c )
+        {
+            const Vector2D pos( ( c / VGM::GRID_Y_SIZE ) * VGM::GRID_LENGTH + VGM::PITCH_MIN_X,
+                                ( c % VGM::GRID_Y_SIZE ) * VGM::GRID_LENGTH + VGM::PITCH_MIN_Y );
+            if ( check_grid.seenCount( pos ) != check_map[c] )
+            {
+                ++mismatch;
+            }
+        }
+    }
+
+    std::cout << "updates=" << n
+              << " linear=" << linear_msec * 1000.0 / n
+              << " grid=" << grid_msec * 1000.0 / n
+              << " fine(" << fine_map.gridLength() << "m, " << fine_map.gridSize() << " cells)="
+              << fine_msec * 1000.0 / n
+              << " [usec/update]"
+              << " mismatch=" << mismatch
+              << std::endl;
+
+    return ( mismatch == 0 ? 0 : 1 );
+}
@@ -128,7 +128,7 @@ Body_TurnToBall::execute( PlayerAgent * agent )
         return false;
     }
 
-    Vector2D ball_point = agent->world().ball().inertiaPoint( M_cycle );
+    Vector2D ball_point = agent->world().ballTrajectory().pos( M_cycle );
 
     return Body_TurnToPoint( ball_point, M_cycle ).execute( agent );
 }
@@ -353,7 +353,7 @@ Body_Dribble2008::doTurnOnly( PlayerAgent * agent,
                       __FILE__": doTurnOnly() cannot turn by 1 step. angle_diff = %.1f",
                       dir_diff );
         Vector2D my_next2 = wm.self().inertiaPoint( 2 );
-        Vector2D ball_next2 = wm.ball().inertiaPoint( 2 );
+        Vector2D ball_next2 = wm.ballTrajectory().pos( 2 );
         double ball_dist_next2 = my_next2.dist( ball_next2 );
         if ( ball_dist_next2 > ( ptype.kickableArea()
                                  - ball_speed * SP.ballRand()
@@ -102,7 +102,7 @@ Body_Intercept2009::execute( PlayerAgent * agent )
                   best_intercept.turnCycle(), best_intercept.dashCycle(),
                   best_intercept.dashPower(), best_intercept.dashAngle().degree() );
 
-    Vector2D target_point = wm.ball().inertiaPoint( best_intercept.reachCycle() );
+    Vector2D target_point = wm.ballTrajectory().pos( best_intercept.reachCycle() );
     agent->debugClient().setTarget( target_point );
 
     if ( best_intercept.dashCycle() == 0 )
@@ -284,8 +284,8 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
 
         const int cycle = cache[i].reachCycle();
         const Vector2D self_pos = wm.self().inertiaPoint( cycle );
-        const Vector2D ball_pos = wm.ball().inertiaPoint( cycle );
-        const Vector2D ball_vel = wm.ball().vel() * std::pow( SP.ballDecay(), cycle );
+        const Vector2D ball_pos = wm.ballTrajectory().pos( cycle );
+        const Vector2D ball_vel = wm.ballTrajectory().vel( cycle );
 
 #ifdef DEBUG_PRINT_INTERCEPT_LIST
         dlog.addText( Logger::INTERCEPT,
@@ -578,8 +578,7 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
         }
 
         const Vector2D noturn_ball_vel
-            = wm.ball().vel()
-            * std::pow( SP.ballDecay(), noturn_best->reachCycle() );
+            = wm.ballTrajectory().vel( noturn_best->reachCycle() );
         const double noturn_ball_speed = noturn_ball_vel.r();
         if ( noturn_ball_vel.x > 0.1
              && ( noturn_ball_speed > speed_max
@@ -606,9 +605,8 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
         return *forward_best;
     }
 
-    const Vector2D fastest_pos = wm.ball().inertiaPoint( cache[0].reachCycle() );
-    const Vector2D fastest_vel = wm.ball().vel() * std::pow( SP.ballDecay(),
-                                                             cache[0].reachCycle() );
+    const Vector2D fastest_pos = wm.ballTrajectory().pos( cache[0].reachCycle() );
+    const Vector2D fastest_vel = wm.ballTrajectory().vel( cache[0].reachCycle() );
     if ( ( fastest_pos.x > -33.0
            || fastest_pos.absY() > 20.0 )
          && ( cache[0].reachCycle() >= 10
@@ -625,9 +623,9 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
     if ( noturn_best && nearest_best )
     {
         const Vector2D noturn_self_pos = wm.self().inertiaPoint( noturn_best->reachCycle() );
-        const Vector2D noturn_ball_pos = wm.ball().inertiaPoint( noturn_best->reachCycle() );
+        const Vector2D noturn_ball_pos = wm.ballTrajectory().pos( noturn_best->reachCycle() );
         const Vector2D nearest_self_pos = wm.self().inertiaPoint( nearest_best->reachCycle() );
-        const Vector2D nearest_ball_pos = wm.ball().inertiaPoint( nearest_best->reachCycle() );
+        const Vector2D nearest_ball_pos = wm.ballTrajectory().pos( nearest_best->reachCycle() );
 
 //         if ( wm.self().pos().dist2( noturn_ball_pos )
 //              < wm.self().pos().dist2( nearest_ball_pos ) )
@@ -646,8 +644,7 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
         if ( nearest_best->reachCycle() <= noturn_best->reachCycle() + 2 )
         {
             const Vector2D nearest_ball_vel
-                = wm.ball().vel()
-                * std::pow( SP.ballDecay(), nearest_best->reachCycle() );
+                = wm.ballTrajectory().vel( nearest_best->reachCycle() );
             const double nearest_ball_speed = nearest_ball_vel.r();
             if ( nearest_ball_speed < 0.7 )
             {
@@ -660,8 +657,7 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
             }
 
             const Vector2D noturn_ball_vel
-                = wm.ball().vel()
-                * std::pow( SP.ballDecay(), noturn_best->reachCycle() );
+                = wm.ballTrajectory().vel( noturn_best->reachCycle() );
 
             if ( nearest_best->ballDist() < wm.self().playerType().kickableArea() - 0.4
                  && nearest_best->ballDist() < noturn_best->ballDist()
@@ -787,8 +783,8 @@ Body_Intercept2009::getBestIntercept_Test( const WorldModel & /*wm*/,
         }
 
         const int reach_cycle = info.reachCycle();
-        const Vector2D ball_pos = wm.ball().inertiaPoint( reach_cycle );
-        const Vector2D ball_vel = wm.ball().vel() * std::pow( SP.ballDecay(), reach_cycle );
+        const Vector2D ball_pos = wm.ballTrajectory().pos( reach_cycle );
+        const Vector2D ball_vel = wm.ballTrajectory().vel( reach_cycle );
 
 
 
@@ -960,8 +956,7 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
     AngleDeg accel_angle = wm.self().body();
     if ( info.dashPower() < 0.0 ) accel_angle += 180.0;
 
-    Vector2D ball_vel = wm.ball().vel() * std::pow( ServerParam::i().ballDecay(),
-                                                    info.reachCycle() );
+    Vector2D ball_vel = wm.ballTrajectory().vel( info.reachCycle() );
 
     if ( ( ! wm.self().goalie()
            || wm.lastKickerSide() == wm.ourSide() )
@@ -1010,7 +1005,7 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
     double used_power = info.dashPower();
 
     if ( wm.ball().seenPosCount() <= 2
-         && wm.ball().vel().r() * std::pow( ServerParam::i().ballDecay(), info.reachCycle() ) < ptype.kickableArea() * 1.5
+         && wm.ballTrajectory().vel( info.reachCycle() ).r() < ptype.kickableArea() * 1.5
          && info.dashAngle().abs() < 5.0
          && target_rel.absX() < ( ptype.kickableArea()
                                   + ptype.dashRate( wm.self().effort() )
@@ -92,7 +92,7 @@ Body_Intercept2013::execute( PlayerAgent * agent )
 
     // debug output
     {
-        Vector2D ball_pos = wm.ball().inertiaPoint( best_intercept.reachCycle() );
+        Vector2D ball_pos = wm.ballTrajectory().pos( best_intercept.reachCycle() );
         agent->debugClient().setTarget( ball_pos );
 
         dlog.addText( Logger::INTERCEPT,
@@ -198,7 +198,7 @@ Body_Intercept2013::doFirstTurn( PlayerAgent * agent,
     const WorldModel & wm = agent->world();
 
     const Vector2D self_pos = wm.self().inertiaPoint( info.reachCycle() );
-    const Vector2D ball_pos = wm.ball().inertiaPoint( info.reachCycle() );
+    const Vector2D ball_pos = wm.ballTrajectory().pos( info.reachCycle() );
 
     AngleDeg ball_angle = ( ball_pos - self_pos ).th();
     if ( info.dashPower() < 0.0 )
@@ -257,7 +257,7 @@ Body_Intercept2013::doDashWait( PlayerAgent * agent,
     const WorldModel & wm = agent->world();
 
     const Vector2D self_pos = wm.self().inertiaPoint( info.reachCycle() );
-    const Vector2D ball_pos = wm.ball().inertiaPoint( info.reachCycle() );
+    const Vector2D ball_pos = wm.ballTrajectory().pos( info.reachCycle() );
     const bool goalie_mode = ( wm.self().goalie()
                                && wm.lastKickerSide() != wm.ourSide()
                                && ball_pos.x < ServerParam::i().ourPenaltyAreaLineX()
@@ -507,7 +507,7 @@ Body_Intercept2013::get_best_intercept2013( const WorldModel & wm,
             continue;
         }
 
-        const Vector2D ball_pos = wm.ball().inertiaPoint( it->reachCycle() );
+        const Vector2D ball_pos = wm.ballTrajectory().pos( it->reachCycle() );
         double turn_angle = (ball_pos.th() - wm.self().body()).abs();
         const AngleDeg body_angle = wm.self().body() + turn_angle;
         const double ball_speed = first_ball_speed * std::pow( SP.ballDecay(), it->reachCycle() );
@@ -799,7 +799,7 @@ Body_Intercept2013::get_best_intercept_goalie( const WorldModel & wm )
           it != end;
           ++it, ++count )
     {
-        const Vector2D ball_pos = wm.ball().inertiaPoint( it->reachCycle() );
+        const Vector2D ball_pos = wm.ballTrajectory().pos( it->reachCycle() );
         double turn_angle = (ball_pos.th() - wm.self().body()).abs();
         const AngleDeg body_angle = wm.self().body() + turn_angle;
         const double control_area = ( ball_pos.x < SP.ourPenaltyAreaLineX() - 0.5
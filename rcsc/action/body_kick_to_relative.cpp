@@ -43,6 +43,8 @@
 #include <rcsc/soccer_math.h>
 #include <rcsc/math_util.h>
 
+#include <list>
+
 namespace rcsc {
 
 const size_t Body_KickToRelative::DEFAULT_KICK_QUEUE_MAX = 5;
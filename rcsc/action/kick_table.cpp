@@ -50,6 +50,16 @@
 #include <algorithm>
 #include <functional>
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/types.h> // mmap()
+#include <sys/stat.h> // fstat()
+#include <sys/mman.h> // mmap()
+#include <fcntl.h> // open()
+#include <unistd.h> // close(), getpid()
 
 #define DEBUG_PROFILE
 // #define DEBUG
@@ -103,6 +113,100 @@ struct SequenceCmp {
       }
 };
 
+namespace {
+
+/*!
+  \struct BinaryHeader
+  \brief header block of the binary kick table file
+*/
+struct BinaryHeader {
+    char magic_[8]; //!< file identifier
+    boost::uint32_t version_; //!< format version
+    boost::uint32_t byte_order_; //!< byte order mark
+    boost::uint64_t hash_; //!< parameter hash value
+    boost::uint32_t state_record_size_; //!< sizeof( StateRecord )
+    boost::uint32_t path_record_size_; //!< sizeof( KickTable::Path )
+    boost::int32_t state_size_; //!< number of states
+    boost::int32_t table_size_[KickTable::DEST_DIR_DIVS]; //!< number of paths in each table
+    double player_size_; //!< player size
+    double kickable_margin_; //!< kickable margin
+    double ball_size_; //!< ball size
+};
+
+/*!
+  \struct StateRecord
+  \brief fixed size state record in the binary kick table file
+*/
+struct StateRecord {
+    boost::int32_t index_;
+    boost::int32_t padding_;
+    double dist_;
+    double x_;
+    double y_;
+    double kick_rate_;
+};
+
+const char BINARY_MAGIC[8] = { 'R', 'C', 'S', 'C', 'K', 'T', 'B', '\0' };
+const boost::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief FNV-1a hash update
+ */
+inline
+void
+hash_bytes( boost::uint64_t & hash,
+            const void * data,
+            const size_t size )
+{
+    const unsigned char * p = static_cast< const unsigned char * >( data );
+    for ( size_t i = 0; i < size; ++i )
+    {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief deleter for the mapped file region
+ */
+struct MappedRegionDeleter {
+    size_t size_;
+
+    explicit
+    MappedRegionDeleter( const size_t size )
+        : size_( size )
+      { }
+
+    void operator()( void * addr ) const
+      {
+          if ( addr )
+          {
+              ::munmap( addr, size_ );
+          }
+      }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KickTable::TypeTable::TypeTable()
+    : hash_( 0 ),
+      player_size_( 0.0 ),
+      kickable_margin_( 0.0 ),
+      ball_size_( 0.0 )
+{
+    for ( int i = 0; i < DEST_DIR_DIVS; ++i )
+    {
+        table_[i] = static_cast< const Path * >( 0 );
+        table_size_[i] = 0;
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -253,9 +357,7 @@ KickTable::instance()
 
  */
 KickTable::KickTable()
-    : M_player_size( 0.0 )
-    , M_kickable_margin( 0.0 )
-    , M_ball_size( 0.0 )
+    : M_table( static_cast< const TypeTable * >( 0 ) )
 {
     for ( int i = 0; i < MAX_DEPTH; ++ i )
     {
@@ -263,6 +365,99 @@ KickTable::KickTable()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+boost::uint64_t
+KickTable::calc_param_hash( const PlayerType & player_type )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    boost::uint64_t hash = 14695981039346656037ULL;
+
+    const boost::int32_t layout[] = { BINARY_FORMAT_VERSION,
+                                      STATE_DIVS_NEAR, STATE_DIVS_MID, STATE_DIVS_FAR,
+                                      DEST_DIR_DIVS, MAX_TABLE_SIZE };
+    const double values[] = { NEAR_SIDE_RATE, MID_RATE, FAR_SIDE_RATE,
+                              SP.ballSize(),
+                              SP.maxPower(),
+                              SP.ballAccelMax(),
+                              SP.ballSpeedMax(),
+                              player_type.playerSize(),
+                              player_type.kickableMargin(),
+                              player_type.kickPowerRate() };
+
+    hash_bytes( hash, layout, sizeof( layout ) );
+    hash_bytes( hash, values, sizeof( values ) );
+
+    return hash;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+KickTable::binary_file_name( const PlayerType & player_type )
+{
+    std::ostringstream os;
+    os << "kick_table_v" << BINARY_FORMAT_VERSION << '_'
+       << std::hex << std::setw( 16 ) << std::setfill( '0' )
+       << calc_param_hash( player_type )
+       << ".bin";
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KickTable::TypeTablePtr
+KickTable::findTable( const boost::uint64_t hash ) const
+{
+    for ( std::map< int, TypeTablePtr >::const_iterator it = M_type_tables.begin(),
+              end = M_type_tables.end();
+          it != end;
+          ++it )
+    {
+        if ( it->second->hash_ == hash )
+        {
+            return it->second;
+        }
+    }
+
+    return TypeTablePtr();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const KickTable::TypeTable *
+KickTable::selectTable( const PlayerType & player_type ) const
+{
+    if ( M_type_tables.empty() )
+    {
+        return static_cast< const TypeTable * >( 0 );
+    }
+
+    std::map< int, TypeTablePtr >::const_iterator it = M_type_tables.find( player_type.id() );
+    if ( it != M_type_tables.end()
+         && it->second->hash_ == calc_param_hash( player_type ) )
+    {
+        return it->second.get();
+    }
+
+    it = M_type_tables.find( Hetero_Default );
+    if ( it != M_type_tables.end() )
+    {
+        return it->second.get();
+    }
+
+    return M_type_tables.begin()->second.get();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -272,20 +467,42 @@ KickTable::createTables()
 {
     const PlayerType player_type; // default type
 
-    if ( std::fabs( M_player_size - player_type.playerSize() ) < rcsc::EPS
-         && std::fabs( M_kickable_margin - player_type.kickableMargin() ) < rcsc::EPS
-         && std::fabs( M_ball_size - ServerParam::i().ballSize() ) < rcsc::EPS )
+    return createTables( player_type );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::createTables( const PlayerType & player_type )
+{
+    const boost::uint64_t hash = calc_param_hash( player_type );
+
+    std::map< int, TypeTablePtr >::iterator it = M_type_tables.find( player_type.id() );
+    if ( it != M_type_tables.end()
+         && it->second->hash_ == hash )
     {
         return false;
     }
 
+    TypeTablePtr same = findTable( hash );
+    if ( same )
+    {
+        M_type_tables[player_type.id()] = same;
+        M_table = static_cast< const TypeTable * >( 0 );
+        return true;
+    }
+
     //std::cerr << "createTables" << std::endl;
 
-    M_player_size = player_type.playerSize();
-    M_kickable_margin = player_type.kickableMargin();
-    M_ball_size = ServerParam::i().ballSize();
+    TypeTablePtr table( new TypeTable() );
+    table->hash_ = hash;
+    table->player_size_ = player_type.playerSize();
+    table->kickable_margin_ = player_type.kickableMargin();
+    table->ball_size_ = ServerParam::i().ballSize();
 
-    createStateList( player_type );
+    createStateList( player_type, *table );
 
     MSecTimer timer;
 
@@ -294,17 +511,25 @@ KickTable::createTables()
 
     for ( int i = 0; i < DEST_DIR_DIVS; ++i, angle += angle_step )
     {
-        createTable( angle, M_tables[i] );
+        createTable( table->state_list_, angle, table->paths_[i] );
+        table->table_[i] = ( table->paths_[i].empty()
+                             ? static_cast< const Path * >( 0 )
+                             : &table->paths_[i][0] );
+        table->table_size_[i] = table->paths_[i].size();
     }
 
+    M_type_tables[player_type.id()] = table;
+    M_table = static_cast< const TypeTable * >( 0 );
+
     dlog.addText( Logger::KICK,
-                  __FILE__": createTables() elapsed %.3f [ms]",
+                  __FILE__": createTables() type=%d elapsed %.3f [ms]",
+                  player_type.id(),
                   timer.elapsedReal() );
 
 #if 0
     const double kprate = ServerParam::i().kickPowerRate();
-    for ( std::vector< State >::iterator s = M_state_list.begin();
-          s != M_state_list.end();
+    for ( std::vector< State >::iterator s = table->state_list_.begin();
+          s != table->state_list_.end();
           ++s )
     {
         std::cout << "  state "
@@ -320,8 +545,8 @@ KickTable::createTables()
     for ( int i = 0; i < DEST_DIR_DIVS; ++i, angle += angle_step )
     {
         std::cout << "create table " << i << " : angle="  << angle << std::endl;
-        for ( std::vector< Path >::iterator p = M_tables[i].begin();
-              p != M_tables[i].end();
+        for ( std::vector< Path >::iterator p = table->paths_[i].begin();
+              p != table->paths_[i].end();
               ++p )
         {
             std::cout << "  table "
@@ -336,6 +561,76 @@ KickTable::createTables()
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::setupTables( const std::string & cache_dir )
+{
+    std::vector< const PlayerType * > types;
+
+    const PlayerType default_type;
+    types.push_back( &default_type );
+
+    const PlayerTypeSet::PlayerTypeMap & type_map = PlayerTypeSet::i().playerTypeMap();
+    for ( PlayerTypeSet::PlayerTypeMap::const_iterator it = type_map.begin(),
+              end = type_map.end();
+          it != end;
+          ++it )
+    {
+        types.push_back( &(it->second) );
+    }
+
+    bool result = true;
+
+    for ( std::vector< const PlayerType * >::const_iterator t = types.begin(),
+              end = types.end();
+          t != end;
+          ++t )
+    {
+        const PlayerType & type = **t;
+        const boost::uint64_t hash = calc_param_hash( type );
+        const TypeTablePtr same = findTable( hash );
+
+        if ( cache_dir.empty()
+             || ( same && same->mapped_ ) )
+        {
+            // the table is created, or shared with the type that has the same parameters.
+            createTables( type );
+        }
+        else
+        {
+            const std::string file_path = cache_dir + '/' + binary_file_name( type );
+
+            if ( ! readBinary( file_path, type ) )
+            {
+                createTables( type );
+
+                if ( writeBinary( file_path, type ) )
+                {
+                    // replace the private copy by the shared mapped pages
+                    readBinary( file_path, type );
+                }
+                else
+                {
+                    std::cerr << "KickTable: could not write the binary table ["
+                              << file_path << "]" << std::endl;
+                }
+            }
+        }
+
+        const TypeTable * table = selectTable( type );
+        if ( ! table
+             || table->hash_ != hash )
+        {
+            result = false;
+        }
+    }
+
+    return result;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -351,13 +646,12 @@ KickTable::read( const std::string & file_path )
         return false;
     }
 
-    M_state_list.clear();
-    M_state_list.reserve( NUM_STATE );
+    TypeTablePtr table( new TypeTable() );
+    table->state_list_.reserve( NUM_STATE );
 
     for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
     {
-        M_tables[dir].clear();
-        M_tables[dir].reserve( NUM_STATE * NUM_STATE );
+        table->paths_[dir].reserve( NUM_STATE * NUM_STATE );
     }
 
     std::string line_buf;
@@ -431,8 +725,9 @@ KickTable::read( const std::string & file_path )
             return false;
         }
 
+        state.dist_ = state.pos_.r();
         state.flag_ = SAFETY;
-        M_state_list.push_back( state );
+        table->state_list_.push_back( state );
 
     }
 
@@ -482,13 +777,35 @@ KickTable::read( const std::string & file_path )
                 return false;
             }
 
-            M_tables[dir].push_back( path );
+            table->paths_[dir].push_back( path );
         }
+
+        table->table_[dir] = ( table->paths_[dir].empty()
+                               ? static_cast< const Path * >( 0 )
+                               : &table->paths_[dir][0] );
+        table->table_size_[dir] = table->paths_[dir].size();
+    }
+
+    const PlayerType default_type;
+
+    // the table is up to date only if it was created with the current parameters.
+    // otherwise createTables() rebuilds it.
+    if ( std::fabs( player_size - default_type.playerSize() ) < rcsc::EPS
+         && std::fabs( kickable_margin - default_type.kickableMargin() ) < rcsc::EPS
+         && std::fabs( ball_size - ServerParam::i().ballSize() ) < rcsc::EPS )
+    {
+        table->hash_ = calc_param_hash( default_type );
+    }
+    else
+    {
+        table->hash_ = 0;
     }
+    table->player_size_ = player_size;
+    table->kickable_margin_ = kickable_margin;
+    table->ball_size_ = ball_size;
 
-    M_player_size = player_size;
-    M_kickable_margin = kickable_margin;
-    M_ball_size = ball_size;
+    M_type_tables[Hetero_Default] = table;
+    M_table = static_cast< const TypeTable * >( 0 );
 
     std::cerr << "read kick table ... ok" << std::endl;
 
@@ -502,6 +819,14 @@ KickTable::read( const std::string & file_path )
 bool
 KickTable::write( const std::string & file_path )
 {
+    std::map< int, TypeTablePtr >::const_iterator it = M_type_tables.find( Hetero_Default );
+    if ( it == M_type_tables.end() )
+    {
+        return false;
+    }
+
+    const TypeTable & table = *(it->second);
+
     std::ofstream fout( file_path.c_str() );
     if ( ! fout.is_open() )
     {
@@ -511,20 +836,20 @@ KickTable::write( const std::string & file_path )
     //
     // write server parameters
     //
-    fout << M_player_size << ' '
-         << M_kickable_margin << ' '
-         << M_ball_size << '\n';
+    fout << table.player_size_ << ' '
+         << table.kickable_margin_ << ' '
+         << table.ball_size_ << '\n';
 
     //
     // write state size
     //
-    fout << M_state_list.size() << '\n';
+    fout << table.state_list_.size() << '\n';
 
     //
     // write state list
     //
-    for ( std::vector< State >::const_iterator s = M_state_list.begin();
-          s != M_state_list.end();
+    for ( std::vector< State >::const_iterator s = table.state_list_.begin();
+          s != table.state_list_.end();
           ++s )
     {
         fout << s->index_ << ' '
@@ -535,11 +860,10 @@ KickTable::write( const std::string & file_path )
 
     for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
     {
-        fout << M_tables[dir].size() << '\n';
+        fout << table.table_size_[dir] << '\n';
 
-        for ( std::vector< Path >::const_iterator t = M_tables[dir].begin();
-              t != M_tables[dir].end();
-              ++t )
+        const Path * end = table.table_[dir] + table.table_size_[dir];
+        for ( const Path * t = table.table_[dir]; t != end; ++t )
         {
             fout << t->origin_ << ' '
                  << t->dest_ << ' '
@@ -554,12 +878,244 @@ KickTable::write( const std::string & file_path )
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::readBinary( const std::string & file_path,
+                       const PlayerType & player_type )
+{
+    const boost::uint64_t hash = calc_param_hash( player_type );
+
+    const int fd = ::open( file_path.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || static_cast< size_t >( st.st_size ) < sizeof( BinaryHeader ) )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    const size_t file_size = st.st_size;
+    void * addr = ::mmap( 0, file_size, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        std::cerr << "KickTable: mmap failed [" << file_path << "]" << std::endl;
+        return false;
+    }
+
+    boost::shared_ptr< void > region( addr, MappedRegionDeleter( file_size ) );
+
+    const char * data = static_cast< const char * >( addr );
+    const BinaryHeader * header = reinterpret_cast< const BinaryHeader * >( data );
+
+    if ( std::memcmp( header->magic_, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) != 0
+         || header->version_ != BINARY_FORMAT_VERSION
+         || header->byte_order_ != BYTE_ORDER_MARK
+         || header->state_record_size_ != sizeof( StateRecord )
+         || header->path_record_size_ != sizeof( Path )
+         || header->state_size_ != NUM_STATE )
+    {
+        std::cerr << "KickTable: illegal binary table format [" << file_path << "]"
+                  << std::endl;
+        return false;
+    }
+
+    if ( header->hash_ != hash )
+    {
+        // stale table for other parameters
+        return false;
+    }
+
+    size_t total_size = sizeof( BinaryHeader ) + sizeof( StateRecord ) * NUM_STATE;
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        if ( header->table_size_[dir] < 0
+             || header->table_size_[dir] > MAX_TABLE_SIZE )
+        {
+            std::cerr << "KickTable: illegal table size [" << file_path << "]"
+                      << std::endl;
+            return false;
+        }
+        total_size += sizeof( Path ) * header->table_size_[dir];
+    }
+
+    if ( total_size != file_size )
+    {
+        std::cerr << "KickTable: illegal binary table size [" << file_path << "]"
+                  << std::endl;
+        return false;
+    }
+
+    TypeTablePtr table( new TypeTable() );
+    table->hash_ = hash;
+    table->player_size_ = header->player_size_;
+    table->kickable_margin_ = header->kickable_margin_;
+    table->ball_size_ = header->ball_size_;
+    table->mapped_ = region;
+
+    //
+    // states are copied because they are small.
+    //
+    const StateRecord * records
+        = reinterpret_cast< const StateRecord * >( data + sizeof( BinaryHeader ) );
+
+    table->state_list_.reserve( NUM_STATE );
+    for ( int i = 0; i < NUM_STATE; ++i )
+    {
+        table->state_list_.push_back( State( records[i].index_,
+                                             records[i].dist_,
+                                             Vector2D( records[i].x_, records[i].y_ ),
+                                             records[i].kick_rate_ ) );
+    }
+
+    //
+    // paths refer to the mapped pages directly.
+    //
+    const Path * path = reinterpret_cast< const Path * >( records + NUM_STATE );
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        const int size = header->table_size_[dir];
+        for ( int i = 0; i < size; ++i )
+        {
+            if ( path[i].origin_ < 0 || NUM_STATE <= path[i].origin_
+                 || path[i].dest_ < 0 || NUM_STATE <= path[i].dest_ )
+            {
+                std::cerr << "KickTable: illegal path index [" << file_path << "]"
+                          << std::endl;
+                return false;
+            }
+        }
+
+        table->table_[dir] = ( size > 0 ? path : static_cast< const Path * >( 0 ) );
+        table->table_size_[dir] = size;
+        path += size;
+    }
+
+    //
+    // share the mapped table with all types that have the same hash value
+    //
+    for ( std::map< int, TypeTablePtr >::iterator it = M_type_tables.begin(),
+              end = M_type_tables.end();
+          it != end;
+          ++it )
+    {
+        if ( it->second->hash_ == hash )
+        {
+            it->second = table;
+        }
+    }
+
+    M_type_tables[player_type.id()] = table;
+    M_table = static_cast< const TypeTable * >( 0 );
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::writeBinary( const std::string & file_path,
+                        const PlayerType & player_type ) const
+{
+    const boost::uint64_t hash = calc_param_hash( player_type );
+    const TypeTablePtr table = findTable( hash );
+
+    if ( ! table
+         || table->state_list_.size() != NUM_STATE )
+    {
+        return false;
+    }
+
+    BinaryHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic_, BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+    header.version_ = BINARY_FORMAT_VERSION;
+    header.byte_order_ = BYTE_ORDER_MARK;
+    header.hash_ = hash;
+    header.state_record_size_ = sizeof( StateRecord );
+    header.path_record_size_ = sizeof( Path );
+    header.state_size_ = NUM_STATE;
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        header.table_size_[dir] = table->table_size_[dir];
+    }
+    header.player_size_ = table->player_size_;
+    header.kickable_margin_ = table->kickable_margin_;
+    header.ball_size_ = table->ball_size_;
+
+    //
+    // write to the temporary file, then rename it,
+    // so that other processes never map an incomplete file.
+    //
+    std::ostringstream tmp_path;
+    tmp_path << file_path << ".tmp." << ::getpid();
+
+    std::FILE * fp = std::fopen( tmp_path.str().c_str(), "wb" );
+    if ( ! fp )
+    {
+        return false;
+    }
+
+    bool result = ( std::fwrite( &header, sizeof( header ), 1, fp ) == 1 );
+
+    for ( std::vector< State >::const_iterator s = table->state_list_.begin(),
+              end = table->state_list_.end();
+          result && s != end;
+          ++s )
+    {
+        StateRecord record;
+        std::memset( &record, 0, sizeof( record ) );
+        record.index_ = s->index_;
+        record.dist_ = s->dist_;
+        record.x_ = s->pos_.x;
+        record.y_ = s->pos_.y;
+        record.kick_rate_ = s->kick_rate_;
+
+        result = ( std::fwrite( &record, sizeof( record ), 1, fp ) == 1 );
+    }
+
+    for ( int dir = 0; result && dir < DEST_DIR_DIVS; ++dir )
+    {
+        const size_t size = table->table_size_[dir];
+        if ( size > 0 )
+        {
+            result = ( std::fwrite( table->table_[dir], sizeof( Path ), size, fp ) == size );
+        }
+    }
+
+    if ( std::fclose( fp ) != 0 )
+    {
+        result = false;
+    }
+
+    if ( ! result
+         || std::rename( tmp_path.str().c_str(), file_path.c_str() ) != 0 )
+    {
+        std::remove( tmp_path.str().c_str() );
+        return false;
+    }
+
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
  */
 void
-KickTable::createStateList( const PlayerType & player_type )
+KickTable::createStateList( const PlayerType & player_type,
+                            TypeTable & table )
 {
     const double near_dist = calc_near_dist( player_type );
     const double mid_dist = calc_mid_dist( player_type );
@@ -580,16 +1136,18 @@ KickTable::createStateList( const PlayerType & player_type )
               << std::endl;
 #endif
 
+    std::vector< State > & state_list = table.state_list_;
+
     int index = 0;
-    M_state_list.clear();
-    M_state_list.reserve( NUM_STATE );
+    state_list.clear();
+    state_list.reserve( NUM_STATE );
 
     for ( int near = 0; near < STATE_DIVS_NEAR; ++near )
     {
         AngleDeg angle = -180.0 + ( near_angle_step * near );
         Vector2D pos = Vector2D::polar2vector( near_dist, angle );
         double krate = player_type.kickRate( near_dist, angle.degree() );
-        M_state_list.push_back( State( index, near_dist, pos, krate ) );
+        state_list.push_back( State( index, near_dist, pos, krate ) );
         ++index;
     }
 
@@ -598,7 +1156,7 @@ KickTable::createStateList( const PlayerType & player_type )
         AngleDeg angle = -180.0 + ( mid_angle_step * mid );
         Vector2D pos = Vector2D::polar2vector( mid_dist, angle );
         double krate = player_type.kickRate( mid_dist, angle.degree() );
-        M_state_list.push_back( State( index, mid_dist, pos, krate ) );
+        state_list.push_back( State( index, mid_dist, pos, krate ) );
         ++index;
     }
 
@@ -607,13 +1165,13 @@ KickTable::createStateList( const PlayerType & player_type )
         AngleDeg angle = -180.0 + ( far_angle_step * far );
         Vector2D pos = Vector2D::polar2vector( far_dist, angle );
         double krate = player_type.kickRate( far_dist, angle.degree() );
-        M_state_list.push_back( State( index, far_dist, pos, krate ) );
+        state_list.push_back( State( index, far_dist, pos, krate ) );
         ++index;
     }
 
 #if 0
-    for ( std::vector< State >::const_iterator s = M_state_list.begin();
-          s != M_state_list.end();
+    for ( std::vector< State >::const_iterator s = state_list.begin();
+          s != state_list.end();
           ++s )
     {
         std::cerr << s->index_ << ' '
@@ -629,11 +1187,12 @@ KickTable::createStateList( const PlayerType & player_type )
 
  */
 void
-KickTable::createTable( const AngleDeg & angle,
+KickTable::createTable( const std::vector< State > & state_list,
+                        const AngleDeg & angle,
                         std::vector< Path > & table )
 {
     const int max_combination = NUM_STATE * NUM_STATE;
-    const int max_state = M_state_list.size();
+    const int max_state = state_list.size();
 
     table.clear();
     table.reserve( max_combination );
@@ -642,15 +1201,15 @@ KickTable::createTable( const AngleDeg & angle,
     {
         for ( int dest = 0; dest < max_state; ++dest )
         {
-            Vector2D vel = M_state_list[dest].pos_ - M_state_list[origin].pos_;
+            Vector2D vel = state_list[dest].pos_ - state_list[origin].pos_;
             Vector2D max_vel = calc_max_velocity( angle,
-                                                  M_state_list[dest].kick_rate_,
+                                                  state_list[dest].kick_rate_,
                                                   vel );
             Vector2D accel = max_vel - vel;
 
             Path path( origin, dest );
             path.max_speed_ = max_vel.r();
-            path.power_ = accel.r() / M_state_list[dest].kick_rate_;
+            path.power_ = accel.r() / state_list[dest].kick_rate_;
             table.push_back( path );
         }
     }
@@ -672,12 +1231,16 @@ KickTable::updateState( const WorldModel & world )
 {
     static GameTime s_update_time( -1, 0 );
 
-    if ( s_update_time == world.time() )
+    const TypeTable * table = selectTable( world.self().playerType() );
+
+    if ( s_update_time == world.time()
+         && M_table == table )
     {
         return;
     }
 
     s_update_time = world.time();
+    M_table = table;
 
     //
     // update current state
@@ -687,6 +1250,7 @@ KickTable::updateState( const WorldModel & world )
 #endif
 
     createStateCache( world );
+    createKickCache( world );
 
 #ifdef DEBUG_PROFILE
     dlog.addText( Logger::KICK,
@@ -770,7 +1334,7 @@ KickTable::createStateCache( const WorldModel & world )
         int index = 0;
         for ( int near = 0; near < STATE_DIVS_NEAR; ++near )
         {
-            Vector2D pos = M_state_list[index].pos_;
+            Vector2D pos = M_table->state_list_[index].pos_;
             double krate = self_type.kickRate( near_dist, pos.th().degree() );
 
             pos.rotate( world.self().body() );
@@ -788,14 +1352,14 @@ KickTable::createStateCache( const WorldModel & world )
                           "__ cache_near_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
                           i+1, index,
                           pos.x, pos.y,
-                          krate, M_state_list[index].kick_rate_ );
+                          krate, M_table->state_list_[index].kick_rate_ );
 #endif
             ++index;
         }
 
         for ( int mid = 0; mid < STATE_DIVS_MID; ++mid )
         {
-            Vector2D pos = M_state_list[index].pos_;
+            Vector2D pos = M_table->state_list_[index].pos_;
             double krate = self_type.kickRate( mid_dist, pos.th().degree() );
 
             pos.rotate( world.self().body() );
@@ -813,14 +1377,14 @@ KickTable::createStateCache( const WorldModel & world )
                           "__ cache_mid_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
                           i+1, index,
                           pos.x, pos.y,
-                          krate,  M_state_list[index].kick_rate_ );
+                          krate,  M_table->state_list_[index].kick_rate_ );
 #endif
             ++index;
         }
 
         for ( int far = 0; far < STATE_DIVS_FAR; ++far )
         {
-            Vector2D pos = M_state_list[index].pos_;
+            Vector2D pos = M_table->state_list_[index].pos_;
             double krate = self_type.kickRate( far_dist, pos.th().degree() );
 
             pos.rotate( world.self().body() );
@@ -838,7 +1402,7 @@ KickTable::createStateCache( const WorldModel & world )
                           "__ cache_far_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
                           i+1, index,
                           pos.x, pos.y,
-                          krate, M_state_list[index].kick_rate_ );
+                          krate, M_table->state_list_[index].kick_rate_ );
 #endif
             ++index;
         }
@@ -846,6 +1410,129 @@ KickTable::createStateCache( const WorldModel & world )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KickTable::createKickCache( const WorldModel & world )
+{
+    const ServerParam & param = ServerParam::i();
+    const PlayerType & self_type = world.self().playerType();
+
+    const double max_power = param.maxPower();
+    const double accel_max = param.ballAccelMax();
+    const double ball_decay = param.ballDecay();
+
+    //
+    // structure-of-arrays copy of the state cache
+    //
+    for ( int i = 0; i < MAX_DEPTH; ++i )
+    {
+        StateArray & array = M_state_array[i];
+        const std::vector< State > & states = M_state_cache[i];
+
+        for ( int s = 0; s < NUM_STATE; ++s )
+        {
+            array.pos_x_[s] = states[s].pos_.x;
+            array.pos_y_[s] = states[s].pos_.y;
+            array.max_accel_[s] = std::min( states[s].kick_rate_ * max_power, accel_max );
+        }
+    }
+
+    //
+    // first kick from the current ball to each first layer state.
+    // it does not depend on the kick target.
+    //
+    const double my_kickable_area = self_type.kickableArea();
+
+    const double my_noise = world.self().vel().r() * param.playerRand();
+    const double current_dir_diff_rate
+        = ( world.ball().angleFromSelf() - world.self().body() ).abs() / 180.0;
+    const double current_dist_rate = ( ( world.ball().distFromSelf()
+                                         - self_type.playerSize()
+                                         - param.ballSize() )
+                                       / self_type.kickableMargin() );
+    const double current_pos_rate
+        = 0.5 + 0.25 * ( current_dir_diff_rate + current_dist_rate );
+    const double current_speed_rate
+        = 0.5 + 0.5 * ( world.ball().vel().r()
+                        / ( param.ballSpeedMax() * param.ballDecay() ) );
+
+    for ( int i = 0; i < NUM_STATE; ++i )
+    {
+        const State & state = M_state_cache[0][i];
+
+        Vector2D vel = state.pos_ - world.ball().pos();
+        Vector2D accel = vel - world.ball().vel();
+
+        M_first_accel_r2[i] = accel.r2();
+        M_first_accel_r[i] = accel.r();
+
+        double kick_power = M_first_accel_r[i] / world.self().kickRate();
+        double ball_noise = vel.r() * param.ballRand();
+        double max_kick_rand
+            = self_type.kickRand()
+            * ( kick_power / param.maxPower() )
+            * ( current_pos_rate + current_speed_rate );
+
+        M_first_kick_miss[i] = ( ( my_noise + ball_noise + max_kick_rand )
+                                 > my_kickable_area - state.dist_ - 0.05
+                                 ? KICK_MISS_POSSIBILITY
+                                 : SAFETY );
+
+        vel *= ball_decay;
+        M_first_vel_x[i] = vel.x;
+        M_first_vel_y[i] = vel.y;
+    }
+
+    //
+    // second kick from each first layer state to each second layer state.
+    //
+    for ( int o = 0; o < NUM_STATE; ++o )
+    {
+        const Vector2D & pos_1st = M_state_cache[0][o].pos_;
+        const Vector2D vel1( M_first_vel_x[o], M_first_vel_y[o] );
+        const double max_accel2 = square( M_state_array[0].max_accel_[o] );
+
+        for ( int d = 0; d < NUM_STATE; ++d )
+        {
+            Vector2D vel2 = M_state_cache[1][d].pos_ - pos_1st;
+            Vector2D accel = vel2 - vel1;
+
+            M_second_kick_ok[o][d] = ! ( accel.r2() > max_accel2 );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KickTable::calcReleaseVelocity( const int layer,
+                                const Vector2D & target_point,
+                                const double & first_speed )
+{
+    StateArray & array = M_state_array[layer];
+
+    const double target_x = target_point.x;
+    const double target_y = target_point.y;
+
+    // same as ( target_point - pos ).setLengthVector( first_speed ),
+    // but written as a branch free loop over the arrays.
+    for ( int i = 0; i < NUM_STATE; ++i )
+    {
+        const double dx = target_x - array.pos_x_[i];
+        const double dy = target_y - array.pos_y_[i];
+        const double mag = std::sqrt( dx * dx + dy * dy );
+        const double rate = ( mag < Vector2D::EPSILON ? 1.0 : first_speed / mag );
+
+        array.release_vel_x_[i] = dx * rate;
+        array.release_vel_y_[i] = dy * rate;
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1379,37 +2066,30 @@ KickTable::simulateOneStep( const WorldModel & world,
 
  */
 bool
-KickTable::simulateTwoStep( const WorldModel & world,
+KickTable::simulateTwoStep( const WorldModel & /*world*/,
                             const Vector2D & target_point,
                             const double & first_speed )
 {
     static const double max_power = ServerParam::i().maxPower();
     static const double accel_max = ServerParam::i().ballAccelMax();
-    static const double ball_decay = ServerParam::i().ballDecay();
 
-    const PlayerType & self_type = world.self().playerType();
     const double current_max_accel = std::min( M_current_state.kick_rate_ * max_power, accel_max );
-#if 1
-    const ServerParam & param = ServerParam::i();
-    const double my_kickable_area = self_type.kickableArea();
 
-    const double my_noise = world.self().vel().r() * param.playerRand();
-    const double current_dir_diff_rate
-        = ( world.ball().angleFromSelf() - world.self().body() ).abs() / 180.0;
-    const double current_dist_rate = ( ( world.ball().distFromSelf()
-                                         - self_type.playerSize()
-                                         - param.ballSize() )
-                                       / self_type.kickableMargin() );
-    const double current_pos_rate
-        = 0.5 + 0.25 * ( current_dir_diff_rate + current_dist_rate );
-    const double current_speed_rate
-        = 0.5 + 0.5 * ( world.ball().vel().r()
-                        / ( param.ballSpeedMax() * param.ballDecay() ) );
-#endif
-    const Vector2D my_final_pos
-        = world.self().pos()
-        + world.self().vel()
-        + world.self().vel() * self_type.playerDecay();
+    //
+    // release kick at each first layer state.
+    // evaluated together for all states in the structure-of-arrays form.
+    //
+    calcReleaseVelocity( 0, target_point, first_speed );
+
+    const StateArray & array = M_state_array[0];
+    double release_accel_r[NUM_STATE];
+
+    for ( int i = 0; i < NUM_STATE; ++i )
+    {
+        const double ax = array.release_vel_x_[i] - M_first_vel_x[i];
+        const double ay = array.release_vel_y_[i] - M_first_vel_y[i];
+        release_accel_r[i] = std::sqrt( ax * ax + ay * ay );
+    }
 
     int success_count = 0;
     double max_speed2 = 0.0;
@@ -1458,58 +2138,26 @@ KickTable::simulateTwoStep( const WorldModel & world,
             return false;
         }
 
-        int kick_miss_flag = SAFETY;
-        const Vector2D target_vel = ( target_point - state.pos_ ).setLengthVector( first_speed );
-
-        Vector2D vel = state.pos_ - world.ball().pos();
-        Vector2D accel = vel - world.ball().vel();
-        double accel_r = accel.r();
-
-        if ( accel_r > current_max_accel )
+        if ( M_first_accel_r[i] > current_max_accel )
         {
 #ifdef DEBUG
             dlog.addText( Logger::KICK,
                           "xx__ 2 step: failed(1) required_accel=%.3f > max_accel=%.3f",
-                          accel_r, current_max_accel );
+                          M_first_accel_r[i], current_max_accel );
 #endif
             continue;
         }
-#if 1
-        {
-            double kick_power = accel_r / world.self().kickRate();
-            double ball_noise = vel.r() * param.ballRand();
-            double max_kick_rand
-                = self_type.kickRand()
-                * ( kick_power / param.maxPower() )
-                * ( current_pos_rate + current_speed_rate );
-            if ( ( my_noise + ball_noise + max_kick_rand ) //* 0.9
-                 > my_kickable_area - state.dist_ - 0.05 ) //0.1 )
-            {
-#ifdef DEBUG
-                dlog.addText( Logger::KICK,
-                              "xx__ 2 step: failed. buffer is not safety. power=%.3f"
-                              " my_kickable=%.3f state_dist=%.3f,"
-                              " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
-                              kick_power,
-                              my_kickable_area, state.dist_,
-                              ( my_noise + ball_noise + max_kick_rand ) * 0.9,
-                              my_noise, ball_noise, max_kick_rand );
-#endif
-                kick_miss_flag |= KICK_MISS_POSSIBILITY;
-            }
-        }
-#endif
-        vel *= ball_decay;
 
-        accel = target_vel - vel;
-        accel_r = accel.r();
+        const int kick_miss_flag = M_first_kick_miss[i];
+        const Vector2D target_vel( array.release_vel_x_[i], array.release_vel_y_[i] );
+        const Vector2D vel( M_first_vel_x[i], M_first_vel_y[i] );
 
-        if ( accel_r > std::min( state.kick_rate_ * max_power, accel_max ) )
+        if ( release_accel_r[i] > array.max_accel_[i] )
         {
 #ifdef DEBUG
             dlog.addText( Logger::KICK,
                           "xx__ 2step: failed(2) required_accel=%.3f > max_accel=%.3f",
-                          accel_r, std::min( state.kick_rate_ * max_power, accel_max ) );
+                          release_accel_r[i], array.max_accel_[i] );
 #endif
             if ( success_count == 0 )
             {
@@ -1524,7 +2172,7 @@ KickTable::simulateTwoStep( const WorldModel & world,
                         M_candidates.push_back( Sequence() );
                     }
                     max_speed2 = d2;
-                    accel = max_vel - vel;
+                    Vector2D accel = max_vel - vel;
 
                     M_candidates.back().flag_ = ( ( M_current_state.flag_ & ~RELEASE_INTERFERE )
                                                   | state.flag_ );
@@ -1551,7 +2199,7 @@ KickTable::simulateTwoStep( const WorldModel & world,
         M_candidates.back().pos_list_.push_back( state.pos_ );
         M_candidates.back().pos_list_.push_back( state.pos_ + target_vel );
         M_candidates.back().speed_ = first_speed;
-        M_candidates.back().power_ = accel_r / state.kick_rate_;
+        M_candidates.back().power_ = release_accel_r[i] / state.kick_rate_;
 #ifdef DEBUG
         dlog.addText( Logger::KICK,
                       "ok__ 2 step: last_power=%.2f subtarget=(%.2f %.2f)",
@@ -1579,26 +2227,7 @@ KickTable::simulateThreeStep( const WorldModel & world,
     const double current_max_accel = std::min( M_current_state.kick_rate_ * max_power,
                                                accel_max );
     const double current_max_accel2 = current_max_accel * current_max_accel;
-#if 1
-    const ServerParam & param = ServerParam::i();
-    const PlayerType & self_type = world.self().playerType();
-
-    const double my_kickable_area = self_type.kickableArea();
 
-    const double my_noise1 = world.self().vel().r() * param.playerRand();
-    //const double my_noise2 = my_noise1 * self_type.playerDecay();
-    const double current_dir_diff_rate
-        = ( world.ball().angleFromSelf() - world.self().body() ).abs() / 180.0;
-    const double current_dist_rate = ( ( world.ball().distFromSelf()
-                                         - self_type.playerSize()
-                                         - param.ballSize() )
-                                       / self_type.kickableMargin() );
-    const double current_pos_rate
-        = 0.5 + 0.25 * ( current_dir_diff_rate + current_dist_rate );
-    const double current_speed_rate
-        = 0.5 + 0.5 * ( world.ball().vel().r()
-                        / ( param.ballSpeedMax() * param.ballDecay() ) );
-#endif
     AngleDeg target_rel_angle = ( target_point - world.self().pos() ).th() - world.self().body();
     double angle_deg = target_rel_angle.degree() + 180.0;
     int target_angle_index = static_cast< int >( rint( DEST_DIR_DIVS * ( angle_deg / 360.0 ) ) );
@@ -1610,14 +2239,21 @@ KickTable::simulateThreeStep( const WorldModel & world,
                   target_angle_index );
 #endif
 
-    const std::vector< Path > & table = M_tables[target_angle_index];
+    //
+    // release kick at each second layer state.
+    //
+    calcReleaseVelocity( 1, target_point, first_speed );
+
+    const StateArray & array = M_state_array[1];
+
+    const Path * table = M_table->table_[target_angle_index];
 
     int success_count = 0;
     double max_speed2 = 0.0;
 
     int count = 0;
-    const std::vector< Path >::const_iterator end = table.end();
-    for ( std::vector< Path >::const_iterator it = table.begin();
+    const Path * end = table + M_table->table_size_[target_angle_index];
+    for ( const Path * it = table;
           it != end && count < MAX_TABLE_SIZE && success_count <= 10;
           ++it, ++count )
     {
@@ -1679,83 +2315,47 @@ KickTable::simulateThreeStep( const WorldModel & world,
 #ifdef DEBUG_THREE_STEP
             dlog.addText( Logger::KICK,
                           "xx__ 3 step: interfere after release. state_pos=(%.2f %.2f)",
-                          state.pos_.x, state.pos_.y );
+                          state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             return false;
         }
 
-
-        const Vector2D target_vel = ( target_point - state_2nd.pos_ ).setLengthVector( first_speed );
-
-        int kick_miss_flag = SAFETY;
-
-        Vector2D vel1 = state_1st.pos_ - world.ball().pos();
-        Vector2D accel = vel1 - world.ball().vel();
-        double accel_r2 = accel.r2();
-
-        if ( accel_r2 > current_max_accel2 )
+        if ( M_first_accel_r2[it->origin_] > current_max_accel2 )
         {
 #ifdef DEBUG_THREE_STEP
             dlog.addText( Logger::KICK,
                           "xx__ 3 step: failed(1) required_accel=%.3f > max_accel=%.3f",
-                          std::sqrt( accel_r2 ), std::sqrt( current_max_accel2 ) );
+                          M_first_accel_r[it->origin_], current_max_accel );
 #endif
             continue;
         }
 
-#if 1
+        if ( ! M_second_kick_ok[it->origin_][it->dest_] )
         {
-            double kick_power = std::sqrt( accel_r2 ) / world.self().kickRate();
-            double ball_noise = vel1.r() * param.ballRand();
-            double max_kick_rand
-                = self_type.kickRand()
-                * ( kick_power / param.maxPower() )
-                * ( current_pos_rate + current_speed_rate );
-            if ( ( my_noise1 + ball_noise + max_kick_rand ) //* 0.95
-                 > my_kickable_area - state_1st.dist_ - 0.05 ) //0.1 )
-            {
 #ifdef DEBUG_THREE_STEP
-                dlog.addText( Logger::KICK,
-                              "xx__ 3 step: failed. 1st kick may cause unkickable. power=%.3f"
-                              " my_kickable=%.3f state_dist=%.3f,"
-                              " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
-                              kick_power,
-                              my_kickable_area, state_1st.dist_,
-                              ( my_noise1 + ball_noise + max_kick_rand ) * 0.9,
-                              my_noise1, ball_noise, max_kick_rand );
+            dlog.addText( Logger::KICK,
+                          "xx__ 3 step: failed(2) origin=%d dest=%d",
+                          it->origin_, it->dest_ );
 #endif
-                kick_miss_flag |= KICK_MISS_POSSIBILITY;
-            }
+            continue;
         }
-#endif
 
-        vel1 *= ball_decay;
+        const int kick_miss_flag = M_first_kick_miss[it->origin_];
+        const Vector2D target_vel( array.release_vel_x_[it->dest_],
+                                   array.release_vel_y_[it->dest_] );
 
         Vector2D vel2 = state_2nd.pos_ - state_1st.pos_;
-        accel = vel2 - vel1;
-        accel_r2 = accel.r2();
-
-        if ( accel_r2 > square( std::min( state_1st.kick_rate_ * max_power, accel_max ) ) )
-        {
-#ifdef DEBUG_THREE_STEP
-            dlog.addText( Logger::KICK,
-                          "xx__ 3 step: failed(2) required_accel=%.3f > max_accel=%.3f",
-                          std::sqrt( accel_r2 ),
-                          std::min( state_1st.kick_rate_ * max_power, accel_max ) );
-#endif
-            continue;
-        }
         vel2 *= ball_decay;
 
-        accel = target_vel - vel2;
-        accel_r2 = accel.r2();
-        if ( accel_r2 > square( std::min( state_2nd.kick_rate_ * max_power, accel_max ) ) )
+        Vector2D accel = target_vel - vel2;
+        double accel_r2 = accel.r2();
+        if ( accel_r2 > square( array.max_accel_[it->dest_] ) )
         {
 #ifdef DEBUG_THREE_STEP
             dlog.addText( Logger::KICK,
                           "xx__ 3 step: failed(3) required_accel=%.3f > max_accel=%.3f",
                           std::sqrt( accel_r2 ),
-                          std::min( state_2nd.kick_rate_ * max_power, accel_max ) );
+                          array.max_accel_[it->dest_] );
 #endif
             if ( success_count == 0 )
             {
@@ -1944,7 +2544,7 @@ KickTable::simulate( const WorldModel & world,
                      const int max_step,
                      Sequence & sequence )
 {
-    if ( M_state_list.empty() )
+    if ( M_type_tables.empty() )
     {
         dlog.addText( Logger::KICK,
                       __FILE__": simulate() KickTable is not initialized!." );
@@ -1970,10 +2570,93 @@ KickTable::simulate( const WorldModel & world,
                   target_point.x, target_point.y,
                   target_speed );
 
-    M_candidates.clear();
+    updateState( world );
+
+    const bool result = simulateImpl( world,
+                                      target_point, target_speed, speed_thr, max_step,
+                                      sequence );
+
+#ifdef DEBUG_PROFILE
+    dlog.addText( Logger::KICK,
+                  __FILE__": simulate() kick_table_elapsed=%.4f [ms].",
+                  timer.elapsedReal() );
+#endif
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+KickTable::simulate( const WorldModel & world,
+                     const std::vector< Request > & requests,
+                     std::vector< Sequence > & sequences )
+{
+    sequences.clear();
+    sequences.resize( requests.size() );
+
+    if ( M_type_tables.empty() )
+    {
+        dlog.addText( Logger::KICK,
+                      __FILE__": simulate() KickTable is not initialized!." );
+        std::cerr << "KickTable has not been initialized! "
+                  << "KickTable::instance().createTable() has to be called before using KickTable::simulate()."
+                  << std::endl;
+        return 0;
+    }
+
+#ifdef DEBUG_PROFILE
+    MSecTimer timer;
+#endif
 
     updateState( world );
 
+    int success_count = 0;
+
+    const size_t size = requests.size();
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const Request & req = requests[i];
+
+        double target_speed = bound( 0.0,
+                                     req.first_speed_,
+                                     ServerParam::i().ballSpeedMax() );
+        double speed_thr = bound( 0.0,
+                                  req.allowable_speed_,
+                                  target_speed );
+
+        if ( simulateImpl( world,
+                           req.target_point_, target_speed, speed_thr, req.max_step_,
+                           sequences[i] ) )
+        {
+            ++success_count;
+        }
+    }
+
+#ifdef DEBUG_PROFILE
+    dlog.addText( Logger::KICK,
+                  __FILE__": simulate() batch size=%d success=%d kick_table_elapsed=%.4f [ms].",
+                  static_cast< int >( size ), success_count,
+                  timer.elapsedReal() );
+#endif
+    return success_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::simulateImpl( const WorldModel & world,
+                         const Vector2D & target_point,
+                         const double & target_speed,
+                         const double & speed_thr,
+                         const int max_step,
+                         Sequence & sequence )
+{
+    M_candidates.clear();
+
     checkCollisionAfterRelease( world,
                                 target_point,
                                 target_speed );
@@ -2034,11 +2717,6 @@ KickTable::simulate( const WorldModel & world,
                   sequence.power_,
                   sequence.score_ );
 
-#ifdef DEBUG_PROFILE
-    dlog.addText( Logger::KICK,
-                  __FILE__": simulate() kick_table_elapsed=%.4f [ms].",
-                  timer.elapsedReal() );
-#endif
     return sequence.speed_ >= target_speed - rcsc::EPS;
 }
 
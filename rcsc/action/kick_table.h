@@ -35,7 +35,12 @@
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/geom/angle_deg.h>
 
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+#include <map>
 #include <vector>
+#include <string>
 #include <algorithm>
 
 namespace rcsc {
@@ -75,6 +80,10 @@ public:
         MAX_TABLE_SIZE = 256,
     };
 
+    enum {
+        BINARY_FORMAT_VERSION = 1, //!< version number of the binary table file
+    };
+
     /*!
       \enum Flag
       \brief status bit flags
@@ -212,6 +221,34 @@ public:
           }
     };
 
+    /*!
+      \struct Request
+      \brief kick target used by the batch simulation
+     */
+    struct Request {
+        Vector2D target_point_; //!< kick target point
+        double first_speed_; //!< required first speed
+        double allowable_speed_; //!< required first speed threshold
+        int max_step_; //!< maximum size of kick sequence
+
+        /*!
+          \brief construct a request object
+          \param target_point kick target point
+          \param first_speed required first speed
+          \param allowable_speed required first speed threshold
+          \param max_step maximum size of kick sequence
+         */
+        Request( const Vector2D & target_point,
+                 const double & first_speed,
+                 const double & allowable_speed,
+                 const int max_step )
+            : target_point_( target_point )
+            , first_speed_( first_speed )
+            , allowable_speed_( allowable_speed )
+            , max_step_( max_step )
+          { }
+    };
+
     /*!
       \brief caclulate the distance of near side sub-target
       \param player_type calculated PlayerType
@@ -250,22 +287,44 @@ public:
 
 private:
 
+    /*!
+      \struct TypeTable
+      \brief static state list and heuristic path tables for one player type.
+
+      Path tables point either into paths_ or into a read-only mapped binary
+      file shared by all processes on the host.
+     */
+    struct TypeTable {
+        boost::uint64_t hash_; //!< parameter hash value used as the table key
+        double player_size_; //!< player size used to create the table
+        double kickable_margin_; //!< kickable margin used to create the table
+        double ball_size_; //!< ball size used to create the table
+
+        std::vector< State > state_list_; //!< static state list
+        std::vector< Path > paths_[DEST_DIR_DIVS]; //!< owned path storage. empty if mapped
+
+        const Path * table_[DEST_DIR_DIVS]; //!< head of each path table
+        int table_size_[DEST_DIR_DIVS]; //!< size of each path table
+
+        boost::shared_ptr< void > mapped_; //!< mapped file region, if any
+
+        /*!
+          \brief initialize with empty tables
+         */
+        TypeTable();
+    };
+
+    typedef boost::shared_ptr< TypeTable > TypeTablePtr;
+
     //
     // offline data
     //
 
-    //! default player size
-    double M_player_size;
-    //! default kickable margin
-    double M_kickable_margin;
-    //! default ball size
-    double M_ball_size;
+    //! static tables. key: player type id
+    std::map< int, TypeTablePtr > M_type_tables;
 
-    //! static state list
-    std::vector< State > M_state_list;
-
-    //! static heuristic table
-    std::vector< Path > M_tables[DEST_DIR_DIVS];
+    //! the table used for the current state cache
+    const TypeTable * M_table;
 
     //
     // online data
@@ -277,6 +336,35 @@ private:
     //! future state cache
     std::vector< State > M_state_cache[MAX_DEPTH];
 
+    /*!
+      \struct StateArray
+      \brief structure-of-arrays copy of one state cache layer.
+      updated once per cycle and shared by all simulations in the same cycle.
+     */
+    struct StateArray {
+        double pos_x_[NUM_STATE]; //!< global x of the state
+        double pos_y_[NUM_STATE]; //!< global y of the state
+        double max_accel_[NUM_STATE]; //!< max ball accel by the kick at this state
+        double release_vel_x_[NUM_STATE]; //!< release velocity x. updated for each target.
+        double release_vel_y_[NUM_STATE]; //!< release velocity y. updated for each target.
+    };
+
+    //! structure-of-arrays state cache
+    StateArray M_state_array[MAX_DEPTH];
+
+    //! length of the accel required to move the current ball to the first layer state
+    double M_first_accel_r[NUM_STATE];
+    //! squared value of M_first_accel_r
+    double M_first_accel_r2[NUM_STATE];
+    //! ball velocity x after the first kick to the first layer state (already decayed)
+    double M_first_vel_x[NUM_STATE];
+    //! ball velocity y after the first kick to the first layer state (already decayed)
+    double M_first_vel_y[NUM_STATE];
+    //! kick miss flag of the first kick to the first layer state
+    int M_first_kick_miss[NUM_STATE];
+    //! feasibility of the second kick. [first layer state][second layer state]
+    bool M_second_kick_ok[NUM_STATE][NUM_STATE];
+
     //! result kick sequences
     std::vector< Sequence > M_candidates;
 
@@ -293,17 +381,36 @@ private:
 
     /*!
       \brief create static state list
+      \param player_type player type used to calculate the states
+      \param table reference to the result table
      */
-    void createStateList( const PlayerType & player_type );
+    void createStateList( const PlayerType & player_type,
+                          TypeTable & table );
 
     /*!
       \brief create table for angle
+      \param state_list static state list
       \param angle target angle relative to body angle
       \param table referecne to the container variable
      */
-    void createTable( const AngleDeg & angle,
+    void createTable( const std::vector< State > & state_list,
+                      const AngleDeg & angle,
                       std::vector< Path > & table );
 
+    /*!
+      \brief find the table that has the same parameter hash
+      \param hash parameter hash value
+      \return table pointer. empty if not found.
+     */
+    TypeTablePtr findTable( const boost::uint64_t hash ) const;
+
+    /*!
+      \brief select the table for the player type
+      \param player_type player type of the kicker
+      \return table pointer. NULL if no table is created.
+     */
+    const TypeTable * selectTable( const PlayerType & player_type ) const;
+
     /*!
       \brief update internal state
       \param world const rererence to the WorldModel
@@ -316,6 +423,39 @@ private:
      */
     void createStateCache( const WorldModel & world );
 
+    /*!
+      \brief create the target independent kick cache used by all simulations in this cycle
+      \param world const rererence to the WorldModel
+     */
+    void createKickCache( const WorldModel & world );
+
+    /*!
+      \brief calculate the release velocity at each state in the layer
+      \param layer index of the state cache layer
+      \param target_point kick target point
+      \param first_speed required first speed
+     */
+    void calcReleaseVelocity( const int layer,
+                              const Vector2D & target_point,
+                              const double & first_speed );
+
+    /*!
+      \brief simulate kick sequence using the current state cache
+      \param world const reference to the WorldModel
+      \param target_point kick target point
+      \param target_speed required first speed (already bounded)
+      \param speed_thr required first speed threshold (already bounded)
+      \param max_step maximum size of kick sequence
+      \param sequence reference to the result variable
+      \return if successful kick is found, then true
+     */
+    bool simulateImpl( const WorldModel & world,
+                       const Vector2D & target_point,
+                       const double & target_speed,
+                       const double & speed_thr,
+                       const int max_step,
+                       Sequence & sequence );
+
     /*!
       \brief update collision flag of state caches for the target_point and first_speed
       \param world const rererence to the WorldModel
@@ -408,25 +548,76 @@ public:
     KickTable & instance();
 
     /*!
-      \brief create heuristic table
+      \brief calculate the hash value of the parameters that affect the table
+      \param player_type calculated PlayerType
+      \return hash value
+     */
+    static
+    boost::uint64_t calc_param_hash( const PlayerType & player_type );
+
+    /*!
+      \brief get the binary table file name for the player type
+      \param player_type calculated PlayerType
+      \return file name (without directory)
+     */
+    static
+    std::string binary_file_name( const PlayerType & player_type );
+
+    /*!
+      \brief create heuristic table for the default player type
       \return result of table creation
      */
     bool createTables();
 
     /*!
-      \brief read table data from file
+      \brief create heuristic table for the given player type
+      \param player_type calculated PlayerType
+      \return false if the table already exists
+     */
+    bool createTables( const PlayerType & player_type );
+
+    /*!
+      \brief setup tables for the default type and all received player types.
+      If cache_dir is not empty, the binary files in cache_dir are mapped, and
+      missing or stale files are created and written before mapping.
+      Otherwise, the tables are created in memory.
+      \param cache_dir directory path of the binary table files. can be empty.
+      \return true if every player type has a valid table
+     */
+    bool setupTables( const std::string & cache_dir );
+
+    /*!
+      \brief read table data for the default player type from text file
       \param file_path file path to read
       \return read result
      */
     bool read( const std::string & file_path );
 
     /*!
-      \brief write table data to file
+      \brief write table data for the default player type to text file
       \param file_path file path to write
       \return write result
      */
     bool write( const std::string & file_path );
 
+    /*!
+      \brief map the binary table file read-only and register it for the player type
+      \param file_path file path to map
+      \param player_type player type that the table is used for
+      \return false if the file does not exist, or the version or hash value does not match
+     */
+    bool readBinary( const std::string & file_path,
+                     const PlayerType & player_type );
+
+    /*!
+      \brief write the table for the player type to the binary file
+      \param file_path file path to write
+      \param player_type player type that the table was created for
+      \return write result
+     */
+    bool writeBinary( const std::string & file_path,
+                      const PlayerType & player_type ) const;
+
     /*!
       \brief simulate kick sequence
       \param world const reference to the WorldModel
@@ -444,6 +635,18 @@ public:
                    const int max_step,
                    Sequence & sequence );
 
+    /*!
+      \brief simulate kick sequences for several targets at once.
+      The state cache and the target independent kicks are shared by all requests.
+      \param world const reference to the WorldModel
+      \param requests kick targets
+      \param sequences reference to the result variable. one sequence per request.
+      \return the number of requests for which a successful kick is found
+     */
+    int simulate( const WorldModel & world,
+                  const std::vector< Request > & requests,
+                  std::vector< Sequence > & sequences );
+
     /*!
       \brief get the candidate kick sequences
       \return const reference to the container of Sequence
@@ -0,0 +1,252 @@
+// -*-c++-*-
+
+/*!
+  \file agent_host.cpp
+  \brief multiple agents event loop Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "agent_host.h"
+
+#include "basic_client.h"
+#include "soccer_agent.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+
+#include <poll.h> // poll()
+#include <sys/time.h> // gettimeofday()
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the current time
+  \return milli seconds
+*/
+long
+current_msec()
+{
+    struct timeval tv;
+    ::gettimeofday( &tv, NULL );
+    return tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+}
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+AgentHost::AgentHost()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+AgentHost::~AgentHost()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AgentHost::add( SoccerAgent * agent )
+{
+    if ( ! agent
+         || ! agent->M_client )
+    {
+        std::cerr << "***ERROR*** AgentHost::add() the agent is not initialized."
+                  << std::endl;
+        return false;
+    }
+
+    if ( agent->M_client->clientMode() != BasicClient::ONLINE )
+    {
+        std::cerr << "***ERROR*** AgentHost::add() supports only the online client."
+                  << std::endl;
+        return false;
+    }
+
+    if ( ! M_entries.empty() )
+    {
+        // the action caches are process globals. see the class description.
+        std::cerr << "***ERROR*** AgentHost::add() only one agent can be hosted."
+                  << std::endl;
+        return false;
+    }
+
+    M_entries.push_back( Entry( agent, agent->M_client ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+AgentHost::exit( Entry & entry )
+{
+    if ( entry.alive_ )
+    {
+        entry.alive_ = false;
+        entry.agent_->handleExit();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+AgentHost::run()
+{
+    for ( std::vector< Entry >::iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        it->alive_ = true;
+        if ( ! it->agent_->handleStart()
+             || ! it->client_->isServerAlive()
+             || it->client_->socketFd() < 0 )
+        {
+            exit( *it );
+            continue;
+        }
+
+        it->timeout_count_ = 0;
+        it->waited_msec_ = 0;
+        it->deadline_ = current_msec() + it->client_->intervalMSec();
+    }
+
+    // index of M_entries for each element of fds
+    std::vector< std::size_t > indices;
+    std::vector< struct pollfd > fds;
+    indices.reserve( M_entries.size() );
+    fds.reserve( M_entries.size() );
+
+    bool changed = true;
+
+    while ( true )
+    {
+        if ( changed )
+        {
+            changed = false;
+            indices.clear();
+            fds.clear();
+            for ( std::size_t i = 0; i < M_entries.size(); ++i )
+            {
+                if ( ! M_entries[i].alive_ ) continue;
+
+                struct pollfd p;
+                p.fd = M_entries[i].client_->socketFd();
+                p.events = POLLIN;
+                p.revents = 0;
+                indices.push_back( i );
+                fds.push_back( p );
+            }
+        }
+
+        if ( fds.empty() )
+        {
+            break;
+        }
+
+        long now = current_msec();
+        long timeout = M_entries[indices.front()].deadline_ - now;
+        for ( std::size_t i = 1; i < indices.size(); ++i )
+        {
+            timeout = std::min( timeout, M_entries[indices[i]].deadline_ - now );
+        }
+        if ( timeout < 0 ) timeout = 0;
+
+        int ret = ::poll( &fds[0], fds.size(), static_cast< int >( timeout ) );
+        if ( ret < 0 )
+        {
+            if ( errno == EINTR ) continue;
+            perror( "poll" );
+            break;
+        }
+
+        for ( std::size_t i = 0; i < fds.size(); ++i )
+        {
+            Entry & entry = M_entries[indices[i]];
+
+            if ( fds[i].revents != 0 )
+            {
+                // received message, reset wait time
+                entry.waited_msec_ = 0;
+                entry.timeout_count_ = 0;
+                entry.agent_->handleMessage();
+                entry.deadline_ = current_msec() + entry.client_->intervalMSec();
+            }
+            else
+            {
+                now = current_msec();
+                if ( entry.deadline_ > now )
+                {
+                    continue;
+                }
+
+                // no meesage. timeout.
+                entry.waited_msec_ += entry.client_->intervalMSec();
+                ++entry.timeout_count_;
+                entry.agent_->handleTimeout( entry.timeout_count_,
+                                             entry.waited_msec_ );
+                entry.deadline_ = current_msec() + entry.client_->intervalMSec();
+            }
+
+            if ( ! entry.client_->isServerAlive() )
+            {
+                exit( entry );
+                changed = true;
+            }
+        }
+    }
+
+    for ( std::vector< Entry >::iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        exit( *it );
+    }
+}
+
+}
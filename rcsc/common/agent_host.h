@@ -0,0 +1,163 @@
+// -*-c++-*-
+
+/*!
+  \file agent_host.h
+  \brief multiple agents event loop Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_AGENT_HOST_H
+#define RCSC_COMMON_AGENT_HOST_H
+
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+class BasicClient;
+class SoccerAgent;
+
+/*!
+  \class AgentHost
+  \brief event loop that drives the agents with one poll() call.
+
+  BasicClient::run() blocks in its own select() loop, so it can drive only
+  one agent per process. AgentHost waits for all agents' sockets with one
+  poll() call and keeps a timer for each agent, so that every agent receives
+  the same handleMessage()/handleTimeout()/handleExit() sequence as it
+  would under BasicClient::run().
+
+  Usage:
+  \code
+  rcsc::BasicClient client;
+  SamplePlayer player;
+  rcsc::AgentHost host;
+  player.init( &client, argc, argv );
+  host.add( &player );
+  host.run();
+  \endcode
+
+  Currently, only one agent can be registered. The player actions keep
+  per-agent state in process globals: KickTable holds the table selected
+  for the player type and the state caches built from the agent's
+  WorldModel, and many actions (Body_Pass, Body_HoldBall2008,
+  Neck_ScanField, the intercept, clear ball and advance ball actions,
+  LocalizationPFilter, ...) keep function-static caches keyed only on the
+  game time. A second agent in the same cycle would reuse the first
+  agent's results. add() refuses the second agent until these caches
+  are owned by each agent.
+
+  Parameter singletons (ServerParam, PlayerParam, PlayerTypeSet) and
+  debug logger (dlog) are process globals.
+  All handlers are called in the thread that calls run().
+ */
+class AgentHost {
+private:
+
+    /*!
+      \struct Entry
+      \brief event status of the hosted agent
+     */
+    struct Entry {
+        SoccerAgent * agent_; //!< pointer to the agent instance
+        BasicClient * client_; //!< client instance used by the agent
+        bool alive_; //!< false if handleExit() has been called.
+        int timeout_count_; //!< count of timeout without server message
+        long waited_msec_; //!< elapsed milli seconds since the last message
+        long deadline_; //!< next timeout time [msec]
+
+        Entry( SoccerAgent * agent,
+               BasicClient * client )
+            : agent_( agent ),
+              client_( client ),
+              alive_( false ),
+              timeout_count_( 0 ),
+              waited_msec_( 0 ),
+              deadline_( 0 )
+          { }
+    };
+
+    //! hosted agents
+    std::vector< Entry > M_entries;
+
+    // nocopyable
+    AgentHost( const AgentHost & );
+    AgentHost & operator=( const AgentHost & );
+
+public:
+
+    /*!
+      \brief create an empty host
+     */
+    AgentHost();
+
+    /*!
+      \brief nothing to do. agents are not deleted.
+     */
+    ~AgentHost();
+
+    /*!
+      \brief register the agent.
+      \param agent pointer to the agent already initialized by SoccerAgent::init().
+      \return false if the agent does not have the online client,
+      or another agent has already been registered.
+     */
+    bool add( SoccerAgent * agent );
+
+    /*!
+      \brief get the number of registered agents
+      \return the number of registered agents
+     */
+    std::size_t size() const
+      {
+          return M_entries.size();
+      }
+
+    /*!
+      \brief program mainloop for all registered agents.
+
+      handleStart() is called for each agent in the registered order.
+      Then, the loop continues while at least one agent can estimate its
+      server is alive. When an agent's socket becomes readable,
+      handleMessage() of the agent is called. When an agent has not
+      received any message in its interval msec, handleTimeout() is called.
+      handleExit() is called once for each agent when its server is not
+      alive or the loop is end.
+     */
+    void run();
+
+private:
+
+    /*!
+      \brief call handleExit() of the agent and remove it from the loop.
+      \param entry target agent entry
+     */
+    void exit( Entry & entry );
+};
+
+}
+
+#endif
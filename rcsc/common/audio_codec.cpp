@@ -74,10 +74,13 @@ AudioCodec::AudioCodec()
 {
     // create int <-> char map
 
+    std::fill( M_char_to_int_table, M_char_to_int_table + 256, -1 );
+
     for ( int i = 0; i < CHAR_SIZE; ++i )
     {
         M_char_to_int_map.insert( std::make_pair( CHAR_SET[i], i ) );
         M_int_to_char_map.push_back( CHAR_SET[i] );
+        M_char_to_int_table[static_cast< unsigned char >( CHAR_SET[i] )] = i;
     }
 }
 
@@ -103,47 +106,41 @@ AudioCodec::encodeInt64ToStr( const boost::int64_t & ival,
                               const int len,
                               std::string & to ) const
 {
-    std::vector< int > remainder_values;
-    remainder_values.reserve( len );
-
-    boost::int64_t divided = ival;
-
-    for ( int i = 0; i < len - 1; ++i )
-    {
-        remainder_values.push_back( divided % CHAR_SIZE );
-        divided /= CHAR_SIZE;
-    }
+    // encoded characters. int64 value never needs more than 11 characters.
+    char buf[64];
 
-    if ( divided >= CHAR_SIZE )
+    if ( ival < 0
+         || len < 1
+         || len > static_cast< int >( sizeof( buf ) ) )
     {
         std::cerr << __FILE__ << ':' << __LINE__
                   << " ***ERROR*** AudioCodec::encodeInt64ToStr."
-                  << " Illegal value. "
+                  << " Illegal value or length. "
                   << std::endl;
         return false;
     }
 
-    remainder_values.push_back( divided );
+    boost::int64_t divided = ival;
 
-    try
+    for ( int i = len - 1; i > 0; --i )
     {
-        const std::vector< int >::reverse_iterator end = remainder_values.rend();
-        for ( std::vector< int >::reverse_iterator it = remainder_values.rbegin();
-              it != end;
-              ++it )
-        {
-            to += M_int_to_char_map.at( *it );
-        }
+        buf[i] = M_int_to_char_map[divided % CHAR_SIZE];
+        divided /= CHAR_SIZE;
     }
-    catch ( std::exception & e )
+
+    if ( divided >= CHAR_SIZE )
     {
         std::cerr << __FILE__ << ':' << __LINE__
                   << " ***ERROR*** AudioCodec::encodeInt64ToStr."
-                  << " Exception caught: " << e.what()
+                  << " Illegal value. "
                   << std::endl;
         return false;
     }
 
+    buf[0] = M_int_to_char_map[divided];
+
+    to.append( buf, len );
+
     return true;
 }
 
@@ -155,34 +152,39 @@ bool
 AudioCodec::decodeStrToInt64( const std::string & from,
                               boost::int64_t * to ) const
 {
-    if ( from.empty() )
+    return decodeStrToInt64( from.data(), from.length(), to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeStrToInt64( const char * from,
+                              const std::size_t len,
+                              boost::int64_t * to ) const
+{
+    if ( len == 0 )
     {
         return false;
     }
 
     boost::int64_t rval = 0;
-    int digit_count = from.length() - 1;
 
-    const std::string::const_iterator end = from.end();
-    for ( std::string::const_iterator ch = from.begin();
-          ch != end;
-          ++ch, --digit_count )
+    for ( std::size_t i = 0; i < len; ++i )
     {
-        CharToIntCont::const_iterator it = M_char_to_int_map.find( *ch );
-        if ( it == M_char_to_int_map.end() )
+        const int val = charToInt( from[i] );
+        if ( val < 0 )
         {
             std::cerr << __FILE__ << ": " << __LINE__
                       << " ***ERROR*** AudioCodec::decodeStrToInt64."
                       << " Unexpected communication message. ["
-                      << from << "]"
+                      << std::string( from, len ) << "]"
                       << std::endl;
             return false;
         }
 
-        rval
-            += static_cast< boost::int64_t >( it->second )
-            * static_cast< boost::int64_t >
-            ( std::pow( static_cast< double >( CHAR_SIZE ), digit_count ) );
+        rval = rval * CHAR_SIZE + val;
     }
 
     if ( to )
@@ -239,8 +241,8 @@ AudioCodec::encodePercentageToChar( const double & value ) const
 double
 AudioCodec::decodeCharToPercentage( const char ch ) const
 {
-    CharToIntCont::const_iterator it = charToIntMap().find( ch );
-    if ( it == charToIntMap().end() )
+    const int val = charToInt( ch );
+    if ( val < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeCharToPercentage."
@@ -249,7 +251,7 @@ AudioCodec::decodeCharToPercentage( const char ch ) const
         return ERROR_VALUE;
     }
 
-    return ( static_cast< double >( it->second )
+    return ( static_cast< double >( val )
              / static_cast< double >( CHAR_SIZE - 1) );
 }
 
@@ -454,9 +456,21 @@ AudioCodec::decodeStr5ToPosVel( const std::string & from,
         return false;
     }
 
+    return decodeStr5ToPosVel( from.data(), pos, vel );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeStr5ToPosVel( const char * from,
+                                Vector2D * pos,
+                                Vector2D * vel ) const
+{
     boost::int64_t read_val = 0;
 
-    if ( ! decodeStrToInt64( from, &read_val ) )
+    if ( ! decodeStrToInt64( from, 5, &read_val ) )
     {
         return false;
     }
@@ -494,9 +508,20 @@ AudioCodec::decodeStr3ToPos( const std::string & from,
         return false;
     }
 
+    return decodeStr3ToPos( from.data(), pos );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeStr3ToPos( const char * from,
+                             Vector2D * pos ) const
+{
     boost::int64_t read_val = 0;
 
-    if ( ! decodeStrToInt64( from, &read_val ) )
+    if ( ! decodeStrToInt64( from, 3, &read_val ) )
     {
         return false;
     }
@@ -545,9 +570,21 @@ AudioCodec::decodeStr4ToUnumPos( const std::string & from,
         return false;
     }
 
+    return decodeStr4ToUnumPos( from.data(), unum, pos );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeStr4ToUnumPos( const char * from,
+                                 int * unum,
+                                 Vector2D * pos ) const
+{
     boost::int64_t read_val = 0;
 
-    if ( ! decodeStrToInt64( from, &read_val ) )
+    if ( ! decodeStrToInt64( from, 4, &read_val ) )
     {
         return false;
     }
@@ -628,10 +665,8 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                                const char ch2,
                                const double & norm_factor ) const
 {
-    const CharToIntCont::const_iterator end = charToIntMap().end();
-
-    CharToIntCont::const_iterator it = charToIntMap().find( ch1 );
-    if ( it == end )
+    const int i1 = charToInt( ch1 );
+    if ( i1 < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeStr2ToCoord()."
@@ -639,10 +674,9 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                   << std::endl;
         return ERROR_VALUE;
     }
-    int i1 = it->second;
 
-    it = charToIntMap().find( ch2 );
-    if ( it == end )
+    const int i2 = charToInt( ch2 );
+    if ( i2 < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeStr2ToCoord()."
@@ -650,7 +684,6 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                   << std::endl;
         return ERROR_VALUE;
     }
-    int i2 = it->second;
 
     return
         (
@@ -760,8 +793,8 @@ AudioCodec::encodeSpeedToChar( const double & val ) const
 double
 AudioCodec::decodeCharToSpeed( const char ch ) const
 {
-    CharToIntCont::const_iterator it = charToIntMap().find( ch );
-    if ( it == charToIntMap().end() )
+    const int val = charToInt( ch );
+    if ( val < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeSpeedL1."
@@ -771,7 +804,7 @@ AudioCodec::decodeCharToSpeed( const char ch ) const
     }
 
     return
-        ( static_cast< double >( it->second ) * SPEED_STEP_L1
+        ( static_cast< double >( val ) * SPEED_STEP_L1
           - SPEED_NORM_FACTOR
           );
 }
@@ -114,6 +114,9 @@ private:
     //! map to cnvert integer to character. vector of char
     IntToCharCont M_int_to_char_map;
 
+    //! table to convert character to integer. -1 means unsupported character.
+    int M_char_to_int_table[256];
+
 public:
 
     static const std::string CHAR_SET; //!< available character set
@@ -208,6 +211,16 @@ public:
           return M_int_to_char_map;
       }
 
+    /*!
+      \brief convert character to integer by the lookup table
+      \param ch character to be converted
+      \return integer value, or -1 if ch is not in CHAR_SET
+    */
+    int charToInt( const char ch ) const
+      {
+          return M_char_to_int_table[static_cast< unsigned char >( ch )];
+      }
+
     /*!
       \brief encode decimal (64bit) integer to the encoded string.
       \param ival input value
@@ -228,6 +241,17 @@ public:
     bool decodeStrToInt64( const std::string & from,
                            boost::int64_t * to ) const;
 
+    /*!
+      \brief decode the characters to the decimal (64bit) integer
+      \param from pointer to the first character
+      \param len the number of characters to be decoded
+      \param to pointer to the result instance
+      \return decode status
+     */
+    bool decodeStrToInt64( const char * from,
+                           const std::size_t len,
+                           boost::int64_t * to ) const;
+
 
     /*!
       \brief encode % value to 1 character
@@ -271,6 +295,17 @@ public:
                              Vector2D * pos,
                              Vector2D * vel ) const;
 
+    /*!
+      \brief decode 5 characters to position and velocity
+      \param from pointer to the first character. at least 5 characters must be available.
+      \param pos variable pointer to store the decoded position value
+      \param vel variable pointer to store the decoded velocity value
+      \return true if successfully decoded
+    */
+    bool decodeStr5ToPosVel( const char * from,
+                             Vector2D * pos,
+                             Vector2D * vel ) const;
+
     /*!
       \brief encode position to 3 characters.
       \param pos position value to be encoded
@@ -293,6 +328,15 @@ public:
     bool decodeStr3ToPos( const std::string & from,
                           Vector2D * pos ) const;
 
+    /*!
+      \brief decode 3 characters to and position
+      \param from pointer to the first character. at least 3 characters must be available.
+      \param pos pointer to the result variable
+      \return true if successfully decoded
+    */
+    bool decodeStr3ToPos( const char * from,
+                          Vector2D * pos ) const;
+
 
     /*!
       \brief encode uniform number and position to 4 characters.
@@ -320,6 +364,17 @@ public:
                               int * unum,
                               Vector2D * pos ) const;
 
+    /*!
+      \brief decode 4 characters to uniform number and position
+      \param from pointer to the first character. at least 4 characters must be available.
+      \param unum pointer to the result variable
+      \param pos pointer to the result variable
+      \return true if successfully decoded
+    */
+    bool decodeStr4ToUnumPos( const char * from,
+                              int * unum,
+                              Vector2D * pos ) const;
+
     /*!
       \brief encode coordinate value( x or y ) to 2 characters.
       \param xy coordinate value to be encoded, X or Y.
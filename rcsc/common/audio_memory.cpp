@@ -40,6 +40,8 @@
 
 namespace rcsc {
 
+const std::size_t AudioMemory::PLAYER_RECORD_SIZE;
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -60,9 +62,27 @@ AudioMemory::AudioMemory()
       M_stamina_time( -1, 0 ),
       M_recovery_time( -1, 0 ),
       M_dribble_time( -1, 0 ),
-      M_free_message_time( -1, 0 )
+      M_free_message_time( -1, 0 ),
+      M_player_record( PLAYER_RECORD_SIZE )
 {
-
+    // heard info containers are cleared every cycle, but their capacity is kept.
+    // reserve enough capacity not to reallocate them during the game.
+    const std::size_t capacity = MAX_PLAYER * 2;
+    M_ball.reserve( capacity );
+    M_pass.reserve( capacity );
+    M_our_intercept.reserve( capacity );
+    M_opp_intercept.reserve( capacity );
+    M_goalie.reserve( capacity );
+    M_player.reserve( capacity * 3 );
+    M_offside_line.reserve( capacity );
+    M_defense_line.reserve( capacity );
+    M_wait_request.reserve( capacity );
+    M_pass_request.reserve( capacity );
+    M_run_request.reserve( capacity );
+    M_stamina.reserve( capacity );
+    M_recovery.reserve( capacity );
+    M_dribble.reserve( capacity );
+    M_free_message.reserve( capacity );
 }
 
 /*-------------------------------------------------------------------*/
@@ -225,10 +245,6 @@ AudioMemory::setPlayer( const int sender,
     M_time = current;
 
     M_player_record.push_back( std::pair< GameTime, Player >( current, M_player.back() ) );
-    while ( M_player_record.size() > 30 )
-    {
-        M_player_record.pop_front();
-    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -260,10 +276,6 @@ AudioMemory::setPlayer( const int sender,
 
 
     M_player_record.push_back( std::pair< GameTime, Player >( current, M_player.back() ) );
-    while ( M_player_record.size() > 30 )
-    {
-        M_player_record.pop_front();
-    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -35,10 +35,11 @@
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_time.h>
 
+#include <boost/circular_buffer.hpp>
+
 #include <iostream>
 #include <string>
 #include <vector>
-#include <deque>
 
 namespace rcsc {
 
@@ -347,8 +348,11 @@ public:
     };
 
 
-    //! alias of player record container type
-    typedef std::deque< std::pair< GameTime, Player > > PlayerRecord;
+    //! alias of player record container type. the oldest record is overwritten when full.
+    typedef boost::circular_buffer< std::pair< GameTime, Player > > PlayerRecord;
+
+    //! the maximum number of records in PlayerRecord
+    static const std::size_t PLAYER_RECORD_SIZE = 30;
 
 protected:
 
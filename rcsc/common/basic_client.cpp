@@ -56,6 +56,8 @@ namespace rcsc {
 */
 BasicClient::BasicClient()
     : M_client_mode( ONLINE ),
+      M_offline_command_matched( 0 ),
+      M_offline_command_mismatched( 0 ),
       M_server_alive( false ),
       M_interval_msec( 10 ),
       M_compression_level( 0 )
@@ -177,6 +179,9 @@ BasicClient::runOffline( SoccerAgent * agent )
     {
         agent->handleMessageOffline();
     }
+
+    // the offline log ended. the remaining commands have no counterpart.
+    compareOfflineCommands( true );
 }
 
 /*-------------------------------------------------------------------*/
@@ -208,6 +213,16 @@ BasicClient::setIntervalMSec( const long & interval_msec )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+int
+BasicClient::socketFd() const
+{
+    return ( M_socket ? M_socket->fd() : -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 BasicClient::setServerAlive( const bool alive )
@@ -303,6 +318,56 @@ BasicClient::printOfflineThink()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+BasicClient::compareOfflineCommands( const bool finished )
+{
+    while ( ! M_offline_sent_commands.empty()
+            && ! M_offline_recorded_commands.empty() )
+    {
+        if ( M_offline_sent_commands.front() == M_offline_recorded_commands.front() )
+        {
+            ++M_offline_command_matched;
+        }
+        else
+        {
+            ++M_offline_command_mismatched;
+            if ( M_offline_command_mismatched <= 10 )
+            {
+                std::cerr << "offline command mismatch:"
+                          << "\n  recorded [" << M_offline_recorded_commands.front() << "]"
+                          << "\n  sent     [" << M_offline_sent_commands.front() << "]"
+                          << std::endl;
+            }
+        }
+
+        M_offline_sent_commands.pop_front();
+        M_offline_recorded_commands.pop_front();
+    }
+
+    if ( ! finished )
+    {
+        return;
+    }
+
+    if ( ! M_offline_sent_commands.empty()
+         || ! M_offline_recorded_commands.empty() )
+    {
+        std::cerr << "offline command mismatch:"
+                  << " unmatched recorded=" << M_offline_recorded_commands.size()
+                  << " unmatched sent=" << M_offline_sent_commands.size()
+                  << std::endl;
+    }
+
+    M_offline_command_mismatched += static_cast< int >( M_offline_sent_commands.size() );
+    M_offline_command_mismatched += static_cast< int >( M_offline_recorded_commands.size() );
+    M_offline_sent_commands.clear();
+    M_offline_recorded_commands.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 BasicClient::connectTo( const char * hostname,
@@ -342,6 +407,11 @@ BasicClient::sendMessage( const char * msg )
 {
     if ( clientMode() != ONLINE )
     {
+        if ( M_offline_in.is_open() )
+        {
+            M_offline_sent_commands.push_back( msg );
+            compareOfflineCommands( false );
+        }
         return 1;
     }
 
@@ -350,6 +420,11 @@ BasicClient::sendMessage( const char * msg )
         return 0;
     }
 
+    if ( M_offline_out.is_open() )
+    {
+        M_offline_out << "(send " << msg << ")\n";
+    }
+
 #ifdef HAVE_LIBZ
     if ( M_compression_level > 0
          && M_compressor )
@@ -391,6 +466,14 @@ BasicClient::recvMessage()
         {
             if ( M_decompression_message.empty() ) continue;
 
+            if ( ! M_decompression_message.compare( 0, 6, "(send " ) )
+            {
+                // recorded command: "(send <msg>)"
+                M_offline_recorded_commands.push_back( M_decompression_message.substr( 6, M_decompression_message.length() - 7 ) );
+                compareOfflineCommands( false );
+                continue;
+            }
+
             return M_decompression_message.size();
         }
 
@@ -34,6 +34,7 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <deque>
 #include <fstream>
 #include <string>
 
@@ -82,6 +83,15 @@ private:
     //! offline client input log file
     std::ofstream M_offline_out;
 
+    //! commands sent in the offline mode, not yet compared with the recorded ones
+    std::deque< std::string > M_offline_sent_commands;
+
+    //! recorded commands in the offline log, not yet compared with the sent ones
+    std::deque< std::string > M_offline_recorded_commands;
+
+    int M_offline_command_matched; //!< the number of sent commands same as the recorded ones
+    int M_offline_command_mismatched; //!< the number of sent commands differ from the recorded ones
+
     //! flag to check server status
     bool M_server_alive;
 
@@ -153,6 +163,24 @@ public:
      */
     void printOfflineThink();
 
+    /*!
+      \brief get the number of commands same as the recorded ones in the offline log
+      \return the number of matched commands
+     */
+    int offlineCommandMatched() const
+      {
+          return M_offline_command_matched;
+      }
+
+    /*!
+      \brief get the number of commands differ from the recorded ones in the offline log
+      \return the number of mismatched commands
+     */
+    int offlineCommandMismatched() const
+      {
+          return M_offline_command_mismatched;
+      }
+
     /*!
       \brief connect to the specified server with timeout value for select()
       \param hostname server host name
@@ -191,6 +219,13 @@ private:
      */
     void runOffline( SoccerAgent * agent );
 
+    /*!
+      \brief compare the sent commands with the recorded commands in the offline log.
+      \param finished if true, the remaining commands that have no counterpart
+      are counted as mismatched.
+     */
+    void compareOfflineCommands( const bool finished );
+
 public:
 
     /*!
@@ -199,6 +234,21 @@ public:
      */
     void setIntervalMSec( const long & interval_msec );
 
+    /*!
+      \brief get the current interval time for select()
+      \return interval by milli second
+     */
+    long intervalMSec() const
+      {
+          return M_interval_msec;
+      }
+
+    /*!
+      \brief get the file descriptor of the server connection
+      \return file descriptor. -1 if no connection.
+     */
+    int socketFd() const;
+
     /*!
       \brief set server status
       \param alive server status flag. if server is dead, this value becomes false.
@@ -216,6 +266,9 @@ public:
       \brief send raw string to the server
       \param msg message to be sent
       \return result of ::sendto()
+
+      If the offline client log is opened, the message is recorded as "(send <msg>)".
+      In the offline mode, the message is compared with the recorded one.
      */
     int sendMessage( const char * msg );
 
@@ -0,0 +1,216 @@
+// -*-c++-*-
+
+/*!
+  \file command_buffer.cpp
+  \brief fixed size command string buffer Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "command_buffer.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+//! 10^(-4) ... 10^9. exact for non-negative exponents.
+const double POW10[] = {
+    1.0e-4, 1.0e-3, 1.0e-2, 1.0e-1,
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+};
+
+inline
+double
+power_of_ten( const int e )
+{
+    return POW10[e + 4];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  format the value in the "%g" format (6 significant digits) without printf.
+  \return the number of characters, or 0 if the value has to be formatted
+  by printf, i.e. exponential notation or rounding at an exact tie.
+*/
+std::size_t
+format_g6( const double value,
+           char * buf )
+{
+    const double a = std::fabs( value );
+    if ( ! ( a >= 1.0e-4 && a < 1.0e6 ) )
+    {
+        return 0;
+    }
+
+    int e = 5;
+    while ( a < power_of_ten( e ) )
+    {
+        --e;
+    }
+
+    // 6 significant digits. the product is exact within 0.5 ulp because 10^(5-e) is exact.
+    const double scaled = a * power_of_ten( 5 - e );
+    const double fl = std::floor( scaled );
+    const double frac = scaled - fl;
+    if ( std::fabs( frac - 0.5 ) < 1.0e-9 )
+    {
+        // too close to the tie to decide the rounding direction
+        return 0;
+    }
+
+    long digits = static_cast< long >( fl ) + ( frac > 0.5 ? 1 : 0 );
+    if ( digits >= 1000000 )
+    {
+        digits /= 10;
+        ++e;
+        if ( e >= 6 )
+        {
+            return 0;
+        }
+    }
+    else if ( digits < 100000 )
+    {
+        // a is slightly smaller than inexact 10^e
+        return 0;
+    }
+
+    char d[6];
+    for ( int i = 5; i >= 0; --i )
+    {
+        d[i] = static_cast< char >( '0' + digits % 10 );
+        digits /= 10;
+    }
+
+    // index of the last digit to be printed. trailing zeros are removed as "%g" does.
+    int last = 5;
+    while ( last > 0 && last > e && d[last] == '0' )
+    {
+        --last;
+    }
+
+    char * p = buf;
+    if ( value < 0.0 )
+    {
+        *p++ = '-';
+    }
+
+    if ( e >= 0 )
+    {
+        for ( int i = 0; i <= e; ++i )
+        {
+            *p++ = d[i];
+        }
+        if ( last > e )
+        {
+            *p++ = '.';
+            for ( int i = e + 1; i <= last; ++i )
+            {
+                *p++ = d[i];
+            }
+        }
+    }
+    else
+    {
+        *p++ = '0';
+        *p++ = '.';
+        for ( int i = e + 1; i < 0; ++i )
+        {
+            *p++ = '0';
+        }
+        for ( int i = 0; i <= last; ++i )
+        {
+            *p++ = d[i];
+        }
+    }
+
+    return static_cast< std::size_t >( p - buf );
+}
+
+}
+
+namespace rcsc {
+
+const std::size_t CommandBuffer::CAPACITY;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+CommandBuffer::operator<<( const int value )
+{
+    char buf[16];
+    char * p = buf + sizeof( buf );
+
+    unsigned int u = ( value < 0
+                       ? 0u - static_cast< unsigned int >( value )
+                       : static_cast< unsigned int >( value ) );
+    do
+    {
+        *--p = static_cast< char >( '0' + u % 10 );
+        u /= 10;
+    }
+    while ( u != 0 );
+
+    if ( value < 0 )
+    {
+        *--p = '-';
+    }
+
+    return append( p, static_cast< std::size_t >( buf + sizeof( buf ) - p ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+CommandBuffer::operator<<( const double value )
+{
+    char buf[32];
+
+    if ( value == 0.0 )
+    {
+        return ( 1.0 / value < 0.0
+                 ? append( "-0", 2 )
+                 : append( "0", 1 ) );
+    }
+
+    std::size_t n = format_g6( value, buf );
+    if ( n == 0 )
+    {
+        const int len = std::snprintf( buf, sizeof( buf ), "%g", value );
+        n = ( len > 0 ? static_cast< std::size_t >( len ) : 0 );
+    }
+
+    return append( buf, n );
+}
+
+}
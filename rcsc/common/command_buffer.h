@@ -0,0 +1,196 @@
+// -*-c++-*-
+
+/*!
+  \file command_buffer.h
+  \brief fixed size command string buffer Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_COMMAND_BUFFER_H
+#define RCSC_COMMON_COMMAND_BUFFER_H
+
+#include <string>
+#include <cstring>
+
+namespace rcsc {
+
+/*!
+  \class CommandBuffer
+  \brief preallocated buffer to compose the command string sent to rcssserver.
+
+  The buffer never allocates memory. Numbers are formatted in the same
+  way as the default std::ostream format (i.e. "%g"), so the composed
+  string is identical to the one made by the stream operators.
+  Characters that exceed the capacity are dropped and overflow() becomes true.
+*/
+class CommandBuffer {
+public:
+
+    //! buffer capacity including the terminating null character. the same as rcssserver's message size.
+    static const std::size_t CAPACITY = 8192;
+
+private:
+
+    //! character buffer, always null terminated
+    char M_buffer[CAPACITY];
+
+    //! current string length
+    std::size_t M_size;
+
+    //! true if some characters were dropped
+    bool M_overflow;
+
+    // nocopyable
+    CommandBuffer( const CommandBuffer & );
+    CommandBuffer & operator=( const CommandBuffer & );
+
+public:
+
+    /*!
+      \brief create an empty buffer
+     */
+    CommandBuffer()
+        : M_size( 0 ),
+          M_overflow( false )
+      {
+          M_buffer[0] = '\0';
+      }
+
+    /*!
+      \brief clear the string
+     */
+    void clear()
+      {
+          M_size = 0;
+          M_overflow = false;
+          M_buffer[0] = '\0';
+      }
+
+    /*!
+      \brief get the null terminated string
+      \return const pointer to the buffer
+     */
+    const char * c_str() const
+      {
+          return M_buffer;
+      }
+
+    /*!
+      \brief get the string length
+      \return the number of characters
+     */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief check if the string is empty
+      \return true if empty
+     */
+    bool empty() const
+      {
+          return M_size == 0;
+      }
+
+    /*!
+      \brief check if some characters were dropped
+      \return true if overflowed
+     */
+    bool overflow() const
+      {
+          return M_overflow;
+      }
+
+    /*!
+      \brief append the characters
+      \param str pointer to the characters
+      \param n the number of characters
+      \return reference to itself
+     */
+    CommandBuffer & append( const char * str,
+                            std::size_t n )
+      {
+          if ( M_size + n >= CAPACITY )
+          {
+              n = CAPACITY - 1 - M_size;
+              M_overflow = true;
+          }
+          std::memcpy( M_buffer + M_size, str, n );
+          M_size += n;
+          M_buffer[M_size] = '\0';
+          return *this;
+      }
+
+    /*!
+      \brief append the null terminated string
+      \param str string
+      \return reference to itself
+     */
+    CommandBuffer & operator<<( const char * str )
+      {
+          return append( str, std::strlen( str ) );
+      }
+
+    /*!
+      \brief append the string
+      \param str string
+      \return reference to itself
+     */
+    CommandBuffer & operator<<( const std::string & str )
+      {
+          return append( str.data(), str.length() );
+      }
+
+    /*!
+      \brief append a character
+      \param c character
+      \return reference to itself
+     */
+    CommandBuffer & operator<<( const char c )
+      {
+          return append( &c, 1 );
+      }
+
+    /*!
+      \brief append the integer in decimal
+      \param value integer value
+      \return reference to itself
+     */
+    CommandBuffer & operator<<( const int value );
+
+    /*!
+      \brief append the floating point number in the "%g" format
+      \param value floating point number
+      \return reference to itself
+     */
+    CommandBuffer & operator<<( const double value );
+
+};
+
+}
+
+#endif
@@ -37,10 +37,15 @@
 #include <rcsc/game_time.h>
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 #include <cstdarg>
 #include <cstring>
 
+#include <pthread.h>
+#include <sys/time.h>
+
 namespace rcsc {
 
 namespace  {
@@ -48,12 +53,418 @@ namespace  {
 //! buffer size for the log message.
 #define G_BUFFER_SIZE 2048
 
-//! temporary buffer
-char g_buffer[G_BUFFER_SIZE];
-
 //! main buffer
 std::string g_str;
 
+//! size of the binary record header
+const std::size_t BINARY_HEADER_SIZE = 16;
+
+//! max number of values in the binary record
+const int BINARY_MAX_VALUES = 6;
+
+//! max text length in the binary record
+const std::size_t BINARY_MAX_TEXT = 65535 - BINARY_HEADER_SIZE - sizeof( float ) * BINARY_MAX_VALUES;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the absolute time after the specified period
+  \param msec period [millisecond]
+  \return absolute time for pthread_cond_timedwait
+*/
+timespec
+time_after( const long msec )
+{
+    timeval now;
+    gettimeofday( &now, 0 );
+
+    long nsec = now.tv_usec * 1000 + ( msec % 1000 ) * 1000 * 1000;
+    timespec abstime;
+    abstime.tv_sec = now.tv_sec + msec / 1000 + nsec / ( 1000 * 1000 * 1000 );
+    abstime.tv_nsec = nsec % ( 1000 * 1000 * 1000 );
+    return abstime;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Logger::AsyncWriter
+  \brief background writer thread and the ring buffers of the logging threads.
+
+  Each logging thread has its own single producer/single consumer ring
+  buffer. The logging thread formats messages into its staging buffer
+  without any synchronization, and moves them into the ring buffer at
+  flush(). Only complete lines are published, so that lines from different
+  threads are never mixed in the output file.
+
+  The writer object, the thread local key and the rings are kept until
+  the logger is destroyed, because the logging threads may still hold
+  their rings after stopAsync(). The rings are reused by the next
+  startAsync().
+*/
+struct Logger::AsyncWriter {
+
+    /*!
+      \struct Ring
+      \brief byte ring buffer owned by one logging thread
+    */
+    struct Ring {
+        AsyncWriter * owner_; //!< writer that drains this ring
+        std::vector< char > data_; //!< ring storage
+        volatile std::size_t write_count_; //!< total published bytes. updated only by the producer.
+        volatile std::size_t read_count_; //!< total consumed bytes. updated only by the writer.
+        volatile bool retired_; //!< true if the owner thread has exited
+        std::string staging_; //!< formatted messages not yet published
+
+        Ring( AsyncWriter * owner,
+              const std::size_t size )
+            : owner_( owner ),
+              data_( size ),
+              write_count_( 0 ),
+              read_count_( 0 ),
+              retired_( false )
+          {
+              staging_.reserve( 8192 * 4 );
+          }
+
+        /*!
+          \brief copy the head of the data into the ring. called by the producer.
+          \param buf data
+          \param len data length
+          \param binary true if the data consists of binary records
+          \return the number of copied bytes
+        */
+        std::size_t push( const char * buf,
+                          const std::size_t len,
+                          const bool binary )
+          {
+              const std::size_t capacity = data_.size();
+              const std::size_t r = read_count_;
+              __sync_synchronize();
+              const std::size_t w = write_count_;
+
+              const std::size_t space = capacity - ( w - r );
+              std::size_t n = std::min( space, len );
+              if ( n < len )
+              {
+                  // publish only the complete lines or records
+                  if ( binary )
+                  {
+                      std::size_t end = 0;
+                      while ( end < n )
+                      {
+                          boost::uint16_t size;
+                          std::memcpy( &size, buf + end, sizeof( size ) );
+                          if ( end + size > n ) break;
+                          end += size;
+                      }
+                      n = end;
+                  }
+                  else
+                  {
+                      while ( n > 0 && buf[n - 1] != '\n' ) --n;
+                  }
+                  if ( n == 0 && space == capacity )
+                  {
+                      // the line is longer than the ring
+                      n = space;
+                  }
+              }
+
+              if ( n == 0 )
+              {
+                  return 0;
+              }
+
+              const std::size_t index = w % capacity;
+              const std::size_t first = std::min( n, capacity - index );
+              std::memcpy( &data_[index], buf, first );
+              if ( first < n )
+              {
+                  std::memcpy( &data_[0], buf + first, n - first );
+              }
+
+              __sync_synchronize();
+              write_count_ = w + n;
+              return n;
+          }
+
+        /*!
+          \brief write the published data to the file. called by the writer.
+          \param fout output file
+          \return true if any data is written
+        */
+        bool drain( FILE * fout )
+          {
+              const std::size_t w = write_count_;
+              __sync_synchronize();
+              const std::size_t r = read_count_;
+              if ( w == r )
+              {
+                  return false;
+              }
+
+              const std::size_t capacity = data_.size();
+              const std::size_t n = w - r;
+              const std::size_t index = r % capacity;
+              const std::size_t first = std::min( n, capacity - index );
+              std::fwrite( &data_[index], sizeof( char ), first, fout );
+              if ( first < n )
+              {
+                  std::fwrite( &data_[0], sizeof( char ), n - first, fout );
+              }
+
+              __sync_synchronize();
+              read_count_ = w;
+              return true;
+          }
+
+        bool empty() const
+          {
+              return write_count_ == read_count_;
+          }
+    };
+
+    FILE * fout_; //!< output file
+    std::size_t ring_size_; //!< ring buffer size for each thread
+    OverflowPolicy policy_; //!< behavior when the ring is full
+    bool binary_; //!< true if the log is written in the binary format
+
+    pthread_key_t key_; //!< thread local Ring
+    pthread_t thread_; //!< writer thread
+
+    pthread_mutex_t mutex_; //!< protects rings_ and stop_
+    pthread_cond_t data_cond_; //!< signaled when messages are published
+    pthread_cond_t space_cond_; //!< signaled when the writer consumed messages
+
+    std::vector< Ring * > rings_; //!< all registered rings
+    bool stop_; //!< termination flag
+    volatile bool running_; //!< true while the writer thread is running
+
+    volatile std::size_t dropped_; //!< total size of discarded messages
+
+    AsyncWriter( FILE * fout,
+                 const std::size_t ring_size,
+                 const OverflowPolicy policy,
+                 const bool binary )
+        : fout_( fout ),
+          ring_size_( ring_size ),
+          policy_( policy ),
+          binary_( binary ),
+          stop_( false ),
+          running_( false ),
+          dropped_( 0 )
+      {
+          pthread_key_create( &key_, &AsyncWriter::retire );
+          pthread_mutex_init( &mutex_, 0 );
+          pthread_cond_init( &data_cond_, 0 );
+          pthread_cond_init( &space_cond_, 0 );
+      }
+
+    ~AsyncWriter()
+      {
+          for ( std::vector< Ring * >::iterator it = rings_.begin(), end = rings_.end();
+                it != end;
+                ++it )
+          {
+              delete *it;
+          }
+
+          pthread_cond_destroy( &space_cond_ );
+          pthread_cond_destroy( &data_cond_ );
+          pthread_mutex_destroy( &mutex_ );
+          pthread_key_delete( key_ );
+      }
+
+    /*!
+      \brief get the ring of the calling thread. a new ring is registered at the first call.
+      \return reference to the ring
+    */
+    Ring & ring()
+      {
+          Ring * r = static_cast< Ring * >( pthread_getspecific( key_ ) );
+          if ( ! r )
+          {
+              r = new Ring( this, ring_size_ );
+              pthread_mutex_lock( &mutex_ );
+              rings_.push_back( r );
+              pthread_mutex_unlock( &mutex_ );
+              pthread_setspecific( key_, r );
+          }
+          return *r;
+      }
+
+    /*!
+      \brief prepare the rings for the next writer thread.
+      called while no writer thread is running.
+    */
+    void reset()
+      {
+          pthread_mutex_lock( &mutex_ );
+          for ( std::vector< Ring * >::iterator it = rings_.begin();
+                it != rings_.end(); )
+          {
+              if ( (*it)->retired_ )
+              {
+                  delete *it;
+                  it = rings_.erase( it );
+                  continue;
+              }
+
+              // all published data were drained by the previous writer
+              (*it)->write_count_ = 0;
+              (*it)->read_count_ = 0;
+              (*it)->data_.resize( ring_size_ );
+              ++it;
+          }
+          stop_ = false;
+          pthread_mutex_unlock( &mutex_ );
+      }
+
+    void commit( Ring & r );
+
+    static
+    void retire( void * arg );
+
+    static
+    void * thread_main( void * arg );
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief move the staging buffer into the ring buffer
+*/
+void
+Logger::AsyncWriter::commit( Ring & r )
+{
+    if ( r.staging_.empty() )
+    {
+        return;
+    }
+
+    const char * buf = r.staging_.data();
+    std::size_t len = r.staging_.length();
+
+    while ( len > 0 )
+    {
+        const std::size_t n = r.push( buf, len, binary_ );
+        buf += n;
+        len -= n;
+
+        if ( len == 0 )
+        {
+            break;
+        }
+
+        if ( policy_ == DROP_ON_OVERFLOW )
+        {
+            __sync_fetch_and_add( &dropped_, len );
+            break;
+        }
+
+        // BLOCK_ON_OVERFLOW: wake up the writer and wait for the space.
+        pthread_mutex_lock( &mutex_ );
+        pthread_cond_signal( &data_cond_ );
+        const timespec abstime = time_after( 10 );
+        pthread_cond_timedwait( &space_cond_, &mutex_, &abstime );
+        pthread_mutex_unlock( &mutex_ );
+    }
+
+    r.staging_.erase();
+
+    pthread_mutex_lock( &mutex_ );
+    pthread_cond_signal( &data_cond_ );
+    pthread_mutex_unlock( &mutex_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief thread local destructor. publish the remaining messages of the exited thread.
+*/
+void
+Logger::AsyncWriter::retire( void * arg )
+{
+    Ring * r = static_cast< Ring * >( arg );
+    AsyncWriter * self = r->owner_;
+
+    if ( self->running_ )
+    {
+        self->commit( *r );
+    }
+
+    pthread_mutex_lock( &self->mutex_ );
+    r->retired_ = true;
+    pthread_mutex_unlock( &self->mutex_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void *
+Logger::AsyncWriter::thread_main( void * arg )
+{
+    AsyncWriter * self = static_cast< AsyncWriter * >( arg );
+
+    std::vector< Ring * > rings;
+
+    pthread_mutex_lock( &self->mutex_ );
+    while ( true )
+    {
+        rings = self->rings_;
+        const bool stop = self->stop_;
+        pthread_mutex_unlock( &self->mutex_ );
+
+        bool written = false;
+        for ( std::vector< Ring * >::iterator it = rings.begin(), end = rings.end();
+              it != end;
+              ++it )
+        {
+            if ( (*it)->drain( self->fout_ ) )
+            {
+                written = true;
+            }
+        }
+
+        if ( written )
+        {
+            std::fflush( self->fout_ );
+        }
+
+        pthread_mutex_lock( &self->mutex_ );
+        pthread_cond_broadcast( &self->space_cond_ );
+
+        for ( std::vector< Ring * >::iterator it = self->rings_.begin();
+              it != self->rings_.end(); )
+        {
+            if ( (*it)->retired_
+                 && (*it)->empty() )
+            {
+                delete *it;
+                it = self->rings_.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if ( written )
+        {
+            continue;
+        }
+
+        if ( stop )
+        {
+            break;
+        }
+
+        const timespec abstime = time_after( 100 );
+        pthread_cond_timedwait( &self->data_cond_, &self->mutex_, &abstime );
+    }
+    pthread_mutex_unlock( &self->mutex_ );
+
+    return static_cast< void * >( 0 );
 }
 
 //! global variable
@@ -67,9 +478,9 @@ Logger::Logger()
     : M_time( static_cast< GameTime * >( 0 ) )
     , M_fout( NULL )
     , M_flags( 0 )
+    , M_format( TEXT_FORMAT )
 {
     g_str.reserve( 8192 * 4 );
-    std::strcpy( g_buffer, "" );
 }
 
 /*-------------------------------------------------------------------*/
@@ -80,6 +491,7 @@ Logger::~Logger()
 {
     if ( M_fout )
     {
+        this->stopAsync();
         this->flush();
         fclose( M_fout );
         M_fout = NULL;
@@ -91,9 +503,25 @@ Logger::~Logger()
 
  */
 void
-Logger::open( const std::string & filepath )
+Logger::open( const std::string & filepath,
+              const Format format )
 {
-    M_fout = std::fopen( filepath.c_str(), "w" );
+    stopAsync();
+    M_format = format;
+    M_colors.clear();
+
+    M_fout = std::fopen( filepath.c_str(), ( format == BINARY_FORMAT ? "wb" : "w" ) );
+
+    if ( M_fout
+         && format == BINARY_FORMAT )
+    {
+        const boost::uint16_t endian = 1;
+        char header[8] = { 'R', 'C', 'D', 'L',
+                           static_cast< char >( BINARY_VERSION ),
+                           *reinterpret_cast< const char * >( &endian ),
+                           0, 0 };
+        std::fwrite( header, sizeof( char ), sizeof( header ), M_fout );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -116,6 +544,115 @@ Logger::setLogFlag( const GameTime * time,
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+Logger::startAsync( const std::size_t buffer_size,
+                    const OverflowPolicy policy )
+{
+    if ( ! M_fout )
+    {
+        return false;
+    }
+
+    if ( isAsync() )
+    {
+        return true;
+    }
+
+    this->flush();
+
+    // a ring must be able to hold at least a few lines.
+    const std::size_t size = std::max( buffer_size,
+                                       static_cast< std::size_t >( G_BUFFER_SIZE * 4 ) );
+    if ( ! M_async )
+    {
+        M_async.reset( new AsyncWriter( M_fout, size, policy, M_format == BINARY_FORMAT ) );
+    }
+    else
+    {
+        // reuse the rings of the previous session
+        M_async->fout_ = M_fout;
+        M_async->ring_size_ = size;
+        M_async->policy_ = policy;
+        M_async->binary_ = ( M_format == BINARY_FORMAT );
+        M_async->reset();
+    }
+
+    if ( pthread_create( &M_async->thread_, 0, &AsyncWriter::thread_main, M_async.get() ) != 0 )
+    {
+        std::cerr << "(Logger) could not create the writer thread." << std::endl;
+        return false;
+    }
+
+    M_async->running_ = true;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::stopAsync()
+{
+    if ( ! isAsync() )
+    {
+        return;
+    }
+
+    M_async->commit( M_async->ring() );
+
+    pthread_mutex_lock( &M_async->mutex_ );
+    M_async->stop_ = true;
+    pthread_cond_signal( &M_async->data_cond_ );
+    pthread_mutex_unlock( &M_async->mutex_ );
+
+    pthread_join( M_async->thread_, 0 );
+
+    // the writer object is kept, because other threads may still refer to their rings.
+    M_async->running_ = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+Logger::isAsync() const
+{
+    return M_async && M_async->running_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Logger::droppedSize() const
+{
+    return ( M_async
+             ? static_cast< std::size_t >( M_async->dropped_ )
+             : 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string &
+Logger::buffer()
+{
+    if ( isAsync() )
+    {
+        return M_async->ring().staging_;
+    }
+
+    return g_str;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -123,10 +660,15 @@ Logger::setLogFlag( const GameTime * time,
 void
 Logger::flush()
 {
+    if ( isAsync() )
+    {
+        M_async->commit( M_async->ring() );
+        return;
+    }
+
     if ( M_fout && g_str.length() > 0 )
     {
-        fputs( g_str.c_str(), M_fout );
-        //fwrite( g_str.c_str(), sizeof( char ), g_str.length(), M_fout );
+        fwrite( g_str.data(), sizeof( char ), g_str.length(), M_fout );
         fflush( M_fout );
     }
     g_str.erase();
@@ -139,7 +681,110 @@ Logger::flush()
 void
 Logger::clear()
 {
-    g_str.erase();
+    buffer().erase();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+boost::uint16_t
+Logger::colorId( std::string & buf,
+                 const char * color )
+{
+    if ( ! color )
+    {
+        return 0;
+    }
+
+    // the color table is shared by all logging threads.
+    const bool async = isAsync();
+    if ( async )
+    {
+        pthread_mutex_lock( &M_async->mutex_ );
+    }
+
+    boost::uint16_t id = 0;
+    for ( std::size_t i = 0; i < M_colors.size(); ++i )
+    {
+        if ( M_colors[i] == color )
+        {
+            id = static_cast< boost::uint16_t >( i + 1 );
+            break;
+        }
+    }
+
+    if ( id == 0
+         && M_colors.size() < 65535 )
+    {
+        M_colors.push_back( color );
+        id = static_cast< boost::uint16_t >( M_colors.size() );
+        addBinary( buf, 'K', 0, id, 0, 0, color );
+    }
+
+    if ( async )
+    {
+        pthread_mutex_unlock( &M_async->mutex_ );
+    }
+
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+boost::uint16_t
+Logger::colorId( std::string & buf,
+                 const int r, const int g, const int b )
+{
+    char col[8];
+    snprintf( col, 8, "#%02x%02x%02x", r, g, b );
+    return colorId( buf, col );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::addBinary( std::string & buf,
+                   const char type,
+                   const boost::int32_t level,
+                   const boost::uint16_t color,
+                   const double * values,
+                   const int n,
+                   const char * text )
+{
+    const std::size_t text_len = ( text
+                                   ? std::min( std::strlen( text ), BINARY_MAX_TEXT )
+                                   : 0 );
+    const boost::uint16_t size
+        = static_cast< boost::uint16_t >( BINARY_HEADER_SIZE + sizeof( float ) * n + text_len );
+    const boost::uint8_t n_values = static_cast< boost::uint8_t >( n );
+    const boost::uint16_t reserved = 0;
+    const boost::int32_t cycle = static_cast< boost::int32_t >( M_time->cycle() );
+
+    char record[BINARY_HEADER_SIZE + sizeof( float ) * BINARY_MAX_VALUES];
+    char * ptr = record;
+    std::memcpy( ptr, &size, 2 ); ptr += 2;
+    *ptr = type; ptr += 1;
+    std::memcpy( ptr, &n_values, 1 ); ptr += 1;
+    std::memcpy( ptr, &color, 2 ); ptr += 2;
+    std::memcpy( ptr, &reserved, 2 ); ptr += 2;
+    std::memcpy( ptr, &cycle, 4 ); ptr += 4;
+    std::memcpy( ptr, &level, 4 ); ptr += 4;
+    for ( int i = 0; i < n; ++i )
+    {
+        const float v = static_cast< float >( values[i] );
+        std::memcpy( ptr, &v, 4 ); ptr += 4;
+    }
+
+    buf.append( record, ptr - record );
+    if ( text_len > 0 )
+    {
+        buf.append( text, text_len );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -153,20 +798,31 @@ Logger::addText( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
+        char text[G_BUFFER_SIZE];
         va_list argp;
         va_start( argp, msg );
-        vsnprintf( g_buffer, G_BUFFER_SIZE, msg, argp );
+        vsnprintf( text, G_BUFFER_SIZE, msg, argp );
         va_end( argp );
 
-        char header[32];
-        snprintf( header, 32, "%ld %d M ",
-                  M_time->cycle(),
-                  level );
+        if ( M_format == BINARY_FORMAT )
+        {
+            addBinary( buf, 'M', level, 0, 0, 0, text );
+        }
+        else
+        {
+            char header[32];
+            snprintf( header, 32, "%ld %d M ",
+                      M_time->cycle(),
+                      level );
+
+            buf += header;
+            buf += text;
+            buf += '\n';
+        }
 
-        g_str += header;
-        g_str += g_buffer;
-        g_str += '\n';
-        if ( g_str.length() > 8192 * 3 )
+        if ( buf.length() > 8192 * 3 )
         {
             flush();
         }
@@ -185,17 +841,26 @@ Logger::addPoint( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y };
+            addBinary( buf, 'p', level, colorId( buf, color ), values, 2 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d p %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   x, y );
-        g_str += msg;
+        buf += msg;
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -211,14 +876,23 @@ Logger::addPoint( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y };
+            addBinary( buf, 'p', level, colorId( buf, r, g, b ), values, 2 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d p %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
                   x, y,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -236,17 +910,26 @@ Logger::addLine( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x1, y1, x2, y2 };
+            addBinary( buf, 'l', level, colorId( buf, color ), values, 4 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d l %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   x1, y1, x2, y2 );
-        g_str += msg;
+        buf += msg;
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -264,14 +947,23 @@ Logger::addLine( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x1, y1, x2, y2 };
+            addBinary( buf, 'l', level, colorId( buf, r, g, b ), values, 4 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d l %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
                   x1, y1, x2, y2,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -290,19 +982,28 @@ Logger::addArc( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y, radius, start_angle.degree(), span_angle };
+            addBinary( buf, 'a', level, colorId( buf, color ), values, 5 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d a %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   x, y, radius, start_angle.degree(), span_angle );
-        g_str += msg;
+        buf += msg;
 
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
 
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -322,14 +1023,23 @@ Logger::addArc( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y, radius, start_angle.degree(), span_angle };
+            addBinary( buf, 'a', level, colorId( buf, r, g, b ), values, 5 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d a %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
                   x, y, radius, start_angle.degree(), span_angle,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -347,18 +1057,27 @@ Logger::addCircle( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y, radius };
+            addBinary( buf, ( fill ? 'C' : 'c' ), level, colorId( buf, color ), values, 3 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   ( fill ? 'C' : 'c' ),
                   x, y, radius );
-        g_str += msg;
+        buf += msg;
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -376,15 +1095,24 @@ Logger::addCircle( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y, radius };
+            addBinary( buf, ( fill ? 'C' : 'c' ), level, colorId( buf, r, g, b ), values, 3 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
                   ( fill ? 'C' : 'c' ),
                   x, y, radius,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -405,18 +1133,27 @@ Logger::addTriangle( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x1, y1, x2, y2, x3, y3 };
+            addBinary( buf, ( fill ? 'T' : 't' ), level, colorId( buf, color ), values, 6 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   ( fill ? 'T' : 't' ),
                   x1, y1, x2, y2, x3, y3 );
-        g_str += msg;
+        buf += msg;
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -437,15 +1174,24 @@ Logger::addTriangle( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x1, y1, x2, y2, x3, y3 };
+            addBinary( buf, ( fill ? 'T' : 't' ), level, colorId( buf, r, g, b ), values, 6 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
                   ( fill ? 'T' : 't' ),
                   x1, y1, x2, y2, x3, y3,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -464,18 +1210,27 @@ Logger::addRect( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { left, top, length, width };
+            addBinary( buf, ( fill ? 'R' : 'r' ), level, colorId( buf, color ), values, 4 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   ( fill ? 'R' : 'r' ),
                   left, top, length, width );
-        g_str += msg;
+        buf += msg;
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -494,15 +1249,24 @@ Logger::addRect( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { left, top, length, width };
+            addBinary( buf, ( fill ? 'R' : 'r' ), level, colorId( buf, r, g, b ), values, 4 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
                   ( fill ? 'R' : 'r' ),
                   left, top, length, width,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -523,19 +1287,29 @@ Logger::addSector( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y, min_radius, max_radius,
+                                      start_angle.degree(), span_angle };
+            addBinary( buf, ( fill ? 'S' : 's' ), level, colorId( buf, color ), values, 6 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   ( fill ? 'S' : 's' ),
                   x, y, min_radius, max_radius,
                   start_angle.degree(), span_angle );
-        g_str += msg;
+        buf += msg;
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -556,7 +1330,17 @@ Logger::addSector( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
         char msg[128];
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y, min_radius, max_radius,
+                                      start_angle.degree(), span_angle };
+            addBinary( buf, ( fill ? 'S' : 's' ), level, colorId( buf, r, g, b ), values, 6 );
+            return;
+        }
+
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
@@ -564,8 +1348,8 @@ Logger::addSector( const boost::int32_t level,
                   x, y, min_radius, max_radius,
                   start_angle.degree(), span_angle,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -581,10 +1365,22 @@ Logger::addSector( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
-        char msg[128];
+        std::string & buf = buffer();
+
         double span_angle = ( sector.angleLeftStart().isLeftOf( sector.angleRightEnd() )
                               ? ( sector.angleLeftStart() - sector.angleRightEnd() ).abs()
                               : 360.0 - ( sector.angleLeftStart() - sector.angleRightEnd() ).abs() );
+
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { sector.center().x, sector.center().y,
+                                      sector.radiusMin(), sector.radiusMax(),
+                                      sector.angleLeftStart().degree(), span_angle };
+            addBinary( buf, ( fill ? 'S' : 's' ), level, colorId( buf, color ), values, 6 );
+            return;
+        }
+
+        char msg[128];
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   level,
@@ -592,12 +1388,12 @@ Logger::addSector( const boost::int32_t level,
                   sector.center().x, sector.center().y,
                   sector.radiusMin(), sector.radiusMax(),
                   sector.angleLeftStart().degree(), span_angle );
-        g_str += msg;
+        buf += msg;
         if ( color )
         {
-            g_str += color;
+            buf += color;
         }
-        g_str += '\n';
+        buf += '\n';
     }
 }
 
@@ -613,10 +1409,22 @@ Logger::addSector( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
-        char msg[128];
+        std::string & buf = buffer();
+
         double span_angle = ( sector.angleLeftStart().isLeftOf( sector.angleRightEnd() )
                               ? ( sector.angleLeftStart() - sector.angleRightEnd() ).abs()
                               : 360.0 - ( sector.angleLeftStart() - sector.angleRightEnd() ).abs() );
+
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { sector.center().x, sector.center().y,
+                                      sector.radiusMin(), sector.radiusMax(),
+                                      sector.angleLeftStart().degree(), span_angle };
+            addBinary( buf, ( fill ? 'S' : 's' ), level, colorId( buf, r, g, b ), values, 6 );
+            return;
+        }
+
+        char msg[128];
         snprintf( msg, 128, "%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   level,
@@ -625,8 +1433,8 @@ Logger::addSector( const boost::int32_t level,
                   sector.radiusMin(), sector.radiusMax(),
                   sector.angleLeftStart().degree(), span_angle,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -643,22 +1451,31 @@ Logger::addMessage( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y };
+            addBinary( buf, 'm', level, colorId( buf, color ), values, 2, msg );
+            return;
+        }
+
         char header[128];
         snprintf( header, 128, "%ld %d m %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   x, y );
-        g_str += header;
+        buf += header;
 
         if ( color )
         {
-            g_str += "(c ";
-            g_str += color;
-            g_str += ") ";
+            buf += "(c ";
+            buf += color;
+            buf += ") ";
         }
 
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
@@ -675,21 +1492,30 @@ Logger::addMessage( const boost::int32_t level,
 {
     if ( M_fout && ( level & M_flags ) && M_time )
     {
+        std::string & buf = buffer();
+
+        if ( M_format == BINARY_FORMAT )
+        {
+            const double values[] = { x, y };
+            addBinary( buf, 'm', level, colorId( buf, r, g, b ), values, 2, msg );
+            return;
+        }
+
         char header[128];
         snprintf( header, 128, "%ld %d m %.4f %.4f ",
                   M_time->cycle(),
                   level,
                   x, y );
-        g_str += header;
+        buf += header;
 
         char col[8];
         snprintf( col, 8, "#%02x%02x%02x", r, g, b );
-        g_str += "(c ";
-        g_str += col;
-        g_str += ") ";
+        buf += "(c ";
+        buf += col;
+        buf += ") ";
 
-        g_str += msg;
-        g_str += '\n';
+        buf += msg;
+        buf += '\n';
     }
 }
 
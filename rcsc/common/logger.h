@@ -38,10 +38,13 @@
 #include <rcsc/geom/sector_2d.h>
 #include <rcsc/geom/triangle_2d.h>
 
+#include <boost/scoped_ptr.hpp>
 #include <boost/cstdint.hpp>
 
+#include <vector>
 #include <string>
 #include <cstdio>
+#include <cstddef>
 
 namespace rcsc {
 
@@ -118,6 +121,35 @@ public:
     Message := <x:Real> <y:Real>[ (c <Color>)] <Str>
     **************************************************/
 
+    /*************************************************
+    Binary Log Format:
+    File := <Header> <Record>*
+    Header := "RCDL" <version:uint8> <endian:uint8> <reserved:uint16>
+        version : BINARY_VERSION
+        endian : 1 if little endian
+    Record := <size:uint16> <Type:char> <n:uint8> <color:uint16> <reserved:uint16>
+              <Time:int32> <Level:int32> <value:float32>{n} [<Str>]
+        size : total record size in bytes including this header
+        Type : the same character as the text format, or 'K'
+        color : interned color id. 0 means no color.
+        Str : text of 'M' and 'm' records, not terminated by null
+    'K' record defines the color string of the id given by <color>.
+    A color is defined only once and may appear after the records
+    that use it. The values have the same order as the text format.
+    Use rcdlog2txt to convert the binary log to the text format.
+    **************************************************/
+
+    //! binary log format version
+    static const int BINARY_VERSION = 1;
+
+    /*!
+      \brief output format of the log file
+     */
+    enum Format {
+        TEXT_FORMAT, //!< human readable text format
+        BINARY_FORMAT //!< fixed size binary records
+    };
+
     static const boost::int32_t SYSTEM    = LEVEL_01; //!< log level definition alias
     static const boost::int32_t SENSOR    = LEVEL_02; //!< log level definition alias
     static const boost::int32_t WORLD     = LEVEL_03; //!< log level definition alias
@@ -140,8 +172,18 @@ public:
     static const boost::int32_t ANALYZER  = LEVEL_20; //!< log level definition alias
     static const boost::int32_t ACTION_CHAIN = LEVEL_21; //!< log level definition alias
 
+    /*!
+      \brief behavior of the asynchronous mode when the ring buffer is full
+     */
+    enum OverflowPolicy {
+        DROP_ON_OVERFLOW, //!< discard the message that does not fit
+        BLOCK_ON_OVERFLOW //!< wait until the writer thread makes space
+    };
+
 private:
 
+    struct AsyncWriter;
+
     //! const pointer to GameTime instance
     const GameTime * M_time;
 
@@ -151,6 +193,19 @@ private:
     //! log level flag
     boost::int32_t M_flags;
 
+    //! output format
+    Format M_format;
+
+    //! interned color strings for the binary format. the index + 1 is the color id.
+    std::vector< std::string > M_colors;
+
+    //! background writer. null in the synchronous mode.
+    boost::scoped_ptr< AsyncWriter > M_async;
+
+    // not used
+    Logger( const Logger & );
+    Logger & operator=( const Logger & );
+
 public:
     /*!
       \brief allocate message buffer memory
@@ -185,8 +240,19 @@ public:
     /*!
       \brief open file to record
       \param filepath file path string
+      \param format output format
      */
-    void open( const std::string & filepath );
+    void open( const std::string & filepath,
+               const Format format = TEXT_FORMAT );
+
+    /*!
+      \brief get the output format
+      \return output format
+     */
+    Format format() const
+      {
+          return M_format;
+      }
 
     /*!
       \brief check if file is opened
@@ -198,7 +264,40 @@ public:
       }
 
     /*!
-      \brief flush stored message
+      \brief start the asynchronous mode.
+      After this call, messages are formatted into a buffer local to the
+      calling thread, and flush() moves them into the thread's ring buffer
+      instead of writing the file. A background thread drains the ring
+      buffers to the file.
+      \param buffer_size ring buffer size for each thread [byte]
+      \param policy behavior when the ring buffer is full
+      \return true if the writer thread is started
+     */
+    bool startAsync( const std::size_t buffer_size,
+                     const OverflowPolicy policy );
+
+    /*!
+      \brief stop the writer thread after writing all committed messages.
+      The logger returns to the synchronous mode.
+     */
+    void stopAsync();
+
+    /*!
+      \brief check if the asynchronous mode is active
+      \return true if the writer thread is running
+     */
+    bool isAsync() const;
+
+    /*!
+      \brief get the total size of the discarded messages in the asynchronous mode
+      \return discarded size [byte]
+     */
+    std::size_t droppedSize() const;
+
+    /*!
+      \brief flush stored message.
+      In the asynchronous mode, the messages of the calling thread are
+      passed to the writer thread and this method does not touch the file.
     */
     void flush();
 
@@ -207,6 +306,54 @@ public:
     */
     void clear();
 
+private:
+
+    /*!
+      \brief get the message buffer for the calling thread
+      \return reference to the buffer
+    */
+    std::string & buffer();
+
+    /*!
+      \brief get the interned id of the color. a new color is defined in the buffer.
+      \param buf message buffer of the calling thread
+      \param color color name string
+      \return color id. 0 if color is null.
+    */
+    boost::uint16_t colorId( std::string & buf,
+                             const char * color );
+
+    /*!
+      \brief get the interned id of the color
+      \param buf message buffer of the calling thread
+      \param r red value
+      \param g green value
+      \param b blue value
+      \return color id
+    */
+    boost::uint16_t colorId( std::string & buf,
+                             const int r, const int g, const int b );
+
+    /*!
+      \brief append the binary record
+      \param buf message buffer of the calling thread
+      \param type record type character
+      \param level log level
+      \param color color id
+      \param values array of values
+      \param n the number of values
+      \param text text string or null
+    */
+    void addBinary( std::string & buf,
+                    const char type,
+                    const boost::int32_t level,
+                    const boost::uint16_t color,
+                    const double * values,
+                    const int n,
+                    const char * text = 0 );
+
+public:
+
     /*!
       \brief add free message to buffer with cycle, level & message tag 'T'
       \param level debug flag level
@@ -91,7 +91,7 @@ BallMessageParser::parse( const int sender ,
     Vector2D ball_pos;
     Vector2D ball_vel;
 
-    if ( ! AudioCodec::i().decodeStr5ToPosVel( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStr5ToPosVel( msg,
                                                &ball_pos, &ball_vel ) )
     {
         std::cerr << "***ERROR*** BallMessageParser::parse()"
@@ -159,7 +159,7 @@ PassMessageParser::parse( const int sender,
     int receiver_number = 0;
     Vector2D receive_pos;
 
-    if ( ! AudioCodec::i().decodeStr4ToUnumPos( std::string( msg, 4 ),
+    if ( ! AudioCodec::i().decodeStr4ToUnumPos( msg,
                                                 &receiver_number,
                                                 &receive_pos ) )
     {
@@ -176,7 +176,7 @@ PassMessageParser::parse( const int sender,
     Vector2D ball_pos;
     Vector2D ball_vel;
 
-    if ( ! AudioCodec::i().decodeStr5ToPosVel( std::string( msg, 5 ),
+    if ( ! AudioCodec::i().decodeStr5ToPosVel( msg,
                                                &ball_pos, &ball_vel ) )
     {
         std::cerr << "***ERROR*** PassMessageParser::parse()"
@@ -246,11 +246,9 @@ InterceptMessageParser::parse( const int sender,
     }
     ++msg;
 
-    AudioCodec::CharToIntCont::const_iterator unum_it
-        = AudioCodec::i().charToIntMap().find( *msg );
-    if ( unum_it == AudioCodec::i().charToIntMap().end()
-         || unum_it->second <= 0
-         || MAX_PLAYER*2 < unum_it->second )
+    const int unum = AudioCodec::i().charToInt( *msg );
+    if ( unum <= 0
+         || MAX_PLAYER*2 < unum )
     {
         std::cerr << "InterceptMessageParser::parse() "
                   << " Illegal player number. message = [" << msg << "]"
@@ -262,9 +260,8 @@ InterceptMessageParser::parse( const int sender,
     }
     ++msg;
 
-    AudioCodec::CharToIntCont::const_iterator cycle
-        = AudioCodec::i().charToIntMap().find( *msg );
-    if ( cycle == AudioCodec::i().charToIntMap().end() )
+    const int cycle = AudioCodec::i().charToInt( *msg );
+    if ( cycle < 0 )
     {
         std::cerr << "InterceptMessageParser::parse() "
                   << " Illegal cycle. message = [" << msg << "]"
@@ -277,9 +274,9 @@ InterceptMessageParser::parse( const int sender,
 
     dlog.addText( Logger::SENSOR,
                   "InterceptMessageParser: success! number=%d cycle=%d",
-                  unum_it->second, cycle->second );
+                  unum, cycle );
 
-    M_memory->setIntercept( sender, unum_it->second, cycle->second, current );
+    M_memory->setIntercept( sender, unum, cycle, current );
 
     return slength();
 }
@@ -327,7 +324,7 @@ GoalieMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "GoalieMessageParser::parse()"
@@ -422,7 +419,7 @@ GoalieAndPlayerMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "Goalie1PlayerMessageParser::parse()"
@@ -677,7 +674,7 @@ PassRequestMessageParser::parse( const int sender,
 
     Vector2D pos;
 
-    if ( ! AudioCodec::i().decodeStr3ToPos( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStr3ToPos( msg,
                                             &pos ) )
     {
         std::cerr << "PassRequestMessage::parse()"
@@ -870,7 +867,7 @@ DribbleMessageParser::parse( const int sender,
 
     boost::int64_t ival = 0;
 
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "DribbleMessageParser::parse()"
@@ -947,7 +944,7 @@ BallGoalieMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "BallGoalieMessageParser::parse()"
@@ -1053,7 +1050,7 @@ OnePlayerMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "OnePlayerMessageParser::parse()"
@@ -1140,7 +1137,7 @@ TwoPlayerMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "TwoPlayerMessageParser::parse()"
@@ -1249,7 +1246,7 @@ ThreePlayerMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "ThreePlayerMessageParser::parse()"
@@ -1371,7 +1368,7 @@ SelfMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "SelfMessageParser::parse()"
@@ -1467,7 +1464,7 @@ TeammateMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "TeammateMessageParser::parse()"
@@ -1561,7 +1558,7 @@ OpponentMessageParser::parse( const int sender,
     ++msg;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, slength() - 1,
                                              &ival ) )
     {
         std::cerr << "OpponentMessageParser::parse()"
@@ -1652,7 +1649,7 @@ BallPlayerMessageParser::parse( const int sender,
     Vector2D ball_pos;
     Vector2D ball_vel;
 
-    if ( ! AudioCodec::i().decodeStr5ToPosVel( std::string( msg, 5 ),
+    if ( ! AudioCodec::i().decodeStr5ToPosVel( msg,
                                                &ball_pos, &ball_vel ) )
     {
         std::cerr << "***ERROR*** BallPlayerMessageParser::parse()"
@@ -1666,7 +1663,7 @@ BallPlayerMessageParser::parse( const int sender,
     msg += 5;
 
     boost::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, 4 ),
+    if ( ! AudioCodec::i().decodeStrToInt64( msg, 4,
                                              &ival ) )
     {
         std::cerr << "BallPlayerMessageParser::parse()"
@@ -49,6 +49,7 @@ class CmdLineParser;
  */
 class SoccerAgent {
 public:
+    friend class AgentHost;
     friend class BasicClient;
 
 protected:
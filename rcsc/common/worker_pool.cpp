@@ -0,0 +1,248 @@
+// -*-c++-*-
+
+/*!
+  \file worker_pool.cpp
+  \brief fixed size worker thread pool Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "worker_pool.h"
+
+#include <vector>
+#include <iostream>
+
+#include <pthread.h>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct WorkerPool::Impl
+  \brief shared state between the caller and the worker threads.
+*/
+struct WorkerPool::Impl {
+
+    std::vector< pthread_t > threads_; //!< worker threads
+
+    pthread_mutex_t mutex_; //!< protects all variables below
+    pthread_cond_t start_cond_; //!< signaled when a new batch is posted
+    pthread_cond_t done_cond_; //!< signaled when the last task is finished
+
+    Task task_; //!< current task function
+    void * data_; //!< current user data
+    int n_tasks_; //!< the number of tasks in the current batch
+    int next_index_; //!< the next task index to be executed
+    int n_done_; //!< the number of finished tasks in the current batch
+    unsigned long generation_; //!< batch counter
+    bool stop_; //!< termination flag
+
+    Impl()
+        : task_( 0 ),
+          data_( 0 ),
+          n_tasks_( 0 ),
+          next_index_( 0 ),
+          n_done_( 0 ),
+          generation_( 0 ),
+          stop_( false )
+      {
+          pthread_mutex_init( &mutex_, 0 );
+          pthread_cond_init( &start_cond_, 0 );
+          pthread_cond_init( &done_cond_, 0 );
+      }
+
+    ~Impl()
+      {
+          pthread_cond_destroy( &done_cond_ );
+          pthread_cond_destroy( &start_cond_ );
+          pthread_mutex_destroy( &mutex_ );
+      }
+
+    /*!
+      \brief execute the remaining tasks of the current batch.
+      mutex_ must be locked by the caller.
+    */
+    void consume()
+      {
+          while ( next_index_ < n_tasks_ )
+          {
+              const int index = next_index_++;
+              Task task = task_;
+              void * data = data_;
+
+              pthread_mutex_unlock( &mutex_ );
+              task( data, index );
+              pthread_mutex_lock( &mutex_ );
+
+              if ( ++n_done_ == n_tasks_ )
+              {
+                  pthread_cond_signal( &done_cond_ );
+              }
+          }
+      }
+
+    static
+    void * thread_main( void * arg );
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void *
+WorkerPool::Impl::thread_main( void * arg )
+{
+    Impl * impl = static_cast< Impl * >( arg );
+
+    pthread_mutex_lock( &impl->mutex_ );
+
+    unsigned long generation = impl->generation_;
+    while ( true )
+    {
+        while ( ! impl->stop_
+                && generation == impl->generation_ )
+        {
+            pthread_cond_wait( &impl->start_cond_, &impl->mutex_ );
+        }
+
+        if ( impl->stop_ )
+        {
+            break;
+        }
+
+        generation = impl->generation_;
+        impl->consume();
+    }
+
+    pthread_mutex_unlock( &impl->mutex_ );
+    return static_cast< void * >( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorkerPool::WorkerPool( const int n_threads )
+    : M_impl( new Impl() )
+{
+    for ( int i = 1; i < n_threads; ++i )
+    {
+        pthread_t th;
+        if ( pthread_create( &th, 0, &Impl::thread_main, M_impl.get() ) != 0 )
+        {
+            std::cerr << "(WorkerPool) could not create a worker thread. "
+                      << M_impl->threads_.size() + 1 << " threads are used."
+                      << std::endl;
+            break;
+        }
+        M_impl->threads_.push_back( th );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorkerPool::~WorkerPool()
+{
+    pthread_mutex_lock( &M_impl->mutex_ );
+    M_impl->stop_ = true;
+    pthread_cond_broadcast( &M_impl->start_cond_ );
+    pthread_mutex_unlock( &M_impl->mutex_ );
+
+    for ( std::vector< pthread_t >::iterator it = M_impl->threads_.begin(), end = M_impl->threads_.end();
+          it != end;
+          ++it )
+    {
+        pthread_join( *it, 0 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+WorkerPool::size() const
+{
+    return static_cast< int >( M_impl->threads_.size() ) + 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorkerPool::run( Task task,
+                 void * data,
+                 const int n_tasks )
+{
+    if ( n_tasks <= 0 )
+    {
+        return;
+    }
+
+    if ( M_impl->threads_.empty()
+         || n_tasks == 1 )
+    {
+        for ( int i = 0; i < n_tasks; ++i )
+        {
+            task( data, i );
+        }
+        return;
+    }
+
+    pthread_mutex_lock( &M_impl->mutex_ );
+
+    M_impl->task_ = task;
+    M_impl->data_ = data;
+    M_impl->n_tasks_ = n_tasks;
+    M_impl->next_index_ = 0;
+    M_impl->n_done_ = 0;
+    ++M_impl->generation_;
+    pthread_cond_broadcast( &M_impl->start_cond_ );
+
+    // the calling thread also executes tasks.
+    M_impl->consume();
+
+    while ( M_impl->n_done_ < M_impl->n_tasks_ )
+    {
+        pthread_cond_wait( &M_impl->done_cond_, &M_impl->mutex_ );
+    }
+
+    M_impl->task_ = 0;
+    M_impl->data_ = 0;
+    M_impl->n_tasks_ = 0;
+    M_impl->next_index_ = 0;
+    M_impl->n_done_ = 0;
+
+    pthread_mutex_unlock( &M_impl->mutex_ );
+}
+
+}
@@ -0,0 +1,105 @@
+// -*-c++-*-
+
+/*!
+  \file worker_pool.h
+  \brief fixed size worker thread pool Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_WORKER_POOL_H
+#define RCSC_COMMON_WORKER_POOL_H
+
+#include <boost/scoped_ptr.hpp>
+
+namespace rcsc {
+
+/*!
+  \class WorkerPool
+  \brief fixed size thread pool that runs a batch of indexed tasks.
+
+  run() distributes the task indices over the worker threads and the
+  calling thread, and blocks until all tasks are finished. Each task
+  should write its result into its own slot so that the caller can
+  merge the results in a deterministic order.
+*/
+class WorkerPool {
+public:
+
+    /*!
+      \brief task function type.
+      The first argument is the user data, the second is the task index.
+    */
+    typedef void (*Task)( void * data,
+                          const int index );
+
+private:
+
+    struct Impl; //!< pimpl idiom
+
+    //! implementation
+    boost::scoped_ptr< Impl > M_impl;
+
+    // not used
+    WorkerPool();
+    WorkerPool( const WorkerPool & );
+    WorkerPool & operator=( const WorkerPool & );
+
+public:
+
+    /*!
+      \brief create worker threads.
+      \param n_threads the number of threads including the calling thread.
+      if less than 2, all tasks are executed by the calling thread.
+    */
+    explicit
+    WorkerPool( const int n_threads );
+
+    /*!
+      \brief stop and join all worker threads
+    */
+    ~WorkerPool();
+
+    /*!
+      \brief get the number of threads including the calling thread
+      \return the number of threads
+    */
+    int size() const;
+
+    /*!
+      \brief execute task( data, i ) for all i in [0, n_tasks), and wait for them.
+      \param task task function
+      \param data user data passed to the task function
+      \param n_tasks the number of tasks
+    */
+    void run( Task task,
+              void * data,
+              const int n_tasks );
+
+};
+
+}
+
+#endif
@@ -0,0 +1,490 @@
+// -*-c++-*-
+
+/*!
+  \file formation_grid.cpp
+  \brief baked formation grid Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_grid.h"
+
+#include <rcsc/formation/formation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+//! file identifier
+const char MAGIC[4] = { 'F', 'G', 'R', 'D' };
+
+//! file format version
+const unsigned int FILE_VERSION = 1;
+
+//! the maximum number of nodes, guard against broken files
+const unsigned int MAX_NODES = 4096 * 4096;
+
+//! the number of values in one node
+const std::size_t NODE_SIZE = 22;
+
+/*-------------------------------------------------------------------*/
+/*!
+  write the value in little endian
+*/
+void
+write_u32( std::ostream & os,
+           const unsigned int value )
+{
+    char buf[4];
+    buf[0] = static_cast< char >( value & 0xff );
+    buf[1] = static_cast< char >( ( value >> 8 ) & 0xff );
+    buf[2] = static_cast< char >( ( value >> 16 ) & 0xff );
+    buf[3] = static_cast< char >( ( value >> 24 ) & 0xff );
+    os.write( buf, 4 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+read_u32( std::istream & is,
+          unsigned int * value )
+{
+    unsigned char buf[4];
+    if ( ! is.read( reinterpret_cast< char * >( buf ), 4 ) )
+    {
+        return false;
+    }
+    *value = ( static_cast< unsigned int >( buf[0] )
+               | ( static_cast< unsigned int >( buf[1] ) << 8 )
+               | ( static_cast< unsigned int >( buf[2] ) << 16 )
+               | ( static_cast< unsigned int >( buf[3] ) << 24 ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+write_float( std::ostream & os,
+             const float value )
+{
+    unsigned int bits;
+    std::memcpy( &bits, &value, 4 );
+    write_u32( os, bits );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+read_float( std::istream & is,
+            float * value )
+{
+    unsigned int bits;
+    if ( ! read_u32( is, &bits ) )
+    {
+        return false;
+    }
+    std::memcpy( value, &bits, 4 );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+write_string( std::ostream & os,
+              const std::string & str )
+{
+    write_u32( os, static_cast< unsigned int >( str.length() ) );
+    os.write( str.data(), str.length() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+read_string( std::istream & is,
+             std::string * str )
+{
+    unsigned int len;
+    if ( ! read_u32( is, &len )
+         || len > 1024 )
+    {
+        return false;
+    }
+    str->resize( len );
+    return ( len == 0
+             || is.read( &(*str)[0], len ) );
+}
+
+}
+
+namespace rcsc {
+
+const double FormationGrid::DEFAULT_STEP = 1.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormationGrid::FormationGrid()
+    : M_area( default_area() ),
+      M_columns( 0 ),
+      M_rows( 0 ),
+      M_inv_step_x( 0.0 ),
+      M_inv_step_y( 0.0 )
+{
+    for ( int i = 0; i < 11; ++i )
+    {
+        M_symmetry_number[i] = -1;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Rect2D
+FormationGrid::default_area()
+{
+    return Rect2D( Vector2D( -52.5, -34.0 ), Vector2D( 52.5, 34.0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FormationGrid::build( const Formation & formation,
+                      const Rect2D & area,
+                      const double step )
+{
+    if ( area.size().length() <= 0.0
+         || area.size().width() <= 0.0
+         || step <= 0.0 )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " *** ERROR *** illegal grid area or step."
+                  << std::endl;
+        return false;
+    }
+
+    const int columns = static_cast< int >( std::ceil( area.size().length() / step - 1.0e-6 ) ) + 1;
+    const int rows = static_cast< int >( std::ceil( area.size().width() / step - 1.0e-6 ) ) + 1;
+
+    if ( static_cast< double >( columns ) * rows > MAX_NODES )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " *** ERROR *** too small grid step " << step
+                  << std::endl;
+        return false;
+    }
+
+    M_method_name = formation.methodName();
+    for ( int unum = 1; unum <= 11; ++unum )
+    {
+        M_role_name[unum - 1] = formation.getRoleName( unum );
+        M_symmetry_number[unum - 1] = formation.getSymmetryNumber( unum );
+    }
+
+    M_area = area;
+    M_columns = columns;
+    M_rows = rows;
+    M_inv_step_x = ( columns - 1 ) / area.size().length();
+    M_inv_step_y = ( rows - 1 ) / area.size().width();
+
+    M_positions.resize( NODE_SIZE * columns * rows );
+
+    const double step_x = area.size().length() / ( columns - 1 );
+    const double step_y = area.size().width() / ( rows - 1 );
+
+    std::vector< Vector2D > positions;
+    positions.reserve( 11 );
+
+    std::vector< float >::iterator it = M_positions.begin();
+    for ( int j = 0; j < rows; ++j )
+    {
+        const double y = ( j == rows - 1 ? area.bottom() : area.top() + step_y * j );
+        for ( int i = 0; i < columns; ++i )
+        {
+            const double x = ( i == columns - 1 ? area.right() : area.left() + step_x * i );
+
+            formation.getPositions( Vector2D( x, y ), positions );
+            for ( int p = 0; p < 11; ++p )
+            {
+                if ( p >= static_cast< int >( positions.size() )
+                     || ! positions[p].isValid() )
+                {
+                    std::cerr << __FILE__ << ":" << __LINE__
+                              << " *** ERROR *** no position for player " << p + 1
+                              << " at " << Vector2D( x, y )
+                              << std::endl;
+                    M_positions.clear();
+                    return false;
+                }
+                *it++ = static_cast< float >( positions[p].x );
+                *it++ = static_cast< float >( positions[p].y );
+            }
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FormationGrid::read( std::istream & is )
+{
+    char magic[4];
+    unsigned int version = 0;
+    if ( ! is.read( magic, 4 )
+         || std::memcmp( magic, MAGIC, 4 ) != 0
+         || ! read_u32( is, &version )
+         || version != FILE_VERSION )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " *** ERROR *** unsupported formation grid format."
+                  << std::endl;
+        return false;
+    }
+
+    std::string method_name;
+    std::string role_name[11];
+    int symmetry_number[11];
+    float min_x, min_y, max_x, max_y;
+    unsigned int columns, rows;
+
+    bool result = read_string( is, &method_name );
+    for ( int i = 0; result && i < 11; ++i )
+    {
+        unsigned int value = 0;
+        result = ( read_string( is, &role_name[i] )
+                   && read_u32( is, &value ) );
+        symmetry_number[i] = static_cast< int >( value );
+    }
+
+    result = ( result
+               && read_float( is, &min_x )
+               && read_float( is, &min_y )
+               && read_float( is, &max_x )
+               && read_float( is, &max_y )
+               && read_u32( is, &columns )
+               && read_u32( is, &rows ) );
+
+    if ( ! result
+         || ! ( min_x < max_x )
+         || ! ( min_y < max_y )
+         || columns < 2
+         || rows < 2
+         || static_cast< double >( columns ) * rows > MAX_NODES )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " *** ERROR *** illegal formation grid header."
+                  << std::endl;
+        return false;
+    }
+
+    std::vector< float > positions( NODE_SIZE * columns * rows );
+    for ( std::vector< float >::iterator it = positions.begin(), end = positions.end();
+          it != end;
+          ++it )
+    {
+        if ( ! read_float( is, &(*it) ) )
+        {
+            std::cerr << __FILE__ << ":" << __LINE__
+                      << " *** ERROR *** formation grid data is too short."
+                      << std::endl;
+            return false;
+        }
+    }
+
+    M_method_name = method_name;
+    for ( int i = 0; i < 11; ++i )
+    {
+        M_role_name[i] = role_name[i];
+        M_symmetry_number[i] = symmetry_number[i];
+    }
+    M_area = Rect2D( Vector2D( min_x, min_y ), Vector2D( max_x, max_y ) );
+    M_columns = static_cast< int >( columns );
+    M_rows = static_cast< int >( rows );
+    M_inv_step_x = ( M_columns - 1 ) / M_area.size().length();
+    M_inv_step_y = ( M_rows - 1 ) / M_area.size().width();
+    M_positions.swap( positions );
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FormationGrid::write( std::ostream & os ) const
+{
+    if ( empty() )
+    {
+        return false;
+    }
+
+    os.write( MAGIC, 4 );
+    write_u32( os, FILE_VERSION );
+
+    write_string( os, M_method_name );
+    for ( int i = 0; i < 11; ++i )
+    {
+        write_string( os, M_role_name[i] );
+        write_u32( os, static_cast< unsigned int >( M_symmetry_number[i] ) );
+    }
+
+    write_float( os, static_cast< float >( M_area.left() ) );
+    write_float( os, static_cast< float >( M_area.top() ) );
+    write_float( os, static_cast< float >( M_area.right() ) );
+    write_float( os, static_cast< float >( M_area.bottom() ) );
+    write_u32( os, static_cast< unsigned int >( M_columns ) );
+    write_u32( os, static_cast< unsigned int >( M_rows ) );
+
+    for ( std::vector< float >::const_iterator it = M_positions.begin(), end = M_positions.end();
+          it != end;
+          ++it )
+    {
+        write_float( os, *it );
+    }
+
+    return static_cast< bool >( os );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+FormationGrid::locate( const Vector2D & focus_point,
+                       double * tx,
+                       double * ty ) const
+{
+    double fx = ( focus_point.x - M_area.left() ) * M_inv_step_x;
+    double fy = ( focus_point.y - M_area.top() ) * M_inv_step_y;
+
+    // also handles NaN
+    if ( ! ( fx > 0.0 ) ) fx = 0.0;
+    if ( ! ( fy > 0.0 ) ) fy = 0.0;
+
+    const int ix = std::min( static_cast< int >( std::min( fx, static_cast< double >( M_columns ) ) ), M_columns - 2 );
+    const int iy = std::min( static_cast< int >( std::min( fy, static_cast< double >( M_rows ) ) ), M_rows - 2 );
+
+    *tx = std::min( 1.0, fx - ix );
+    *ty = std::min( 1.0, fy - iy );
+
+    return NODE_SIZE * ( static_cast< std::size_t >( iy ) * M_columns + ix );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+FormationGrid::getPosition( const int unum,
+                            const Vector2D & focus_point ) const
+{
+    if ( unum < 1 || 11 < unum
+         || empty() )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << " *** ERROR *** invalid unum " << unum
+                  << " or empty grid."
+                  << std::endl;
+        return Vector2D::INVALIDATED;
+    }
+
+    double tx, ty;
+    const std::size_t idx = locate( focus_point, &tx, &ty ) + 2 * ( unum - 1 );
+
+    const float * p00 = &M_positions[idx];
+    const float * p10 = p00 + NODE_SIZE;
+    const float * p01 = p00 + NODE_SIZE * M_columns;
+    const float * p11 = p01 + NODE_SIZE;
+
+    const double w00 = ( 1.0 - tx ) * ( 1.0 - ty );
+    const double w10 = tx * ( 1.0 - ty );
+    const double w01 = ( 1.0 - tx ) * ty;
+    const double w11 = tx * ty;
+
+    return Vector2D( w00 * p00[0] + w10 * p10[0] + w01 * p01[0] + w11 * p11[0],
+                     w00 * p00[1] + w10 * p10[1] + w01 * p01[1] + w11 * p11[1] );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FormationGrid::getPositions( const Vector2D & focus_point,
+                             std::vector< Vector2D > & positions ) const
+{
+    positions.clear();
+
+    if ( empty() )
+    {
+        return;
+    }
+
+    double tx, ty;
+    const std::size_t idx = locate( focus_point, &tx, &ty );
+
+    const float * p00 = &M_positions[idx];
+    const float * p10 = p00 + NODE_SIZE;
+    const float * p01 = p00 + NODE_SIZE * M_columns;
+    const float * p11 = p01 + NODE_SIZE;
+
+    const double w00 = ( 1.0 - tx ) * ( 1.0 - ty );
+    const double w10 = tx * ( 1.0 - ty );
+    const double w01 = ( 1.0 - tx ) * ty;
+    const double w11 = tx * ty;
+
+    positions.reserve( 11 );
+    for ( std::size_t i = 0; i < NODE_SIZE; i += 2 )
+    {
+        positions.push_back( Vector2D( w00 * p00[i] + w10 * p10[i] + w01 * p01[i] + w11 * p11[i],
+                                       w00 * p00[i+1] + w10 * p10[i+1] + w01 * p01[i+1] + w11 * p11[i+1] ) );
+    }
+}
+
+}
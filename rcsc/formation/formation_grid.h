@@ -0,0 +1,237 @@
+// -*-c++-*-
+
+/*!
+  \file formation_grid.h
+  \brief baked formation grid Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_FORMATION_FORMATION_GRID_H
+#define RCSC_FORMATION_FORMATION_GRID_H
+
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+
+class Formation;
+
+/*!
+  \class FormationGrid
+  \brief precomputed positions of a trained formation.
+
+  All players' positions are sampled on the grid nodes over the
+  focus point area, and the position for any focus point is given by
+  the bilinear interpolation of the four surrounding nodes.
+  The focus point outside the area is moved to the nearest point in
+  the area. The grid can be saved to a compact binary file and loaded
+  at startup instead of the source formation.
+*/
+class FormationGrid {
+public:
+
+    typedef boost::shared_ptr< FormationGrid > Ptr; //<! pointer type
+    typedef boost::shared_ptr< const FormationGrid > ConstPtr; //<! const pointer type
+
+    //! default grid interval
+    static const double DEFAULT_STEP;
+
+private:
+
+    //! the method name of the source formation
+    std::string M_method_name;
+
+    //! players' role names
+    std::string M_role_name[11];
+
+    //! players' symmetry numbers
+    int M_symmetry_number[11];
+
+    //! the focus point area covered by the grid
+    Rect2D M_area;
+
+    //! the number of nodes along x
+    int M_columns;
+
+    //! the number of nodes along y
+    int M_rows;
+
+    //! reciprocal of the x interval
+    double M_inv_step_x;
+
+    //! reciprocal of the y interval
+    double M_inv_step_y;
+
+    //! (x, y) of 11 players for each node. the node (i, j) starts at 22 * ( j * columns + i )
+    std::vector< float > M_positions;
+
+public:
+
+    /*!
+      \brief create an empty grid
+     */
+    FormationGrid();
+
+    /*!
+      \brief get the default area, the whole pitch
+      \return area rectangle
+     */
+    static
+    Rect2D default_area();
+
+    /*!
+      \brief sample the positions of the trained formation
+      \param formation source formation
+      \param area the focus point area
+      \param step the maximum grid interval
+      \return true if successfully created
+     */
+    bool build( const Formation & formation,
+                const Rect2D & area = default_area(),
+                const double step = DEFAULT_STEP );
+
+    /*!
+      \brief read the grid from the binary input stream
+      \param is reference to the input stream
+      \return true if successfully read
+     */
+    bool read( std::istream & is );
+
+    /*!
+      \brief write the grid to the binary output stream
+      \param os reference to the output stream
+      \return true if successfully written
+     */
+    bool write( std::ostream & os ) const;
+
+    /*!
+      \brief check if the grid has data
+      \return true if no data
+     */
+    bool empty() const
+      {
+          return M_positions.empty();
+      }
+
+    /*!
+      \brief get the method name of the source formation
+      \return method name string
+     */
+    const std::string & methodName() const
+      {
+          return M_method_name;
+      }
+
+    /*!
+      \brief get the focus point area
+      \return area rectangle
+     */
+    const Rect2D & area() const
+      {
+          return M_area;
+      }
+
+    /*!
+      \brief get the number of nodes along x
+      \return the number of columns
+     */
+    int columns() const
+      {
+          return M_columns;
+      }
+
+    /*!
+      \brief get the number of nodes along y
+      \return the number of rows
+     */
+    int rows() const
+      {
+          return M_rows;
+      }
+
+    /*!
+      \brief get the role name of the specified player
+      \param unum player number
+      \return role name string
+     */
+    std::string getRoleName( const int unum ) const
+      {
+          if ( unum < 1 || 11 < unum ) return std::string();
+          return M_role_name[unum - 1];
+      }
+
+    /*!
+      \brief get symmetry reference number of the specified player.
+      \param unum player number
+      \return symmetry number of the source formation
+     */
+    int getSymmetryNumber( const int unum ) const
+      {
+          if ( unum < 1 || 11 < unum ) return 0;
+          return M_symmetry_number[unum - 1];
+      }
+
+    /*!
+      \brief get position for the current focus point
+      \param unum player number
+      \param focus_point current focus point, usually ball position.
+      \return interpolated position
+     */
+    Vector2D getPosition( const int unum,
+                          const Vector2D & focus_point ) const;
+
+    /*!
+      \brief get all positions for the current focus point
+      \param focus_point current focus point, usually ball position
+      \param positions contaner to store the result
+     */
+    void getPositions( const Vector2D & focus_point,
+                       std::vector< Vector2D > & positions ) const;
+
+private:
+
+    /*!
+      \brief get the top-left node and the interpolation weights
+      \param focus_point focus point
+      \param tx result x weight of the right nodes
+      \param ty result y weight of the bottom nodes
+      \return index of the first value of the top-left node
+     */
+    std::size_t locate( const Vector2D & focus_point,
+                        double * tx,
+                        double * ty ) const;
+
+};
+
+}
+
+#endif
@@ -38,6 +38,7 @@
 #include <rcsc/math_util.h>
 
 #include <algorithm>
+#include <limits>
 #include <cstdio>
 
 namespace rcsc {
@@ -45,6 +46,7 @@ namespace rcsc {
 using namespace formation;
 
 const std::string FormationKNN::NAME( "k-NN" );
+const size_t FormationKNN::MAX_K;
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -53,6 +55,8 @@ const std::string FormationKNN::NAME( "k-NN" );
 FormationKNN::FormationKNN()
     : Formation()
     , M_k( 3 )
+    , M_tree_samples( static_cast< const SampleDataSet * >( 0 ) )
+    , M_tree_modified_count( 0 )
 {
     for ( int i = 0; i < 11; ++i )
     {
@@ -271,36 +275,185 @@ FormationKNN::createNewRole( const int unum,
 
 /*-------------------------------------------------------------------*/
 
+namespace {
+
 /*!
-  \class DataCmp
-  \brief data compare function object
+  \struct Neighbors
+  \brief fixed size container of the nearest samples sorted by distance
  */
-class DataCmp {
-private:
-    const Vector2D M_point; //!< center point
-public:
+struct Neighbors {
+    const SampleData * data_[FormationKNN::MAX_K]; //!< nearest samples
+    double dist2_[FormationKNN::MAX_K]; //!< squared distance to each sample
+    size_t size_; //!< the number of stored samples
+    size_t k_; //!< the number of samples to be stored
 
     /*!
-      \brief construct with center point
-      \param point center point
+      \brief create an empty container
+      \param k the number of samples to be stored
      */
-    DataCmp( const Vector2D & point )
-        : M_point( point )
+    explicit
+    Neighbors( const size_t k )
+        : size_( 0 ),
+          k_( k )
       { }
 
     /*!
-      \brief operator function
-      \param lhs left hand side object
-      \param rhs right hand side object
-      \return true if lhs data point is closer than rhs data point
+      \brief get the current search radius
+      \return squared distance to the k-th sample, or a huge value if not full
+     */
+    double worst() const
+      {
+          return ( size_ < k_ ? std::numeric_limits< double >::max() : dist2_[size_ - 1] );
+      }
+
+    /*!
+      \brief insert the sample if it is nearer than the k-th sample
+      \param data sample data
+      \param d2 squared distance to the focus point
      */
+    void insert( const SampleData * data,
+                 const double & d2 )
+      {
+          if ( d2 >= worst() )
+          {
+              return;
+          }
+
+          size_t i = ( size_ < k_ ? size_++ : size_ - 1 );
+          while ( i > 0 && dist2_[i - 1] > d2 )
+          {
+              data_[i] = data_[i - 1];
+              dist2_[i] = dist2_[i - 1];
+              --i;
+          }
+          data_[i] = data;
+          dist2_[i] = d2;
+      }
+};
+
+/*!
+  \brief compare the ball position by the axis
+ */
+struct AxisCmp {
+    const int axis_; //!< 0: x, 1: y
+
+    explicit
+    AxisCmp( const int axis )
+        : axis_( axis )
+      { }
+
     bool operator()( const SampleData * lhs,
-                     const SampleData * rhs )
+                     const SampleData * rhs ) const
       {
-          return lhs->ball_.dist2( M_point ) < rhs->ball_.dist2( M_point );
+          return ( axis_ == 0
+                   ? lhs->ball_.x < rhs->ball_.x
+                   : lhs->ball_.y < rhs->ball_.y );
       }
 };
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief build the implicit k-d tree. the median of the range is the node.
+ */
+void
+build_tree( std::vector< const SampleData * >::iterator first,
+            std::vector< const SampleData * >::iterator last,
+            const int depth )
+{
+    if ( last - first <= 1 )
+    {
+        return;
+    }
+
+    std::vector< const SampleData * >::iterator mid = first + ( last - first ) / 2;
+    std::nth_element( first, mid, last, AxisCmp( depth % 2 ) );
+
+    build_tree( first, mid, depth + 1 );
+    build_tree( mid + 1, last, depth + 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief search the nearest samples in the k-d tree
+ */
+void
+search_tree( const SampleData * const * first,
+             const SampleData * const * last,
+             const int depth,
+             const Vector2D & point,
+             Neighbors & result )
+{
+    if ( first >= last )
+    {
+        return;
+    }
+
+    const SampleData * const * mid = first + ( last - first ) / 2;
+    const Vector2D & pos = (*mid)->ball_;
+
+    result.insert( *mid, pos.dist2( point ) );
+
+    const double diff = ( depth % 2 == 0
+                          ? point.x - pos.x
+                          : point.y - pos.y );
+
+    // search the near side first, then the far side if it may contain nearer samples.
+    if ( diff < 0.0 )
+    {
+        search_tree( first, mid, depth + 1, point, result );
+        if ( diff * diff < result.worst() )
+        {
+            search_tree( mid + 1, last, depth + 1, point, result );
+        }
+    }
+    else
+    {
+        search_tree( mid + 1, last, depth + 1, point, result );
+        if ( diff * diff < result.worst() )
+        {
+            search_tree( first, mid, depth + 1, point, result );
+        }
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+size_t
+FormationKNN::findNearestSamples( const Vector2D & focus_point,
+                                  const SampleData ** samples,
+                                  double * dist2 ) const
+{
+    Neighbors result( std::min( M_k, MAX_K ) );
+
+    if ( M_tree_samples == M_samples.get()
+         && M_tree_modified_count == M_samples->modifiedCount() )
+    {
+        if ( ! M_tree.empty() )
+        {
+            search_tree( &M_tree[0], &M_tree[0] + M_tree.size(), 0, focus_point, result );
+        }
+    }
+    else
+    {
+        // the index is not built for the current samples,
+        // or the samples have been edited since train() was called.
+        const SampleDataSet::DataCont::const_iterator d_end = M_samples->dataCont().end();
+        for ( SampleDataSet::DataCont::const_iterator d = M_samples->dataCont().begin();
+              d != d_end;
+              ++d )
+        {
+            result.insert( &(*d), d->ball_.dist2( focus_point ) );
+        }
+    }
+
+    std::copy( result.data_, result.data_ + result.size_, samples );
+    std::copy( result.dist2_, result.dist2_ + result.size_, dist2 );
+    return result.size_;
+}
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -310,8 +463,6 @@ Vector2D
 FormationKNN::getPosition( const int unum,
                            const Vector2D & focus_point ) const
 {
-    static std::vector< const SampleData * > ptr_vector;
-
     if ( unum < 1 || 11 < unum )
     {
         std::cerr << __FILE__ << ":" << __LINE__
@@ -320,39 +471,25 @@ FormationKNN::getPosition( const int unum,
         return Vector2D::INVALIDATED;
     }
 
-    if ( M_samples->dataCont().empty() )
+    if ( ! M_samples
+         || M_samples->dataCont().empty() )
     {
         return Vector2D( 0.0, 0.0 );
     }
 
-    ptr_vector.reserve( M_samples->dataCont().size() );
-
-    const SampleDataSet::DataCont::const_iterator d_end = M_samples->dataCont().end();
-    for ( SampleDataSet::DataCont::const_iterator d = M_samples->dataCont().begin();
-          d != d_end;
-          ++d )
-    {
-        ptr_vector.push_back( &(*d) );
-    }
-
-    const size_t size = std::min( ptr_vector.size(), M_k );
-
-    std::partial_sort( ptr_vector.begin(),
-                       ptr_vector.begin() + size,
-                       ptr_vector.end(),
-                       DataCmp( focus_point ) );
+    const SampleData * samples[MAX_K];
+    double inv_dist2[MAX_K];
+    const size_t size = findNearestSamples( focus_point, samples, inv_dist2 );
 
-    std::vector< double > inv_dist2( size, 0.0 );
     double sum_inv_dist2 = 0.0;
 
     for ( size_t i = 0; i < size; ++i )
     {
-        double d2 = ptr_vector[i]->ball_.dist2( focus_point );
-        if ( d2 < 1.0e-10 )
+        if ( inv_dist2[i] < 1.0e-10 )
         {
-            return ptr_vector[i]->getPosition( unum );
+            return samples[i]->getPosition( unum );
         }
-        inv_dist2[i] = 1.0 / d2;
+        inv_dist2[i] = 1.0 / inv_dist2[i];
         sum_inv_dist2 += inv_dist2[i];
     }
 
@@ -360,30 +497,32 @@ FormationKNN::getPosition( const int unum,
 
     for ( size_t i = 0; i < size; ++i )
     {
-        pos += ptr_vector[i]->getPosition( unum ) * inv_dist2[i];
+        pos += samples[i]->getPosition( unum ) * inv_dist2[i];
     }
 
     pos /= sum_inv_dist2;
 
-    ptr_vector.clear();
+    return pos;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationKNN::getPositions( const Vector2D & focus_point,
+                            std::vector< Vector2D > & positions ) const
+{
+    positions.clear();
 
-#if 0
-    if ( unum == 11 )
+    if ( ! M_samples
+         || M_samples->dataCont().empty() )
     {
-        std::cerr << "sum_inv_dist2=" << sum_inv_dist2 << '\n';
-        for ( size_t i = 0; i < size; ++i )
-        {
-            std::cerr << "  ball=" << ptr_vector[i]->ball_
-                      << " pos=" << ptr_vector[i]->getPosition( unum )
-                      << " inv_dist2=" << inv_dist2[i]
-                      << " rate=" << ( inv_dist2[i] / sum_inv_dist2 )
-                      << '\n';
-        }
-        std::cerr << "  pos = " << pos << std::endl;
+        return;
     }
-#endif
 
-    return pos;
+    positions.reserve( 11 );
+    appendPositions( focus_point, positions );
 }
 
 /*-------------------------------------------------------------------*/
@@ -391,46 +530,54 @@ FormationKNN::getPosition( const int unum,
 
  */
 void
-FormationKNN::getPositions( const Vector2D & focus_point,
+FormationKNN::getPositions( const std::vector< Vector2D > & focus_points,
                             std::vector< Vector2D > & positions ) const
 {
-    static std::vector< const SampleData * > ptr_vector;
-
     positions.clear();
 
-    ptr_vector.reserve( M_samples->dataCont().size() );
+    if ( ! M_samples
+         || M_samples->dataCont().empty() )
+    {
+        return;
+    }
 
-    const SampleDataSet::DataCont::const_iterator d_end = M_samples->dataCont().end();
-    for ( SampleDataSet::DataCont::const_iterator d = M_samples->dataCont().begin();
-          d != d_end;
-          ++d )
+    positions.reserve( focus_points.size() * 11 );
+
+    const std::vector< Vector2D >::const_iterator end = focus_points.end();
+    for ( std::vector< Vector2D >::const_iterator p = focus_points.begin();
+          p != end;
+          ++p )
     {
-        ptr_vector.push_back( &(*d) );
+        appendPositions( *p, positions );
     }
+}
 
-    const size_t size = std::min( ptr_vector.size(), M_k );
+/*-------------------------------------------------------------------*/
+/*!
 
-    std::partial_sort( ptr_vector.begin(),
-                       ptr_vector.begin() + size,
-                       ptr_vector.end(),
-                       DataCmp( focus_point ) );
+ */
+void
+FormationKNN::appendPositions( const Vector2D & focus_point,
+                               std::vector< Vector2D > & positions ) const
+{
+    const SampleData * samples[MAX_K];
+    double inv_dist2[MAX_K];
+    const size_t size = findNearestSamples( focus_point, samples, inv_dist2 );
 
-    std::vector< double > inv_dist2( size, 0.0 );
     double sum_inv_dist2 = 0.0;
 
     for ( size_t i = 0; i < size; ++i )
     {
-        double d2 = ptr_vector[i]->ball_.dist2( focus_point );
-        if ( d2 < 1.0e-10 )
+        if ( inv_dist2[i] < 1.0e-10 )
         {
             for ( int unum = 1; unum <= 11; ++unum )
             {
-                positions.push_back( ptr_vector[i]->getPosition( unum ) );
+                positions.push_back( samples[i]->getPosition( unum ) );
             }
             return;
         }
 
-        inv_dist2[i] = 1.0 / d2;
+        inv_dist2[i] = 1.0 / inv_dist2[i];
         sum_inv_dist2 += inv_dist2[i];
     }
 
@@ -440,14 +587,12 @@ FormationKNN::getPositions( const Vector2D & focus_point,
 
         for ( size_t i = 0; i < size; ++i )
         {
-            pos += ptr_vector[i]->getPosition( unum ) * inv_dist2[i];
+            pos += samples[i]->getPosition( unum ) * inv_dist2[i];
         }
 
         pos /= sum_inv_dist2;
         positions.push_back( pos );
     }
-
-    ptr_vector.clear();
 }
 
 /*-------------------------------------------------------------------*/
@@ -457,7 +602,28 @@ FormationKNN::getPositions( const Vector2D & focus_point,
 void
 FormationKNN::train()
 {
+    M_tree.clear();
+    M_tree_samples = M_samples.get();
+    M_tree_modified_count = 0;
+
+    if ( ! M_samples )
+    {
+        return;
+    }
+
+    M_tree_modified_count = M_samples->modifiedCount();
 
+    M_tree.reserve( M_samples->dataCont().size() );
+
+    const SampleDataSet::DataCont::const_iterator d_end = M_samples->dataCont().end();
+    for ( SampleDataSet::DataCont::const_iterator d = M_samples->dataCont().begin();
+          d != d_end;
+          ++d )
+    {
+        M_tree.push_back( &(*d) );
+    }
+
+    build_tree( M_tree.begin(), M_tree.end(), 0 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -480,6 +646,8 @@ FormationKNN::readConf( std::istream & is )
         return false;
     }
 
+    train();
+
     return true;
 }
 
@@ -50,6 +50,9 @@ public:
 
     static const std::string NAME; //!< type name
 
+    //! the maximum number of the neighbors used by the interpolation
+    static const size_t MAX_K = 16;
+
 private:
 
     //! parameter for k-nearest neighbor
@@ -61,6 +64,15 @@ private:
     //! data instance container
     std::vector< formation::SampleData > M_data;
 
+    //! k-d tree of the sample ball positions. samples are stored in the tree order.
+    std::vector< const formation::SampleData * > M_tree;
+
+    //! the sample set used to build M_tree
+    const formation::SampleDataSet * M_tree_samples;
+
+    //! the modification counter of M_tree_samples when M_tree was built
+    unsigned long M_tree_modified_count;
+
 public:
     /*!
       \brief just call the base class constructor
@@ -159,11 +171,43 @@ public:
                        std::vector< Vector2D > & positions ) const;
 
     /*!
-      \brief update formation paramter using training data set
+      \brief get all positions for each focus point
+      \param focus_points focus points, usually ball positions
+      \param positions contaner to store the result. 11 positions are
+      stored for each focus point in the order of focus_points.
+     */
+    void getPositions( const std::vector< Vector2D > & focus_points,
+                       std::vector< Vector2D > & positions ) const;
+
+    /*!
+      \brief update formation paramter using training data set.
+      the k-d tree of the sample ball positions is rebuilt.
      */
     virtual
     void train();
 
+private:
+
+    /*!
+      \brief find the k nearest samples of the focus point.
+      if the k-d tree is not built for the current samples, all samples are scanned.
+      \param focus_point focus point
+      \param samples array to store the found samples. the size must be at least MAX_K.
+      \param dist2 array to store the squared distances. the size must be at least MAX_K.
+      \return the number of found samples
+     */
+    size_t findNearestSamples( const Vector2D & focus_point,
+                               const formation::SampleData ** samples,
+                               double * dist2 ) const;
+
+    /*!
+      \brief append all positions for the focus point
+      \param focus_point focus point
+      \param positions contaner to store the result
+     */
+    void appendPositions( const Vector2D & focus_point,
+                          std::vector< Vector2D > & positions ) const;
+
 protected:
 
     /*!
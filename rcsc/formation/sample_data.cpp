@@ -78,7 +78,8 @@ round_coordinates( const double & x,
 
  */
 SampleDataSet::SampleDataSet()
-    : M_data_cont()
+    : M_data_cont(),
+      M_modified_count( 0 )
 {
 
 }
@@ -92,6 +93,7 @@ SampleDataSet::clear()
 {
     M_data_cont.clear();
     M_constraints.clear();
+    ++M_modified_count;
 }
 
 /*-------------------------------------------------------------------*/
@@ -283,6 +285,7 @@ SampleDataSet::addData( const Formation & formation,
     // add data
     //
     M_data_cont.push_back( data );
+    ++M_modified_count;
 
     std::cerr << "Added data. current data size = " << M_data_cont.size()
               << std::endl;
@@ -350,6 +353,7 @@ SampleDataSet::insertData( const Formation & formation,
     std::advance( it, idx );
 
     M_data_cont.insert( it, data );
+    ++M_modified_count;
 
     std::cerr << "Inserted data at index="
               << std::distance( M_data_cont.begin(), it ) + 1
@@ -418,6 +422,7 @@ SampleDataSet::replaceData( const Formation & formation,
 
     SampleData original_data = *replaced;
     *replaced = data;
+    ++M_modified_count;
 
     //
     // check intersection
@@ -510,6 +515,7 @@ SampleDataSet::replaceSymmetryData( const Formation & formation,
 
     SampleData tmp = *replaced;
     *replaced = reversed_data;
+    ++M_modified_count;
 
     //
     // check intersection
@@ -565,6 +571,7 @@ SampleDataSet::removeData( const size_t idx )
     // remove sample
     //
     M_data_cont.erase( it );
+    ++M_modified_count;
 
     //
     updateDataIndex();
@@ -596,6 +603,7 @@ SampleDataSet::changeDataIndex( const size_t old_idx,
     DataCont tmp_list;
     tmp_list.splice( tmp_list.end(), M_data_cont, oit );
     M_data_cont.splice( nit, tmp_list );
+    ++M_modified_count;
 
     updateDataIndex();
 
@@ -901,6 +909,7 @@ SampleDataSet::open( const std::string & filepath )
         std::cerr << "Failed to read the training data file [" << filepath << "]"
                   << std::endl;
         M_data_cont.clear();
+        ++M_modified_count;
         return false;
     }
 
@@ -915,6 +924,7 @@ bool
 SampleDataSet::read( std::istream & is )
 {
     M_data_cont.clear();
+    ++M_modified_count;
 
     //
     // check header line.
@@ -1015,6 +1025,7 @@ SampleDataSet::readOld( std::istream & is )
         }
 
         M_data_cont.push_back( new_data );
+        ++M_modified_count;
     }
 
     return true;
@@ -1182,6 +1193,7 @@ SampleDataSet::readSample( std::istream & is,
     }
 
     M_data_cont.push_back( new_data );
+    ++M_modified_count;
 
     return true;
 }
@@ -134,6 +134,7 @@ private:
 
     DataCont M_data_cont; //!< data container.
     Constraints M_constraints; //!< constraint container.
+    unsigned long M_modified_count; //!< incremented whenever the data container is changed.
 
 public:
 
@@ -147,7 +148,8 @@ public:
       \param other source object.
      */
     SampleDataSet( const SampleDataSet & other )
-        : M_data_cont( other.dataCont() )
+        : M_data_cont( other.dataCont() ),
+          M_modified_count( 0 )
       { }
 
     /*!
@@ -159,6 +161,7 @@ public:
           if ( this != &other )
           {
               M_data_cont = other.dataCont();
+              ++M_modified_count;
           }
           return *this;
       }
@@ -189,6 +192,16 @@ public:
           return M_constraints;
       }
 
+    /*!
+      \brief get the modification counter. the value is changed whenever
+      the data are added, removed, replaced or reordered.
+      \return counter value.
+     */
+    unsigned long modifiedCount() const
+      {
+          return M_modified_count;
+      }
+
     /*!
       \brief get the specified index data.
       \return const pointer to the data. if no matched data, NULL is returned.
@@ -37,6 +37,9 @@
 
 #include <rcsc/geom/triangle_2d.h>
 
+#include <limits>
+#include <cmath>
+
 namespace rcsc {
 
 const double DelaunayTriangulation::EPSILON = 1.0e-10;
@@ -204,6 +207,8 @@ DelaunayTriangulation::clearResults()
 
     M_triangles.clear();
     M_edges.clear();
+
+    clearIndex();
 }
 
 /*-------------------------------------------------------------------*/
@@ -226,6 +231,8 @@ DelaunayTriangulation::addVertex( const double & x,
         }
     }
 
+    clearIndex();
+
     int id = M_vertices.size();
     M_vertices.push_back( Vertex( id, x, y ) );
     return id;
@@ -238,6 +245,8 @@ DelaunayTriangulation::addVertex( const double & x,
 void
 DelaunayTriangulation::addVertices( const std::vector< Vector2D > & v )
 {
+    clearIndex();
+
     M_vertices.reserve( M_vertices.size() + v.size() );
 
     int id = M_vertices.size();
@@ -421,16 +430,98 @@ DelaunayTriangulation::findNearestVertex( const Vector2D & pos ) const
     const Vertex * candidate = static_cast< Vertex * >( 0 );
 
     double min_dist2 = 10000000.0;
-    const VertexCont::const_iterator end = M_vertices.end();
-    for ( VertexCont::const_iterator it = M_vertices.begin();
-          it != end;
-          ++it )
+
+    if ( M_grid_vertex_begin.empty() )
     {
-        double d2 = it->pos().dist2( pos );
-        if ( d2 < min_dist2 )
+        const VertexCont::const_iterator end = M_vertices.end();
+        for ( VertexCont::const_iterator it = M_vertices.begin();
+              it != end;
+              ++it )
         {
-            candidate = &(*it);
-            min_dist2 = d2;
+            double d2 = it->pos().dist2( pos );
+            if ( d2 < min_dist2 )
+            {
+                candidate = &(*it);
+                min_dist2 = d2;
+            }
+        }
+
+        return candidate;
+    }
+
+    //
+    // search the cells in the order of the ring around the cell of pos.
+    // the search is finished when the unvisited cells are farther than the candidate.
+    //
+
+    const int col = gridCol( pos.x );
+    const int row = gridRow( pos.y );
+    const int max_ring = std::max( std::max( col, M_grid_cols - 1 - col ),
+                                   std::max( row, M_grid_rows - 1 - row ) );
+
+    for ( int ring = 0; ring <= max_ring; ++ring )
+    {
+        const int min_c = std::max( 0, col - ring );
+        const int max_c = std::min( M_grid_cols - 1, col + ring );
+        const int min_r = std::max( 0, row - ring );
+        const int max_r = std::min( M_grid_rows - 1, row + ring );
+
+        for ( int r = min_r; r <= max_r; ++r )
+        {
+            const bool edge_row = ( r == row - ring || r == row + ring );
+            for ( int c = min_c; c <= max_c; ++c )
+            {
+                if ( ! edge_row
+                     && c != col - ring
+                     && c != col + ring )
+                {
+                    continue;
+                }
+
+                const std::size_t cell = r * M_grid_cols + c;
+                for ( std::size_t i = M_grid_vertex_begin[cell]; i < M_grid_vertex_begin[cell + 1]; ++i )
+                {
+                    const Vertex & v = M_vertices[M_grid_vertices[i]];
+                    double d2 = v.pos().dist2( pos );
+                    if ( d2 < min_dist2
+                         || ( d2 == min_dist2
+                              && candidate
+                              && v.id() < candidate->id() ) )
+                    {
+                        candidate = &v;
+                        min_dist2 = d2;
+                    }
+                }
+            }
+        }
+
+        if ( ! candidate )
+        {
+            continue;
+        }
+
+        // the distance to the nearest unvisited cell
+        double bound = std::numeric_limits< double >::max();
+        if ( col + ring + 1 < M_grid_cols )
+        {
+            bound = std::min( bound, M_grid_min_x + ( col + ring + 1 ) * M_grid_cell_width - pos.x );
+        }
+        if ( col - ring > 0 )
+        {
+            bound = std::min( bound, pos.x - ( M_grid_min_x + ( col - ring ) * M_grid_cell_width ) );
+        }
+        if ( row + ring + 1 < M_grid_rows )
+        {
+            bound = std::min( bound, M_grid_min_y + ( row + ring + 1 ) * M_grid_cell_height - pos.y );
+        }
+        if ( row - ring > 0 )
+        {
+            bound = std::min( bound, pos.y - ( M_grid_min_y + ( row - ring ) * M_grid_cell_height ) );
+        }
+
+        if ( bound * bound > min_dist2 )
+        {
+            break;
         }
     }
 
@@ -536,6 +627,7 @@ DelaunayTriangulation::compute()
     }
 
     removeInitialVertices();
+    buildIndex();
 #ifdef DEBUG
     std::cout << __FILE__ << ':' << __LINE__
               << " compute() end\n"
@@ -1052,98 +1144,306 @@ DelaunayTriangulation::ContainedType
 DelaunayTriangulation::findTriangleContains( const Vector2D & pos,
                                              TrianglePtr * sol ) const
 {
+    if ( ! M_grid_triangle_begin.empty() )
+    {
+        // all triangles that may contain pos are registered in the cell.
+        if ( pos.x < M_grid_min_x || M_grid_max_x < pos.x
+             || pos.y < M_grid_min_y || M_grid_max_y < pos.y )
+        {
+            return NOT_CONTAINED;
+        }
+
+        const std::size_t cell = gridRow( pos.y ) * M_grid_cols + gridCol( pos.x );
+        for ( std::size_t i = M_grid_triangle_begin[cell]; i < M_grid_triangle_begin[cell + 1]; ++i )
+        {
+            const ContainedType type = containedType( M_grid_triangles[i], pos );
+            if ( type != NOT_CONTAINED )
+            {
+                *sol = M_grid_triangles[i];
+                return type;
+            }
+        }
+
+        return NOT_CONTAINED;
+    }
+
     const TriangleCont::const_iterator end = M_triangles.end();
     for ( TriangleCont::const_iterator it = M_triangles.begin();
           it != end;
           ++it )
     {
-        const TrianglePtr tri = it->second;
+        const ContainedType type = containedType( it->second, pos );
+        if ( type != NOT_CONTAINED )
+        {
+            *sol = it->second;
+            return type;
+        }
+    }
+
+    //std::cout << "findTriangleContains() end not found " << std::endl;
+    return NOT_CONTAINED;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DelaunayTriangulation::ContainedType
+DelaunayTriangulation::containedType( const Triangle * tri,
+                                      const Vector2D & pos )
+{
+    if ( std::fabs( tri->circumcenter().x - pos.x )
+         > tri->circumradius()
+         || std::fabs( tri->circumcenter().y - pos.y )
+         > tri->circumradius() )
+    {
+        // out of circumcircle
+        return NOT_CONTAINED;
+    }
+
+    Vector2D rel0( tri->vertex( 0 )->pos() - pos );
+    Vector2D rel1( tri->vertex( 1 )->pos() - pos );
+    Vector2D rel2( tri->vertex( 2 )->pos() - pos );
 
-        if ( std::fabs( tri->circumcenter().x - pos.x )
-             > tri->circumradius()
-             || std::fabs( tri->circumcenter().y - pos.y )
-             > tri->circumradius() )
+    double outer0 = rel0.outerProduct( rel1 );
+    double outer1 = rel1.outerProduct( rel2 );
+    double outer2 = rel2.outerProduct( rel0 );
+
+    if ( std::fabs( outer0 ) <= EPSILON )
+    {
+        if ( rel0.x * rel1.x > EPSILON
+             || rel0.y * rel1.y > EPSILON )
         {
-            // out of circumcircle
-            continue;
+            // not online
+            return NOT_CONTAINED;
         }
+        //std::cout << "findTriangleContains() found online on 0-1 " << std::endl;
+        return ONLINE;
+    }
 
-        Vector2D rel0( tri->vertex( 0 )->pos() - pos );
-        Vector2D rel1( tri->vertex( 1 )->pos() - pos );
-        Vector2D rel2( tri->vertex( 2 )->pos() - pos );
-
-        double outer0 = rel0.outerProduct( rel1 );
-        double outer1 = rel1.outerProduct( rel2 );
-        double outer2 = rel2.outerProduct( rel0 );
-
-        //std::cout << "findTriangleContains() found online\n"
-        //          << " tri0 = " << tri->vertex( 0 )->pos()
-        //          << " tri0 = " << tri->vertex( 1 )->pos()
-        //          << " tri0 = " << tri->vertex( 2 )->pos()
-        //          << "\n  outer0 = " << outer0
-        //          << "  outer1 = " << outer1
-        //          << "  outer2 = " << outer2
-        //          << std::endl;
+    if ( std::fabs( outer1 ) <= EPSILON )
+    {
+        if ( rel1.x * rel2.x > EPSILON
+             || rel1.y * rel2.y > EPSILON )
+        {
+            // not online
+            return NOT_CONTAINED;
+        }
+        //std::cout << "findTriangleContains() found online on 1-2 " << std::endl;
+        return ONLINE;
+    }
 
-        if ( std::fabs( outer0 ) <= EPSILON )
+    if ( std::fabs( outer2 ) <= EPSILON )
+    {
+        if ( rel2.x * rel0.x > EPSILON
+             || rel2.y * rel0.y > EPSILON )
         {
-            if ( rel0.x * rel1.x > EPSILON
-                 || rel0.y * rel1.y > EPSILON )
-            {
-                // not online
-                continue;
-            }
-            //std::cout << "findTriangleContains() found online on 0-1 " << std::endl;
-            *sol = tri;
-            return ONLINE;
+            // not online
+            return NOT_CONTAINED;
         }
+        //std::cout << "findTriangleContains() found online on 2-0 " << std::endl;
+        return ONLINE;
+    }
+
+    if ( ( outer0 >= 0.0 && outer1 >= 0.0 && outer2 >= 0.0 )
+         || ( outer0 <= 0.0 && outer1 <= 0.0 && outer2 <= 0.0 ) )
+    {
+#ifdef DEBUG
+        std::cout << __FILE__ << ':' << __LINE__
+                  << " findTriangleContains() found contained "
+                  << " pos" << pos
+                  << " triangle"
+                  << tri->vertex( 0 )->pos()
+                  << tri->vertex( 1 )->pos()
+                  << tri->vertex( 2 )->pos()
+                  << std::endl;
+#endif
+        return CONTAINED;
+    }
+
+    return NOT_CONTAINED;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DelaunayTriangulation::clearIndex()
+{
+    M_grid_cols = M_grid_rows = 0;
+    M_grid_triangle_begin.clear();
+    M_grid_triangles.clear();
+    M_grid_vertex_begin.clear();
+    M_grid_vertices.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DelaunayTriangulation::buildIndex()
+{
+    clearIndex();
+
+    if ( M_triangles.empty()
+         || M_vertices.empty() )
+    {
+        return;
+    }
+
+    // the bounding box of all vertices.
+    // the margin covers the tolerance of containedType().
+    const double margin = 1.0e-6;
+
+    double min_x = M_vertices.front().pos().x;
+    double max_x = min_x;
+    double min_y = M_vertices.front().pos().y;
+    double max_y = min_y;
+
+    const VertexCont::const_iterator vend = M_vertices.end();
+    for ( VertexCont::const_iterator it = M_vertices.begin();
+          it != vend;
+          ++it )
+    {
+        min_x = std::min( min_x, it->pos().x );
+        max_x = std::max( max_x, it->pos().x );
+        min_y = std::min( min_y, it->pos().y );
+        max_y = std::max( max_y, it->pos().y );
+    }
+
+    M_grid_min_x = min_x - margin;
+    M_grid_max_x = max_x + margin;
+    M_grid_min_y = min_y - margin;
+    M_grid_max_y = max_y + margin;
+
+    // about one triangle per cell
+    const double width = M_grid_max_x - M_grid_min_x;
+    const double height = M_grid_max_y - M_grid_min_y;
+    const double n = static_cast< double >( M_triangles.size() );
+
+    M_grid_cols = std::min( 256, std::max( 1, static_cast< int >( std::sqrt( n * width / height ) + 0.5 ) ) );
+    M_grid_rows = std::min( 256, std::max( 1, static_cast< int >( n / M_grid_cols + 0.5 ) ) );
+    M_grid_cell_width = width / M_grid_cols;
+    M_grid_cell_height = height / M_grid_rows;
 
-        if ( std::fabs( outer1 ) <= EPSILON )
+    const std::size_t n_cells = M_grid_cols * M_grid_rows;
+
+    //
+    // triangles. registered to all cells that overlap the bounding box.
+    // the triangle container is sorted by id, so as each cell.
+    //
+    M_grid_triangle_begin.assign( n_cells + 1, 0 );
+
+    for ( int pass = 0; pass < 2; ++pass )
+    {
+        const TriangleCont::const_iterator tend = M_triangles.end();
+        for ( TriangleCont::const_iterator it = M_triangles.begin();
+              it != tend;
+              ++it )
         {
-            if ( rel1.x * rel2.x > EPSILON
-                 || rel1.y * rel2.y > EPSILON )
+            const Triangle * tri = it->second;
+            const Vector2D & p0 = tri->vertex( 0 )->pos();
+            const Vector2D & p1 = tri->vertex( 1 )->pos();
+            const Vector2D & p2 = tri->vertex( 2 )->pos();
+
+            const int c0 = gridCol( std::min( p0.x, std::min( p1.x, p2.x ) ) - margin );
+            const int c1 = gridCol( std::max( p0.x, std::max( p1.x, p2.x ) ) + margin );
+            const int r0 = gridRow( std::min( p0.y, std::min( p1.y, p2.y ) ) - margin );
+            const int r1 = gridRow( std::max( p0.y, std::max( p1.y, p2.y ) ) + margin );
+
+            for ( int r = r0; r <= r1; ++r )
             {
-                // not online
-                continue;
+                for ( int c = c0; c <= c1; ++c )
+                {
+                    const std::size_t cell = r * M_grid_cols + c;
+                    if ( pass == 0 )
+                    {
+                        ++M_grid_triangle_begin[cell + 1];
+                    }
+                    else
+                    {
+                        M_grid_triangles[M_grid_triangle_begin[cell]++] = it->second;
+                    }
+                }
             }
-            //std::cout << "findTriangleContains() found online on 1-2 " << std::endl;
-            *sol = tri;
-            return ONLINE;
         }
 
-        if ( std::fabs( outer2 ) <= EPSILON )
+        if ( pass == 0 )
         {
-            if ( rel2.x * rel0.x > EPSILON
-                 || rel2.y * rel0.y > EPSILON )
+            for ( std::size_t i = 0; i < n_cells; ++i )
             {
-                // not online
-                continue;
+                M_grid_triangle_begin[i + 1] += M_grid_triangle_begin[i];
             }
-            //std::cout << "findTriangleContains() found online on 2-0 " << std::endl;
-            *sol = tri;
-            return ONLINE;
+            M_grid_triangles.resize( M_grid_triangle_begin[n_cells] );
         }
-
-        if ( ( outer0 >= 0.0 && outer1 >= 0.0 && outer2 >= 0.0 )
-             || ( outer0 <= 0.0 && outer1 <= 0.0 && outer2 <= 0.0 ) )
+        else
         {
-#ifdef DEBUG
-            std::cout << __FILE__ << ':' << __LINE__
-                      << " findTriangleContains() found contained "
-                      << " pos" << pos
-                      << " triangle"
-                      << tri->vertex( 0 )->pos()
-                      << tri->vertex( 1 )->pos()
-                      << tri->vertex( 2 )->pos()
-                      << std::endl;
-#endif
-            *sol = tri;
-            return CONTAINED;
+            // restore the begin offsets shifted by the fill loop
+            for ( std::size_t i = n_cells; i > 0; --i )
+            {
+                M_grid_triangle_begin[i] = M_grid_triangle_begin[i - 1];
+            }
+            M_grid_triangle_begin[0] = 0;
         }
     }
 
-    //std::cout << "findTriangleContains() end not found " << std::endl;
-    return NOT_CONTAINED;
+    //
+    // vertices
+    //
+    M_grid_vertex_begin.assign( n_cells + 1, 0 );
+    M_grid_vertices.resize( M_vertices.size() );
+
+    for ( std::size_t i = 0; i < M_vertices.size(); ++i )
+    {
+        const std::size_t cell = ( gridRow( M_vertices[i].pos().y ) * M_grid_cols
+                                   + gridCol( M_vertices[i].pos().x ) );
+        ++M_grid_vertex_begin[cell + 1];
+    }
+
+    for ( std::size_t i = 0; i < n_cells; ++i )
+    {
+        M_grid_vertex_begin[i + 1] += M_grid_vertex_begin[i];
+    }
+
+    std::vector< std::size_t > fill( M_grid_vertex_begin.begin(), M_grid_vertex_begin.end() - 1 );
+    for ( std::size_t i = 0; i < M_vertices.size(); ++i )
+    {
+        const std::size_t cell = ( gridRow( M_vertices[i].pos().y ) * M_grid_cols
+                                   + gridCol( M_vertices[i].pos().x ) );
+        M_grid_vertices[fill[cell]++] = i;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+DelaunayTriangulation::gridCol( const double & x ) const
+{
+    const double c = std::floor( ( x - M_grid_min_x ) / M_grid_cell_width );
+    return ( c < 0.0
+             ? 0
+             : c >= M_grid_cols
+             ? M_grid_cols - 1
+             : static_cast< int >( c ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+DelaunayTriangulation::gridRow( const double & y ) const
+{
+    const double r = std::floor( ( y - M_grid_min_y ) / M_grid_cell_height );
+    return ( r < 0.0
+             ? 0
+             : r >= M_grid_rows
+             ? M_grid_rows - 1
+             : static_cast< int >( r ) );
 }
 
 }
@@ -553,6 +553,29 @@ private:
     //! triangle instance holder. key: id
     TriangleCont M_triangles;
 
+    //
+    // point location index. built at the end of compute().
+    // if empty, the lookup methods perform the linear search.
+    //
+
+    double M_grid_min_x; //!< left of the index grid
+    double M_grid_min_y; //!< top of the index grid
+    double M_grid_max_x; //!< right of the index grid
+    double M_grid_max_y; //!< bottom of the index grid
+    double M_grid_cell_width; //!< cell size of the index grid
+    double M_grid_cell_height; //!< cell size of the index grid
+    int M_grid_cols; //!< the number of cells in x direction
+    int M_grid_rows; //!< the number of cells in y direction
+
+    //! offset of each cell in M_grid_triangles. size: cols * rows + 1
+    std::vector< std::size_t > M_grid_triangle_begin;
+    //! triangles that overlap each cell, sorted by id in each cell
+    std::vector< TrianglePtr > M_grid_triangles;
+    //! offset of each cell in M_grid_vertices. size: cols * rows + 1
+    std::vector< std::size_t > M_grid_vertex_begin;
+    //! index of the vertices in each cell, sorted in each cell
+    std::vector< std::size_t > M_grid_vertices;
+
     // not used
     DelaunayTriangulation & operator=( const DelaunayTriangulation & );
 
@@ -562,6 +585,10 @@ public:
       \brief nothing to do
     */
     DelaunayTriangulation()
+        : M_edge_count( 0 ),
+          M_tri_count( 0 ),
+          M_grid_cols( 0 ),
+          M_grid_rows( 0 )
       { }
 
     /*!
@@ -572,6 +599,10 @@ public:
     */
     explicit
     DelaunayTriangulation( const Rect2D & region )
+        : M_edge_count( 0 ),
+          M_tri_count( 0 ),
+          M_grid_cols( 0 ),
+          M_grid_rows( 0 )
       {
           //std::cout << "create with rect" << std::endl;
           createInitialTriangle( region );
@@ -667,7 +698,9 @@ public:
     Vertex * getVertex( const int id ) const;
 
     /*!
-      \brief compute the Delaunay Triangulation
+      \brief compute the Delaunay Triangulation.
+      The point location index used by findTriangleContains() and
+      findNearestVertex() is also built.
     */
     void compute();
 
@@ -678,6 +711,7 @@ public:
 
     /*!
       \brief find triangle that contains pos from the computed triangle set.
+      If several triangles contain pos, the one that has the smallest id is returned.
       \param pos coordinates of the target point
       \return const pointer to the found triangle. if no triangle, NULL is returned.
      */
@@ -685,7 +719,8 @@ public:
     Triangle * findTriangleContains( const Vector2D & pos ) const;
 
     /*!
-      \brief find the vertex nearest to the specified point
+      \brief find the vertex nearest to the specified point.
+      If several vertices have the same distance, the first one is returned.
       \param pos coordinates of the target point
       \return const pointer to the found vertex, if no vertex, NULL is returned.
      */
@@ -748,6 +783,40 @@ private:
     ContainedType findTriangleContains( const Vector2D & pos,
                                         TrianglePtr * sol ) const;
 
+    /*!
+      \brief check how the point is contained by the triangle
+      \param tri checked triangle
+      \param pos coordinates of the target point
+      \return how the point is contained.
+     */
+    static
+    ContainedType containedType( const Triangle * tri,
+                                 const Vector2D & pos );
+
+    /*!
+      \brief build the point location index from the current triangles and vertices
+     */
+    void buildIndex();
+
+    /*!
+      \brief clear the point location index
+     */
+    void clearIndex();
+
+    /*!
+      \brief get the column index of the grid cell. the value is clamped into the grid.
+      \param x coordinate x
+      \return column index
+     */
+    int gridCol( const double & x ) const;
+
+    /*!
+      \brief get the row index of the grid cell. the value is clamped into the grid.
+      \param y coordinate y
+      \return row index
+     */
+    int gridRow( const double & y ) const;
+
     /*!
       \brief remove the specified edge from edge set
       \param id Id number of the removed edge.
@@ -0,0 +1,204 @@
+// -*-c++-*-
+
+/*!
+  \file test_delaunay_triangulation.cpp
+  \brief test code for rcsc::DelaunayTriangulation
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "delaunay_triangulation.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+using rcsc::DelaunayTriangulation;
+using rcsc::Rect2D;
+using rcsc::Size2D;
+using rcsc::Vector2D;
+
+class DelaunayTriangulationTest
+    : public CPPUNIT_NS::TestFixture {
+
+    CPPUNIT_TEST_SUITE( DelaunayTriangulationTest );
+    CPPUNIT_TEST( testEmpty );
+    CPPUNIT_TEST( testFindTriangle );
+    CPPUNIT_TEST( testFindNearestVertex );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmpty();
+    void testFindTriangle();
+    void testFindNearestVertex();
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DelaunayTriangulationTest );
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  create the triangulation of 5x5 grid points
+ */
+void
+create_grid( DelaunayTriangulation & dt )
+{
+    dt.init( Rect2D( Vector2D( -60.0, -45.0 ), Size2D( 120.0, 90.0 ) ) );
+
+    for ( int x = -2; x <= 2; ++x )
+    {
+        for ( int y = -2; y <= 2; ++y )
+        {
+            dt.addVertex( x * 10.0, y * 10.0 );
+        }
+    }
+
+    dt.compute();
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DelaunayTriangulationTest::testEmpty()
+{
+    DelaunayTriangulation dt;
+
+    CPPUNIT_ASSERT( ! dt.findTriangleContains( Vector2D( 0.0, 0.0 ) ) );
+    CPPUNIT_ASSERT( ! dt.findNearestVertex( Vector2D( 0.0, 0.0 ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DelaunayTriangulationTest::testFindTriangle()
+{
+    DelaunayTriangulation dt;
+    create_grid( dt );
+
+    CPPUNIT_ASSERT_EQUAL( static_cast< size_t >( 32 ), dt.triangles().size() );
+
+    // the first triangle in id order is returned, as the linear search does.
+    for ( double x = -25.0; x <= 25.0; x += 2.5 )
+    {
+        for ( double y = -25.0; y <= 25.0; y += 2.5 )
+        {
+            const Vector2D pos( x, y );
+            const DelaunayTriangulation::Triangle * expected = 0;
+            for ( DelaunayTriangulation::TriangleCont::const_iterator it = dt.triangles().begin();
+                  it != dt.triangles().end();
+                  ++it )
+            {
+                const Vector2D & p0 = it->second->vertex( 0 )->pos();
+                const Vector2D & p1 = it->second->vertex( 1 )->pos();
+                const Vector2D & p2 = it->second->vertex( 2 )->pos();
+                const double o0 = ( p0 - pos ).outerProduct( p1 - pos );
+                const double o1 = ( p1 - pos ).outerProduct( p2 - pos );
+                const double o2 = ( p2 - pos ).outerProduct( p0 - pos );
+                if ( ( o0 >= 0.0 && o1 >= 0.0 && o2 >= 0.0 )
+                     || ( o0 <= 0.0 && o1 <= 0.0 && o2 <= 0.0 ) )
+                {
+                    expected = it->second;
+                    break;
+                }
+            }
+
+            CPPUNIT_ASSERT( expected == dt.findTriangleContains( pos ) );
+        }
+    }
+
+    CPPUNIT_ASSERT( ! dt.findTriangleContains( Vector2D( 20.5, 0.0 ) ) );
+    CPPUNIT_ASSERT( ! dt.findTriangleContains( Vector2D( 0.0, -40.0 ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DelaunayTriangulationTest::testFindNearestVertex()
+{
+    DelaunayTriangulation dt;
+    create_grid( dt );
+
+    // vertex id = ( x + 2 ) * 5 + ( y + 2 )
+    CPPUNIT_ASSERT_EQUAL( 12, dt.findNearestVertex( Vector2D( 1.0, -1.0 ) )->id() );
+    CPPUNIT_ASSERT_EQUAL( 24, dt.findNearestVertex( Vector2D( 50.0, 50.0 ) )->id() );
+    CPPUNIT_ASSERT_EQUAL( 0, dt.findNearestVertex( Vector2D( -30.0, -21.0 ) )->id() );
+    CPPUNIT_ASSERT_EQUAL( 22, dt.findNearestVertex( Vector2D( 100.0, 0.0 ) )->id() );
+
+    // if the distances are same, the first vertex is returned.
+    CPPUNIT_ASSERT_EQUAL( 12, dt.findNearestVertex( Vector2D( 5.0, 5.0 ) )->id() );
+    CPPUNIT_ASSERT_EQUAL( 7, dt.findNearestVertex( Vector2D( -5.0, 0.0 ) )->id() );
+
+    // too far
+    CPPUNIT_ASSERT( ! dt.findNearestVertex( Vector2D( 5000.0, 0.0 ) ) );
+}
+
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+int
+main( int, char ** )
+{
+    // create the event manager and test controller
+    CPPUNIT_NS::TestResult controller;
+
+    // add a listner that collects test results
+    CPPUNIT_NS::TestResultCollector result;
+    controller.addListener( &result );
+
+    // add a listener that prints dots as test run.
+    CPPUNIT_NS::BriefTestProgressListener progress;
+    controller.addListener( &progress );
+
+    // add the top suite to the test runner.
+    CPPUNIT_NS::TestRunner runner;
+    runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+    runner.run( controller );
+
+    // output results in a compiler compatible format
+    CPPUNIT_NS::CompilerOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    outputter.write();
+
+    return result.wasSuccessful() ? 0 : 1;
+}
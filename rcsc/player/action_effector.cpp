@@ -43,6 +43,7 @@
 #include "see_state.h"
 
 #include <rcsc/math_util.h>
+#include <rcsc/common/command_buffer.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/logger.h>
 
@@ -60,6 +61,17 @@ ActionEffector::ActionEffector( const PlayerAgent & agent )
     , M_command_say( static_cast< PlayerSayCommand * >( 0 ) )
     , M_command_pointto( static_cast< PlayerPointtoCommand * >( 0 ) )
     , M_command_attentionto( static_cast< PlayerAttentiontoCommand * >( 0 ) )
+    , M_move_command( 0.0, 0.0 )
+    , M_dash_command( 0.0 )
+    , M_turn_command( 0.0 )
+    , M_kick_command( 0.0, 0.0 )
+    , M_catch_command( 0.0 )
+    , M_tackle_command( 0.0 )
+    , M_turn_neck_command( 0.0 )
+    , M_change_view_command( ViewWidth::NORMAL, ViewQuality::HIGH )
+    , M_say_command( 0.0 )
+    , M_pointto_command()
+    , M_attentionto_command()
     , M_last_action_time( 0, 0 )
     , M_last_body_command_type( PlayerCommand::ILLEGAL )
     , M_done_turn_neck( false )
@@ -93,41 +105,7 @@ ActionEffector::ActionEffector( const PlayerAgent & agent )
 */
 ActionEffector::~ActionEffector()
 {
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
-
-    if ( M_command_turn_neck )
-    {
-        delete M_command_turn_neck;
-        M_command_turn_neck = static_cast< PlayerTurnNeckCommand * >( 0 );
-    }
-
-    if ( M_command_change_view )
-    {
-        delete M_command_change_view;
-        M_command_change_view = static_cast< PlayerChangeViewCommand * >( 0 );
-    }
 
-    if ( M_command_say )
-    {
-        delete M_command_say;
-        M_command_say = static_cast< PlayerSayCommand * >( 0 );;
-    }
-
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = static_cast< PlayerPointtoCommand * >( 0 );;
-    }
-
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = static_cast< PlayerAttentiontoCommand * >( 0 );;
-    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -399,6 +377,18 @@ ActionEffector::checkCommandCount( const BodySensor & sense )
 */
 std::ostream &
 ActionEffector::makeCommand( std::ostream & to )
+{
+    CommandBuffer buf;
+    makeCommand( buf );
+    return to.write( buf.c_str(), buf.size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+ActionEffector::makeCommand( CommandBuffer & to )
 {
     M_last_action_time = M_agent.world().time();
 
@@ -409,9 +399,8 @@ ActionEffector::makeCommand( std::ostream & to )
         {
             M_catch_time = M_agent.world().time();
         }
-        M_command_body->toStr( to );
+        M_command_body->toBuffer( to );
         incCommandCount( M_command_body->type() );
-        delete M_command_body;
         M_command_body = static_cast< PlayerBodyCommand * >( 0 );
     }
     else
@@ -426,7 +415,7 @@ ActionEffector::makeCommand( std::ostream & to )
                       << "  WARNING. no body command." << std::endl;
             // register dummy command
             PlayerTurnCommand turn( 0 );
-            turn.toStr( to );
+            turn.toBuffer( to );
             incCommandCount( PlayerCommand::TURN );
         }
     }
@@ -434,46 +423,42 @@ ActionEffector::makeCommand( std::ostream & to )
     if ( M_command_turn_neck )
     {
         M_done_turn_neck = true;
-        M_command_turn_neck->toStr( to );
+        M_command_turn_neck->toBuffer( to );
         incCommandCount( PlayerCommand::TURN_NECK );
-        delete M_command_turn_neck;
         M_command_turn_neck = static_cast< PlayerTurnNeckCommand * >( 0 );
     }
 
     if ( M_command_change_view )
     {
-        M_command_change_view->toStr( to );
+        M_command_change_view->toBuffer( to );
         incCommandCount( PlayerCommand::CHANGE_VIEW );
-        delete M_command_change_view;
         M_command_change_view = static_cast< PlayerChangeViewCommand * >( 0 );
     }
 
     if ( M_command_pointto )
     {
-        M_command_pointto->toStr( to );
+        M_command_pointto->toBuffer( to );
         incCommandCount( PlayerCommand::POINTTO );
-        delete M_command_pointto;
         M_command_pointto = static_cast< PlayerPointtoCommand * >( 0 );
     }
 
     if ( M_command_attentionto )
     {
-        M_command_attentionto->toStr( to );
+        M_command_attentionto->toBuffer( to );
         incCommandCount( PlayerCommand::ATTENTIONTO );
-        delete M_command_attentionto;
         M_command_attentionto = static_cast< PlayerAttentiontoCommand * >( 0 );
     }
 
     if ( ServerParam::i().synchMode() )
     {
         PlayerDoneCommand done_com;
-        done_com.toStr( to );
+        done_com.toBuffer( to );
     }
 
     makeSayCommand();
     if ( M_command_say )
     {
-        M_command_say->toStr( to );
+        M_command_say->toBuffer( to );
         incCommandCount( PlayerCommand::SAY );
     }
 
@@ -488,41 +473,17 @@ ActionEffector::makeCommand( std::ostream & to )
 void
 ActionEffector::clearAllCommands()
 {
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
+    M_command_body = static_cast< PlayerBodyCommand * >( 0 );
 
-    if ( M_command_turn_neck )
-    {
-        delete M_command_turn_neck;
-        M_command_turn_neck = static_cast< PlayerTurnNeckCommand * >( 0 );
-    }
+    M_command_turn_neck = static_cast< PlayerTurnNeckCommand * >( 0 );
 
-    if ( M_command_change_view )
-    {
-        delete M_command_change_view;
-        M_command_change_view = static_cast< PlayerChangeViewCommand * >( 0 );
-    }
+    M_command_change_view = static_cast< PlayerChangeViewCommand * >( 0 );
 
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = static_cast< PlayerPointtoCommand * >( 0 );
-    }
+    M_command_pointto = static_cast< PlayerPointtoCommand * >( 0 );
 
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = static_cast< PlayerAttentiontoCommand * >( 0 );
-    }
+    M_command_attentionto = static_cast< PlayerAttentiontoCommand * >( 0 );
 
-    if ( M_command_say )
-    {
-        delete M_command_say;
-        M_command_say = static_cast< PlayerSayCommand * >( 0 );
-    }
+    M_command_say = static_cast< PlayerSayCommand * >( 0 );
     clearSayMessages();
 }
 
@@ -574,12 +535,8 @@ ActionEffector::setKick( const double & power,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
-    M_command_body = new PlayerKickCommand( command_power, rel_dir.degree() );
+    M_kick_command = PlayerKickCommand( command_power, rel_dir.degree() );
+    M_command_body = &M_kick_command;
 
     // set estimated action effect
     M_kick_accel.setPolar( command_power * M_agent.world().self().kickRate(),
@@ -766,12 +723,8 @@ ActionEffector::setDash( const double & power,
     //
     // create command object
     //
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
-    M_command_body = new PlayerDashCommand( command_power, command_dir );
+    M_dash_command = PlayerDashCommand( command_power, command_dir );
+    M_command_body = &M_dash_command;
 
     //
     // set estimated command effect: accel magnitude
@@ -871,14 +824,9 @@ ActionEffector::setTurn( const AngleDeg & moment )
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
-
     // moment is a command param, not a real moment.
-    M_command_body = new PlayerTurnCommand( command_moment );
+    M_turn_command = PlayerTurnCommand( command_moment );
+    M_command_body = &M_turn_command;
 
     // set estimated action effect
     /*
@@ -1013,12 +961,8 @@ ActionEffector::setMove( const double & x,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
-    M_command_body = new PlayerMoveCommand( command_x, command_y );
+    M_move_command = PlayerMoveCommand( command_x, command_y );
+    M_command_body = &M_move_command;
 
     M_move_pos.assign( command_x, command_y );
 }
@@ -1055,12 +999,8 @@ ActionEffector::setCatch()
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
-    M_command_body = new PlayerCatchCommand( catch_angle.degree() );
+    M_catch_command = PlayerCatchCommand( catch_angle.degree() );
+    M_command_body = &M_catch_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1127,12 +1067,8 @@ ActionEffector::setTackle( const double & power_or_dir,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = static_cast< PlayerBodyCommand * >( 0 );
-    }
-    M_command_body = new PlayerTackleCommand( actual_power_or_dir, foul );
+    M_tackle_command = PlayerTackleCommand( actual_power_or_dir, foul );
+    M_command_body = &M_tackle_command;
 
     // set estimated command effect
     M_tackle_power = actual_power_or_dir;
@@ -1216,12 +1152,8 @@ ActionEffector::setTurnNeck( const AngleDeg & moment )
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_turn_neck )
-    {
-        delete M_command_turn_neck;
-        M_command_turn_neck = static_cast< PlayerTurnNeckCommand * >( 0 );
-    }
-    M_command_turn_neck = new PlayerTurnNeckCommand( command_moment );
+    M_turn_neck_command = PlayerTurnNeckCommand( command_moment );
+    M_command_turn_neck = &M_turn_neck_command;
 
     // set estimated command effect
     M_turn_neck_moment = command_moment;
@@ -1240,15 +1172,10 @@ ActionEffector::setChangeView( const ViewWidth & width )
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_change_view )
-    {
-        delete M_command_change_view;
-        M_command_change_view = static_cast< PlayerChangeViewCommand * >( 0 );
-    }
-
-    M_command_change_view = new PlayerChangeViewCommand( width,
-                                                         ViewQuality::HIGH,
-                                                         M_agent.config().version() );
+    M_change_view_command = PlayerChangeViewCommand( width,
+                                                     ViewQuality::HIGH,
+                                                     M_agent.config().version() );
+    M_command_change_view = &M_change_view_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1346,13 +1273,9 @@ ActionEffector::setPointto( const double & x,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = static_cast< PlayerPointtoCommand * >( 0 );
-    }
-    M_command_pointto = new PlayerPointtoCommand( target_rel.r(),
-                                                  target_rel.th().degree() );
+    M_pointto_command = PlayerPointtoCommand( target_rel.r(),
+                                              target_rel.th().degree() );
+    M_command_pointto = &M_pointto_command;
 
     // set estimated commadn effect
     M_pointto_pos = target_pos;
@@ -1370,12 +1293,8 @@ ActionEffector::setPointtoOff()
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = static_cast< PlayerPointtoCommand * >( 0 );
-    }
-    M_command_pointto = new PlayerPointtoCommand();
+    M_pointto_command = PlayerPointtoCommand();
+    M_command_pointto = &M_pointto_command;
 
     // set estimated command effect
     M_pointto_pos.invalidate();
@@ -1395,17 +1314,12 @@ ActionEffector::setAttentionto( const SideID side,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = static_cast< PlayerAttentiontoCommand * >( 0 );
-    }
-
-    M_command_attentionto
-        = new PlayerAttentiontoCommand( ( M_agent.world().ourSide() == side
-                                          ? PlayerAttentiontoCommand::OUR
-                                          : PlayerAttentiontoCommand::OPP ),
-                                        unum );
+    M_attentionto_command
+        = PlayerAttentiontoCommand( ( M_agent.world().ourSide() == side
+                                      ? PlayerAttentiontoCommand::OUR
+                                      : PlayerAttentiontoCommand::OPP ),
+                                    unum );
+    M_command_attentionto = &M_attentionto_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1420,12 +1334,8 @@ ActionEffector::setAttentiontoOff()
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = static_cast< PlayerAttentiontoCommand * >( 0 );
-    }
-    M_command_attentionto = new PlayerAttentiontoCommand();
+    M_attentionto_command = PlayerAttentiontoCommand();
+    M_command_attentionto = &M_attentionto_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1455,11 +1365,7 @@ ActionEffector::getSayMessageLength() const
 void
 ActionEffector::makeSayCommand()
 {
-    if ( M_command_say )
-    {
-        delete M_command_say;
-        M_command_say = static_cast< PlayerSayCommand * >( 0 );
-    }
+    M_command_say = static_cast< PlayerSayCommand * >( 0 );
 
     M_say_message.erase();
 
@@ -1487,8 +1393,10 @@ ActionEffector::makeSayCommand()
         return;
     }
 
-    M_command_say = new PlayerSayCommand( M_say_message,
-                                          M_agent.config().version() );
+    // reuse the message buffer of the command object
+    M_say_command.setVersion( M_agent.config().version() );
+    M_say_command.assign( M_say_message );
+    M_command_say = &M_say_command;
 
     dlog.addText( Logger::ACTION,
                   __FILE__" (makeSayCommand) say message [%s]",
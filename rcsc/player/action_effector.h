@@ -46,6 +46,7 @@
 namespace rcsc {
 
 class BodySensor;
+class CommandBuffer;
 class PlayerAgent;
 class SayMessage;
 class ServerParam;
@@ -59,20 +60,32 @@ private:
     //! const reference to the PlayerAgent instance
     const PlayerAgent & M_agent;
 
-    //! pointer of body action for dynamic allocation
+    //! pointer to the registered body command object, or NULL
     PlayerBodyCommand * M_command_body;
 
-    //! pointer of turn_neck for dynamic allocation
+    //! pointer to the registered turn_neck command object, or NULL
     PlayerTurnNeckCommand * M_command_turn_neck;
-    //! pointer of change_view for dynamic allocation
+    //! pointer to the registered change_view command object, or NULL
     PlayerChangeViewCommand * M_command_change_view;
-    //! pointer of say for dynamic allocation
+    //! pointer to the registered say command object, or NULL
     PlayerSayCommand * M_command_say;
-    //! pointer of pointto for dynamic allocation
+    //! pointer to the registered pointto command object, or NULL
     PlayerPointtoCommand * M_command_pointto;
-    //! pointer to attentionto for dynamic allocation
+    //! pointer to the registered attentionto command object, or NULL
     PlayerAttentiontoCommand * M_command_attentionto;
 
+    // preallocated command objects. the above pointers refer to these objects.
+    PlayerMoveCommand M_move_command;
+    PlayerDashCommand M_dash_command;
+    PlayerTurnCommand M_turn_command;
+    PlayerKickCommand M_kick_command;
+    PlayerCatchCommand M_catch_command;
+    PlayerTackleCommand M_tackle_command;
+    PlayerTurnNeckCommand M_turn_neck_command;
+    PlayerChangeViewCommand M_change_view_command;
+    PlayerSayCommand M_say_command;
+    PlayerPointtoCommand M_pointto_command;
+    PlayerAttentiontoCommand M_attentionto_command;
 
     //! command counter
     int M_command_counter[PlayerCommand::ILLEGAL + 1];
@@ -137,7 +150,7 @@ public:
     ActionEffector( const PlayerAgent & agent );
 
     /*!
-      \brief destruct dynamic allocated command objects
+      \brief destructor. nothing to do
     */
     ~ActionEffector();
 
@@ -161,17 +174,26 @@ public:
     */
     void checkCommandCount( const BodySensor & sense );
 
+    /*!
+      \brief make command string and update last action time
+      \param to reference to the preallocated buffer
+      \return reference to the buffer
+
+      After command string composition, all command objects are released.
+    */
+    CommandBuffer & makeCommand( CommandBuffer & to );
+
     /*!
       \brief make command string and update last action time
       \param to reference to the output stream
       \return reference to the output stream
 
-      After command string composition, all command objects are deleted.
+      After command string composition, all command objects are released.
     */
     std::ostream & makeCommand( std::ostream & to );
 
     /*!
-      \brief delete all command objects and say messages.
+      \brief release all command objects and delete say messages.
      */
     void clearAllCommands();
 
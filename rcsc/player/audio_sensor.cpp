@@ -42,6 +42,7 @@
 #include <rcsc/math_util.h>
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 namespace rcsc {
@@ -56,6 +57,9 @@ AudioSensor::AudioSensor()
     , M_freeform_message_time( -1, 0 )
     , M_trainer_message_time( -1, 0 )
 {
+    // a player can hear at most one message from each player in a cycle
+    M_teammate_messages.reserve( MAX_PLAYER * 2 );
+    M_opponent_messages.reserve( MAX_PLAYER * 2 );
     M_freeform_message.reserve( 256 );
 }
 
@@ -75,8 +79,9 @@ AudioSensor::addParser( boost::shared_ptr< SayMessageParser > parser )
         return;
     }
 
-    if ( M_say_message_parsers.find( parser->header() )
-         != M_say_message_parsers.end() )
+    boost::shared_ptr< SayMessageParser > & entry = this->parser( parser->header() );
+
+    if ( entry )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** AudioSensor::addSayMessageParser()"
@@ -86,8 +91,7 @@ AudioSensor::addParser( boost::shared_ptr< SayMessageParser > parser )
         return;
     }
 
-    M_say_message_parsers.insert( ParserMap::value_type( parser->header(),
-                                                         parser ) );
+    entry = parser;
 }
 
 /*-------------------------------------------------------------------*/
@@ -97,8 +101,8 @@ AudioSensor::addParser( boost::shared_ptr< SayMessageParser > parser )
 void
 AudioSensor::removeParser( const char header )
 {
-    ParserMap::iterator it = M_say_message_parsers.find( header );
-    if ( it == M_say_message_parsers.end() )
+    boost::shared_ptr< SayMessageParser > & entry = parser( header );
+    if ( ! entry )
     {
         std::cerr << "***WARNING*** AudioSensor::removeParser()"
                   << " header [" << header
@@ -107,7 +111,7 @@ AudioSensor::removeParser( const char header )
         return;
     }
 
-    M_say_message_parsers.erase( it );
+    entry.reset();
 }
 
 /*-------------------------------------------------------------------*/
@@ -139,22 +143,48 @@ AudioSensor::parsePlayerMessage( const char * msg,
       (hear <TIME> opp)
     */
 
-    long cycle = 0;
-    double dir = 0.0;
-    int unum = 0;
-    char sender[8];
-    int n_read = 0;
+    const char * const raw = msg;
+
+    // v8+ complete message. the header is read in place without copying.
+    char * next = 0;
 
-    // v8+ complete message
-    if ( std::sscanf( msg, " (hear %ld %lf %7[^ ] %d %n ",
-                      &cycle, &dir, sender, &unum, &n_read ) != 4 )
+    while ( *msg == ' ' ) ++msg;
+    if ( std::strncmp( msg, "(hear ", 6 ) != 0 )
     {
         std::cerr << "***ERROR*** AudioSensor::parsePlayerMessage()"
-                  << " heard unsupported message. [" << msg << "]"
+                  << " heard unsupported message. [" << raw << "]"
+                  << std::endl;
+        return;
+    }
+    msg += 6;
+
+    std::strtol( msg, &next, 10 ); // skip time
+    const bool cycle_ok = ( next != msg );
+    msg = next;
+
+    const double dir = std::strtod( msg, &next );
+    const bool dir_ok = ( next != msg );
+    msg = next;
+
+    while ( *msg == ' ' ) ++msg;
+    const char * sender = msg;
+    while ( *msg != ' ' && *msg != '\0' ) ++msg;
+    const std::size_t sender_len = msg - sender;
+
+    const int unum = static_cast< int >( std::strtol( msg, &next, 10 ) );
+    const bool unum_ok = ( next != msg );
+    msg = next;
+
+    if ( ! cycle_ok
+         || ! dir_ok
+         || sender_len == 0
+         || ! unum_ok )
+    {
+        std::cerr << "***ERROR*** AudioSensor::parsePlayerMessage()"
+                  << " heard unsupported message. [" << raw << "]"
                   << std::endl;
         return;
     }
-    msg += n_read;
 
     while ( *msg == ' ' ) ++msg;
 
@@ -165,28 +195,23 @@ AudioSensor::parsePlayerMessage( const char * msg,
         ++msg;
     }
 
-    HearMessage message;
-    message.unum_ = unum;
-    message.dir_ = dir;
-    message.str_ = msg;
-
-    std::string::size_type pos = message.str_.rfind( end_char );
-    if ( pos == std::string::npos )
+    const char * end = std::strrchr( msg, end_char );
+    if ( ! end )
     {
         std::cerr << "***ERROR*** AudioSensor::parsePlayerMessage."
                   << " Illegal message. [" << msg << ']'
                   << std::endl;
         return;
     }
-    message.str_.erase( pos );
 
-    if ( message.str_.empty() )
+    if ( end == msg )
     {
         // empty message
         return;
     }
 
-    if ( ! std::strncmp( sender, "our", 3 ) )
+    if ( sender_len >= 3
+         && ! std::strncmp( sender, "our", 3 ) )
     {
         if ( M_teammate_message_time != current )
         {
@@ -196,11 +221,11 @@ AudioSensor::parsePlayerMessage( const char * msg,
             M_teammate_messages.clear();
         }
 
-        M_teammate_messages.push_back( message );
-
-        parseTeammateMessage( message );
+        parseTeammateMessage( addMessage( M_teammate_messages,
+                                          unum, dir, msg, end - msg ) );
     }
-    else if ( ! std::strncmp( sender, "opp", 3 ) )
+    else if ( sender_len >= 3
+              && ! std::strncmp( sender, "opp", 3 ) )
     {
         if ( M_opponent_message_time != current )
         {
@@ -208,10 +233,33 @@ AudioSensor::parsePlayerMessage( const char * msg,
             M_opponent_messages.clear();
         }
 
-        M_opponent_messages.push_back( message );
+        addMessage( M_opponent_messages,
+                    unum, dir, msg, end - msg );
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const HearMessage &
+AudioSensor::addMessage( std::vector< HearMessage > & messages,
+                         const int unum,
+                         const double & dir,
+                         const char * msg,
+                         const std::size_t len )
+{
+    // the reserved capacity and the short string buffer are reused.
+    messages.resize( messages.size() + 1 );
+
+    HearMessage & message = messages.back();
+    message.unum_ = unum;
+    message.dir_ = dir;
+    message.str_.assign( msg, len );
+
+    return message;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -397,8 +445,6 @@ AudioSensor::parseTeammateMessage( const HearMessage & message )
         return;
     }
 
-    const ParserMap::iterator end = M_say_message_parsers.end();
-
     const char * msg = message.str_.c_str();
 
     while ( *msg != '\0' )
@@ -407,9 +453,9 @@ AudioSensor::parseTeammateMessage( const HearMessage & message )
 
         int len = 0;
 
-        ParserMap::iterator it = M_say_message_parsers.find( tag );
+        const boost::shared_ptr< SayMessageParser > & p = parser( tag );
 
-        if ( it == end )
+        if ( ! p )
         {
             dlog.addText( Logger::SENSOR,
                           __FILE__" (parseTeammateMessage) unsupported message [%s] in [%s]",
@@ -417,8 +463,8 @@ AudioSensor::parseTeammateMessage( const HearMessage & message )
             return;
         }
 
-        len = it->second->parse( message.unum_, message.dir_, msg,
-                                 M_teammate_message_time );
+        len = p->parse( message.unum_, message.dir_, msg,
+                        M_teammate_message_time );
 
         if ( len < 0 )
         {
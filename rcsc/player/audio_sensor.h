@@ -41,8 +41,6 @@
 #include <boost/shared_ptr.hpp>
 
 #include <string>
-#include <map>
-#include <list>
 #include <vector>
 
 namespace rcsc {
@@ -58,11 +56,11 @@ class FreeformParser;
 class AudioSensor {
 private:
 
-    //! typedef of the say message parser container
-    typedef std::map< char, boost::shared_ptr< SayMessageParser > > ParserMap;
+    //! the size of the parser table. one entry for each header character.
+    static const int PARSER_TABLE_SIZE = 256;
 
-    //! player message parsers
-    ParserMap M_say_message_parsers;
+    //! player message parsers indexed by the header character
+    boost::shared_ptr< SayMessageParser > M_say_message_parsers[PARSER_TABLE_SIZE];
 
     //! freeform message parsers
     boost::shared_ptr< FreeformParser > M_freeform_parser;
@@ -71,13 +69,13 @@ private:
     GameTime M_teammate_message_time;
 
     //! last heard message data from teammate players
-    std::list< HearMessage > M_teammate_messages;
+    std::vector< HearMessage > M_teammate_messages;
 
     //! last time that teammate message is heard
     GameTime M_opponent_message_time;
 
     //! last heard message data from opponent players
-    std::list< HearMessage > M_opponent_messages;
+    std::vector< HearMessage > M_opponent_messages;
 
     //! last time when freeform message is heard
     GameTime M_freeform_message_time;
@@ -154,7 +152,7 @@ public:
       \return const reference to the message object container
      */
     const
-    std::list< HearMessage > & teammateMessages() const
+    std::vector< HearMessage > & teammateMessages() const
       {
           return M_teammate_messages;
       }
@@ -174,7 +172,7 @@ public:
       \return const reference to the message object container
      */
     const
-    std::list< HearMessage > & opponentMessages() const
+    std::vector< HearMessage > & opponentMessages() const
       {
           return M_opponent_messages;
       }
@@ -220,6 +218,32 @@ public:
       }
 
 private:
+    /*!
+      \brief get the parser for the header character
+      \param header header character
+      \return reference to the table entry
+     */
+    boost::shared_ptr< SayMessageParser > & parser( const char header )
+      {
+          return M_say_message_parsers[static_cast< unsigned char >( header )];
+      }
+
+    /*!
+      \brief add the heard message to the container
+      \param messages reference to the message container
+      \param unum sender's uniform number
+      \param dir sender's direction
+      \param msg pointer to the first character of the message body
+      \param len the length of the message body
+      \return reference to the added message
+     */
+    static
+    const HearMessage & addMessage( std::vector< HearMessage > & messages,
+                                    const int unum,
+                                    const double & dir,
+                                    const char * msg,
+                                    const std::size_t len );
+
     /*
       \brief analyze message from teammate
       \param message message object from teammate
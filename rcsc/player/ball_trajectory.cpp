@@ -0,0 +1,222 @@
+// -*-c++-*-
+
+/*!
+  \file ball_trajectory.cpp
+  \brief predicted ball trajectory Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "ball_trajectory.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/soccer_math.h>
+
+#include <cmath>
+
+namespace rcsc {
+
+const int BallTrajectory::MAX_STEP = 30;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+BallTrajectory::BallTrajectory()
+    : M_decay( ServerParam::DEFAULT_BALL_DECAY ),
+      M_stop_step( -1 ),
+      M_out_of_pitch_step( -1 )
+{
+    M_pos.reserve( MAX_STEP + 1 );
+    M_vel.reserve( MAX_STEP + 1 );
+    M_dist.reserve( MAX_STEP + 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+BallTrajectory::clear()
+{
+    M_pos.clear();
+    M_vel.clear();
+    M_dist.clear();
+    M_stop_step = -1;
+    M_out_of_pitch_step = -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+BallTrajectory::create( const Vector2D & pos,
+                        const Vector2D & vel,
+                        const int max_step )
+{
+    const ServerParam & SP = ServerParam::i();
+    const double pitch_x_max = ( SP.keepawayMode()
+                                 ? SP.keepawayLength() * 0.5
+                                 : SP.pitchHalfLength() + 5.0 );
+    const double pitch_y_max = ( SP.keepawayMode()
+                                 ? SP.keepawayWidth() * 0.5
+                                 : SP.pitchHalfWidth() + 5.0 );
+
+    clear();
+
+    M_decay = SP.ballDecay();
+
+    Vector2D bpos = pos;
+    Vector2D bvel = vel;
+    double dist = 0.0;
+
+    M_pos.push_back( bpos );
+    M_vel.push_back( bvel );
+    M_dist.push_back( dist );
+
+    for ( int i = 1; i <= max_step; ++i )
+    {
+        dist += bvel.r();
+        bpos += bvel;
+        bvel *= M_decay;
+
+        M_pos.push_back( bpos );
+        M_vel.push_back( bvel );
+        M_dist.push_back( dist );
+
+        if ( i >= 5
+             && bvel.r2() < 0.01*0.01 )
+        {
+            // ball stopped
+            M_stop_step = i;
+            break;
+        }
+
+        if ( bpos.absX() > pitch_x_max
+             || bpos.absY() > pitch_y_max )
+        {
+            // out of pitch
+            M_out_of_pitch_step = i;
+            break;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+BallTrajectory::pos( const int step ) const
+{
+    if ( M_pos.empty() )
+    {
+        return Vector2D::INVALIDATED;
+    }
+
+    if ( step <= 0 )
+    {
+        return M_pos.front();
+    }
+
+    const int last = lastStep();
+    if ( step <= last )
+    {
+        return M_pos[step];
+    }
+
+    return inertia_n_step_point( M_pos.back(), M_vel.back(), step - last, M_decay );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+BallTrajectory::vel( const int step ) const
+{
+    if ( M_vel.empty() )
+    {
+        return Vector2D( 0.0, 0.0 );
+    }
+
+    if ( step <= 0 )
+    {
+        return M_vel.front();
+    }
+
+    const int last = lastStep();
+    if ( step <= last )
+    {
+        return M_vel[step];
+    }
+
+    return M_vel.back() * std::pow( M_decay, step - last );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+BallTrajectory::travelDist( const int step ) const
+{
+    if ( M_dist.empty()
+         || step <= 0 )
+    {
+        return 0.0;
+    }
+
+    const int last = lastStep();
+    if ( step <= last )
+    {
+        return M_dist[step];
+    }
+
+    return M_dist.back()
+        + inertia_n_step_distance( M_vel.back().r(), step - last, M_decay );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Vector2D
+BallTrajectory::finalPoint() const
+{
+    if ( M_pos.empty() )
+    {
+        return Vector2D::INVALIDATED;
+    }
+
+    return inertia_final_point( M_pos.back(), M_vel.back(), M_decay );
+}
+
+}
@@ -0,0 +1,183 @@
+// -*-c++-*-
+
+/*!
+  \file ball_trajectory.h
+  \brief predicted ball trajectory Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_BALL_TRAJECTORY_H
+#define RCSC_PLAYER_BALL_TRAJECTORY_H
+
+#include <rcsc/geom/vector_2d.h>
+
+#include <vector>
+
+namespace rcsc {
+
+/*!
+  \class BallTrajectory
+  \brief future ball states predicted only by inertia movement.
+
+  The trajectory is simulated step by step from the initial state until
+  the ball stops, goes out of the pitch or the step limit is reached.
+  WorldModel holds one instance updated once per decision, and all
+  intercept predictors and action modules refer to it instead of
+  re-simulating the ball by themselves.
+*/
+class BallTrajectory {
+public:
+
+    //! default maximal simulation step
+    static const int MAX_STEP;
+
+private:
+
+    //! ball decay parameter used by the simulation
+    double M_decay;
+
+    //! predicted ball positions. index 0 is the initial state.
+    std::vector< Vector2D > M_pos;
+    //! predicted ball velocities. index 0 is the initial state.
+    std::vector< Vector2D > M_vel;
+    //! cumulative travel distance from the initial position
+    std::vector< double > M_dist;
+
+    //! the step when the ball is regarded as stopped. -1 if not reached.
+    int M_stop_step;
+    //! the first step when the ball is out of the pitch. -1 if not reached.
+    int M_out_of_pitch_step;
+
+public:
+
+    /*!
+      \brief construct an empty trajectory
+    */
+    BallTrajectory();
+
+    /*!
+      \brief simulate the trajectory from the given ball state.
+      \param pos initial ball position
+      \param vel initial ball velocity
+      \param max_step maximal simulation step. if 0, only the initial state is stored.
+    */
+    void create( const Vector2D & pos,
+                 const Vector2D & vel,
+                 const int max_step );
+
+    /*!
+      \brief clear all data
+    */
+    void clear();
+
+    /*!
+      \brief check if trajectory has no state
+      \return true if no state
+    */
+    bool empty() const
+      {
+          return M_pos.empty();
+      }
+
+    /*!
+      \brief get the number of simulated states including the initial state
+      \return the number of states
+    */
+    std::size_t size() const
+      {
+          return M_pos.size();
+      }
+
+    /*!
+      \brief get the last simulated step
+      \return step index of the last state
+    */
+    int lastStep() const
+      {
+          return static_cast< int >( M_pos.size() ) - 1;
+      }
+
+    /*!
+      \brief get the step when the ball is regarded as stopped
+      \return step index or -1
+    */
+    int stopStep() const
+      {
+          return M_stop_step;
+      }
+
+    /*!
+      \brief get the first step when the ball is out of the pitch
+      \return step index or -1
+    */
+    int outOfPitchStep() const
+      {
+          return M_out_of_pitch_step;
+      }
+
+    /*!
+      \brief get the container of simulated positions
+      \return const reference to the container
+    */
+    const std::vector< Vector2D > & posList() const
+      {
+          return M_pos;
+      }
+
+    /*!
+      \brief get the ball position after n steps.
+      if step exceeds the simulated range, it is extrapolated from the last state.
+      \param step step count from the initial state
+      \return ball position
+    */
+    Vector2D pos( const int step ) const;
+
+    /*!
+      \brief get the ball velocity after n steps.
+      if step exceeds the simulated range, it is extrapolated from the last state.
+      \param step step count from the initial state
+      \return ball velocity
+    */
+    Vector2D vel( const int step ) const;
+
+    /*!
+      \brief get the ball travel distance after n steps.
+      \param step step count from the initial state
+      \return travel distance from the initial position
+    */
+    double travelDist( const int step ) const;
+
+    /*!
+      \brief get the ball final point
+      \return ball final position
+    */
+    Vector2D finalPoint() const;
+
+};
+
+}
+
+#endif
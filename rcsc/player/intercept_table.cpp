@@ -42,6 +42,7 @@
 
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/common/worker_pool.h>
 #include <rcsc/game_time.h>
 
 #include <algorithm>
@@ -52,6 +53,22 @@ namespace rcsc {
 
 const std::size_t InterceptTable::MAX_CYCLE = 30;
 
+namespace {
+
+//! cycle limit used by the prefetch. same as the initial value of the serial loop.
+const int PREFETCH_MAX_CYCLE = 1000;
+
+/*!
+  \struct PrefetchData
+  \brief user data passed to the prefetch task
+*/
+struct PrefetchData {
+    const PlayerIntercept * predictor_;
+    const void * tasks_;
+};
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -59,10 +76,9 @@ const std::size_t InterceptTable::MAX_CYCLE = 30;
 InterceptTable::InterceptTable( const WorldModel & world )
     : M_world( world )
     , M_update_time( 0, 0 )
+    , M_ball_trajectory( &M_kickable_ball_trajectory )
+    , M_self_max_solutions( 0 )
 {
-    M_ball_pos_cache.reserve( MAX_CYCLE + 2 );
-    //M_ball_vel_cache.reserve( MAX_CYCLE + 2 );
-
     M_self_cache.reserve( ( MAX_CYCLE + 2 ) * 2 );
 
     clear();
@@ -84,7 +100,8 @@ InterceptTable::~InterceptTable()
 void
 InterceptTable::clear()
 {
-    M_ball_pos_cache.clear();
+    M_kickable_ball_trajectory.clear();
+    M_ball_trajectory = &M_kickable_ball_trajectory;
 
     M_self_reach_cycle = 1000;
     M_self_exhaust_reach_cycle = 1000;
@@ -100,6 +117,44 @@ InterceptTable::clear()
     M_second_opponent = static_cast< PlayerObject * >( 0 );
 
     M_self_cache.clear();
+
+    M_player_tasks.clear();
+    M_teammate_prefetch.clear();
+    M_opponent_prefetch.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::setWorkerThreads( const int n_threads )
+{
+    if ( n_threads <= 1 )
+    {
+        M_worker_pool.reset();
+        return;
+    }
+
+    if ( M_worker_pool
+         && M_worker_pool->size() == n_threads )
+    {
+        return;
+    }
+
+    M_worker_pool = boost::shared_ptr< WorkerPool >( new WorkerPool( n_threads ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+InterceptTable::workerThreads() const
+{
+    return ( M_worker_pool
+             ? M_worker_pool->size()
+             : 1 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -146,7 +201,7 @@ InterceptTable::update()
     }
 #endif
 
-    createBallCache();
+    setBallTrajectory();
 
 #ifdef DEBUG
     dlog.addText( Logger::INTERCEPT,
@@ -155,6 +210,11 @@ InterceptTable::update()
 
     predictSelf();
 
+    if ( M_worker_pool )
+    {
+        prefetchPlayers();
+    }
+
 #ifdef DEBUG
     dlog.addText( Logger::INTERCEPT,
                   "==========Intercept Predict Opponent==========" );
@@ -328,53 +388,19 @@ InterceptTable::hearOpponent( const int unum,
 
 */
 void
-InterceptTable::createBallCache()
+InterceptTable::setBallTrajectory()
 {
-    const ServerParam & SP = ServerParam::i();
-    const double pitch_x_max = ( SP.keepawayMode()
-                                 ? SP.keepawayLength() * 0.5
-                                 : SP.pitchHalfLength() + 5.0 );
-    const double pitch_y_max = ( SP.keepawayMode()
-                                 ? SP.keepawayWidth() * 0.5
-                                 : SP.pitchHalfWidth() + 5.0 );
-    const double bdecay = SP.ballDecay();
-
-    Vector2D bpos = M_world.ball().pos();
-    Vector2D bvel = M_world.ball().vel();
-
-    M_ball_pos_cache.push_back( bpos );
-
     if ( M_world.self().isKickable() )
     {
+        // no need to estimate the future ball status
+        M_kickable_ball_trajectory.create( M_world.ball().pos(),
+                                           M_world.ball().vel(),
+                                           0 );
+        M_ball_trajectory = &M_kickable_ball_trajectory;
         return;
     }
 
-    for ( std::size_t i = 1; i <= MAX_CYCLE; ++i )
-    {
-        bpos += bvel;
-        bvel *= bdecay;
-
-        M_ball_pos_cache.push_back( bpos );
-
-        if ( i >= 5
-             && bvel.r2() < 0.01*0.01 )
-        {
-            // ball stopped
-            break;
-        }
-
-        if ( bpos.absX() > pitch_x_max
-             || bpos.absY() > pitch_y_max )
-        {
-            // out of pitch
-            break;
-        }
-    }
-
-    if ( M_ball_pos_cache.size() == 1 )
-    {
-        M_ball_pos_cache.push_back( bpos );
-    }
+    M_ball_trajectory = &M_world.ballTrajectory();
 }
 
 /*-------------------------------------------------------------------*/
@@ -392,10 +418,9 @@ InterceptTable::predictSelf()
         return;
     }
 
-    std::size_t max_cycle = std::min( MAX_CYCLE, M_ball_pos_cache.size() );
+    std::size_t max_cycle = std::min( MAX_CYCLE, M_ball_trajectory->size() );
 
-    //SelfIntercept predictor( M_world, M_ball_pos_cache );
-    SelfInterceptV13 predictor( M_world, M_ball_pos_cache );
+    SelfInterceptV13 predictor( M_world, *M_ball_trajectory, M_self_max_solutions );
     predictor.predict( max_cycle, M_self_cache );
 
     if ( M_self_cache.empty() )
@@ -494,11 +519,12 @@ InterceptTable::predictTeammate()
     int min_cycle = 1000;
     int second_min_cycle = 1000;
 
-    PlayerIntercept predictor( M_world, M_ball_pos_cache );
+    PlayerIntercept predictor( M_world, *M_ball_trajectory );
 
+    std::size_t index = 0;
     for ( PlayerPtrCont::const_iterator it = teammates.begin();
           it != t_end;
-          ++it )
+          ++it, ++index )
     {
         if ( (*it)->posCount() >= 10 )
         {
@@ -525,8 +551,11 @@ InterceptTable::predictTeammate()
             continue;
         }
 
-        int cycle = predictor.predict( *(*it), *player_type,
-                                       second_min_cycle );
+        int cycle = predictPlayer( predictor, *(*it), *player_type,
+                                   second_min_cycle,
+                                   ( index < M_teammate_prefetch.size()
+                                     ? M_teammate_prefetch[index]
+                                     : -1 ) );
         dlog.addText( Logger::INTERCEPT,
                       "---> Teammate %d.(%.1f %.1f) type=%d cycle=%d",
                       (*it)->unum(),
@@ -601,11 +630,12 @@ InterceptTable::predictOpponent()
     int min_cycle = 1000;
     int second_min_cycle = 1000;
 
-    PlayerIntercept predictor( M_world, M_ball_pos_cache );
+    PlayerIntercept predictor( M_world, *M_ball_trajectory );
 
+    std::size_t index = 0;
     for ( PlayerPtrCont::const_iterator it = opponents.begin();
           it != o_end;
-          ++it )
+          ++it, ++index )
     {
         if ( (*it)->posCount() >= 15 )
         {
@@ -632,8 +662,11 @@ InterceptTable::predictOpponent()
             continue;
         }
 
-        int cycle = predictor.predict( *(*it), *player_type,
-                                       second_min_cycle );
+        int cycle = predictPlayer( predictor, *(*it), *player_type,
+                                   second_min_cycle,
+                                   ( index < M_opponent_prefetch.size()
+                                     ? M_opponent_prefetch[index]
+                                     : -1 ) );
         dlog.addText( Logger::INTERCEPT,
                       "---> Opponent.%d (%.1f %.1f) type=%d cycle=%d",
                       (*it)->unum(),
@@ -664,4 +697,128 @@ InterceptTable::predictOpponent()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::prefetch_task( void * data,
+                               const int index )
+{
+    const PrefetchData * prefetch = static_cast< const PrefetchData * >( data );
+    const PlayerTask & task = static_cast< const PlayerTask * >( prefetch->tasks_ )[index];
+
+    *task.result_ = prefetch->predictor_->predict( *task.player_,
+                                                   *task.player_type_,
+                                                   PREFETCH_MAX_CYCLE );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::prefetchPlayers()
+{
+    //
+    // Each player is predicted without the cycle limit. predictPlayer()
+    // converts the result to the one with the limit used by the serial loop.
+    // PlayerIntercept::predict() must not write the debug log in this function,
+    // because Logger is not thread safe.
+    //
+
+    const PlayerPtrCont & teammates = M_world.teammatesFromBall();
+    const PlayerPtrCont & opponents = M_world.opponentsFromBall();
+
+    M_player_tasks.clear();
+    M_teammate_prefetch.assign( teammates.size(), -1 );
+    M_opponent_prefetch.assign( opponents.size(), -1 );
+
+    if ( ! M_world.existKickableTeammate() )
+    {
+        for ( std::size_t i = 0; i < teammates.size(); ++i )
+        {
+            const PlayerType * player_type = teammates[i]->playerTypePtr();
+            if ( teammates[i]->posCount() >= 10
+                 || ! player_type )
+            {
+                continue;
+            }
+
+            PlayerTask task;
+            task.player_ = teammates[i];
+            task.player_type_ = player_type;
+            task.result_ = &M_teammate_prefetch[i];
+            M_player_tasks.push_back( task );
+        }
+    }
+
+    if ( ! M_world.existKickableOpponent() )
+    {
+        for ( std::size_t i = 0; i < opponents.size(); ++i )
+        {
+            const PlayerType * player_type = opponents[i]->playerTypePtr();
+            if ( opponents[i]->posCount() >= 15
+                 || ! player_type )
+            {
+                continue;
+            }
+
+            PlayerTask task;
+            task.player_ = opponents[i];
+            task.player_type_ = player_type;
+            task.result_ = &M_opponent_prefetch[i];
+            M_player_tasks.push_back( task );
+        }
+    }
+
+    if ( M_player_tasks.empty() )
+    {
+        return;
+    }
+
+    PlayerIntercept predictor( M_world, *M_ball_trajectory );
+
+    PrefetchData data;
+    data.predictor_ = &predictor;
+    data.tasks_ = &M_player_tasks[0];
+
+    M_worker_pool->run( &prefetch_task,
+                        &data,
+                        static_cast< int >( M_player_tasks.size() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+InterceptTable::predictPlayer( const PlayerIntercept & predictor,
+                               const PlayerObject & player,
+                               const PlayerType & player_type,
+                               const int max_cycle,
+                               const int prefetch ) const
+{
+    if ( prefetch < 0 )
+    {
+        return predictor.predict( player, player_type, max_cycle );
+    }
+
+    //
+    // PlayerIntercept::predict() returns the first reachable step found in
+    // [min_cycle, min(max_cycle, ball_step)), otherwise the final point
+    // estimation that is never less than ball_step.
+    // If the unlimited result was found in the loop but the limited loop
+    // cannot reach it, the final point estimation has to be recomputed.
+    //
+    const int ball_step = static_cast< int >( M_ball_trajectory->size() );
+    if ( prefetch < ball_step
+         && prefetch >= max_cycle )
+    {
+        return predictor.predict( player, player_type, max_cycle );
+    }
+
+    return prefetch;
+}
+
 }
@@ -32,13 +32,21 @@
 #ifndef RCSC_PLAYER_INTERCEPT_TABLE_H
 #define RCSC_PLAYER_INTERCEPT_TABLE_H
 
+#include <rcsc/player/ball_trajectory.h>
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_time.h>
+
+#include <boost/shared_ptr.hpp>
+
 #include <vector>
+#include <algorithm>
 
 namespace rcsc {
 
+class PlayerIntercept;
 class PlayerObject;
+class PlayerType;
+class WorkerPool;
 class WorldModel;
 
 /*-------------------------------------------------------------------*/
@@ -264,6 +272,17 @@ public:
   \brief interception info holder for all players
 */
 class InterceptTable {
+private:
+
+    /*!
+      \brief intercept prediction task for one player. used by the parallel mode.
+    */
+    struct PlayerTask {
+        const PlayerObject * player_; //!< target player
+        const PlayerType * player_type_; //!< player type of the target player
+        int * result_; //!< pointer to the result slot
+    };
+
 private:
 
     //! maximal estimation cycle
@@ -275,9 +294,10 @@ private:
     //! last updated time
     GameTime M_update_time;
 
-    //! cache of predicted future ball positions
-    std::vector< Vector2D > M_ball_pos_cache;
-    //std::vector< Vector2D > M_ball_vel_cache;
+    //! trajectory used by the predictors. points to the WorldModel's one or M_kickable_ball_trajectory.
+    const BallTrajectory * M_ball_trajectory;
+    //! trajectory that contains only the current ball state. used when self can kick the ball.
+    BallTrajectory M_kickable_ball_trajectory;
 
     //! predicted min reach cycle for self without stamina exhaust
     int M_self_reach_cycle;
@@ -306,6 +326,18 @@ private:
     //! interception info cache for smart interception
     std::vector< InterceptInfo > M_self_cache;
 
+    //! the number of the fastest self solutions kept for each stamina mode. 0 means all.
+    int M_self_max_solutions;
+
+    //! worker threads for the parallel prediction. null means the serial mode.
+    boost::shared_ptr< WorkerPool > M_worker_pool;
+    //! task list for the parallel prediction
+    std::vector< PlayerTask > M_player_tasks;
+    //! prefetched reach cycle without the cycle limit. the index is same as WorldModel::teammatesFromBall(). -1 means not predicted.
+    std::vector< int > M_teammate_prefetch;
+    //! prefetched reach cycle without the cycle limit. the index is same as WorldModel::opponentsFromBall(). -1 means not predicted.
+    std::vector< int > M_opponent_prefetch;
+
 
     //! not used
     InterceptTable();
@@ -329,6 +361,41 @@ public:
     */
     void update();
 
+    /*!
+      \brief set the number of threads used by the teammate/opponent prediction.
+      \param n_threads the number of threads including the caller thread.
+      if less than 2, the prediction is done serially.
+
+      The result is always identical to the serial mode.
+    */
+    void setWorkerThreads( const int n_threads );
+
+    /*!
+      \brief get the number of threads used by the teammate/opponent prediction
+      \return the number of threads
+    */
+    int workerThreads() const;
+
+    /*!
+      \brief set the number of the fastest self solutions kept for each stamina mode.
+      \param n the number of solutions. if 0, all found solutions are kept.
+
+      A small value also stops the long step search early.
+    */
+    void setSelfMaxSolutions( const int n )
+      {
+          M_self_max_solutions = std::max( 0, n );
+      }
+
+    /*!
+      \brief get the number of the fastest self solutions kept for each stamina mode
+      \return the number of solutions. 0 means all.
+    */
+    int selfMaxSolutions() const
+      {
+          return M_self_max_solutions;
+      }
+
     /*!
       \brief set teammate intercept info mainly by heard info
       \param unum uniform number
@@ -469,15 +536,45 @@ private:
     void clear();
 
     /*!
-      \brief create cache of future ball status
+      \brief select the ball trajectory used by the predictors
     */
-    void createBallCache();
+    void setBallTrajectory();
 
     /*!
       \brief predict self interception
     */
     void predictSelf();
 
+    /*!
+      \brief predict all teammates and opponents in parallel without the cycle limit.
+      the results are merged by predictTeammate() and predictOpponent().
+    */
+    void prefetchPlayers();
+
+    /*!
+      \brief WorkerPool task function for prefetchPlayers()
+      \param data pointer to the prefetch data
+      \param index task index
+    */
+    static
+    void prefetch_task( void * data,
+                        const int index );
+
+    /*!
+      \brief get the reach cycle of the player with the cycle limit.
+      \param predictor intercept predictor
+      \param player target player
+      \param player_type player type of the target player
+      \param max_cycle cycle limit
+      \param prefetch the prefetched cycle or -1
+      \return the same value as predictor.predict( player, player_type, max_cycle )
+    */
+    int predictPlayer( const PlayerIntercept & predictor,
+                       const PlayerObject & player,
+                       const PlayerType & player_type,
+                       const int max_cycle,
+                       const int prefetch ) const;
+
     /*!
       \predict teammate interception
     */
@@ -37,6 +37,8 @@
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
 
+#include <boost/cstdint.hpp>
+
 namespace rcsc {
 
 class BodySensor;
@@ -163,6 +165,15 @@ public:
     ~Localization()
       { }
 
+    /*!
+      \brief set the sub stream id of the random stream used by this module.
+      The default implementation does nothing.
+      \param id sub stream id given to RandomEngine::stream()
+     */
+    virtual
+    void setRandomStreamId( const boost::uint64_t )
+      { }
+
    /*!
       \brief update internal state using received sense_body information
       \param body sense_body object
@@ -79,12 +79,23 @@ private:
     //! grid point container
     std::vector< Vector2D > M_points;
 
+    //! random stream, opened at the first use after the agent's seed is applied
+    RandomStream M_random;
+
+    //! true if M_random is opened
+    bool M_random_opened;
+
+    //! sub stream id of M_random
+    boost::uint64_t M_random_id;
+
 public:
     /*!
       \brief create landmark map and object table
     */
     Impl()
         : M_object_table()
+        , M_random_opened( false )
+        , M_random_id( 0 )
       {
           M_points.reserve( 1024 );
       }
@@ -99,6 +110,30 @@ public:
           return M_object_table;
       }
 
+    /*!
+      \brief get the random stream of this component
+      \return reference to the random stream
+    */
+    RandomStream & random()
+      {
+          if ( ! M_random_opened )
+          {
+              M_random = RandomEngine::instance().stream( "LocalizationDefault", M_random_id );
+              M_random_opened = true;
+          }
+          return M_random;
+      }
+
+    /*!
+      \brief set the sub stream id. the stream is reopened at the next use.
+      \param id sub stream id
+    */
+    void setRandomStreamId( const boost::uint64_t id )
+      {
+          M_random_id = id;
+          M_random_opened = false;
+      }
+
     /*!
       \brief get grid points
       \return grid points
@@ -808,7 +843,6 @@ LocalizationDefault::Impl::resamplePoints( const VisualSensor::MarkerT & marker,
                                            const double & self_face,
                                            const double & self_face_err )
 {
-    static boost::mt19937 s_engine( 49827140 );
     static const size_t max_count = 50;
 
     const std::size_t count = M_points.size();
@@ -833,7 +867,7 @@ LocalizationDefault::Impl::resamplePoints( const VisualSensor::MarkerT & marker,
     // result may not be within current candidate sector
 
     boost::uniform_real<> xy_dst( -0.01, 0.01 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_real<> > xy_rng( s_engine, xy_dst );
+    boost::variate_generator< RandomStream &, boost::uniform_real<> > xy_rng( random(), xy_dst );
 
     if ( count == 1 )
     {
@@ -863,7 +897,7 @@ LocalizationDefault::Impl::resamplePoints( const VisualSensor::MarkerT & marker,
 #endif
 
     boost::uniform_smallint<> index_dst( 0, count - 1 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_smallint<> > index_rng( s_engine, index_dst );
+    boost::variate_generator< RandomStream &, boost::uniform_smallint<> > index_rng( random(), index_dst );
 
     for ( size_t i = count; i < max_count; ++i )
     {
@@ -1116,6 +1150,16 @@ LocalizationDefault::~LocalizationDefault()
 
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationDefault::setRandomStreamId( const boost::uint64_t id )
+{
+    M_impl->setRandomStreamId( id );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -70,6 +70,13 @@ public:
 
 public:
 
+    /*!
+      \brief set the sub stream id of the random stream.
+      \param id sub stream id given to RandomEngine::stream()
+     */
+    virtual
+    void setRandomStreamId( const boost::uint64_t id );
+
    /*!
       \brief update internal state using received sense_body information
       \param body sense_body object
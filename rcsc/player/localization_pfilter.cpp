@@ -64,6 +64,150 @@ namespace rcsc {
 //! type of maerker map container
 typedef std::map< MarkerID, Vector2D > MarkerMap;
 
+/*!
+  \struct ParticleSet
+  \brief candidate positions stored as the structure of arrays
+*/
+struct ParticleSet {
+    std::vector< double > x_; //!< x coordinates
+    std::vector< double > y_; //!< y coordinates
+    std::vector< double > w_; //!< the number of violated sectors
+
+    void reserve( const std::size_t n )
+      {
+          x_.reserve( n );
+          y_.reserve( n );
+          w_.reserve( n );
+      }
+
+    void clear()
+      {
+          x_.clear();
+          y_.clear();
+          w_.clear();
+      }
+
+    void resize( const std::size_t n )
+      {
+          x_.resize( n );
+          y_.resize( n );
+          w_.resize( n );
+      }
+
+    std::size_t size() const
+      {
+          return x_.size();
+      }
+
+    bool empty() const
+      {
+          return x_.empty();
+      }
+
+    void push_back( const Vector2D & p )
+      {
+          x_.push_back( p.x );
+          y_.push_back( p.y );
+          w_.push_back( 0.0 );
+      }
+
+    Vector2D at( const std::size_t i ) const
+      {
+          return Vector2D( x_[i], y_[i] );
+      }
+};
+
+/*!
+  \struct MarkerSector
+  \brief candidate sector given by one seen marker.
+
+  The same area as Sector2D::contains(), but the angle is checked by
+  the cross products instead of atan2, so that the filter loop can be
+  vectorized by the compiler.
+*/
+struct MarkerSector {
+    double x_; //!< x of the base point (marker position)
+    double y_; //!< y of the base point (marker position)
+    double min_r2_; //!< squared min radius
+    double max_r2_; //!< squared max radius
+    double left_x_; //!< x of the unit vector of the left start angle
+    double left_y_; //!< y of the unit vector of the left start angle
+    double right_x_; //!< x of the unit vector of the right end angle
+    double right_y_; //!< y of the unit vector of the right end angle
+    double sign_; //!< -1 if the arc angle is more than 180 degree, otherwise +1
+
+    MarkerSector( const Vector2D & base,
+                  const double & min_r,
+                  const double & max_r,
+                  const AngleDeg & left,
+                  const AngleDeg & right )
+        : x_( base.x ),
+          y_( base.y ),
+          min_r2_( square( std::max( 0.0, min_r ) ) ),
+          max_r2_( square( std::max( 0.0, std::max( min_r, max_r ) ) ) ),
+          left_x_( left.cos() ),
+          left_y_( left.sin() ),
+          right_x_( right.cos() ),
+          right_y_( right.sin() ),
+          sign_( left.isLeftEqualOf( right ) ? 1.0 : -1.0 )
+      { }
+
+    /*!
+      \brief check if the point is outside of this sector
+      \param x x coordinate
+      \param y y coordinate
+      \return 1 if outside, otherwise 0
+    */
+    double outside( const double x,
+                    const double y ) const
+      {
+          const double dx = x - x_;
+          const double dy = y - y_;
+          const double d2 = dx * dx + dy * dy;
+          // within [left, right] if both cross products are not negative.
+          // if the arc is wider than 180 degree, one of them is enough.
+          const double cl = sign_ * ( left_x_ * dy - left_y_ * dx );
+          const double cr = sign_ * ( dx * right_y_ - dy * right_x_ );
+          const double c = sign_ * std::min( cl, cr );
+          const bool out = ( d2 < min_r2_ ) | ( d2 > max_r2_ ) | ( c < 0.0 );
+          return ( out ? 1.0 : 0.0 );
+      }
+
+    /*!
+      \brief increment the weights of the points outside of this sector
+      \param x x coordinates
+      \param y y coordinates
+      \param w weights
+      \param n the number of points
+    */
+    void countViolations( const double * x,
+                          const double * y,
+                          double * w,
+                          const std::size_t n ) const
+      {
+          // the fixed size blocks are vectorized without the alias check
+          // between the input arrays and the weights.
+          std::size_t i = 0;
+          for ( ; i + 4 <= n; i += 4 )
+          {
+              double v[4];
+              for ( int k = 0; k < 4; ++k )
+              {
+                  v[k] = outside( x[i + k], y[i + k] );
+              }
+              for ( int k = 0; k < 4; ++k )
+              {
+                  w[i + k] += v[k];
+              }
+          }
+
+          for ( ; i < n; ++i )
+          {
+              w[i] += outside( x[i], y[i] );
+          }
+      }
+};
+
 /*!
   \struct LocalizeImpl
   \brief localization implementation
@@ -75,24 +219,49 @@ private:
     //! object distance table
     ObjectTable M_object_table;
 
+    //! the number of particles kept after the filtering
+    const std::size_t M_particle_count;
+
     //! grid point container
-    std::vector< Vector2D > M_points;
+    ParticleSet M_points;
 
 
     GameTime M_particles_generate_time;
-    std::vector< Vector2D > M_particles;
+    ParticleSet M_particles;
+
+    //! candidate sectors of the seen markers, reused for each see
+    std::vector< MarkerSector > M_sectors;
+
+    //! work area of the resampling
+    std::vector< double > M_noise;
+
+    //! random stream, opened at the first use after the agent's seed is applied
+    RandomStream M_random;
+
+    //! true if M_random is opened
+    bool M_random_opened;
+
+    //! sub stream id of M_random
+    boost::uint64_t M_random_id;
 public:
     /*!
       \brief create landmark map and object table
-      \param ourside our team side
+      \param particle_count the number of particles kept after the filtering
     */
     explicit
-    Impl()
+    Impl( const int particle_count )
         : M_object_table()
+        , M_particle_count( std::max( 1, particle_count ) )
         , M_particles_generate_time( -1, 0 )
+        , M_random_opened( false )
+        , M_random_id( 0 )
       {
-          M_points.reserve( 1024 );
-          M_particles.reserve( 1024 );
+          const std::size_t capacity = std::max( static_cast< std::size_t >( 1024 ),
+                                                 M_particle_count );
+          M_points.reserve( capacity );
+          M_particles.reserve( capacity );
+          M_sectors.reserve( 64 );
+          M_noise.reserve( capacity * 2 );
       }
 
     /*!
@@ -105,18 +274,42 @@ public:
           return M_object_table;
       }
 
+    /*!
+      \brief get the random stream of this component
+      \return reference to the random stream
+    */
+    RandomStream & random()
+      {
+          if ( ! M_random_opened )
+          {
+              M_random = RandomEngine::instance().stream( "LocalizationPFilter", M_random_id );
+              M_random_opened = true;
+          }
+          return M_random;
+      }
+
+    /*!
+      \brief set the sub stream id. the stream is reopened at the next use.
+      \param id sub stream id
+    */
+    void setRandomStreamId( const boost::uint64_t id )
+      {
+          M_random_id = id;
+          M_random_opened = false;
+      }
+
     /*!
       \brief get grid points
       \return grid points
     */
     const
-    std::vector< Vector2D > & points() const
+    ParticleSet & points() const
       {
           return M_points;
       }
 
     const
-    std::vector< Vector2D > & particles() const
+    ParticleSet & particles() const
       {
           return M_particles;
       }
@@ -151,16 +344,47 @@ public:
                                      const GameTime & current );
 
     /*!
-      \brief update points by one marker
+      \brief create the candidate sector of the seen marker, and add it to M_sectors
       \param marker seen marker info
       \param id estimated marker's Id
       \param self_face agent's global face angle
       \param self_face_err agent's global face angle error
+      \return true if the sector is added
     */
-    void updatePointsBy( const VisualSensor::MarkerT & marker,
-                         const MarkerID id,
-                         const double & self_face,
-                         const double & self_face_err );
+    bool addSector( const VisualSensor::MarkerT & marker,
+                    const MarkerID id,
+                    const double & self_face,
+                    const double & self_face_err );
+
+    /*!
+      \brief keep the points within the most of the sectors in M_sectors.
+      \param points point set
+      \return the number of sectors violated by the rest points
+    */
+    int filterBySectors( ParticleSet & points ) const;
+
+    /*!
+      \brief add the points by the systematic resampling with small noise
+      \param points point set
+      \param max_count the number of points after the resampling
+    */
+    void resampleSystematic( ParticleSet & points,
+                             const std::size_t max_count );
+
+    /*!
+      \brief calculate average point and error range of the point set.
+      \param points point set
+      \param ave_pos pointer to the variable to store the averaged point
+      \param ave_err pointer to the variable to store the averaged point error
+      \param min_pos pointer to the variable to store the minimum coordinates
+      \param max_pos pointer to the variable to store the maximum coordinates
+    */
+    static
+    void averageSet( const ParticleSet & points,
+                     Vector2D * ave_pos,
+                     Vector2D * ave_err,
+                     Vector2D * min_pos,
+                     Vector2D * max_pos );
 
     /*!
       \brief calculate average point and error with all points.
@@ -399,6 +623,8 @@ LocalizationPFilter::Impl::updatePointsByMarkers( const VisualSensor::MarkerCont
     // because first marker is used for the initial point set generation
     ++marker;
 
+    M_sectors.clear();
+
     int count = 0;
     g_filter_count = 0;
     for ( ;
@@ -406,13 +632,23 @@ LocalizationPFilter::Impl::updatePointsByMarkers( const VisualSensor::MarkerCont
           ++marker, ++count )
     {
         ++g_filter_count;
-        updatePointsBy( *marker, marker->id_, self_face, self_face_err );
-        resamplePoints( markers.front(), markers.front().id_, self_face, self_face_err );
+        addSector( *marker, marker->id_, self_face, self_face_err );
+    }
+
+    // all sectors are evaluated at once.
+    // the resampled points are filtered again to refine the result.
+    int violated = filterBySectors( M_points );
+    resamplePoints( markers.front(), markers.front().id_, self_face, self_face_err );
+    if ( ! M_sectors.empty() )
+    {
+        violated = filterBySectors( M_points );
     }
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
-                  __FILE__" (updatePointsByMarkers) filtered marker count = %d", count );
+                  __FILE__" (updatePointsByMarkers) filtered marker count = %d"
+                  " points=%d violated=%d",
+                  count, (int)M_points.size(), violated );
 #endif
 }
 
@@ -457,12 +693,17 @@ LocalizationPFilter::Impl::updatePointsByBehindMarker( const VisualSensor::Marke
                   " update by BEHIND marker" );
 #endif
 
-    updatePointsBy( behind_markers.front(),
-                    marker_id,
-                    self_face, self_face_err );
+    M_sectors.clear();
+    if ( ! addSector( behind_markers.front(),
+                      marker_id,
+                      self_face, self_face_err ) )
+    {
+        return;
+    }
 
-    if ( points().empty() )
+    if ( filterBySectors( M_points ) > 0 )
     {
+        // no point is within the behind marker's sector
         std::cerr << __FILE__ << ": " << current
                   << " (updatePointsByBehindMarker) re-generate points"
                   << std::endl;
@@ -478,6 +719,7 @@ LocalizationPFilter::Impl::updatePointsByBehindMarker( const VisualSensor::Marke
         }
 
         g_filter_count = 0;
+        M_sectors.clear();
 
         int count = 0;
         const VisualSensor::MarkerCont::const_iterator end = markers.end();
@@ -486,9 +728,12 @@ LocalizationPFilter::Impl::updatePointsByBehindMarker( const VisualSensor::Marke
               ++marker, ++count )
         {
             ++g_filter_count;
-            updatePointsBy( *marker, marker->id_, self_face, self_face_err );
-            resamplePoints( markers.front(), markers.front().id_, self_face, self_face_err );
+            addSector( *marker, marker->id_, self_face, self_face_err );
         }
+
+        filterBySectors( M_points );
+        resampleSystematic( M_points, M_particle_count );
+        filterBySectors( M_points );
     }
 }
 
@@ -496,11 +741,11 @@ LocalizationPFilter::Impl::updatePointsByBehindMarker( const VisualSensor::Marke
 /*!
 
  */
-void
-LocalizationPFilter::Impl::updatePointsBy( const VisualSensor::MarkerT & marker,
-                                           const MarkerID id,
-                                           const double & self_face,
-                                           const double & self_face_err )
+bool
+LocalizationPFilter::Impl::addSector( const VisualSensor::MarkerT & marker,
+                                      const MarkerID id,
+                                      const double & self_face,
+                                      const double & self_face_err )
 {
     ////////////////////////////////////////////////////////////////////
     // get marker global position
@@ -511,9 +756,9 @@ LocalizationPFilter::Impl::updatePointsBy( const VisualSensor::MarkerT & marker,
                   << " why cannot find nearest behind marker id ??"
                   << std::endl;
         dlog.addText( Logger::WORLD,
-                      __FILE__" (updatePointsBy)"
+                      __FILE__" (addSector)"
                       " why cannot find CLOSE behind marker id ??" );
-        return;
+        return false;
     }
 
     const Vector2D & marker_pos = it->second;
@@ -527,12 +772,12 @@ LocalizationPFilter::Impl::updatePointsBy( const VisualSensor::MarkerT & marker,
                                            &ave_dist,
                                            &dist_error ) )
     {
-        std::cerr << __FILE__ << " (updatePointsBy) unexpected marker distance "
+        std::cerr << __FILE__ << " (addSector) unexpected marker distance "
                   << marker.dist_ << std::endl;
         dlog.addText( Logger::WORLD,
-                      __FILE__" (updatePointsBy) unexpected marker distance = %f",
+                      __FILE__" (addSector) unexpected marker distance = %f",
                       marker.dist_ );
-        return;
+        return false;
     }
 
     // get dir range info
@@ -543,37 +788,19 @@ LocalizationPFilter::Impl::updatePointsBy( const VisualSensor::MarkerT & marker,
 
     ////////////////////////////////////////////////////////////////////
     // create candidate sector
-    const Sector2D sector( marker_pos, // base point
-                           ave_dist - dist_error, // min dist
-                           ave_dist + dist_error, // max dist
-                           AngleDeg( ave_dir - dir_error ), // start left angle
-                           AngleDeg( ave_dir + dir_error ) ); // end right angle
-
-#if 0
-    {
-        // display candidate area
-        Vector2D v1 = Vector2D::polar2vector( sector.radiusMax(), sector.angleLeftStart() );
-        Vector2D v2 = Vector2D::polar2vector( sector.radiusMax(), sector.angleRightEnd() );
-        Vector2D v3 = Vector2D::polar2vector( sector.radiusMin(), sector.angleLeftStart() );
-        Vector2D v4 = Vector2D::polar2vector( sector.radiusMin(), sector.angleRightEnd() );
-        v1 += marker_pos;
-        v2 += marker_pos;
-        v3 += marker_pos;
-        v4 += marker_pos;
+    M_sectors.push_back( MarkerSector( marker_pos, // base point
+                                       ave_dist - dist_error, // min dist
+                                       ave_dist + dist_error, // max dist
+                                       AngleDeg( ave_dir - dir_error ), // start left angle
+                                       AngleDeg( ave_dir + dir_error ) ) ); // end right angle
 
-        int r = 16 * ( g_filter_count % 16 );
-        int g = 16 * ( ( g_filter_count + 5 ) % 16 );
-        int b = 16 * ( ( g_filter_count + 10 ) % 16 );
-        char col[8];
-        snprintf( col, 8, "#%02x%02x%02x", r, g, b );
-        dlog.addLine( Logger::WORLD, v1, v2, col );
-        dlog.addLine( Logger::WORLD, v2, v4, col );
-        dlog.addLine( Logger::WORLD, v4, v3, col );
-        dlog.addLine( Logger::WORLD, v3, v1, col );
-    }
-#endif
 #ifdef DEBUG_PRINT_SHAPE
     {
+        const Sector2D sector( marker_pos,
+                               std::max( 0.0, ave_dist - dist_error ),
+                               ave_dist + dist_error,
+                               AngleDeg( ave_dir - dir_error ),
+                               AngleDeg( ave_dir + dir_error ) );
 
         int r = 16 * ( g_filter_count % 16 );
         int g = 16 * ( ( g_filter_count + 5 ) % 16 );
@@ -586,36 +813,150 @@ LocalizationPFilter::Impl::updatePointsBy( const VisualSensor::MarkerT & marker,
     }
 #endif
 
-    // check whether points are within candidate sector
-    // not contained points are erased from container.
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::WORLD,
+                  __FILE__" (addSector) marker(% 7.2f, % 7.2f)"
+                  " dist=%f, dist_range=%f"
+                  " dir=%.1f, dir_range=%.1f",
+                  marker_pos.x, marker_pos.y,
+                  ave_dist, dist_error * 2.0,
+                  ave_dir, dir_error * 2.0 );
+#endif
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+LocalizationPFilter::Impl::filterBySectors( ParticleSet & points ) const
+{
+    const std::size_t size = points.size();
+    if ( size == 0 )
+    {
+        return 0;
+    }
 
 #ifdef DEBUG_PROFILE_REMOVE
     Timer timer;
-    int initial_size = M_points.size();
 #endif
 
-    M_points.erase( std::remove_if( M_points.begin(),
-                                    M_points.end(),
-                                    std::not1( Vector2D::IsWithin< Sector2D >( sector ) ) ),
-                    M_points.end() );
+    double * w = &points.w_[0];
+    std::fill( w, w + size, 0.0 );
+
+    // count the violated sectors for each point
+    const std::vector< MarkerSector >::const_iterator end = M_sectors.end();
+    for ( std::vector< MarkerSector >::const_iterator s = M_sectors.begin();
+          s != end;
+          ++s )
+    {
+        s->countViolations( &points.x_[0], &points.y_[0], w, size );
+    }
+
+    // keep the points that violate the least sectors.
+    // if no point is consistent with all sectors, the most likely points are kept.
+    const double min_w = *std::min_element( w, w + size );
+
+    std::size_t n = 0;
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        if ( w[i] == min_w )
+        {
+            points.x_[n] = points.x_[i];
+            points.y_[n] = points.y_[i];
+            ++n;
+        }
+    }
+    points.resize( n );
 
 #ifdef DEBUG_PROFILE_REMOVE
     dlog.addText( Logger::WORLD,
-                  __FILE__" (updatePointsBy) elapsed %f [ms] points=%d -> %d",
-                  timer.elapsedReal(),
-                  initial_size, (int)points().size() );
+                  __FILE__" (filterBySectors) elapsed %f [ms] sectors=%d points=%d -> %d",
+                  timer.elapsedReal(), (int)M_sectors.size(), (int)size, (int)n );
 #endif
 
-#ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updatePointsBy) points=%d marker(% 7.2f, % 7.2f)"
-                  " dist=%f, dist_range=%f"
-                  " dir=%.1f, dir_range=%.1f",
-                  (int)M_points.size(),
-                  marker_pos.x, marker_pos.y,
-                  ave_dist, dist_error * 2.0,
-                  ave_dir, dir_error * 2.0 );
-#endif
+    return static_cast< int >( min_w );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationPFilter::Impl::resampleSystematic( ParticleSet & points,
+                                               const std::size_t max_count )
+{
+    const std::size_t count = points.size();
+    if ( count == 0
+         || count >= max_count )
+    {
+        return;
+    }
+
+    // all rest points have the same weight after filterBySectors().
+    // the systematic resampling takes the points at the regular interval
+    // from a single random offset, so every point is copied
+    // (max_count - count) / count times, plus at most one.
+    const std::size_t add = max_count - count;
+    const double step = static_cast< double >( count ) / static_cast< double >( add );
+
+    double offset = 0.0;
+    random().generateUniform( 0.0, step, &offset, 1 );
+
+    // x & y noises are generated at once.
+    // result may not be within current candidate sector
+    M_noise.resize( add * 2 );
+    random().generateUniform( -0.01, 0.01, &M_noise[0], add * 2 );
+
+    points.resize( max_count );
+
+    double * x = &points.x_[0];
+    double * y = &points.y_[0];
+    const double * noise = &M_noise[0];
+    for ( std::size_t i = 0; i < add; ++i )
+    {
+        const std::size_t j = std::min( count - 1,
+                                        static_cast< std::size_t >( offset + step * i ) );
+        x[count + i] = x[j] + noise[i * 2];
+        y[count + i] = y[j] + noise[i * 2 + 1];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationPFilter::Impl::averageSet( const ParticleSet & points,
+                                       Vector2D * ave_pos,
+                                       Vector2D * ave_err,
+                                       Vector2D * min_pos,
+                                       Vector2D * max_pos )
+{
+    const std::size_t size = points.size();
+    const double * x = &points.x_[0];
+    const double * y = &points.y_[0];
+
+    double sum_x = 0.0, sum_y = 0.0;
+    double min_x = x[0], max_x = x[0];
+    double min_y = y[0], max_y = y[0];
+
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        sum_x += x[i];
+        sum_y += y[i];
+        min_x = std::min( min_x, x[i] );
+        max_x = std::max( max_x, x[i] );
+        min_y = std::min( min_y, y[i] );
+        max_y = std::max( max_y, y[i] );
+    }
+
+    ave_pos->assign( sum_x / size, sum_y / size );
+    ave_err->assign( ( max_x - min_x ) * 0.5, ( max_y - min_y ) * 0.5 );
+    min_pos->assign( min_x, min_y );
+    max_pos->assign( max_x, max_y );
 }
 
 /*-------------------------------------------------------------------*/
@@ -641,55 +982,29 @@ LocalizationPFilter::Impl::averagePoints( Vector2D * ave_pos,
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
                   __FILE__" (averagePoints) rest %d points.",
-                  M_points.size() );
+                  (int)M_points.size() );
 #endif
 
-    double max_x, min_x, max_y, min_y;
-
-    max_x = min_x = M_points.front().x;
-    max_y = min_y = M_points.front().y;
-
-    int count = 0;
-    const std::vector< Vector2D >::const_iterator end = M_points.end();
-    for ( std::vector< Vector2D >::const_iterator it = M_points.begin();
-          it != end;
-          ++it, ++count )
-    {
-        *ave_pos += *it;
 #ifdef DEBUG_PRINT_SHAPE
-        // display points
+    // display points
+    for ( std::size_t i = 0; i < M_points.size(); ++i )
+    {
         dlog.addCircle( Logger::WORLD,
-                        *it, 0.005,
+                        M_points.at( i ), 0.005,
                         "#ff0000",
                         true ); // fill
-#endif
-        if ( it->x > max_x )
-        {
-            max_x = it->x;
-        }
-        else if ( it->x < min_x )
-        {
-            min_x = it->x;
-        }
-
-        if ( it->y > max_y )
-        {
-            max_y = it->y;
-        }
-        else if ( it->y < min_y )
-        {
-            min_y = it->y;
-        }
     }
+#endif
 
-    *ave_pos /= static_cast< double >( count );
+    Vector2D min_pos, max_pos;
+    averageSet( M_points, ave_pos, ave_err, &min_pos, &max_pos );
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
                   __FILE__" (averagePoints) self_pos=(%.3f, %.3f)"
                   "  err_x_range=(%.3f, %.3f)  err_y_range(%.3f, %.3f)",
                   ave_pos->x, ave_pos->y,
-                  min_x, max_x, min_y, max_y );
+                  min_pos.x, max_pos.x, min_pos.y, max_pos.y );
 #endif
 #ifdef DEBUG_PRINT_SHAPE
     dlog.addCircle( Logger::WORLD,
@@ -697,9 +1012,6 @@ LocalizationPFilter::Impl::averagePoints( Vector2D * ave_pos,
                     "#0000ff",
                     true ); // fill
 #endif
-
-    ave_err->x = ( max_x - min_x ) * 0.5;
-    ave_err->y = ( max_y - min_y ) * 0.5;
 }
 
 /*-------------------------------------------------------------------*/
@@ -782,7 +1094,7 @@ LocalizationPFilter::Impl::generatePoints( const VisualSensor::MarkerT & marker,
                                 + ( base_vec * ( min_dist + add_dist ) ) );
 #ifdef DEBUG_PRINT_SHAPE
             dlog.addCircle( Logger::WORLD,
-                            M_points.back(), 0.01,
+                            M_points.at( M_points.size() - 1 ), 0.01,
                             "#ffff00" );
 #endif
         }
@@ -809,7 +1121,7 @@ LocalizationPFilter::Impl::generatePoints( const VisualSensor::MarkerT & marker,
                   ave_dir, dir_range );
     dlog.addText( Logger::WORLD,
                   __FILE__" (generatePoints) first point (%f, %f)",
-                  M_points.front().x, M_points.front().y );
+                  M_points.x_[0], M_points.y_[0] );
 #endif
 #if 0
     // display candidate area
@@ -846,12 +1158,9 @@ LocalizationPFilter::Impl::resamplePoints( const VisualSensor::MarkerT & marker,
                                            const double & self_face,
                                            const double & self_face_err )
 {
-    static boost::mt19937 s_engine( 49827140 );
-    static const size_t max_count = 50;
-
     const std::size_t count = M_points.size();
 
-    if ( count >= max_count )
+    if ( count >= M_particle_count )
     {
         return;
     }
@@ -866,53 +1175,23 @@ LocalizationPFilter::Impl::resamplePoints( const VisualSensor::MarkerT & marker,
         return;
     }
 
-    // generate additional points using valid points coordinate
-    // x & y are generated independently.
-    // result may not be within current candidate sector
-
-    boost::uniform_real<> xy_dst( -0.01, 0.01 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_real<> > xy_rng( s_engine, xy_dst );
-
-    if ( count == 1 )
-    {
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (resamplePoints) only one point. regenerate randomly" );
-#endif
-
-        for ( size_t i = count; i < max_count; ++i )
-        {
-            M_points.push_back( M_points[0]
-                                + Vector2D( xy_rng(), xy_rng() ) );
-#ifdef DEBUG_PRINT_SHAPE
-            dlog.addCircle( Logger::WORLD,
-                            M_points.back(), 0.01,
-                            "#ff0000" );
-#endif
-        }
-
-        return;
-    }
-
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
                   __FILE__" (resamplePoints) generate %d points",
-                  (int)(max_count - count) );
+                  (int)( M_particle_count - count ) );
 #endif
 
-    boost::uniform_smallint<> index_dst( 0, count - 1 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_smallint<> > index_rng( s_engine, index_dst );
+    // generate additional points using valid points coordinate
+    resampleSystematic( M_points, M_particle_count );
 
-    for ( size_t i = count; i < max_count; ++i )
-    {
-        M_points.push_back( M_points[index_rng()]
-                            + Vector2D( xy_rng(), xy_rng() ) );
 #ifdef DEBUG_PRINT_SHAPE
+    for ( std::size_t i = count; i < M_points.size(); ++i )
+    {
         dlog.addCircle( Logger::WORLD,
-                        M_points.back(), 0.01,
+                        M_points.at( i ), 0.01,
                         "#ff0000" );
-#endif
     }
+#endif
 }
 
 /*-------------------------------------------------------------------*/
@@ -1200,7 +1479,7 @@ LocalizationPFilter::Impl::generateParticles( const VisualSensor::MarkerT & mark
                                    + ( base_vec * ( min_dist + add_dist ) ) );
 #ifdef DEBUG_PRINT_PARTICLE
             dlog.addCircle( Logger::WORLD,
-                            M_particles.back(), 0.01,
+                            M_particles.at( M_particles.size() - 1 ), 0.01,
                             "#ff00ff" );
 #endif
         }
@@ -1244,21 +1523,20 @@ LocalizationPFilter::Impl::updateParticles( const Vector2D & last_move,
         return;
     }
 
+    Vector2D move = last_move;
     if ( s_last_update_time == current )
     {
-        for ( std::vector< Vector2D >::iterator p = M_particles.begin();
-              p != M_particles.end();
-              ++p )
-        {
-            *p -= s_last_move;
-        }
+        move -= s_last_move;
     }
 
-    for ( std::vector< Vector2D >::iterator p = M_particles.begin();
-          p != M_particles.end();
-          ++p )
+    const std::size_t size = M_particles.size();
+    for ( std::size_t i = 0; i < size; ++i )
     {
-        *p += last_move;
+        M_particles.x_[i] += move.x;
+    }
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        M_particles.y_[i] += move.y;
     }
 
     s_last_move = last_move;
@@ -1283,13 +1561,24 @@ LocalizationPFilter::Impl::filterParticlesByMarkers( const VisualSensor::MarkerC
         ++marker;
     }
 
+    M_sectors.clear();
     for ( ;
           marker != end;
           ++marker )
     {
-        filterParticles( *marker, marker->id_,
-                         self_face, self_face_err,
-                         current );
+        addSector( *marker, marker->id_, self_face, self_face_err );
+    }
+
+    if ( filterBySectors( M_particles ) > 0
+         && ! markers.empty() )
+    {
+#ifdef DEBUG_PRINT_PARTICLE
+        dlog.addText( Logger::WORLD,
+                      __FILE__" (filterParticlesByMarkers) no consistent particle. regenerate" );
+#endif
+        generateParticles( markers.front(), markers.front().id_,
+                           self_face, self_face_err, current );
+        filterBySectors( M_particles );
     }
 }
 
@@ -1348,84 +1637,21 @@ LocalizationPFilter::Impl::filterParticles( const VisualSensor::MarkerT & marker
                                             const double & self_face_err,
                                             const GameTime & current )
 {
-    //
-    // get marker global position
-    //
-    MarkerMap::const_iterator marker_it = objectTable().landmarkMap().find( id );
-    if ( marker_it == objectTable().landmarkMap().end() )
-    {
-        std::cerr << __FILE__ << ": " << __LINE__
-                  << " why cannot find nearest behind marker id ??"
-                  << std::endl;
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (filterPartiles)"
-                      " why cannot find CLOSE behind marker id ??" );
-        return;
-    }
-
-    const Vector2D & marker_pos = marker_it->second;
-
-    //
-    // get distance range
-    //
-    double ave_dist, dist_error;
-    if ( ! objectTable().getStaticObjInfo( marker.dist_,
-                                           &ave_dist,
-                                           &dist_error ) )
+    M_sectors.clear();
+    if ( ! addSector( marker, id, self_face, self_face_err ) )
     {
-        std::cerr << __FILE__ << " (filterParticles) unexpected marker distance "
-                  << marker.dist_ << std::endl;
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (filterParticles) unexpected marker distance = %f",
-                      marker.dist_ );
         return;
     }
 
-    //
-    // get dir range
-    //
-    double ave_dir, dir_error;
-    getDirRange( marker.dir_, self_face, self_face_err, &ave_dir, &dir_error );
-    // reverse, because base point calculated in above function is marker point.
-    ave_dir += 180.0;
-
-    //
-    // create candidate sector
-    //
-    const Sector2D sector( marker_pos, // base point
-                           ave_dist - dist_error, // min dist
-                           ave_dist + dist_error, // max dist
-                           AngleDeg( ave_dir - dir_error ), // start left angle
-                           AngleDeg( ave_dir + dir_error ) ); // end right angle
-
-#ifdef DEBUG_PRINT_PARTICLE
-    // display candidate area
-    Vector2D v1 = Vector2D::polar2vector( sector.radiusMax(), sector.angleLeftStart() );
-    Vector2D v2 = Vector2D::polar2vector( sector.radiusMax(), sector.angleRightEnd() );
-    Vector2D v3 = Vector2D::polar2vector( sector.radiusMin(), sector.angleLeftStart() );
-    Vector2D v4 = Vector2D::polar2vector( sector.radiusMin(), sector.angleRightEnd() );
-    v1 += marker_pos;
-    v2 += marker_pos;
-    v3 += marker_pos;
-    v4 += marker_pos;
-
-    dlog.addLine( Logger::WORLD, v1, v2, "#aaaaaa" );
-    dlog.addLine( Logger::WORLD, v2, v4, "#aaaaaa" );
-    dlog.addLine( Logger::WORLD, v4, v3, "#aaaaaa" );
-    dlog.addLine( Logger::WORLD, v3, v1, "#aaaaaa" );
-#endif
-
-    M_particles.erase( std::remove_if( M_particles.begin(),
-                                       M_particles.end(),
-                                       std::not1( Vector2D::IsWithin< Sector2D >( sector ) ) ),
-                       M_particles.end() );
+    const int violated = filterBySectors( M_particles );
 
 #ifdef DEBUG_PRINT_PARTICLE
     dlog.addText( Logger::WORLD,
                   __FILE__" (filterParticles) after filtering. %d particles",
                   (int)M_particles.size() );
 #endif
-    if ( M_particles.empty() )
+    if ( M_particles.empty()
+         || violated > 0 )
     {
 #ifdef DEBUG_PRINT_PARTICLE
         dlog.addText( Logger::WORLD,
@@ -1442,31 +1668,26 @@ LocalizationPFilter::Impl::filterParticles( const VisualSensor::MarkerT & marker
 void
 LocalizationPFilter::Impl::resampleParticles()
 {
-    static boost::mt19937 s_gen( 281998167 );
-
     if ( M_particles.empty()
-         || M_particles.size() >= 100 )
+         || M_particles.size() >= M_particle_count )
     {
         return;
     }
 
-    boost::uniform_smallint<> dst( 0, M_particles.size() - 1 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_smallint<> > rng( s_gen, dst );
-
-    for ( int i = M_particles.size(); i < 100; ++i )
-    {
-        int i0 = rng();
-        int i1 = rng();
+#ifdef DEBUG_PRINT_PARTICLE
+    const std::size_t count = M_particles.size();
+#endif
 
-        M_particles.push_back( ( M_particles[i0] + M_particles[i1] ) * 0.5 );
+    resampleSystematic( M_particles, M_particle_count );
 
 #ifdef DEBUG_PRINT_PARTICLE
+    for ( std::size_t i = count; i < M_particles.size(); ++i )
+    {
         dlog.addText( Logger::WORLD,
-                      __FILE__" (resampleParticles) no resampling %d %d -> (%f %f)",
-                      i0, i1,
-                      M_particles.back().x, M_particles.back().y );
-#endif
+                      __FILE__" (resampleParticles) resampled (%f %f)",
+                      M_particles.x_[i], M_particles.y_[i] );
     }
+#endif
 }
 
 /*-------------------------------------------------------------------*/
@@ -1489,44 +1710,19 @@ LocalizationPFilter::Impl::averageParticles( Vector2D * ave_pos,
         return;
     }
 
-    double max_x, min_x, max_y, min_y;
-
-    max_x = min_x = M_particles.front().x;
-    max_y = min_y = M_particles.front().y;
-
-    const std::vector< Vector2D >::const_iterator end = M_particles.end();
-    for ( std::vector< Vector2D >::const_iterator it = M_particles.begin();
-          it != end;
-          ++it )
-    {
-        *ave_pos += *it;
 #ifdef DEBUG_PRINT_PARTICLE
-        // display points
+    // display points
+    for ( std::size_t i = 0; i < M_particles.size(); ++i )
+    {
         dlog.addCircle( Logger::WORLD,
-                        *it, 0.01,
+                        M_particles.at( i ), 0.01,
                         "#00ffff",
                         true ); // fill
-#endif
-        if ( it->x > max_x )
-        {
-            max_x = it->x;
-        }
-        else if ( it->x < min_x )
-        {
-            min_x = it->x;
-        }
-
-        if ( it->y > max_y )
-        {
-            max_y = it->y;
-        }
-        else if ( it->y < min_y )
-        {
-            min_y = it->y;
-        }
     }
+#endif
 
-    *ave_pos /= static_cast< double >( M_particles.size() );
+    Vector2D min_pos, max_pos;
+    averageSet( M_particles, ave_pos, ave_err, &min_pos, &max_pos );
 
 #ifdef DEBUG_PRINT_PARTICLE
     dlog.addCircle( Logger::WORLD,
@@ -1540,21 +1736,20 @@ LocalizationPFilter::Impl::averageParticles( Vector2D * ave_pos,
                   " ave=(%.3f, %.3f) err_x=[%.3f, %.3f] err_y=[%.3f, %.3f]",
                   (int)M_particles.size(),
                   ave_pos->x, ave_pos->y,
-                  min_x, max_x, min_y, max_y );
+                  min_pos.x, max_pos.x, min_pos.y, max_pos.y );
 #endif
-
-    ave_err->x = ( max_x - min_x ) * 0.5;
-    ave_err->y = ( max_y - min_y ) * 0.5;
 }
 
 /////////////////////////////////////////////////////////////////////
 
+const int LocalizationPFilter::DEFAULT_PARTICLE_COUNT;
+
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-LocalizationPFilter::LocalizationPFilter()
-    : M_impl( new Impl() )
+LocalizationPFilter::LocalizationPFilter( const int particle_count )
+    : M_impl( new Impl( particle_count ) )
 {
 
 }
@@ -1579,6 +1774,16 @@ LocalizationPFilter::~LocalizationPFilter()
 //     M_impl->updateParticles( self_vel, current );
 // }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationPFilter::setRandomStreamId( const boost::uint64_t id )
+{
+    M_impl->setRandomStreamId( id );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -57,11 +57,16 @@ private:
     LocalizationPFilter & operator=( const LocalizationPFilter & );
 
 public:
+
+    //! default number of the particles kept after the filtering
+    static const int DEFAULT_PARTICLE_COUNT = 50;
+
     /*!
       \brief create internal implementation
-      \param ourside our team side
+      \param particle_count the number of the particles kept after the filtering
     */
-    LocalizationPFilter();
+    explicit
+    LocalizationPFilter( const int particle_count = DEFAULT_PARTICLE_COUNT );
 
     /*!
       \brief implicitly delete internal impl
@@ -71,6 +76,13 @@ public:
 
 public:
 
+    /*!
+      \brief set the sub stream id of the random stream.
+      \param id sub stream id given to RandomEngine::stream()
+     */
+    virtual
+    void setRandomStreamId( const boost::uint64_t id );
+
    /*!
       \brief estimate self facing direction.
       \param body analyzed body information
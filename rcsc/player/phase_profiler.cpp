@@ -0,0 +1,293 @@
+// -*-c++-*-
+
+/*!
+  \file phase_profiler.cpp
+  \brief per cycle latency profiler of the player agent Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "phase_profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <sys/time.h> // gettimeofday()
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+LatencyHistogram::LatencyHistogram()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyHistogram::clear()
+{
+    for ( int i = 0; i < BUCKETS; ++i )
+    {
+        M_counts[i] = 0;
+    }
+    M_count = 0;
+    M_sum = 0.0;
+    M_max = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+LatencyHistogram::bucket( const long usec )
+{
+    if ( usec < SUB_BUCKETS )
+    {
+        return static_cast< int >( usec );
+    }
+
+    int msb = 0;
+    for ( long v = usec; v > 1; v >>= 1 )
+    {
+        ++msb;
+    }
+
+    const int exponent = msb - SUB_BUCKET_BITS;
+    if ( exponent > MAX_EXPONENT )
+    {
+        return BUCKETS - 1;
+    }
+
+    const int mantissa = static_cast< int >( usec >> exponent ); // [SUB_BUCKETS, 2*SUB_BUCKETS)
+    return SUB_BUCKETS * ( exponent + 1 ) + ( mantissa - SUB_BUCKETS );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+long
+LatencyHistogram::lower_bound( const int i )
+{
+    if ( i < SUB_BUCKETS )
+    {
+        return i;
+    }
+
+    const int exponent = i / SUB_BUCKETS - 1;
+    const long mantissa = i % SUB_BUCKETS + SUB_BUCKETS;
+    return mantissa << exponent;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+long
+LatencyHistogram::upper_bound( const int i )
+{
+    if ( i < SUB_BUCKETS )
+    {
+        return i;
+    }
+
+    const int exponent = i / SUB_BUCKETS - 1;
+    const long mantissa = i % SUB_BUCKETS + SUB_BUCKETS;
+    return ( ( mantissa + 1 ) << exponent ) - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+long
+LatencyHistogram::percentile( const double percent ) const
+{
+    if ( M_count == 0 )
+    {
+        return 0;
+    }
+
+    long rank = static_cast< long >( M_count * percent / 100.0 + 0.5 );
+    if ( rank < 1 ) rank = 1;
+    if ( rank > M_count ) rank = M_count;
+
+    long sum = 0;
+    for ( int i = 0; i < BUCKETS; ++i )
+    {
+        sum += M_counts[i];
+        if ( sum >= rank )
+        {
+            return std::min( upper_bound( i ), M_max );
+        }
+    }
+
+    return M_max;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhaseProfiler::Scope::start()
+{
+    struct timeval tv;
+    ::gettimeofday( &tv, NULL );
+    M_sec = tv.tv_sec;
+    M_usec = tv.tv_usec;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhaseProfiler::Scope::stop()
+{
+    struct timeval tv;
+    ::gettimeofday( &tv, NULL );
+    M_profiler->add( M_phase,
+                     ( tv.tv_sec - M_sec ) * 1000 * 1000 + ( tv.tv_usec - M_usec ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PhaseProfiler::PhaseProfiler()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhaseProfiler::clear()
+{
+    for ( int i = 0; i < MAX_PHASE; ++i )
+    {
+        M_histograms[i].clear();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+PhaseProfiler::phase_name( const Phase phase )
+{
+    static const char * names[] = {
+        "recv",
+        "parse_see",
+        "update_after_see",
+        "update_before_decision",
+        "intercept",
+        "action_impl",
+        "make_command",
+        "send",
+        "action",
+    };
+
+    if ( phase < 0 || MAX_PHASE <= phase )
+    {
+        return "unknown";
+    }
+
+    return names[phase];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+PhaseProfiler::print( std::ostream & os ) const
+{
+    char buf[256];
+
+    std::snprintf( buf, sizeof( buf ),
+                   "%-24s %8s %10s %8s %8s %8s %8s %8s\n",
+                   "phase", "count", "mean", "p50", "p90", "p99", "p99.9", "max" );
+    os << buf;
+
+    for ( int i = 0; i < MAX_PHASE; ++i )
+    {
+        const LatencyHistogram & h = M_histograms[i];
+        std::snprintf( buf, sizeof( buf ),
+                       "%-24s %8ld %10.1f %8ld %8ld %8ld %8ld %8ld\n",
+                       phase_name( static_cast< Phase >( i ) ),
+                       h.count(),
+                       h.mean(),
+                       h.percentile( 50.0 ),
+                       h.percentile( 90.0 ),
+                       h.percentile( 99.0 ),
+                       h.percentile( 99.9 ),
+                       h.max() );
+        os << buf;
+    }
+
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+PhaseProfiler::printHistogram( std::ostream & os ) const
+{
+    for ( int i = 0; i < MAX_PHASE; ++i )
+    {
+        const LatencyHistogram & h = M_histograms[i];
+        for ( int b = 0; b < LatencyHistogram::BUCKETS; ++b )
+        {
+            if ( h.bucketCount( b ) == 0 ) continue;
+
+            os << phase_name( static_cast< Phase >( i ) ) << ' '
+               << LatencyHistogram::lower_bound( b ) << ' '
+               << LatencyHistogram::upper_bound( b ) << ' '
+               << h.bucketCount( b ) << '\n';
+        }
+    }
+
+    return os;
+}
+
+}
@@ -0,0 +1,301 @@
+// -*-c++-*-
+
+/*!
+  \file phase_profiler.h
+  \brief per cycle latency profiler of the player agent Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PHASE_PROFILER_H
+#define RCSC_PLAYER_PHASE_PROFILER_H
+
+#include <iostream>
+
+namespace rcsc {
+
+/*!
+  \class LatencyHistogram
+  \brief fixed size log-linear histogram of the elapsed time.
+
+  Values are recorded in micro seconds. Values less than SUB_BUCKETS
+  have their own bucket. Larger values are stored in SUB_BUCKETS buckets
+  for each power of two, so that the relative error is less than
+  1/SUB_BUCKETS. No memory is allocated after the construction.
+ */
+class LatencyHistogram {
+public:
+
+    enum {
+        SUB_BUCKET_BITS = 4,
+        SUB_BUCKETS = 1 << SUB_BUCKET_BITS, //!< the number of buckets for each power of two
+        MAX_EXPONENT = 27, //!< values up to 2^31 usec can be recorded.
+        BUCKETS = SUB_BUCKETS * ( MAX_EXPONENT + 2 ),
+    };
+
+private:
+
+    long M_counts[BUCKETS]; //!< the number of values in each bucket
+    long M_count; //!< the number of recorded values
+    double M_sum; //!< sum of recorded values
+    long M_max; //!< max recorded value
+
+public:
+
+    /*!
+      \brief create an empty histogram
+     */
+    LatencyHistogram();
+
+    /*!
+      \brief remove all recorded values
+     */
+    void clear();
+
+    /*!
+      \brief record the elapsed time
+      \param usec elapsed time [usec]
+     */
+    void add( long usec )
+      {
+          if ( usec < 0 ) usec = 0;
+          ++M_counts[bucket( usec )];
+          ++M_count;
+          M_sum += usec;
+          if ( usec > M_max ) M_max = usec;
+      }
+
+    /*!
+      \brief get the number of recorded values
+      \return the number of recorded values
+     */
+    long count() const
+      {
+          return M_count;
+      }
+
+    /*!
+      \brief get the mean value
+      \return mean value [usec]
+     */
+    double mean() const
+      {
+          return ( M_count > 0 ? M_sum / M_count : 0.0 );
+      }
+
+    /*!
+      \brief get the max value
+      \return max value [usec]
+     */
+    long max() const
+      {
+          return M_max;
+      }
+
+    /*!
+      \brief get the number of values in the bucket
+      \param i bucket index
+      \return the number of values
+     */
+    long bucketCount( const int i ) const
+      {
+          return M_counts[i];
+      }
+
+    /*!
+      \brief get the value at the given percentile
+      \param percent percentile [0, 100]
+      \return the upper bound of the bucket that contains the percentile [usec]
+     */
+    long percentile( const double percent ) const;
+
+    /*!
+      \brief get the bucket index of the value
+      \param usec value [usec]
+      \return bucket index
+     */
+    static
+    int bucket( const long usec );
+
+    /*!
+      \brief get the smallest value of the bucket
+      \param i bucket index
+      \return the lower bound [usec]
+     */
+    static
+    long lower_bound( const int i );
+
+    /*!
+      \brief get the largest value of the bucket
+      \param i bucket index
+      \return the upper bound [usec]
+     */
+    static
+    long upper_bound( const int i );
+};
+
+/*!
+  \class PhaseProfiler
+  \brief latency histograms for each processing phase of the player agent.
+
+  The phases can be nested. For example, INTERCEPT is a part of
+  UPDATE_BEFORE_DECISION, and ACTION contains all decision phases.
+ */
+class PhaseProfiler {
+public:
+
+    /*!
+      \enum Phase
+      \brief processing phase types
+     */
+    enum Phase {
+        RECV, //!< BasicClient::recvMessage()
+        PARSE_SEE, //!< VisualSensor::parse()
+        UPDATE_AFTER_SEE, //!< WorldModel::updateAfterSee()
+        UPDATE_BEFORE_DECISION, //!< WorldModel::updateJustBeforeDecision()
+        INTERCEPT, //!< InterceptTable::update()
+        ACTION_IMPL, //!< PlayerAgent::actionImpl()
+        MAKE_COMMAND, //!< ActionEffector::makeCommand()
+        SEND, //!< BasicClient::sendMessage()
+        ACTION, //!< whole of PlayerAgent::action()
+        MAX_PHASE
+    };
+
+    /*!
+      \class Scope
+      \brief stop watch that records the elapsed time of the block.
+
+      If the profiler is NULL, nothing is done.
+     */
+    class Scope {
+    private:
+        PhaseProfiler * M_profiler; //!< target profiler. may be NULL
+        Phase M_phase; //!< recorded phase
+        long M_sec; //!< start time
+        long M_usec; //!< start time
+
+        // nocopyable
+        Scope( const Scope & );
+        Scope & operator=( const Scope & );
+
+    public:
+
+        /*!
+          \brief start the stop watch
+          \param profiler pointer to the profiler. may be NULL
+          \param phase recorded phase
+         */
+        Scope( PhaseProfiler * profiler,
+               const Phase phase )
+            : M_profiler( profiler ),
+              M_phase( phase ),
+              M_sec( 0 ),
+              M_usec( 0 )
+          {
+              if ( M_profiler ) start();
+          }
+
+        /*!
+          \brief record the elapsed time
+         */
+        ~Scope()
+          {
+              if ( M_profiler ) stop();
+          }
+
+    private:
+        void start();
+        void stop();
+    };
+
+private:
+
+    LatencyHistogram M_histograms[MAX_PHASE]; //!< histogram for each phase
+
+    // nocopyable
+    PhaseProfiler( const PhaseProfiler & );
+    PhaseProfiler & operator=( const PhaseProfiler & );
+
+public:
+
+    /*!
+      \brief create empty histograms
+     */
+    PhaseProfiler();
+
+    /*!
+      \brief remove all recorded values
+     */
+    void clear();
+
+    /*!
+      \brief record the elapsed time of the phase
+      \param phase phase type
+      \param usec elapsed time [usec]
+     */
+    void add( const Phase phase,
+              const long usec )
+      {
+          M_histograms[phase].add( usec );
+      }
+
+    /*!
+      \brief get the histogram of the phase
+      \param phase phase type
+      \return const reference to the histogram
+     */
+    const LatencyHistogram & histogram( const Phase phase ) const
+      {
+          return M_histograms[phase];
+      }
+
+    /*!
+      \brief print the summary table (count, mean, percentiles, max) of each phase
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & print( std::ostream & os ) const;
+
+    /*!
+      \brief print all non empty buckets.
+      \param os reference to the output stream
+      \return reference to the output stream
+
+      Each line has "<phase> <lower_usec> <upper_usec> <count>".
+     */
+    std::ostream & printHistogram( std::ostream & os ) const;
+
+    /*!
+      \brief get the name string of the phase
+      \param phase phase type
+      \return name string
+     */
+    static
+    const char * phase_name( const Phase phase );
+};
+
+}
+
+#endif
@@ -0,0 +1,607 @@
+// -*-c++-*-
+
+/*!
+  \file physics_stepper.cpp
+  \brief headless soccer physics simulator Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "physics_stepper.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/geom/angle_deg.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+namespace {
+
+//! velocity rate after the collision
+const double COLLISION_VEL_RATE = -0.1;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the player type parameter
+*/
+const PlayerType *
+get_player_type( const int id )
+{
+    const PlayerType * ptype = PlayerTypeSet::i().get( id );
+    if ( ! ptype )
+    {
+        ptype = PlayerTypeSet::i().get( Hetero_Unknown );
+    }
+    return ptype;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PhysicsStepper::PhysicsStepper( const unsigned int seed )
+    : M_rng( seed ),
+      M_noise( true ),
+      M_cycle( 0 )
+{
+    M_players.reserve( 22 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::setSeed( const unsigned int seed )
+{
+    M_rng.seed( seed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::setBall( const Vector2D & pos,
+                         const Vector2D & vel )
+{
+    M_ball.pos_ = pos;
+    M_ball.vel_ = vel;
+    M_ball.accel_.assign( 0.0, 0.0 );
+    M_ball.holder_ = -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PhysicsStepper::addPlayer( const SideID side,
+                           const int unum,
+                           const int player_type,
+                           const bool goalie,
+                           const Vector2D & pos,
+                           const double & body )
+{
+    Player p;
+    p.side_ = side;
+    p.unum_ = unum;
+    p.type_ = player_type;
+    p.goalie_ = goalie;
+    p.player_type_ = get_player_type( player_type );
+    p.pos_ = pos;
+    p.body_ = AngleDeg::normalize_angle( body );
+    p.stamina_.init( *p.player_type_ );
+
+    M_players.push_back( p );
+    return static_cast< int >( M_players.size() ) - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::setPlayer( const int index,
+                           const Vector2D & pos,
+                           const Vector2D & vel,
+                           const double & body )
+{
+    Player & p = M_players[index];
+    p.pos_ = pos;
+    p.vel_ = vel;
+    p.accel_.assign( 0.0, 0.0 );
+    p.body_ = AngleDeg::normalize_angle( body );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PhysicsStepper::setCommand( const int index,
+                            const PlayerBodyCommand & command )
+{
+    Player & p = M_players[index];
+
+    switch ( command.type() ) {
+    case PlayerCommand::DASH:
+        p.arg1_ = static_cast< const PlayerDashCommand & >( command ).dashPower();
+        p.arg2_ = static_cast< const PlayerDashCommand & >( command ).dashDir();
+        break;
+    case PlayerCommand::TURN:
+        p.arg1_ = static_cast< const PlayerTurnCommand & >( command ).turnMoment();
+        p.arg2_ = 0.0;
+        break;
+    case PlayerCommand::KICK:
+        p.arg1_ = static_cast< const PlayerKickCommand & >( command ).kickPower();
+        p.arg2_ = static_cast< const PlayerKickCommand & >( command ).kickDir();
+        break;
+    case PlayerCommand::TACKLE:
+        p.arg1_ = static_cast< const PlayerTackleCommand & >( command ).tacklePowerOrDir();
+        p.arg2_ = 0.0;
+        break;
+    case PlayerCommand::CATCH:
+        p.arg1_ = static_cast< const PlayerCatchCommand & >( command ).catchDir();
+        p.arg2_ = 0.0;
+        break;
+    case PlayerCommand::MOVE:
+        p.arg1_ = static_cast< const PlayerMoveCommand & >( command ).movePos().x;
+        p.arg2_ = static_cast< const PlayerMoveCommand & >( command ).movePos().y;
+        break;
+    default:
+        return false;
+    }
+
+    p.command_ = command.type();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::setTurnNeck( const int index,
+                             const double & moment )
+{
+    M_players[index].neck_moment_ = moment;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+PhysicsStepper::isKickable( const int index ) const
+{
+    const Player & p = M_players[index];
+    return p.pos_.dist2( M_ball.pos_ ) <= std::pow( p.player_type_->kickableArea(), 2 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+PhysicsStepper::drand( const double & min,
+                       const double & max )
+{
+    return min + ( max - min ) * ( M_rng() / 4294967296.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::step()
+{
+    const ServerParam & SP = ServerParam::i();
+
+    //
+    // perform commands
+    //
+    for ( int i = 0; i < static_cast< int >( M_players.size() ); ++i )
+    {
+        Player & p = M_players[i];
+        p.collision_ = false;
+
+        bool dashed = false;
+        if ( p.tackle_cycles_ > 0 )
+        {
+            // frozen by the last tackle
+            --p.tackle_cycles_;
+        }
+        else
+        {
+            switch ( p.command_ ) {
+            case PlayerCommand::DASH:
+                dash( p );
+                dashed = true;
+                break;
+            case PlayerCommand::TURN:
+                turn( p );
+                break;
+            case PlayerCommand::KICK:
+                kick( i );
+                break;
+            case PlayerCommand::TACKLE:
+                tackle( i );
+                break;
+            case PlayerCommand::CATCH:
+                catchBall( i );
+                break;
+            case PlayerCommand::MOVE:
+                p.pos_.assign( p.arg1_, p.arg2_ );
+                p.vel_.assign( 0.0, 0.0 );
+                break;
+            default:
+                break;
+            }
+        }
+
+        if ( p.neck_moment_ != 0.0 )
+        {
+            p.neck_ = SP.normalizeNeckAngle( p.neck_ + SP.normalizeNeckMoment( p.neck_moment_ ) );
+        }
+
+        if ( ! dashed )
+        {
+            p.stamina_.simulateWait( *p.player_type_ );
+        }
+
+        p.command_ = PlayerCommand::BYE;
+        p.neck_moment_ = 0.0;
+    }
+
+    //
+    // movement
+    //
+    if ( M_ball.holder_ < 0 )
+    {
+        move( M_ball.pos_, M_ball.vel_, M_ball.accel_,
+              SP.ballAccelMax(), SP.ballSpeedMax(), SP.ballRand(), SP.ballDecay() );
+    }
+
+    for ( std::vector< Player >::iterator p = M_players.begin(), end = M_players.end();
+          p != end;
+          ++p )
+    {
+        move( p->pos_, p->vel_, p->accel_,
+              SP.playerAccelMax(), p->player_type_->playerSpeedMax(),
+              SP.playerRand(), p->player_type_->playerDecay() );
+    }
+
+    collide();
+
+    if ( M_ball.holder_ >= 0 )
+    {
+        const Player & holder = M_players[M_ball.holder_];
+        M_ball.pos_ = holder.pos_ + Vector2D::polar2vector( holder.player_type_->playerSize() + SP.ballSize(),
+                                                            holder.body_ );
+        M_ball.vel_.assign( 0.0, 0.0 );
+        M_ball.accel_.assign( 0.0, 0.0 );
+    }
+
+    ++M_cycle;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::dash( Player & p )
+{
+    const ServerParam & SP = ServerParam::i();
+    const PlayerType & ptype = *p.player_type_;
+
+    const double effort = p.stamina_.effort();
+    const double dir = SP.discretizeDashAngle( SP.normalizeDashAngle( p.arg2_ ) );
+    double power = SP.normalizeDashPower( p.arg1_ );
+
+    // the consumed stamina cannot exceed the available stamina
+    const bool back_dash = ( power < 0.0 );
+    double power_need = ( back_dash ? power * -2.0 : power );
+    power_need = std::min( power_need, p.stamina_.stamina() + ptype.extraStamina() );
+    power = ( back_dash ? power_need / -2.0 : power_need );
+
+    p.stamina_.simulateDash( ptype, power );
+
+    const double accel_mag = power * ptype.dashRate( effort, dir );
+    p.accel_ += Vector2D::polar2vector( accel_mag, AngleDeg( p.body_ + dir ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::turn( Player & p )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    double moment = SP.normalizeMoment( p.arg1_ );
+    if ( M_noise )
+    {
+        moment *= 1.0 + drand( -SP.playerRand(), SP.playerRand() );
+    }
+
+    p.body_ = AngleDeg::normalize_angle( p.body_
+                                         + p.player_type_->effectiveTurn( moment, p.vel_.r() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::kick( const int index )
+{
+    const ServerParam & SP = ServerParam::i();
+    const Player & p = M_players[index];
+    const PlayerType & ptype = *p.player_type_;
+
+    if ( M_ball.holder_ >= 0
+         && M_ball.holder_ != index )
+    {
+        return;
+    }
+
+    const Vector2D rel = M_ball.pos_ - p.pos_;
+    const double ball_dist = rel.r();
+    if ( ball_dist > ptype.kickableArea() )
+    {
+        return;
+    }
+
+    // release the ball
+    M_ball.holder_ = -1;
+
+    const double power = SP.normalizePower( p.arg1_ );
+    const double dir = SP.normalizeMoment( p.arg2_ );
+    const double dir_diff = ( rel.th() - p.body_ ).abs();
+
+    Vector2D accel = Vector2D::polar2vector( power * ptype.kickRate( ball_dist, dir_diff ),
+                                             AngleDeg( p.body_ + dir ) );
+
+    if ( M_noise
+         && ptype.kickRand() > 0.0 )
+    {
+        const double dist_ball = ball_dist - ptype.playerSize() - SP.ballSize();
+        const double pos_rate = 0.5 + 0.25 * ( dir_diff / 180.0 + dist_ball / ptype.kickableMargin() );
+        const double speed_rate = 0.5 + 0.5 * ( M_ball.vel_.r() / ( SP.ballSpeedMax() * SP.ballDecay() ) );
+        const double max_rand = ptype.kickRand() * ( power / SP.maxPower() ) * ( pos_rate + speed_rate );
+        accel += Vector2D::polar2vector( drand( 0.0, max_rand ), AngleDeg( drand( -180.0, 180.0 ) ) );
+    }
+
+    M_ball.accel_ += accel;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::tackle( const int index )
+{
+    const ServerParam & SP = ServerParam::i();
+    Player & p = M_players[index];
+
+    p.tackle_cycles_ = SP.tackleCycles();
+
+    if ( M_ball.holder_ >= 0 )
+    {
+        return;
+    }
+
+    const Vector2D rel = ( M_ball.pos_ - p.pos_ ).rotatedVector( -p.body_ );
+
+    double fail_prob = 1.0;
+    if ( rel.x > 0.0 )
+    {
+        fail_prob = ( std::pow( rel.x / SP.tackleDist(), SP.tackleExponent() )
+                      + std::pow( std::fabs( rel.y ) / SP.tackleWidth(), SP.tackleExponent() ) );
+    }
+    else if ( SP.tackleBackDist() > 0.0 )
+    {
+        fail_prob = ( std::pow( -rel.x / SP.tackleBackDist(), SP.tackleExponent() )
+                      + std::pow( std::fabs( rel.y ) / SP.tackleWidth(), SP.tackleExponent() ) );
+    }
+
+    if ( fail_prob >= 1.0 )
+    {
+        return;
+    }
+
+    if ( M_noise
+         ? drand( 0.0, 1.0 ) < fail_prob
+         : fail_prob > 0.5 )
+    {
+        return;
+    }
+
+    const double dir = AngleDeg::normalize_angle( p.arg1_ );
+    double power = ( SP.maxBackTacklePower()
+                     + ( SP.maxTacklePower() - SP.maxBackTacklePower() )
+                     * ( 1.0 - std::fabs( dir ) / 180.0 ) );
+    power *= SP.tacklePowerRate();
+    power *= 1.0 - 0.5 * ( rel.th().abs() / 180.0 );
+
+    M_ball.accel_ += Vector2D::polar2vector( power, AngleDeg( p.body_ + dir ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::catchBall( const int index )
+{
+    const ServerParam & SP = ServerParam::i();
+    const Player & p = M_players[index];
+
+    if ( ! p.goalie_
+         || M_ball.holder_ >= 0 )
+    {
+        return;
+    }
+
+    const Vector2D rel = ( M_ball.pos_ - p.pos_ ).rotatedVector( -( p.body_ + SP.normalizeMoment( p.arg1_ ) ) );
+    const double length = SP.catchAreaLength() * p.player_type_->catchAreaLengthStretch();
+
+    if ( rel.x < 0.0
+         || length < rel.x
+         || SP.catchAreaWidth() * 0.5 < std::fabs( rel.y ) )
+    {
+        return;
+    }
+
+    const double prob = p.player_type_->getCatchProbability( rel.r() );
+    if ( M_noise
+         ? drand( 0.0, 1.0 ) >= prob
+         : prob < 0.5 )
+    {
+        return;
+    }
+
+    M_ball.holder_ = index;
+    M_ball.vel_.assign( 0.0, 0.0 );
+    M_ball.accel_.assign( 0.0, 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::move( Vector2D & pos,
+                      Vector2D & vel,
+                      Vector2D & accel,
+                      const double & accel_max,
+                      const double & speed_max,
+                      const double & rand,
+                      const double & decay )
+{
+    if ( accel.x != 0.0 || accel.y != 0.0 )
+    {
+        if ( accel.r2() > accel_max * accel_max )
+        {
+            accel.setLength( accel_max );
+        }
+
+        vel += accel;
+
+        if ( vel.r2() > speed_max * speed_max )
+        {
+            vel.setLength( speed_max );
+        }
+    }
+
+    if ( M_noise
+         && rand > 0.0 )
+    {
+        const double max_rand = vel.r() * rand;
+        vel.x += drand( -max_rand, max_rand );
+        vel.y += drand( -max_rand, max_rand );
+    }
+
+    pos += vel;
+    vel *= decay;
+    accel.assign( 0.0, 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PhysicsStepper::collide()
+{
+    const ServerParam & SP = ServerParam::i();
+    const int size = static_cast< int >( M_players.size() );
+
+    for ( int i = 0; i < size; ++i )
+    {
+        Player & p = M_players[i];
+
+        //
+        // player - ball
+        //
+        if ( M_ball.holder_ != i )
+        {
+            const double min_dist = p.player_type_->playerSize() + SP.ballSize();
+            const Vector2D rel = M_ball.pos_ - p.pos_;
+            if ( rel.r2() < min_dist * min_dist )
+            {
+                const Vector2D dir = ( rel.r2() < 1.0e-10
+                                       ? Vector2D::polar2vector( 1.0, p.body_ )
+                                       : rel );
+                M_ball.pos_ = p.pos_ + dir.setLengthVector( min_dist );
+                M_ball.vel_ *= COLLISION_VEL_RATE;
+                p.vel_ *= COLLISION_VEL_RATE;
+                p.collision_ = true;
+            }
+        }
+
+        //
+        // player - player
+        //
+        for ( int j = i + 1; j < size; ++j )
+        {
+            Player & o = M_players[j];
+
+            const double min_dist = p.player_type_->playerSize() + o.player_type_->playerSize();
+            const Vector2D rel = o.pos_ - p.pos_;
+            if ( rel.r2() >= min_dist * min_dist )
+            {
+                continue;
+            }
+
+            const Vector2D dir = ( rel.r2() < 1.0e-10
+                                   ? Vector2D::polar2vector( 1.0, p.body_ )
+                                   : rel );
+            const Vector2D push = dir.setLengthVector( ( min_dist - rel.r() ) * 0.5 );
+            p.pos_ -= push;
+            o.pos_ += push;
+            p.vel_ *= COLLISION_VEL_RATE;
+            o.vel_ *= COLLISION_VEL_RATE;
+            p.collision_ = true;
+            o.collision_ = true;
+        }
+    }
+}
+
+}
@@ -0,0 +1,306 @@
+// -*-c++-*-
+
+/*!
+  \file physics_stepper.h
+  \brief headless soccer physics simulator Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PHYSICS_STEPPER_H
+#define RCSC_PLAYER_PHYSICS_STEPPER_H
+
+#include <rcsc/player/player_command.h>
+#include <rcsc/common/stamina_model.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/types.h>
+
+#include <boost/random/mersenne_twister.hpp>
+
+#include <vector>
+
+namespace rcsc {
+
+class PlayerType;
+
+/*!
+  \class PhysicsStepper
+  \brief in-process simulator of the ball and player movement.
+
+  This class advances the state of the ball and players by one cycle
+  using the same rules as rcssserver: dash, turn, turn_neck, kick,
+  tackle, catch and move commands, movement noise, velocity decay,
+  object collisions and the stamina model. All parameters are taken
+  from ServerParam and PlayerTypeSet.
+
+  Referee judgement (play modes, offside, fouls and cards) and wind are
+  not simulated. A successful catch makes the goalie hold the ball until
+  the goalie kicks it.
+
+  \code
+  rcsc::PhysicsStepper sim( 1 );
+  sim.setBall( rcsc::Vector2D( 0.0, 0.0 ) );
+  int p = sim.addPlayer( rcsc::LEFT, 9, rcsc::Hetero_Default, false,
+                         rcsc::Vector2D( -1.0, 0.0 ), 0.0 );
+  sim.setCommand( p, rcsc::PlayerKickCommand( 100.0, 0.0 ) );
+  sim.step();
+  \endcode
+ */
+class PhysicsStepper {
+public:
+
+    /*!
+      \struct Ball
+      \brief ball state
+     */
+    struct Ball {
+        Vector2D pos_; //!< position
+        Vector2D vel_; //!< velocity
+        Vector2D accel_; //!< acceleration applied in the next movement
+        int holder_; //!< index of the goalie that holds the ball. -1 if not held.
+
+        Ball()
+            : pos_( 0.0, 0.0 ),
+              vel_( 0.0, 0.0 ),
+              accel_( 0.0, 0.0 ),
+              holder_( -1 )
+          { }
+    };
+
+    /*!
+      \struct Player
+      \brief player state
+     */
+    struct Player {
+        SideID side_; //!< team side
+        int unum_; //!< uniform number
+        int type_; //!< player type id
+        bool goalie_; //!< goalie flag
+        const PlayerType * player_type_; //!< pointer to the player type parameter
+        Vector2D pos_; //!< position
+        Vector2D vel_; //!< velocity
+        Vector2D accel_; //!< acceleration applied in the next movement
+        double body_; //!< global body angle [deg]
+        double neck_; //!< relative neck angle [deg]
+        StaminaModel stamina_; //!< stamina status
+        int tackle_cycles_; //!< the number of cycles the player is frozen by tackle
+        bool collision_; //!< true if the player collided in the last step
+
+        // command
+        PlayerCommand::Type command_; //!< body command type. BYE means no command.
+        double arg1_; //!< first command argument
+        double arg2_; //!< second command argument
+        double neck_moment_; //!< turn_neck command argument
+
+        Player()
+            : side_( NEUTRAL ),
+              unum_( Unum_Unknown ),
+              type_( Hetero_Default ),
+              goalie_( false ),
+              player_type_( static_cast< const PlayerType * >( 0 ) ),
+              pos_( 0.0, 0.0 ),
+              vel_( 0.0, 0.0 ),
+              accel_( 0.0, 0.0 ),
+              body_( 0.0 ),
+              neck_( 0.0 ),
+              tackle_cycles_( 0 ),
+              collision_( false ),
+              command_( PlayerCommand::BYE ),
+              arg1_( 0.0 ),
+              arg2_( 0.0 ),
+              neck_moment_( 0.0 )
+          { }
+    };
+
+private:
+
+    boost::mt19937 M_rng; //!< random number generator for the noise
+    bool M_noise; //!< if false, all random noise is disabled.
+
+    long M_cycle; //!< the number of steps
+    Ball M_ball; //!< ball state
+    std::vector< Player > M_players; //!< all players
+
+public:
+
+    /*!
+      \brief create an empty field
+      \param seed random seed for the noise
+     */
+    explicit
+    PhysicsStepper( const unsigned int seed = 0 );
+
+    /*!
+      \brief enable or disable the random noise
+      \param on if false, the simulation becomes noise free.
+     */
+    void setNoise( const bool on )
+      {
+          M_noise = on;
+      }
+
+    /*!
+      \brief set the random seed
+      \param seed random seed for the noise
+     */
+    void setSeed( const unsigned int seed );
+
+    /*!
+      \brief get the number of simulated steps
+      \return the number of steps
+     */
+    long cycle() const
+      {
+          return M_cycle;
+      }
+
+    /*!
+      \brief set the ball state
+      \param pos ball position
+      \param vel ball velocity
+     */
+    void setBall( const Vector2D & pos,
+                  const Vector2D & vel = Vector2D( 0.0, 0.0 ) );
+
+    /*!
+      \brief add the player
+      \param side team side
+      \param unum uniform number
+      \param player_type player type id registered in PlayerTypeSet
+      \param goalie goalie flag
+      \param pos initial position
+      \param body initial body angle
+      \return index of the player
+     */
+    int addPlayer( const SideID side,
+                   const int unum,
+                   const int player_type,
+                   const bool goalie,
+                   const Vector2D & pos,
+                   const double & body );
+
+    /*!
+      \brief overwrite the player state
+      \param index player index
+      \param pos new position
+      \param vel new velocity
+      \param body new body angle
+     */
+    void setPlayer( const int index,
+                    const Vector2D & pos,
+                    const Vector2D & vel,
+                    const double & body );
+
+    /*!
+      \brief get the ball state
+      \return const reference to the ball state
+     */
+    const Ball & ball() const
+      {
+          return M_ball;
+      }
+
+    /*!
+      \brief get all players
+      \return const reference to the player container
+     */
+    const std::vector< Player > & players() const
+      {
+          return M_players;
+      }
+
+    /*!
+      \brief get the player state
+      \param index player index
+      \return const reference to the player state
+     */
+    const Player & player( const int index ) const
+      {
+          return M_players[index];
+      }
+
+    /*!
+      \brief set the body command performed in the next step.
+      \param index player index
+      \param command dash, turn, kick, tackle, catch or move command.
+      \return true if the command type is supported.
+     */
+    bool setCommand( const int index,
+                     const PlayerBodyCommand & command );
+
+    /*!
+      \brief set the turn_neck command performed in the next step.
+      \param index player index
+      \param moment neck moment
+     */
+    void setTurnNeck( const int index,
+                      const double & moment );
+
+    /*!
+      \brief check if the player can kick the ball
+      \param index player index
+      \return true if the ball is in the kickable area
+     */
+    bool isKickable( const int index ) const;
+
+    /*!
+      \brief perform all commands and advance the simulation by one cycle.
+     */
+    void step();
+
+private:
+
+    /*!
+      \brief get random value in the range [min, max]
+     */
+    double drand( const double & min,
+                  const double & max );
+
+    void dash( Player & p );
+    void turn( Player & p );
+    void kick( const int index );
+    void tackle( const int index );
+    void catchBall( const int index );
+
+    /*!
+      \brief apply the accel, noise and decay to the object
+     */
+    void move( Vector2D & pos,
+               Vector2D & vel,
+               Vector2D & accel,
+               const double & accel_max,
+               const double & speed_max,
+               const double & rand,
+               const double & decay );
+
+    /*!
+      \brief resolve the overlap of objects
+     */
+    void collide();
+};
+
+}
+
+#endif
@@ -41,13 +41,16 @@
 #include "fullstate_sensor.h"
 
 #include "freeform_parser.h"
+#include "phase_profiler.h"
 #include "player_command.h"
 #include "say_message_builder.h"
 #include "soccer_action.h"
 #include "soccer_intention.h"
 
+#include <rcsc/action/kick_table.h>
 #include <rcsc/common/audio_memory.h>
 #include <rcsc/common/basic_client.h>
+#include <rcsc/common/command_buffer.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/player_type.h>
@@ -56,6 +59,7 @@
 #include <rcsc/param/cmd_line_parser.h>
 #include <rcsc/param/conf_file_parser.h>
 #include <rcsc/math_util.h>
+#include <rcsc/random.h>
 #include <rcsc/game_time.h>
 #include <rcsc/game_mode.h>
 #include <rcsc/timer.h>
@@ -63,6 +67,8 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <fstream>
 #include <sstream>
 #include <cstdio>
 #include <cstring>
@@ -135,6 +141,12 @@ struct PlayerAgent::Impl {
     //! intention queue
     boost::shared_ptr< SoccerIntention > intention_;
 
+    //! elapsed time recorder. NULL if profiling is disabled.
+    boost::scoped_ptr< PhaseProfiler > profiler_;
+
+    //! command string buffer reused every cycle
+    CommandBuffer command_buffer_;
+
     /*!
       \brief initialize all members
     */
@@ -172,6 +184,17 @@ struct PlayerAgent::Impl {
      */
     void setDebugFlags();
 
+    /*!
+      \brief write the phase profile to the file.
+     */
+    void writeProfile();
+
+    /*!
+      \brief receive the server message with profiling
+      \return length of received message
+     */
+    int recvMessage();
+
     /*!
       \brief send init or reconnect command to server
 
@@ -728,6 +751,17 @@ PlayerAgent::seeTimeStamp() const
     return M_impl->see_time_stamp_;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const
+PhaseProfiler *
+PlayerAgent::phaseProfiler() const
+{
+    return M_impl->profiler_.get();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -793,6 +827,22 @@ PlayerAgent::initImpl( CmdLineParser & cmd_parser )
                                  config().playerVelCountThr(),
                                  config().playerFaceCountThr() );
 
+    if ( config().randomSeed() >= 0 )
+    {
+        RandomEngine::instance().seed( config().randomSeed() );
+    }
+
+    M_worldmodel.setInterceptThreads( config().interceptThreads() );
+    M_fullstate_worldmodel.setInterceptThreads( config().interceptThreads() );
+    M_worldmodel.setSelfInterceptMaxSolutions( config().selfInterceptMaxSolutions() );
+    M_fullstate_worldmodel.setSelfInterceptMaxSolutions( config().selfInterceptMaxSolutions() );
+
+    if ( config().profilePhases() )
+    {
+        M_impl->profiler_.reset( new PhaseProfiler() );
+        M_worldmodel.setPhaseProfiler( M_impl->profiler_.get() );
+    }
+
     if ( 1 <= config().offlineClientNumber()
          && config().offlineClientNumber() <= 11 )
     {
@@ -879,7 +929,7 @@ PlayerAgent::handleMessage()
     GameTime start_time = M_impl->current_time_;
 
     // receive and analyze message
-    while ( M_client->recvMessage() > 0 )
+    while ( M_impl->recvMessage() > 0 )
     {
         ++counter;
         parse( M_client->message() );
@@ -1106,6 +1156,8 @@ PlayerAgent::finalize()
     }
     std::printf( "\n" );
 #endif
+    M_impl->writeProfile();
+
     std::cout << config().teamName() << ' '
               << world().self().unum() << ": "
               << "finished."
@@ -1210,7 +1262,10 @@ PlayerAgent::Impl::openDebugLog()
     filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
              << agent_.config().debugLogExt();
 
-    dlog.open( filepath.str() );
+    dlog.open( filepath.str(),
+               ( agent_.config().debugLogBinary()
+                 ? Logger::BINARY_FORMAT
+                 : Logger::TEXT_FORMAT ) );
 
     if ( ! dlog.isOpen() )
     {
@@ -1222,9 +1277,79 @@ PlayerAgent::Impl::openDebugLog()
         return false;
     }
 
+    if ( agent_.config().debugLogAsync() )
+    {
+        const std::size_t size
+            = static_cast< std::size_t >( std::max( 1, agent_.config().debugLogBufferSize() ) ) * 1024;
+        if ( ! dlog.startAsync( size,
+                                ( agent_.config().debugLogBlock()
+                                  ? Logger::BLOCK_ON_OVERFLOW
+                                  : Logger::DROP_ON_OVERFLOW ) ) )
+        {
+            std::cerr << agent_.config().teamName() << ' '
+                      << agent_.world().self().unum() << ": "
+                      << " Failed to start the asynchronous debug log."
+                      << " The debug log is written synchronously."
+                      << std::endl;
+        }
+    }
+
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::writeProfile()
+{
+    if ( ! profiler_ )
+    {
+        return;
+    }
+
+    std::ostringstream filepath;
+
+    if ( ! agent_.config().logDir().empty() )
+    {
+        filepath << agent_.config().logDir();
+        if ( *(agent_.config().logDir().rbegin()) != '/' )
+        {
+            filepath << '/';
+        }
+    }
+
+    filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
+             << agent_.config().profileLogExt();
+
+    std::ofstream fout( filepath.str().c_str() );
+    if ( ! fout.is_open() )
+    {
+        std::cerr << agent_.config().teamName() << ' '
+                  << agent_.world().self().unum() << ": "
+                  << " Failed to open the profile file [" << filepath.str() << "]"
+                  << std::endl;
+        return;
+    }
+
+    fout << "# elapsed time [usec]\n";
+    profiler_->print( fout );
+    fout << "# histogram: <phase> <lower_usec> <upper_usec> <count>\n";
+    profiler_->printHistogram( fout );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+PlayerAgent::Impl::recvMessage()
+{
+    PhaseProfiler::Scope scope( profiler_.get(), PhaseProfiler::RECV );
+    return agent_.M_client->recvMessage();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1517,10 +1642,13 @@ PlayerAgent::Impl::analyzeSee( const char * msg )
                   msec_from_sense );
 
     // parse see info
-    visual_.parse( msg,
-                   agent_.config().teamName().c_str(),
-                   agent_.config().version(),
-                   current_time_ );
+    {
+        PhaseProfiler::Scope scope( profiler_.get(), PhaseProfiler::PARSE_SEE );
+        visual_.parse( msg,
+                       agent_.config().teamName().c_str(),
+                       agent_.config().version(),
+                       current_time_ );
+    }
     //visual_.print( std::cout );
 
     // update see timing status
@@ -1545,6 +1673,7 @@ PlayerAgent::Impl::analyzeSee( const char * msg )
          && agent_.world().seeTime() != current_time_ )
     {
         // update seen objects
+        PhaseProfiler::Scope scope( profiler_.get(), PhaseProfiler::UPDATE_AFTER_SEE );
         agent_.M_worldmodel.updateAfterSee( visual_,
                                             body_,
                                             agent_.effector(),
@@ -1936,6 +2065,24 @@ PlayerAgent::Impl::analyzePlayerType( const char * msg )
     PlayerType player_type( msg, agent_.config().version() );
     PlayerTypeSet::instance().insert( player_type );
 
+    if ( static_cast< int >( PlayerTypeSet::i().playerTypeMap().size() )
+         == PlayerParam::i().playerTypes() )
+    {
+        // all player types have been received.
+        // map or create the kick tables before the first kick.
+        MSecTimer timer;
+        if ( ! KickTable::instance().setupTables( agent_.config().kickTableDir() ) )
+        {
+            std::cerr << agent_.config().teamName() << ' '
+                      << agent_.world().self().unum() << ": "
+                      << "***WARNING*** failed to setup the kick tables."
+                      << std::endl;
+        }
+        dlog.addText( Logger::SENSOR,
+                      __FILE__": setup kick tables. elapsed %.3f [ms]",
+                      timer.elapsedReal() );
+    }
+
     agent_.handlePlayerType();
 }
 
@@ -2267,6 +2414,7 @@ PlayerAgent::Impl::analyzeWarning( const char * msg )
 void
 PlayerAgent::action()
 {
+    PhaseProfiler::Scope action_scope( M_impl->profiler_.get(), PhaseProfiler::ACTION );
     MSecTimer timer;
     dlog.addText( Logger::SYSTEM,
                   __FILE__" (action) start" );
@@ -2312,8 +2460,11 @@ PlayerAgent::action()
     // ------------------------------------------------------------------------
     // last update
     // update positining matrix, offside line, defense line, etc.
-    M_worldmodel.updateJustBeforeDecision( effector(),
-                                           M_impl->current_time_ );
+    {
+        PhaseProfiler::Scope scope( M_impl->profiler_.get(), PhaseProfiler::UPDATE_BEFORE_DECISION );
+        M_worldmodel.updateJustBeforeDecision( effector(),
+                                               M_impl->current_time_ );
+    }
     if ( config().debugFullstate()
          && M_fullstate_worldmodel.isValid() )
     {
@@ -2333,7 +2484,10 @@ PlayerAgent::action()
         M_impl->adjustSeeSynchSynchMode();
     }
 
-    actionImpl(); // this is pure virtual method
+    {
+        PhaseProfiler::Scope scope( M_impl->profiler_.get(), PhaseProfiler::ACTION_IMPL );
+        actionImpl(); // this is pure virtual method
+    }
     M_impl->doArmAction();
     M_impl->doViewAction();
     M_impl->doNeckAction();
@@ -2350,15 +2504,19 @@ PlayerAgent::action()
     // ------------------------------------------------------------------------
     // compose command string, and send it to the rcssserver
     {
-        std::ostringstream ostr;
-        M_effector.makeCommand( ostr );
-        const std::string str = ostr.str();
-        if ( str.length() > 0 )
+        CommandBuffer & buf = M_impl->command_buffer_;
+        buf.clear();
+        {
+            PhaseProfiler::Scope scope( M_impl->profiler_.get(), PhaseProfiler::MAKE_COMMAND );
+            M_effector.makeCommand( buf );
+        }
+        if ( ! buf.empty() )
         {
             dlog.addText( Logger::SYSTEM,
                           "---- send[%s]",
-                          str.c_str() );
-            M_client->sendMessage( str.c_str() );
+                          buf.c_str() );
+            PhaseProfiler::Scope scope( M_impl->profiler_.get(), PhaseProfiler::SEND );
+            M_client->sendMessage( buf.c_str() );
         }
     }
 
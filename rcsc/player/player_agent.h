@@ -55,6 +55,7 @@ class VisualSensor;
 class AudioSensor;
 class FreeformParser;
 class FullstateSensor;
+class PhaseProfiler;
 class SeeState;
 class ArmAction;
 class NeckAction;
@@ -219,6 +220,13 @@ public:
     const
     TimeStamp & seeTimeStamp() const;
 
+    /*!
+      \brief get the phase profiler
+      \return const pointer to the profiler. NULL if profiling is disabled.
+    */
+    const
+    PhaseProfiler * phaseProfiler() const;
+
     /*!
       \brief register kick command
       \param power command argument: kick power
@@ -37,11 +37,39 @@
 
 #include "see_state.h"
 
+#include <rcsc/common/command_buffer.h>
+
+#include <sstream>
+
 namespace rcsc {
 
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+CommandBuffer &
+PlayerCommand::toBuffer( CommandBuffer & to ) const
+{
+    std::ostringstream os;
+    toStr( os );
+    return to << os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+PlayerCommand::printBuffer( std::ostream & to ) const
+{
+    CommandBuffer buf;
+    toBuffer( buf );
+    return to.write( buf.c_str(), buf.size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 PlayerInitCommand::PlayerInitCommand( const std::string & team_name,
                                       const double & version,
@@ -124,7 +152,17 @@ PlayerByeCommand::toStr( std::ostream & to ) const
 std::ostream &
 PlayerMoveCommand::toStr( std::ostream & to ) const
 {
-    return to << "(move " << M_x << " " << M_y << ")";
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerMoveCommand::toBuffer( CommandBuffer & to ) const
+{
+    return to << "(move " << M_x << ' ' << M_y << ')';
 }
 
 /*-------------------------------------------------------------------*/
@@ -133,6 +171,16 @@ PlayerMoveCommand::toStr( std::ostream & to ) const
 */
 std::ostream &
 PlayerDashCommand::toStr( std::ostream & to ) const
+{
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerDashCommand::toBuffer( CommandBuffer & to ) const
 {
     to << "(dash " << M_power;
     if ( M_dir != 0.0 )
@@ -149,7 +197,17 @@ PlayerDashCommand::toStr( std::ostream & to ) const
 std::ostream &
 PlayerTurnCommand::toStr( std::ostream & to ) const
 {
-    return to << "(turn " << M_moment << ")";
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerTurnCommand::toBuffer( CommandBuffer & to ) const
+{
+    return to << "(turn " << M_moment << ')';
 }
 
 /*-------------------------------------------------------------------*/
@@ -159,7 +217,17 @@ PlayerTurnCommand::toStr( std::ostream & to ) const
 std::ostream &
 PlayerKickCommand::toStr( std::ostream & to ) const
 {
-    return to << "(kick " << M_power << " " << M_dir << ")";
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerKickCommand::toBuffer( CommandBuffer & to ) const
+{
+    return to << "(kick " << M_power << ' ' << M_dir << ')';
 }
 
 /*-------------------------------------------------------------------*/
@@ -169,7 +237,17 @@ PlayerKickCommand::toStr( std::ostream & to ) const
 std::ostream &
 PlayerCatchCommand::toStr( std::ostream & to ) const
 {
-    return to << "(catch " << M_dir << ")";
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerCatchCommand::toBuffer( CommandBuffer & to ) const
+{
+    return to << "(catch " << M_dir << ')';
 }
 
 /*-------------------------------------------------------------------*/
@@ -178,6 +256,16 @@ PlayerCatchCommand::toStr( std::ostream & to ) const
 */
 std::ostream &
 PlayerTackleCommand::toStr( std::ostream & to ) const
+{
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerTackleCommand::toBuffer( CommandBuffer & to ) const
 {
     to << "(tackle " << M_power_or_dir;
     if ( M_foul )
@@ -196,7 +284,17 @@ PlayerTackleCommand::toStr( std::ostream & to ) const
 std::ostream &
 PlayerTurnNeckCommand::toStr( std::ostream & to ) const
 {
-    return to << "(turn_neck " << M_moment << ")";
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerTurnNeckCommand::toBuffer( CommandBuffer & to ) const
+{
+    return to << "(turn_neck " << M_moment << ')';
 }
 
 /*-------------------------------------------------------------------*/
@@ -205,12 +303,22 @@ PlayerTurnNeckCommand::toStr( std::ostream & to ) const
 */
 std::ostream &
 PlayerChangeViewCommand::toStr( std::ostream & to ) const
+{
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerChangeViewCommand::toBuffer( CommandBuffer & to ) const
 {
     to << "(change_view " << M_width.str();
 
     if ( ! SeeState::synch_see_mode() )
     {
-        to << " " << M_quality.str() << ')';
+        to << ' ' << M_quality.str() << ')';
     }
     else
     {
@@ -226,6 +334,16 @@ PlayerChangeViewCommand::toStr( std::ostream & to ) const
 */
 std::ostream &
 PlayerSayCommand::toStr( std::ostream & to ) const
+{
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerSayCommand::toBuffer( CommandBuffer & to ) const
 {
     if ( ! M_message.empty() )
     {
@@ -235,7 +353,7 @@ PlayerSayCommand::toStr( std::ostream & to ) const
         }
         else
         {
-            to << "(say " << M_message << ")";
+            to << "(say " << M_message << ')';
         }
     }
     return to;
@@ -247,10 +365,20 @@ PlayerSayCommand::toStr( std::ostream & to ) const
 */
 std::ostream &
 PlayerPointtoCommand::toStr( std::ostream & to ) const
+{
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerPointtoCommand::toBuffer( CommandBuffer & to ) const
 {
     if ( M_on )
     {
-        to << "(pointto " << M_dist << " " << M_dir << ")";
+        to << "(pointto " << M_dist << ' ' << M_dir << ')';
     }
     else
     {
@@ -265,12 +393,22 @@ PlayerPointtoCommand::toStr( std::ostream & to ) const
 */
 std::ostream &
 PlayerAttentiontoCommand::toStr( std::ostream & to ) const
+{
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerAttentiontoCommand::toBuffer( CommandBuffer & to ) const
 {
     if ( M_side != NONE )
     {
         to << "(attentionto ";
-        if ( M_side == OUR ) to << "our " << M_number << ")";
-        else                 to << "opp " << M_number << ")";
+        if ( M_side == OUR ) to << "our " << M_number << ')';
+        else                 to << "opp " << M_number << ')';
     }
     else
     {
@@ -370,6 +508,16 @@ PlayerCompressionCommand::toStr( std::ostream & to ) const
 */
 std::ostream &
 PlayerDoneCommand::toStr( std::ostream & to ) const
+{
+    return printBuffer( to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CommandBuffer &
+PlayerDoneCommand::toBuffer( CommandBuffer & to ) const
 {
     return to << "(done)";
 }
@@ -42,6 +42,8 @@
 
 namespace rcsc {
 
+class CommandBuffer;
+
 /*!
   \class PlayerCommand
   \brief abstract player command class
@@ -112,12 +114,30 @@ public:
     virtual
     std::ostream & toStr( std::ostream & to ) const = 0;
 
+    /*!
+      \brief put command string to the preallocated buffer.
+      The default implementation composes the string by toStr().
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    virtual
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name (pure virtual)
       \return command name string
     */
     virtual
     std::string name() const = 0;
+
+protected:
+
+    /*!
+      \brief put the string composed by toBuffer() to ostream
+      \param to reference to the output stream
+      \return reference to the output stream
+    */
+    std::ostream & printBuffer( std::ostream & to ) const;
 };
 
 
@@ -371,6 +391,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -436,6 +463,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -504,6 +538,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -567,6 +608,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -635,6 +683,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -703,6 +758,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -816,6 +878,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -886,6 +955,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -980,6 +1056,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -989,6 +1072,15 @@ public:
           return std::string( "say" );
       }
 
+    /*!
+      \brief set client version
+      \param version player's client version
+     */
+    void setVersion( const double & version )
+      {
+          M_version = version;
+      }
+
     /*!
       \brief assign new message
       \param msg new string
@@ -1074,6 +1166,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -1178,6 +1277,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -1625,6 +1731,13 @@ public:
     */
     std::ostream & toStr( std::ostream & to ) const;
 
+    /*!
+      \brief put command string to the buffer
+      \param to reference to the buffer
+      \return reference to the buffer
+    */
+    CommandBuffer & toBuffer( CommandBuffer & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -98,6 +98,11 @@ PlayerConfig::setDefaultParam()
 
     M_synch_see = false;
 
+    M_intercept_threads = 1;
+    M_self_intercept_max_solutions = 0;
+
+    M_random_seed = -1;
+
     // accuracy threshold
     M_self_pos_count_thr = 20;
     M_self_vel_count_thr = 10;
@@ -116,6 +121,7 @@ PlayerConfig::setDefaultParam()
 
     // configuration
     M_config_dir = "./";
+    M_kick_table_dir = "";
 
     //
     // debug
@@ -144,6 +150,13 @@ PlayerConfig::setDefaultParam()
     // debug logging
     //
     M_debug_log_ext = ".log";
+    M_debug_log_async = false;
+    M_debug_log_buffer_size = 1024;
+    M_debug_log_block = false;
+    M_debug_log_binary = false;
+
+    M_profile_phases = false;
+    M_profile_log_ext = ".prof";
 
     M_debug_system = false;
     M_debug_sensor = false;
@@ -206,6 +219,13 @@ PlayerConfig::createParamMap( ParamMap & param_map )
         ( "debug_fullstate", "", &M_debug_fullstate )
         ( "synch_see", "", &M_synch_see )
 
+        ( "intercept_threads", "", &M_intercept_threads,
+          "specifies the number of threads used by the intercept prediction of other players." )
+        ( "self_intercept_max_solutions", "", &M_self_intercept_max_solutions,
+          "specifies the number of the fastest self intercept solutions. 0 means all solutions." )
+        ( "random_seed", "", &M_random_seed,
+          "specifies the seed of the random number generators. negative value means the default seed." )
+
         ( "self_pos_count_thr", "", &M_self_pos_count_thr )
         ( "self_vel_count_thr", "", &M_self_vel_count_thr )
         ( "self_face_count_thr", "", &M_self_face_count_thr )
@@ -219,6 +239,8 @@ PlayerConfig::createParamMap( ParamMap & param_map )
         ( "player_number", "n",  &M_player_number, "specifies the player's position number (not a uniform number)." )
 
         ( "config_dir", "", &M_config_dir )
+        ( "kick_table_dir", "", &M_kick_table_dir,
+          "specifies the directory of the binary kick table files shared by the player processes." )
 
         ( "debug", "", BoolSwitch( &M_debug ) )
         ( "log_dir", "", &M_log_dir )
@@ -233,6 +255,14 @@ PlayerConfig::createParamMap( ParamMap & param_map )
         ( "offline_client_number", "", &M_offline_client_number )
 
         ( "debug_log_ext", "", &M_debug_log_ext )
+        ( "debug_log_async", "", BoolSwitch( &M_debug_log_async ) )
+        ( "debug_log_buffer_size", "", &M_debug_log_buffer_size )
+        ( "debug_log_block", "", BoolSwitch( &M_debug_log_block ) )
+        ( "debug_log_binary", "", BoolSwitch( &M_debug_log_binary ) )
+
+        ( "profile_phases", "", BoolSwitch( &M_profile_phases ),
+          "record the elapsed time of each processing phase, and write the histograms at exit." )
+        ( "profile_log_ext", "", &M_profile_log_ext )
 
         ( "debug_system", "", BoolSwitch( &M_debug_system ) )
         ( "debug_sensor", "", BoolSwitch( &M_debug_sensor ) )
@@ -79,6 +79,11 @@ private:
 
     bool M_synch_see; //!< if true, synchronous see mode is used.
 
+    int M_intercept_threads; //!< the number of threads used by the intercept prediction of other players
+    int M_self_intercept_max_solutions; //!< the number of the fastest self intercept solutions. 0 means all.
+
+    int M_random_seed; //!< seed of the random number generators. negative value means the default seed.
+
     // confidence value
 
     int M_self_pos_count_thr; //!< self position confidence threshold
@@ -100,6 +105,9 @@ private:
     //! miscellaneous configuration directory.
     std::string M_config_dir;
 
+    //! directory of the binary kick table files. if empty, the tables are created in memory.
+    std::string M_kick_table_dir;
+
     //
     // debug
     //
@@ -134,6 +142,13 @@ private:
     //
 
     std::string M_debug_log_ext; //!< the extension string of debug log file
+    bool M_debug_log_async; //!< if true, debug log is written by the background thread
+    int M_debug_log_buffer_size; //!< ring buffer size for the asynchronous debug log [KB]
+    bool M_debug_log_block; //!< if true, wait for the writer thread instead of dropping messages
+    bool M_debug_log_binary; //!< if true, debug log is written in the binary format
+
+    bool M_profile_phases; //!< if true, the elapsed time of each processing phase is recorded
+    std::string M_profile_log_ext; //!< the extension string of the profile result file
 
     bool M_debug_system; //!< debug level flag
     bool M_debug_sensor; //!< debug level flag
@@ -301,6 +316,24 @@ public:
      */
     bool synchSee() const { return M_synch_see; }
 
+    /*!
+      \brief get the number of threads used by the intercept prediction of other players
+      \return the number of threads. if less than 2, the prediction is done serially.
+     */
+    int interceptThreads() const { return M_intercept_threads; }
+
+    /*!
+      \brief get the number of the fastest self intercept solutions kept for each stamina mode
+      \return the number of solutions. 0 means all solutions are kept.
+     */
+    int selfInterceptMaxSolutions() const { return M_self_intercept_max_solutions; }
+
+    /*!
+      \brief get the seed of the random number generators
+      \return seed value. negative value means the default seed is used.
+     */
+    int randomSeed() const { return M_random_seed; }
+
     // confidence value
 
     /*!
@@ -375,6 +408,12 @@ public:
      */
     const std::string & configDir() const { return M_config_dir; }
 
+    /*!
+      \brief get the directory path of the binary kick table files
+      \return directory path. empty if the tables are not cached in files.
+     */
+    const std::string & kickTableDir() const { return M_kick_table_dir; }
+
     //
     // debug
     //
@@ -452,6 +491,42 @@ public:
      */
     const std::string & debugLogExt() const { return M_debug_log_ext; }
 
+    /*!
+      \brief check if the debug log is written by the background thread
+      \return true if the asynchronous mode is enabled
+     */
+    bool debugLogAsync() const { return M_debug_log_async; }
+
+    /*!
+      \brief get the ring buffer size for the asynchronous debug log
+      \return buffer size [KB]
+     */
+    int debugLogBufferSize() const { return M_debug_log_buffer_size; }
+
+    /*!
+      \brief check if the logging thread waits for the writer when the buffer is full
+      \return true if messages are never dropped
+     */
+    bool debugLogBlock() const { return M_debug_log_block; }
+
+    /*!
+      \brief check if the debug log is written in the binary format
+      \return true if the binary format is used
+     */
+    bool debugLogBinary() const { return M_debug_log_binary; }
+
+    /*!
+      \brief check if the elapsed time of each processing phase is recorded
+      \return true if the phase profiler is enabled
+     */
+    bool profilePhases() const { return M_profile_phases; }
+
+    /*!
+      \brief get the extension string of the profile result file
+      \return the profile result file extention string.
+     */
+    const std::string & profileLogExt() const { return M_profile_log_ext; }
+
     /*!
       \brief get the debug flag
       \return debug flag
@@ -0,0 +1,345 @@
+// -*-c++-*-
+
+/*!
+  \file player_cont.cpp
+  \brief pooled player object container Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "player_cont.h"
+
+#include <algorithm>
+
+namespace rcsc {
+
+const std::size_t PlayerObjectPool::CHUNK_SIZE = 32;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerObjectPool::PlayerObjectPool( const std::size_t capacity )
+{
+    const std::size_t n_chunks = std::max( static_cast< std::size_t >( 1 ),
+                                           ( capacity + CHUNK_SIZE - 1 ) / CHUNK_SIZE );
+    M_chunks.reserve( n_chunks );
+    M_free_slots.reserve( n_chunks * CHUNK_SIZE );
+
+    for ( std::size_t i = 0; i < n_chunks; ++i )
+    {
+        allocateChunk();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerObjectPool::~PlayerObjectPool()
+{
+    for ( std::vector< PlayerObject * >::iterator it = M_chunks.begin(), end = M_chunks.end();
+          it != end;
+          ++it )
+    {
+        delete [] *it;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerObjectPool::allocateChunk()
+{
+    PlayerObject * chunk = new PlayerObject[CHUNK_SIZE];
+    M_chunks.push_back( chunk );
+
+    M_free_slots.reserve( M_chunks.size() * CHUNK_SIZE );
+
+    // the free list is used as a stack.
+    // push in reverse order so that slots are acquired from the chunk head.
+    for ( std::size_t i = CHUNK_SIZE; i > 0; --i )
+    {
+        M_free_slots.push_back( chunk + ( i - 1 ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerObject *
+PlayerObjectPool::acquire( const PlayerObject & p )
+{
+    if ( M_free_slots.empty() )
+    {
+        allocateChunk();
+    }
+
+    PlayerObject * slot = M_free_slots.back();
+    M_free_slots.pop_back();
+
+    *slot = p;
+    return slot;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerObjectPool::release( PlayerObject * p )
+{
+    M_free_slots.push_back( p );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerCont::PlayerCont( const PoolPtr & pool )
+    : M_pool( pool )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerCont::PlayerCont( const PlayerCont & other )
+    : M_pool( other.M_pool )
+{
+    M_slots.reserve( other.M_slots.capacity() );
+    for ( SlotCont::const_iterator it = other.M_slots.begin(), end = other.M_slots.end();
+          it != end;
+          ++it )
+    {
+        M_slots.push_back( M_pool->acquire( **it ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerCont::~PlayerCont()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerCont &
+PlayerCont::operator=( const PlayerCont & other )
+{
+    if ( this == &other )
+    {
+        return *this;
+    }
+
+    clear();
+
+    if ( other.M_slots.empty() )
+    {
+        return *this;
+    }
+
+    createPool();
+
+    M_slots.reserve( other.M_slots.size() );
+    for ( SlotCont::const_iterator it = other.M_slots.begin(), end = other.M_slots.end();
+          it != end;
+          ++it )
+    {
+        M_slots.push_back( M_pool->acquire( **it ) );
+    }
+
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const PlayerCont::PoolPtr &
+PlayerCont::pool() const
+{
+    createPool();
+    return M_pool;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerCont::createPool() const
+{
+    if ( ! M_pool )
+    {
+        M_pool = PoolPtr( new PlayerObjectPool() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerCont::clear()
+{
+    for ( SlotCont::iterator it = M_slots.begin(), end = M_slots.end();
+          it != end;
+          ++it )
+    {
+        M_pool->release( *it );
+    }
+    M_slots.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerCont::push_back( const PlayerObject & p )
+{
+    createPool();
+    M_slots.push_back( M_pool->acquire( p ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerCont::pop_back()
+{
+    M_pool->release( M_slots.back() );
+    M_slots.pop_back();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerCont::iterator
+PlayerCont::erase( iterator pos )
+{
+    M_pool->release( *pos.M_it );
+    return iterator( M_slots.erase( pos.M_it ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerObject *
+PlayerCont::adopt( PlayerObjectPool & from,
+                   PlayerObject * p )
+{
+    if ( &from == M_pool.get() )
+    {
+        return p;
+    }
+
+    PlayerObject * slot = M_pool->acquire( *p );
+    from.release( p );
+    return slot;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerCont::splice( iterator pos,
+                    PlayerCont & other )
+{
+    if ( this == &other
+         || other.M_slots.empty() )
+    {
+        return;
+    }
+
+    const SlotCont::difference_type index = pos.M_it - M_slots.begin();
+    createPool();
+
+    for ( SlotCont::iterator it = other.M_slots.begin(), end = other.M_slots.end();
+          it != end;
+          ++it )
+    {
+        *it = adopt( *other.M_pool, *it );
+    }
+
+    M_slots.insert( M_slots.begin() + index,
+                    other.M_slots.begin(), other.M_slots.end() );
+    other.M_slots.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerCont::splice( iterator pos,
+                    PlayerCont & other,
+                    iterator it )
+{
+    if ( this == &other )
+    {
+        // move inside the same container
+        const SlotCont::difference_type from = it.M_it - M_slots.begin();
+        SlotCont::difference_type to = pos.M_it - M_slots.begin();
+        if ( from == to || from + 1 == to )
+        {
+            return;
+        }
+
+        PlayerObject * p = *it.M_it;
+        M_slots.erase( it.M_it );
+        if ( from < to ) --to;
+        M_slots.insert( M_slots.begin() + to, p );
+        return;
+    }
+
+    const SlotCont::difference_type index = pos.M_it - M_slots.begin();
+    createPool();
+
+    PlayerObject * p = adopt( *other.M_pool, *it.M_it );
+    other.M_slots.erase( it.M_it );
+    M_slots.insert( M_slots.begin() + index, p );
+}
+
+}
@@ -0,0 +1,406 @@
+// -*-c++-*-
+
+/*!
+  \file player_cont.h
+  \brief pooled player object container Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_CONT_H
+#define RCSC_PLAYER_PLAYER_CONT_H
+
+#include <rcsc/player/player_object.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class PlayerObjectPool
+  \brief fixed size storage of PlayerObject slots.
+
+  Slots are allocated by a chunk of contiguous objects and are never
+  moved or freed until the pool is destroyed. Therefore, the address of
+  the acquired object is stable while it is in use, and the steady state
+  update does not require any heap allocation.
+*/
+class PlayerObjectPool {
+public:
+
+    //! the number of slots allocated at once
+    static const std::size_t CHUNK_SIZE;
+
+private:
+
+    //! allocated chunks
+    std::vector< PlayerObject * > M_chunks;
+
+    //! unused slots
+    std::vector< PlayerObject * > M_free_slots;
+
+    // not used
+    PlayerObjectPool( const PlayerObjectPool & );
+    PlayerObjectPool & operator=( const PlayerObjectPool & );
+
+public:
+
+    /*!
+      \brief allocate the initial slots
+      \param capacity the number of initial slots
+    */
+    explicit
+    PlayerObjectPool( const std::size_t capacity = 64 );
+
+    /*!
+      \brief release all chunks
+    */
+    ~PlayerObjectPool();
+
+    /*!
+      \brief get the number of allocated slots
+      \return the number of allocated slots
+    */
+    std::size_t capacity() const
+      {
+          return M_chunks.size() * CHUNK_SIZE;
+      }
+
+    /*!
+      \brief get the number of slots in use
+      \return the number of slots in use
+    */
+    std::size_t used() const
+      {
+          return capacity() - M_free_slots.size();
+      }
+
+    /*!
+      \brief acquire an unused slot and copy the object into it.
+      a new chunk is allocated only if all slots are in use.
+      \param p source object
+      \return pointer to the acquired slot
+    */
+    PlayerObject * acquire( const PlayerObject & p );
+
+    /*!
+      \brief return the slot to the pool
+      \param p pointer acquired by this pool
+    */
+    void release( PlayerObject * p );
+
+private:
+
+    /*!
+      \brief allocate a new chunk
+    */
+    void allocateChunk();
+
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class PlayerCont
+  \brief player object container that refers to PlayerObjectPool slots.
+
+  This class has the std::list compatible interface used by WorldModel.
+  Elements are held by the pool, and this class only holds the ordered
+  array of their pointers. Thus, splice() between containers that share
+  the same pool does not move the object, and pointers to the elements,
+  e.g. PlayerPtrCont, remain valid. If the pools are different, the
+  element is copied to the destination pool.
+
+  Unlike std::list, erase(), splice() and remove_if() invalidate the
+  iterators that point after the modified position.
+*/
+class PlayerCont {
+public:
+
+    typedef PlayerObject value_type; //!< element type
+    typedef PlayerObject & reference; //!< reference type
+    typedef const PlayerObject & const_reference; //!< const reference type
+    typedef PlayerObject * pointer; //!< pointer type
+    typedef const PlayerObject * const_pointer; //!< const pointer type
+    typedef std::size_t size_type; //!< size type
+    typedef std::ptrdiff_t difference_type; //!< difference type
+
+    //! shared pool type
+    typedef boost::shared_ptr< PlayerObjectPool > PoolPtr;
+
+private:
+
+    //! ordered slot pointer container type
+    typedef std::vector< PlayerObject * > SlotCont;
+
+public:
+
+    /*!
+      \class iterator
+      \brief mutable bidirectional iterator
+    */
+    class iterator
+        : public std::iterator< std::bidirectional_iterator_tag, PlayerObject > {
+    private:
+        friend class PlayerCont;
+        friend class const_iterator;
+        SlotCont::iterator M_it; //!< position in the slot array
+
+        explicit
+        iterator( const SlotCont::iterator & it )
+            : M_it( it )
+          { }
+
+    public:
+        iterator()
+            : M_it()
+          { }
+
+        PlayerObject & operator*() const { return **M_it; }
+        PlayerObject * operator->() const { return *M_it; }
+
+        iterator & operator++() { ++M_it; return *this; }
+        iterator operator++( int ) { iterator tmp( *this ); ++M_it; return tmp; }
+        iterator & operator--() { --M_it; return *this; }
+        iterator operator--( int ) { iterator tmp( *this ); --M_it; return tmp; }
+
+        bool operator==( const iterator & rhs ) const { return M_it == rhs.M_it; }
+        bool operator!=( const iterator & rhs ) const { return M_it != rhs.M_it; }
+    };
+
+    /*!
+      \class const_iterator
+      \brief immutable bidirectional iterator
+    */
+    class const_iterator
+        : public std::iterator< std::bidirectional_iterator_tag, const PlayerObject > {
+    private:
+        friend class PlayerCont;
+        SlotCont::const_iterator M_it; //!< position in the slot array
+
+        explicit
+        const_iterator( const SlotCont::const_iterator & it )
+            : M_it( it )
+          { }
+
+    public:
+        const_iterator()
+            : M_it()
+          { }
+
+        const_iterator( const PlayerCont::iterator & it )
+            : M_it( it.M_it )
+          { }
+
+        const PlayerObject & operator*() const { return **M_it; }
+        const PlayerObject * operator->() const { return *M_it; }
+
+        const_iterator & operator++() { ++M_it; return *this; }
+        const_iterator operator++( int ) { const_iterator tmp( *this ); ++M_it; return tmp; }
+        const_iterator & operator--() { --M_it; return *this; }
+        const_iterator operator--( int ) { const_iterator tmp( *this ); --M_it; return tmp; }
+
+        bool operator==( const const_iterator & rhs ) const { return M_it == rhs.M_it; }
+        bool operator!=( const const_iterator & rhs ) const { return M_it != rhs.M_it; }
+    };
+
+private:
+
+    //! object storage. allocated at the first insertion if not given.
+    mutable PoolPtr M_pool;
+
+    //! ordered pointers to the elements
+    SlotCont M_slots;
+
+public:
+
+    /*!
+      \brief create an empty container.
+      \param pool shared object storage. if null, a new pool is created on demand.
+    */
+    explicit
+    PlayerCont( const PoolPtr & pool = PoolPtr() );
+
+    /*!
+      \brief copy all elements into the new slots of the same pool
+      \param other source container
+    */
+    PlayerCont( const PlayerCont & other );
+
+    /*!
+      \brief release all elements
+    */
+    ~PlayerCont();
+
+    /*!
+      \brief replace the elements by the copy of other's elements.
+      the pool of this container is not changed.
+      \param other source container
+      \return reference to itself
+    */
+    PlayerCont & operator=( const PlayerCont & other );
+
+    /*!
+      \brief get the object storage
+      \return shared pool pointer
+    */
+    const PoolPtr & pool() const;
+
+    /*!
+      \brief reserve the pointer array to avoid the reallocation
+      \param n the number of elements
+    */
+    void reserve( const size_type n )
+      {
+          M_slots.reserve( n );
+      }
+
+    iterator begin() { return iterator( M_slots.begin() ); }
+    iterator end() { return iterator( M_slots.end() ); }
+    const_iterator begin() const { return const_iterator( M_slots.begin() ); }
+    const_iterator end() const { return const_iterator( M_slots.end() ); }
+
+    bool empty() const { return M_slots.empty(); }
+    size_type size() const { return M_slots.size(); }
+
+    reference front() { return *M_slots.front(); }
+    const_reference front() const { return *M_slots.front(); }
+    reference back() { return *M_slots.back(); }
+    const_reference back() const { return *M_slots.back(); }
+
+    /*!
+      \brief release all elements
+    */
+    void clear();
+
+    /*!
+      \brief append the copy of the object
+      \param p source object
+    */
+    void push_back( const PlayerObject & p );
+
+    /*!
+      \brief release the last element
+    */
+    void pop_back();
+
+    /*!
+      \brief release the element at the position
+      \param pos position of the released element
+      \return iterator following the released element
+    */
+    iterator erase( iterator pos );
+
+    /*!
+      \brief release all elements that satisfy the predicate.
+      the order of the remaining elements is preserved.
+      \param pred unary predicate
+    */
+    template < typename Predicate >
+    void remove_if( Predicate pred )
+      {
+          SlotCont::iterator last = M_slots.begin();
+          for ( SlotCont::iterator it = M_slots.begin(), end = M_slots.end();
+                it != end;
+                ++it )
+          {
+              if ( pred( **it ) )
+              {
+                  M_pool->release( *it );
+              }
+              else
+              {
+                  *last = *it;
+                  ++last;
+              }
+          }
+          M_slots.erase( last, M_slots.end() );
+      }
+
+    /*!
+      \brief stable sort of the elements. only pointers are swapped.
+      \param comp binary predicate that compares two elements
+    */
+    template < typename Compare >
+    void sort( Compare comp )
+      {
+          // insertion sort. the number of players is small enough,
+          // and this keeps the order of equal elements without extra buffer.
+          for ( SlotCont::size_type i = 1; i < M_slots.size(); ++i )
+          {
+              PlayerObject * p = M_slots[i];
+              SlotCont::size_type j = i;
+              while ( j > 0
+                      && comp( *p, *M_slots[j - 1] ) )
+              {
+                  M_slots[j] = M_slots[j - 1];
+                  --j;
+              }
+              M_slots[j] = p;
+          }
+      }
+
+    /*!
+      \brief move all elements of other to the position
+      \param pos insertion position in this container
+      \param other source container. it becomes empty.
+    */
+    void splice( iterator pos,
+                 PlayerCont & other );
+
+    /*!
+      \brief move one element of other to the position
+      \param pos insertion position in this container
+      \param other source container
+      \param it position of the moved element in other
+    */
+    void splice( iterator pos,
+                 PlayerCont & other,
+                 iterator it );
+
+private:
+
+    /*!
+      \brief create the pool if not exist
+    */
+    void createPool() const;
+
+    /*!
+      \brief copy the object into this pool if the object is held by another pool
+      \param from pool that holds the object
+      \param p object pointer
+      \return pointer held by this pool
+    */
+    PlayerObject * adopt( PlayerObjectPool & from,
+                          PlayerObject * p );
+};
+
+}
+
+#endif
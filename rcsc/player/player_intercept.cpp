@@ -34,6 +34,7 @@
 #endif
 
 #include "player_intercept.h"
+#include "ball_trajectory.h"
 #include "world_model.h"
 #include "ball_object.h"
 #include "player_object.h"
@@ -66,8 +67,8 @@ PlayerIntercept::predict( const PlayerObject & player,
                                     : player.pos() );
     int min_cycle = 0;
     {
-        Vector2D ball_to_player = player_pos - M_world.ball().pos();
-        ball_to_player.rotate( - M_world.ball().vel().th() );
+        Vector2D ball_to_player = player_pos - M_ball_trajectory.pos( 0 );
+        ball_to_player.rotate( - M_ball_trajectory.vel( 0 ).th() );
         min_cycle = static_cast< int >( std::floor( ball_to_player.absY()
                                                     / player_type.realSpeedMax() ) );
     }
@@ -94,14 +95,15 @@ PlayerIntercept::predict( const PlayerObject & player,
         return predictFinal( player, player_type );
     }
 
+    const std::vector< Vector2D > & ball_pos_list = M_ball_trajectory.posList();
     const std::size_t MAX_LOOP = std::min( static_cast< std::size_t >( max_cycle ),
-                                           M_ball_pos_cache.size() );
+                                           ball_pos_list.size() );
 
     for ( std::size_t cycle = static_cast< std::size_t >( min_cycle );
           cycle < MAX_LOOP;
           ++cycle )
     {
-        const Vector2D & ball_pos = M_ball_pos_cache.at( cycle );
+        const Vector2D & ball_pos = ball_pos_list[cycle];
 #ifdef DEBUG2
         dlog.addText( Logger::INTERCEPT,
                       "*** cycle=%d  ball(%.2f %.2f)",
@@ -330,8 +332,8 @@ PlayerIntercept::predictFinal( const PlayerObject & player,
                               ? player.seenVel()
                               : player.vel() );
 
-    const Vector2D & ball_pos = M_ball_pos_cache.back();
-    const int ball_step = static_cast< int >( M_ball_pos_cache.size() );
+    const Vector2D & ball_pos = M_ball_trajectory.posList().back();
+    const int ball_step = static_cast< int >( M_ball_trajectory.size() );
 
     const double control_area = ( ( player.goalie()
                                     && ball_pos.absX() > penalty_x_abs
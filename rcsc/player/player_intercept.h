@@ -39,6 +39,7 @@ namespace rcsc {
 
 class PlayerType;
 class BallObject;
+class BallTrajectory;
 class PlayerObject;
 class WorldModel;
 
@@ -50,8 +51,8 @@ class PlayerIntercept {
 private:
     //! const reference to the WorldModel instance
     const WorldModel & M_world;
-    //! const reference to the predicted ball position cache instance
-    const std::vector< Vector2D > & M_ball_pos_cache;
+    //! const reference to the predicted ball trajectory
+    const BallTrajectory & M_ball_trajectory;
 
     // not used
     PlayerIntercept();
@@ -61,12 +62,12 @@ public:
     /*!
       \brief construct with all variables.
       \param world const reference to the WormdModel instance
-      \param ball_pos_cache const reference to the ball position container
+      \param ball_trajectory const reference to the predicted ball trajectory
     */
     PlayerIntercept( const WorldModel & world,
-                     const std::vector< Vector2D > & ball_pos_cache )
+                     const BallTrajectory & ball_trajectory )
         : M_world( world )
-        , M_ball_pos_cache( ball_pos_cache )
+        , M_ball_trajectory( ball_trajectory )
       { }
 
     /*!
@@ -52,6 +52,8 @@ namespace rcsc {
 class PlayerObject
     : public AbstractPlayerObject {
 private:
+    friend class WorldSnapshot;
+
     //! validation count threshold value for M_pos and M_rpos
     static int S_pos_count_thr;
     //! validation count threshold value for M_vel
@@ -451,8 +453,8 @@ public:
 
 };
 
-//! type of the player object container
-typedef std::list< PlayerObject > PlayerCont;
+//! type of the player object container. defined in player_cont.h
+class PlayerCont;
 //! type of the player object pointer container
 typedef std::vector< PlayerObject * > PlayerPtrCont;
 
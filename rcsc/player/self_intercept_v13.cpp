@@ -34,6 +34,7 @@
 #endif
 
 #include "self_intercept_v13.h"
+#include "ball_trajectory.h"
 
 #include "world_model.h"
 #include "intercept_table.h"
@@ -93,7 +94,7 @@ SelfInterceptV13::predict( const int max_cycle,
 //                   __FILE__": ------------- predict self ---------------" );
 // #endif
 
-    if ( M_ball_pos_cache.size() < 2 )
+    if ( M_ball_trajectory.size() < 2 )
     {
         dlog.addText( Logger::INTERCEPT,
                       __FILE__": no ball position cache." );
@@ -117,6 +118,11 @@ SelfInterceptV13::predict( const int max_cycle,
 
     std::sort( self_cache.begin(), self_cache.end(), InterceptInfo::Cmp() );
 
+    if ( M_max_solutions > 0 )
+    {
+        removeSlowSolutions( self_cache );
+    }
+
 #ifdef DEBUG_PROFILE
     dlog.addText( Logger::INTERCEPT,
                   __FILE__" (predict) elapsed %f [ms]",
@@ -133,7 +139,7 @@ SelfInterceptV13::predict( const int max_cycle,
           it != end;
           ++it )
     {
-        Vector2D bpos = M_world.ball().inertiaPoint( it->reachCycle() );
+        Vector2D bpos = M_ball_trajectory.pos( it->reachCycle() );
         dlog.addText( Logger::INTERCEPT,
                       "(SelfIntercept) type=%d cycle=%d (turn=%d dash=%d)"
                       " power=%.2f angle=%.1f"
@@ -158,7 +164,7 @@ SelfInterceptV13::predict( const int max_cycle,
 void
 SelfInterceptV13::predictOneStep( std::vector< InterceptInfo > & self_cache ) const
 {
-    const Vector2D ball_next = M_world.ball().pos() + M_world.ball().vel();
+    const Vector2D ball_next = M_ball_trajectory.pos( 1 );
     const bool goalie_mode
         = ( M_world.self().goalie()
             && M_world.lastKickerSide() != M_world.ourSide()
@@ -203,7 +209,7 @@ SelfInterceptV13::predictNoDash( std::vector< InterceptInfo > & self_cache ) con
     const SelfObject & self = M_world.self();
 
     const Vector2D my_next = self.pos() + self.vel();
-    const Vector2D ball_next = M_world.ball().pos() + M_world.ball().vel();
+    const Vector2D ball_next = M_ball_trajectory.pos( 1 );
     const bool goalie_mode
         = ( self.goalie()
             && M_world.lastKickerSide() != M_world.ourSide()
@@ -269,7 +275,7 @@ SelfInterceptV13::predictNoDash( std::vector< InterceptInfo > & self_cache ) con
     {
         double kick_rate = ptype.kickRate( next_ball_dist,
                                            next_ball_rel.th().degree() );
-        Vector2D next_ball_vel = M_world.ball().vel() * SP.ballDecay();
+        Vector2D next_ball_vel = M_ball_trajectory.vel( 1 );
 
         if ( SP.maxPower() * kick_rate
              <= next_ball_vel.r() * SP.ballDecay() * 1.1 )
@@ -320,7 +326,7 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
     const SelfObject & self = M_world.self();
     const PlayerType & ptype = self.playerType();
 
-    const Vector2D ball_next = ball.pos() + ball.vel();
+    const Vector2D ball_next = M_ball_trajectory.pos( 1 );
     const bool goalie_mode
         = ( self.goalie()
             && M_world.lastKickerSide() != M_world.ourSide()
@@ -541,7 +547,7 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
     const double control_buf = control_area - 0.075;
 
     const AngleDeg dash_dir = dash_angle - M_world.self().body();
-    const Vector2D ball_next = M_world.ball().pos() + M_world.ball().vel();
+    const Vector2D ball_next = M_ball_trajectory.pos( 1 );
     const Vector2D self_next = self.pos() + self.vel();
 
     const Vector2D ball_rel = ( ball_next - self_next ).rotatedVector( -dash_angle );
@@ -889,15 +895,11 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
     if ( min_cycle < 2 ) min_cycle = 2;
 
 
-    Vector2D ball_pos = ball.inertiaPoint( min_cycle - 1 );
-    Vector2D ball_vel = ball.vel() * std::pow( SP.ballDecay(), min_cycle - 1 );
-
     for ( int cycle = min_cycle; cycle <= max_loop; ++cycle )
     {
         tmp_cache.clear();
 
-        ball_pos += ball_vel;
-        ball_vel *= SP.ballDecay();
+        const Vector2D ball_pos = M_ball_trajectory.pos( cycle );
 
 #ifdef DEBUG_PRINT_SHORT_STEP
         dlog.addText( Logger::INTERCEPT,
@@ -906,7 +908,7 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
                       "(predictShortStep) cycle %d: bpos(%.3f, %.3f) bvel(%.3f, %.3f)",
                       cycle,
                       ball_pos.x, ball_pos.y,
-                      ball_vel.x, ball_vel.y );
+                      M_ball_trajectory.vel( cycle ).x, M_ball_trajectory.vel( cycle ).y );
 
 #endif
         const bool goalie_mode
@@ -985,7 +987,7 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
         }
 
         //const double danger_ball_dist = control_area - 0.2;
-        const double safety_ball_dist = std::max( control_area - 0.2 - ball.pos().dist( ball_pos ) * SP.ballRand(),
+        const double safety_ball_dist = std::max( control_area - 0.2 - M_ball_trajectory.travelDist( cycle ) * SP.ballRand(),
                                                   ptype.playerSize() + SP.ballSize() + ptype.kickableMargin() * 0.4 );
 #ifdef DEBUG_PRINT_SHORT_STEP
         dlog.addText( Logger::INTERCEPT,
@@ -1776,6 +1778,27 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
         start_cycle = MAX_SHORT_STEP + 1;
     }
 
+    //
+    // reachable margin of the max speed disc:
+    //   max_control_area + speed_max * cycle - dist( self, ball(cycle) )
+    // the margin never decreases after the ball becomes slower than speed_max.
+    // hopeless cycles in that range are skipped by bisection.
+    //
+    const double max_control_area = ( self.goalie()
+                                      ? std::max( SP.catchableArea(), ptype.kickableArea() )
+                                      : ptype.kickableArea() );
+    int monotone_cycle = 0;
+    {
+        const double first_speed = M_ball_trajectory.vel( 0 ).r();
+        if ( first_speed > ptype.realSpeedMax() )
+        {
+            monotone_cycle = ( SP.ballDecay() < 1.0
+                               ? static_cast< int >( std::ceil( std::log( ptype.realSpeedMax() / first_speed )
+                                                                / std::log( SP.ballDecay() ) ) ) + 1
+                               : max_cycle );
+        }
+    }
+
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
         dlog.addText( Logger::INTERCEPT,
                       "(predictLongStep) start_cycle=%d max_cycle=%d",
@@ -1792,8 +1815,6 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
     }
 #endif
 
-    Vector2D ball_pos = ball.inertiaPoint( start_cycle - 1 );
-    Vector2D ball_vel = ball.vel() * std::pow( SP.ballDecay(), start_cycle - 1 );
     bool found = false;
 
     int max_loop = max_cycle;
@@ -1801,8 +1822,7 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
     tmp_cache.clear();
     for ( int cycle = start_cycle; cycle < max_loop; ++cycle )
     {
-        ball_pos += ball_vel;
-        ball_vel *= SP.ballDecay();
+        const Vector2D ball_pos = M_ball_trajectory.pos( cycle );
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
         dlog.addText( Logger::INTERCEPT,
@@ -1810,7 +1830,7 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
         dlog.addText( Logger::INTERCEPT,
                       "bpos(%.3f, %.3f) bvel(%.3f, %.3f)",
                       ball_pos.x, ball_pos.y,
-                      ball_vel.x, ball_vel.y );
+                      M_ball_trajectory.vel( cycle ).x, M_ball_trajectory.vel( cycle ).y );
 
 #endif
         //         // ball is stopped
@@ -1853,6 +1873,14 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
             dlog.addText( Logger::INTERCEPT,
                           "%d ____ball is too far. never reach", cycle );
 #endif
+            if ( cycle >= monotone_cycle )
+            {
+                cycle = findFirstReachableCycle( cycle + 1, max_loop, max_control_area ) - 1;
+#ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
+                dlog.addText( Logger::INTERCEPT,
+                              "%d ____skip to the first reachable cycle", cycle + 1 );
+#endif
+            }
             continue;
         }
 
@@ -1879,6 +1907,15 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
                 max_loop = std::min( max_cycle, cycle + 10 );
             }
             found = true;
+
+            if ( hasEnoughSolutions( self_cache ) )
+            {
+#ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
+                dlog.addText( Logger::INTERCEPT,
+                              "%d --> found enough solutions", cycle );
+#endif
+                break;
+            }
         }
         ///////////////////////////////////////////////////////////
 #if 0
@@ -1919,6 +1956,104 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+SelfInterceptV13::findFirstReachableCycle( const int first,
+                                           const int last,
+                                           const double & control_area ) const
+{
+    const Vector2D & self_pos = M_world.self().pos();
+    const double speed_max = M_world.self().playerType().realSpeedMax();
+
+    int lo = first;
+    int hi = last;
+    while ( lo < hi )
+    {
+        const int mid = lo + ( hi - lo ) / 2;
+        if ( control_area + ( speed_max * mid )
+             < self_pos.dist( M_ball_trajectory.pos( mid ) ) )
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SelfInterceptV13::hasEnoughSolutions( const std::vector< InterceptInfo > & self_cache ) const
+{
+    if ( M_max_solutions <= 0 )
+    {
+        return false;
+    }
+
+    //
+    // the long step loop registers solutions in ascending order of the reach cycle.
+    // the search is stopped when the fastest N normal solutions are found.
+    // exhaust solutions slower than them are not searched.
+    //
+
+    int count = 0;
+    for ( std::vector< InterceptInfo >::const_iterator it = self_cache.begin(), end = self_cache.end();
+          it != end;
+          ++it )
+    {
+        if ( it->mode() == InterceptInfo::NORMAL
+             && ++count >= M_max_solutions )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SelfInterceptV13::removeSlowSolutions( std::vector< InterceptInfo > & self_cache ) const
+{
+    int normal_count = 0;
+    int exhaust_count = 0;
+
+    std::vector< InterceptInfo >::iterator out = self_cache.begin();
+    for ( std::vector< InterceptInfo >::iterator it = self_cache.begin(), end = self_cache.end();
+          it != end;
+          ++it )
+    {
+        int & count = ( it->mode() == InterceptInfo::EXHAUST
+                        ? exhaust_count
+                        : normal_count );
+        if ( count >= M_max_solutions )
+        {
+            continue;
+        }
+
+        ++count;
+        if ( out != it )
+        {
+            *out = *it;
+        }
+        ++out;
+    }
+
+    self_cache.erase( out, self_cache.end() );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1932,7 +2067,7 @@ SelfInterceptV13::predictFinal( const int max_cycle,
     const PlayerType & ptype = self.playerType();
 
     const Vector2D my_final_pos = self.inertiaPoint( 100 );
-    const Vector2D ball_final_pos = M_world.ball().inertiaPoint( 100 );
+    const Vector2D ball_final_pos = M_ball_trajectory.pos( 100 );
     const bool goalie_mode =
         ( self.goalie()
           && M_world.lastKickerSide() != M_world.ourSide()
@@ -2153,7 +2288,7 @@ SelfInterceptV13::canBackDashChase( const int cycle,
         }
 
         Vector2D goal( - ServerParam::i().pitchHalfLength(), 0.0 );
-        Vector2D bpos = M_world.ball().inertiaPoint( cycle );
+        Vector2D bpos = M_ball_trajectory.pos( cycle );
         if ( goal.dist( bpos ) > 21.0 )
         {
             return false;
@@ -40,6 +40,7 @@
 namespace rcsc {
 
 class BallObject;
+class BallTrajectory;
 class SelfObject;
 class WorldModel;
 
@@ -60,8 +61,11 @@ private:
     //! const reference to the WorldModel instance
     const WorldModel & M_world;
 
-    //! const reference to the ball position cache
-    const std::vector< Vector2D > & M_ball_pos_cache;
+    //! const reference to the predicted ball trajectory
+    const BallTrajectory & M_ball_trajectory;
+
+    //! the number of solutions kept for each stamina mode. 0 means all solutions.
+    const int M_max_solutions;
 
     // noncopyable
     SelfInterceptV13();
@@ -71,11 +75,16 @@ public:
     /*!
       \brief constructor
       \param world const reference to the WorldModel instance
+      \param ball_trajectory const reference to the predicted ball trajectory
+      \param max_solutions the number of the fastest solutions kept for each
+      stamina mode. if 0, all found solutions are kept.
     */
     SelfInterceptV13( const WorldModel & world,
-                      const std::vector< Vector2D > & ball_pos_cache )
+                      const BallTrajectory & ball_trajectory,
+                      const int max_solutions = 0 )
         : M_world( world )
-        , M_ball_pos_cache( ball_pos_cache )
+        , M_ball_trajectory( ball_trajectory )
+        , M_max_solutions( max_solutions )
       { }
 
     //////////////////////////////////////////////////////////
@@ -211,6 +220,33 @@ private:
     void predictFinal( const int max_cycle,
                        std::vector< InterceptInfo > & self_cache ) const;
 
+    /*!
+      \brief find the first cycle that may be reachable by the max speed disc.
+      \param first the first cycle to be checked
+      \param last the end of the checked range (not included)
+      \param control_area the largest control radius
+      \return the first cycle in [first, last) or last if not found.
+
+      This method assumes that the reachable margin is non-decreasing in the
+      range, i.e. the ball speed is not greater than the player's max speed.
+    */
+    int findFirstReachableCycle( const int first,
+                                 const int last,
+                                 const double & control_area ) const;
+
+    /*!
+      \brief check if the solution cache has enough solutions in fastest-N mode
+      \param self_cache solution cache
+      \return true if no more solution is necessary
+    */
+    bool hasEnoughSolutions( const std::vector< InterceptInfo > & self_cache ) const;
+
+    /*!
+      \brief keep only the fastest solutions for each stamina mode
+      \param self_cache sorted solution cache
+    */
+    void removeSlowSolutions( std::vector< InterceptInfo > & self_cache ) const;
+
     /*!
       \brief check if player can get the ball after cycle
       \param cycle we consder the status 'cycle' cycles later
@@ -42,22 +42,13 @@
 #include <rcsc/game_time.h>
 #include <rcsc/math_util.h>
 
-// #define USE_VECTOR
-// #define USE_MULTI_ARRAY
-
-#ifdef USE_VECTOR
-#  include <vector>
-#elif USE_MULTY_ARRAY
-#  include <boost/multi_array.hpp>
-#endif
-
+#include <vector>
+#include <algorithm>
 #include <iostream>
-#include <cstring>
+#include <limits>
 #include <cmath>
 
-#define DEBUG_PROFILE
-// #define DEBUG_PRINT
-// #define DEBUG_PRINT_TEXT
+// #define DEBUG_PROFILE
 // #define DEBUG_PAINT_GRID_MAP
 
 namespace rcsc {
@@ -91,122 +82,87 @@ const double ViewGridMap::GRID_RADIUS = ViewGridMap::GRID_LENGTH*0.5 * std::sqrt
 
 namespace {
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the direction is included in the view cone
+  \param dir checked direction
+  \param left left edge of the view cone
+  \param width view width
+ */
 inline
-int
-grid_x_index( const double & x )
-{
-    int ix = static_cast< int >( std::ceil( ( x - ViewGridMap::PITCH_MIN_X )
-                                            / ViewGridMap::GRID_LENGTH ) );
-    return bound( 0, ix, ViewGridMap::GRID_X_SIZE );
-}
-
-inline
-int
-grid_y_index( const double & y )
-{
-    int iy = static_cast< int >( std::ceil( ( y - ViewGridMap::PITCH_MIN_Y )
-                                            / ViewGridMap::GRID_LENGTH ) );
-    return bound( 0, iy, ViewGridMap::GRID_Y_SIZE );
-}
-
-inline
-int
-grid_index( const Vector2D & pos )
-{
-    int ix = static_cast< int >( std::ceil( ( pos.x - ViewGridMap::PITCH_MIN_X )
-                                            / ViewGridMap::GRID_LENGTH ) );
-    int iy = static_cast< int >( std::ceil( ( pos.y - ViewGridMap::PITCH_MIN_Y )
-                                            / ViewGridMap::GRID_LENGTH ) );
-    ix = bound( 0, ix, ViewGridMap::GRID_X_SIZE );
-    iy = bound( 0, iy, ViewGridMap::GRID_Y_SIZE );
-
-    return ix * ViewGridMap::GRID_Y_SIZE + iy;
-}
-
-inline
-Vector2D
-grid_center( const int idx )
-{
-    int ix = idx / ViewGridMap::GRID_Y_SIZE;
-    int iy = idx % ViewGridMap::GRID_Y_SIZE;
-
-    return Vector2D( ix * ViewGridMap::GRID_LENGTH + ViewGridMap::PITCH_MIN_X,
-                     iy * ViewGridMap::GRID_LENGTH + ViewGridMap::PITCH_MIN_Y );
-}
-
-inline
-Vector2D
-grid_center( const int ix,
-             const int iy )
+bool
+contains_dir( const double & dir,
+              const AngleDeg & left,
+              const double & width )
 {
-    return Vector2D( ix * ViewGridMap::GRID_LENGTH + ViewGridMap::PITCH_MIN_X,
-                     iy * ViewGridMap::GRID_LENGTH + ViewGridMap::PITCH_MIN_Y );
+    double diff = dir - left.degree();
+    while ( diff < 0.0 ) diff += 360.0;
+    while ( diff >= 360.0 ) diff -= 360.0;
+    return diff <= width;
 }
 
 }
 
-
 ///////////////////////////////////////////////////////////////////////
 /*!
 
 */
 struct ViewGridMap::Impl {
 
-#ifdef USE_VECTOR
-    std::vector< int > grid_map_;
-#elif defined (USE_MULTI_ARRAY)
-    boost::multi_array< int, 2 > grid_map_;
-#else
-    int ** grid_map_;
-#endif
-
-    Impl()
-        :
-#ifdef USE_VECTOR
-        grid_map_( ViewGridMap::GRID_X_SIZE * ViewGridMap::GRID_Y_SIZE, 0 )
-#elif defined (USE_MULTI_ARRAY)
-        grid_map_( boost::extents[ViewGridMap::GRID_X_SIZE][ViewGridMap::GRID_Y_SIZE] )
-#else
-        grid_map_( 0 )
-#endif
+    double grid_length_; //!< the length of the grid cell
+    double grid_radius_; //!< the radius of the circle that contains the grid cell
+    double min_x_; //!< x coordinate of the first column
+    double min_y_; //!< y coordinate of the first row
+    int x_size_; //!< the number of columns
+    int y_size_; //!< the number of rows
+
+    std::vector< double > center_x_; //!< x coordinate of each column
+    std::vector< double > center_y_; //!< y coordinate of each row
+    std::vector< int > grid_map_; //!< count values. index = ix * y_size_ + iy
+
+    GameTime last_update_time_; //!< the last updated time
+
+    explicit
+    Impl( const double & grid_length )
+        : grid_length_( grid_length ),
+          grid_radius_( grid_length * 0.5 * std::sqrt( 2.0 ) ),
+          min_x_( std::ceil( ( -ServerParam::DEFAULT_PITCH_LENGTH*0.5 + 1.5 ) / grid_length ) * grid_length ),
+          min_y_( std::ceil( ( -ServerParam::DEFAULT_PITCH_WIDTH*0.5 + 1.5 ) / grid_length ) * grid_length ),
+          x_size_( 0 ),
+          y_size_( 0 ),
+          last_update_time_( 0, 0 )
       {
-#ifdef USE_VECTOR
-          // do nothing
-#elif defined (USE_MULTI_ARRAY)
-          for ( int x = 0; x < ViewGridMap::GRID_X_SIZE; ++x )
+          const double max_x = std::floor( ( +ServerParam::DEFAULT_PITCH_LENGTH*0.5 - 0.5 ) / grid_length ) * grid_length;
+          const double max_y = std::floor( ( +ServerParam::DEFAULT_PITCH_WIDTH*0.5 - 1.5 ) / grid_length ) * grid_length;
+
+          x_size_ = static_cast< int >( std::ceil( ( max_x - min_x_ ) / grid_length ) ) + 1;
+          y_size_ = static_cast< int >( std::ceil( ( max_y - min_y_ ) / grid_length ) ) + 1;
+
+          center_x_.resize( x_size_ );
+          for ( int ix = 0; ix < x_size_; ++ix )
           {
-              for ( int y = 0; y < ViewGridMap::GRID_Y_SIZE; ++y )
-              {
-                  grid_map_[x][y] = 0;
-              }
+              center_x_[ix] = ix * grid_length_ + min_x_;
           }
-#else
-          grid_map_ = new int*[ViewGridMap::GRID_X_SIZE];
-          for ( int x = 0; x < ViewGridMap::GRID_X_SIZE; ++x )
+
+          center_y_.resize( y_size_ );
+          for ( int iy = 0; iy < y_size_; ++iy )
           {
-              grid_map_[x] = new int[ViewGridMap::GRID_Y_SIZE];
-              for ( int y = 0; y < ViewGridMap::GRID_Y_SIZE; ++y )
-              {
-                  grid_map_[x][y] = 0;
-              }
+              center_y_[iy] = iy * grid_length_ + min_y_;
           }
-#endif
+
+          grid_map_.assign( x_size_ * y_size_, 0 );
       }
 
-    ~Impl()
+    int xIndex( const double & x ) const
       {
-#ifdef USE_VECTOR
-
-#elif defined( USE_MULTI_ARRAY)
-
-#else
-          for ( int y = 0; y < ViewGridMap::GRID_Y_SIZE; ++y )
-          {
-              delete [] grid_map_[y];
-          }
+          int ix = static_cast< int >( std::ceil( ( x - min_x_ ) / grid_length_ ) );
+          return bound( 0, ix, x_size_ - 1 );
+      }
 
-          delete [] grid_map_;
-#endif
+    int yIndex( const double & y ) const
+      {
+          int iy = static_cast< int >( std::ceil( ( y - min_y_ ) / grid_length_ ) );
+          return bound( 0, iy, y_size_ - 1 );
       }
 };
 
@@ -215,10 +171,19 @@ struct ViewGridMap::Impl {
 
 */
 ViewGridMap::ViewGridMap()
-    : M_impl( new ViewGridMap::Impl() )
+    : M_impl( new ViewGridMap::Impl( GRID_LENGTH ) )
 {
-    // std::cerr << __FILE__"create ViewGridMap size=" << M_impl->grid_map_.size()
-    //           << std::endl;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ViewGridMap::ViewGridMap( const double & grid_length )
+    : M_impl( new ViewGridMap::Impl( grid_length > 0.0 ? grid_length : GRID_LENGTH ) )
+{
+
 }
 
 /*-------------------------------------------------------------------*/
@@ -233,11 +198,30 @@ ViewGridMap::~ViewGridMap()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+double
+ViewGridMap::gridLength() const
+{
+    return M_impl->grid_length_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+ViewGridMap::gridSize() const
+{
+    return static_cast< int >( M_impl->grid_map_.size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 ViewGridMap::incrementAll()
 {
-#ifdef USE_VECTOR
     const std::vector< int >::iterator end = M_impl->grid_map_.end();
     for ( std::vector< int >::iterator v = M_impl->grid_map_.begin();
           v != end;
@@ -245,15 +229,6 @@ ViewGridMap::incrementAll()
     {
         *v += 1;
     }
-#else
-    for ( int x = 0; x < ViewGridMap::GRID_X_SIZE; ++x )
-    {
-        for ( int y = 0; y < ViewGridMap::GRID_Y_SIZE; ++y )
-        {
-            M_impl->grid_map_[x][y] += 1;
-        }
-    }
-#endif
 }
 
 /*-------------------------------------------------------------------*/
@@ -264,28 +239,13 @@ void
 ViewGridMap::update( const GameTime & time,
                      const ViewArea & view_area )
 {
-    static GameTime s_update_time( 0, 0 );
+    Impl & impl = *M_impl;
 
-    if ( s_update_time == time )
+    if ( impl.last_update_time_ == time )
     {
         return;
     }
-    s_update_time = time;
-
-#ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" PITCH_MIN_X=%.1f PITCH_MAX_X=%.1f GRID_X_SIZE=%d",
-                  PITCH_MIN_X, PITCH_MAX_X,
-                  GRID_X_SIZE );
-    dlog.addText( Logger::WORLD,
-                  __FILE__" PITCH_MIN_Y=%.1f PITCH_MAX_Y=%.1f GRID_Y_SIZE=%d",
-                  PITCH_MIN_Y, PITCH_MAX_Y,
-                  GRID_Y_SIZE );
-    dlog.addText( Logger::WORLD,
-                  __FILE__" grid map size=%d",
-                  M_impl->grid_map_.size() );
-#endif
-
+    impl.last_update_time_ = time;
 
 #ifdef DEBUG_PROFILE
     Timer timer;
@@ -296,88 +256,86 @@ ViewGridMap::update( const GameTime & time,
         return;
     }
 
-    const AngleDeg left_angle = view_area.angle() - view_area.viewWidth() * 0.5;
-    const AngleDeg right_angle = view_area.angle() + view_area.viewWidth() * 0.5;
-
-    static const double VISIBLE_DIST = ServerParam::i().visibleDistance() - GRID_RADIUS;
-
-#ifdef USE_VECTOR
-    int i = 0;
-    const std::vector< int >::iterator end = M_impl->grid_map_.end();
-    for ( std::vector< int >::iterator v = M_impl->grid_map_.begin();
-          v != end;
-          ++v, ++i )
+    //
+    // A cell is reset if its center is farther than the visible distance
+    // and the circle around the cell is inside the view cone.
+    // The angular margin asin( radius / dist ) of the edge is equivalent to
+    // the perpendicular distance from the edge line, so no atan2/asin is needed.
+    //
+
+    const double width = view_area.viewWidth();
+    const AngleDeg left_angle = view_area.angle() - width * 0.5;
+    const AngleDeg right_angle = view_area.angle() + width * 0.5;
+
+    const double left_x = left_angle.cos();
+    const double left_y = left_angle.sin();
+    const double right_x = right_angle.cos();
+    const double right_y = right_angle.sin();
+
+    const double radius = impl.grid_radius_;
+    const double visible_dist = std::max( 0.0, ServerParam::i().visibleDistance() - radius );
+    const double visible_dist2 = visible_dist * visible_dist;
+
+    const Vector2D & origin = view_area.origin();
+
+    //
+    // the bounding box of the view cone
+    //
+    const double inf = std::numeric_limits< double >::max();
+    const double min_x = ( contains_dir( 180.0, left_angle, width )
+                           || left_x < 0.0 || right_x < 0.0 ) ? -inf : origin.x;
+    const double max_x = ( contains_dir( 0.0, left_angle, width )
+                           || left_x > 0.0 || right_x > 0.0 ) ? +inf : origin.x;
+    const double min_y = ( contains_dir( -90.0, left_angle, width )
+                           || left_y < 0.0 || right_y < 0.0 ) ? -inf : origin.y;
+    const double max_y = ( contains_dir( 90.0, left_angle, width )
+                           || left_y > 0.0 || right_y > 0.0 ) ? +inf : origin.y;
+
+    const int ix_begin = ( min_x == -inf ? 0 : impl.xIndex( min_x - impl.grid_length_ ) );
+    const int ix_end = ( max_x == +inf ? impl.x_size_ : impl.xIndex( max_x + impl.grid_length_ ) + 1 );
+    const int iy_begin = ( min_y == -inf ? 0 : impl.yIndex( min_y - impl.grid_length_ ) );
+    const int iy_end = ( max_y == +inf ? impl.y_size_ : impl.yIndex( max_y + impl.grid_length_ ) + 1 );
+
+    const double * const center_y = &impl.center_y_[0];
+
+    for ( int ix = ix_begin; ix < ix_end; ++ix )
     {
-        int & value = *v;;
-        Vector2D pos = grid_center( i );
-#else
-        for ( int ix = 0; ix < ViewGridMap::GRID_X_SIZE; ++ix )
+        const double rx = impl.center_x_[ix] - origin.x;
+        int * const row = &impl.grid_map_[ix * impl.y_size_];
+
+        for ( int iy = iy_begin; iy < iy_end; ++iy )
         {
-            for ( int iy = 0; iy < ViewGridMap::GRID_Y_SIZE; ++iy )
-            {
-                int & value = M_impl->grid_map_[ix][iy];
-                Vector2D pos = grid_center( ix, iy );
-#endif
+            const double ry = center_y[iy] - origin.y;
+
+            // cross and dot products with the edge directions
+            const double left_cross = left_x * ry - left_y * rx;
+            const double left_dot = left_x * rx + left_y * ry;
+            const double right_cross = right_y * rx - right_x * ry;
+            const double right_dot = right_x * rx + right_y * ry;
+
+            const bool reset = ( ( rx * rx + ry * ry > visible_dist2 )
+                                 & ( ( left_cross > radius )
+                                     | ( ( left_cross > 0.0 ) & ( left_dot < 0.0 ) ) )
+                                 & ( ( right_cross > radius )
+                                     | ( ( right_cross > 0.0 ) & ( right_dot < 0.0 ) ) ) );
+
+            row[iy] = ( reset ? 0 : row[iy] );
+        }
+    }
 
-                double dist = view_area.origin().dist( pos );
-                if ( dist > VISIBLE_DIST )
-                {
-                    AngleDeg angle = ( pos - view_area.origin() ).th();
-                    if ( angle.isRightOf( left_angle )
-                         && angle.isLeftOf( right_angle ) )
-                    {
-                        double angle_thr = AngleDeg::asin_deg( GRID_RADIUS / dist );
-                        if ( ( angle - left_angle ).abs() > angle_thr
-                             && ( angle - right_angle ).abs() > angle_thr )
-                        {
-                            value = 0;
-                        }
-
-                    }
-                }
-#ifdef DEBUG_PRINT_TEXT
-#  ifdef USE_VECTOR
-                dlog.addText( Logger::WORLD,
-                              __FILE__" %05d (%04d %04d) pos=(%.2f %.2f) -> %d | count=%d",
-                              i,
-                              i / ViewGridMap::GRID_Y_SIZE,
-                              i % ViewGridMap::GRID_Y_SIZE,
-                              pos.x, pos.y,
-                              grid_index( pos ),
-                              *v );
-                if ( grid_index( pos ) != i )
-                {
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__"---> index mismatch" );
-                }
-#  else
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (%03d %03d) pos=(%.2f %.2f) -> (%d %d) | count=%d",
-                              ix, iy,
-                              pos.x, pos.y,
-                              grid_x_index( pos.x ), grid_y_index( pos.y ),
-                              value );
-                if ( ix != grid_x_index( pos.x )
-                     || iy != grid_y_index( pos.y ) )
-                {
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__"---> index mismatch" );
-                }
-#  endif
-#endif
 #ifdef DEBUG_PAINT_GRID_MAP
-                // int vv = std::max( 0, 255 - *v * 20 );
-                int vv = std::max( 0, 255 - value * 20 );
-                dlog.addRect( Logger::WORLD,
-                              pos.x - GRID_LENGTH*0.125, pos.y - GRID_LENGTH*0.125,
-                              GRID_LENGTH*0.25, GRID_LENGTH*0.25,
-                              vv, vv, vv,
-                              true );
-#endif
-#ifndef USE_VECTOR
-            }
+    for ( int ix = 0; ix < impl.x_size_; ++ix )
+    {
+        for ( int iy = 0; iy < impl.y_size_; ++iy )
+        {
+            int vv = std::max( 0, 255 - impl.grid_map_[ix * impl.y_size_ + iy] * 20 );
+            dlog.addRect( Logger::WORLD,
+                          impl.center_x_[ix] - impl.grid_length_*0.125,
+                          impl.center_y_[iy] - impl.grid_length_*0.125,
+                          impl.grid_length_*0.25, impl.grid_length_*0.25,
+                          vv, vv, vv,
+                          true );
         }
-#else
     }
 #endif
 
@@ -385,12 +343,7 @@ ViewGridMap::update( const GameTime & time,
     dlog.addText( Logger::WORLD,
                   __FILE__" (update) PROFILE elapsed %f [ms] grid_size=%d",
                   timer.elapsedReal(),
-#ifdef USE_VECTOR
-                  M_impl->grid_map_.size()
-#else
-                  GRID_X_SIZE * GRID_Y_SIZE
-#endif
-                  );
+                  ( ix_end - ix_begin ) * ( iy_end - iy_begin ) );
 #endif
 }
 
@@ -399,23 +352,10 @@ ViewGridMap::update( const GameTime & time,
 
 */
 int
-ViewGridMap::seenCount( const Vector2D & pos )
+ViewGridMap::seenCount( const Vector2D & pos ) const
 {
-#ifdef USE_VECTOR
-    return M_impl->grid_map_.at( grid_index( pos ) );
-    // try
-    // {
-    //     return M_impl->grid_map_.at( grid_index( pos ) );
-    // }
-    // catch ( std::exception & e )
-    // {
-    //     std::cerr << __FILE__ ": exception caught! " << e.what()
-    //               << std::endl;
-    //     return 1000;
-    // }
-#else
-    return M_impl->grid_map_[grid_x_index( pos.x )][grid_y_index( pos.y )];
-#endif
+    return M_impl->grid_map_[M_impl->xIndex( pos.x ) * M_impl->y_size_
+                             + M_impl->yIndex( pos.y )];
 }
 
 }
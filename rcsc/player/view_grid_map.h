@@ -43,6 +43,10 @@ class ViewArea;
 /*!
   \class ViewGridMap
   \brief grid map that stores field accuracy information
+
+  The cell center coordinates are precomputed for each column and row,
+  and update() evaluates only the cells in the bounding box of the view
+  cone without any trigonometric function.
  */
 class ViewGridMap {
 private:
@@ -68,18 +72,43 @@ public:
     static const double GRID_RADIUS;
     static const double GRID_RADIUS2;
 
+private:
+
+    // not used
+    ViewGridMap( const ViewGridMap & );
+    ViewGridMap & operator=( const ViewGridMap & );
+
 public:
 
     /*!
-      \brief default constructor
+      \brief create the grid map with the default grid length
     */
     ViewGridMap();
 
+    /*!
+      \brief create the grid map with the specified grid length
+      \param grid_length the length of the grid cell
+    */
+    explicit
+    ViewGridMap( const double & grid_length );
+
     /*!
       \brief destructor.
      */
     ~ViewGridMap();
 
+    /*!
+      \brief get the length of the grid cell
+      \return grid length
+     */
+    double gridLength() const;
+
+    /*!
+      \brief get the number of grid cells
+      \return the number of grid cells
+     */
+    int gridSize() const;
+
     /*!
       \brief simply increment all grid values.
      */
@@ -96,7 +125,7 @@ public:
       \param pos target point
       \return count value
      */
-    int seenCount( const Vector2D & pos );
+    int seenCount( const Vector2D & pos ) const;
 
 };
 
@@ -37,6 +37,8 @@
 
 #include <rcsc/common/logger.h>
 
+#include <boost/cstdint.hpp>
+
 #include <iterator>
 #include <algorithm>
 #include <limits> // std::numeric_limits
@@ -66,6 +68,199 @@ struct SeenDistCmp {
       }
 };
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief stable sort by the seen distance.
+  insertion sort is used, because the number of objects is small
+  and it does not require any extra buffer.
+  \param cont reference to the container
+*/
+template < typename Cont >
+void
+sort_by_dist( Cont & cont )
+{
+    typedef typename Cont::value_type value_type;
+
+    const SeenDistCmp cmp = SeenDistCmp();
+    const std::size_t size = cont.size();
+
+    for ( std::size_t i = 1; i < size; ++i )
+    {
+        if ( ! cmp( cont[i], cont[i - 1] ) )
+        {
+            continue;
+        }
+
+        const value_type v = cont[i];
+        std::size_t j = i;
+        while ( j > 0
+                && cmp( v, cont[j - 1] ) )
+        {
+            cont[j] = cont[j - 1];
+            --j;
+        }
+        cont[j] = v;
+    }
+}
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct MarkerNameCmp
+  \brief functor to search the marker name without creating a string
+*/
+struct MarkerNameCmp {
+    /*!
+      \brief operation function
+      \param lhs marker table entry
+      \param rhs pair of the name pointer and the name length
+      \return compared result
+     */
+    bool operator()( const std::pair< std::string, MarkerID > & lhs,
+                     const std::pair< const char *, std::size_t > & rhs ) const
+      {
+          return lhs.first.compare( 0, std::string::npos, rhs.first, rhs.second ) < 0;
+      }
+};
+
+//! exactly representable powers of ten
+const double POW10[] = {
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7,
+    1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+    1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+//! the maximal number of values in one object info
+const int MAX_VALUE_TOKEN = 8;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the decimal string to the floating point value.
+
+  The plain decimal notation with at most 15 significant digits is
+  converted by one division of exactly representable values, which is
+  correctly rounded as well as std::strtod. Other notations are passed
+  to std::strtod. Therefore, the result is always same as std::strtod.
+
+  \param str pointer to the top of string
+  \param next pointer to the character following the converted string
+  \return converted value
+*/
+inline
+double
+parse_real( const char * str,
+            const char ** next )
+{
+    const char * p = str;
+
+    while ( *p == ' ' ) ++p;
+
+    bool negative = false;
+    if ( *p == '-' )
+    {
+        negative = true;
+        ++p;
+    }
+    else if ( *p == '+' )
+    {
+        ++p;
+    }
+
+    boost::uint64_t mantissa = 0;
+    int n_digits = 0;
+    int n_significant = 0;
+    int n_fraction = 0;
+
+    while ( '0' <= *p && *p <= '9' )
+    {
+        mantissa = mantissa * 10 + ( *p - '0' );
+        if ( mantissa != 0 ) ++n_significant;
+        ++n_digits;
+        ++p;
+    }
+
+    if ( *p == '.' )
+    {
+        ++p;
+        while ( '0' <= *p && *p <= '9' )
+        {
+            mantissa = mantissa * 10 + ( *p - '0' );
+            if ( mantissa != 0 ) ++n_significant;
+            ++n_digits;
+            ++n_fraction;
+            ++p;
+        }
+    }
+
+    if ( n_digits == 0
+         || n_significant > 15
+         || n_fraction > 22
+         || ( 'a' <= *p && *p <= 'z' )
+         || ( 'A' <= *p && *p <= 'Z' ) )
+    {
+        // exponent, hex, inf, nan or too many digits
+        char * end;
+        const double value = std::strtod( str, &end );
+        *next = end;
+        return value;
+    }
+
+    *next = p;
+
+    const double value = static_cast< double >( mantissa ) / POW10[n_fraction];
+    return ( negative ? -value : value );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the positional values of the object info.
+  \param tok pointer to the current position. updated to the closing paren.
+  \param values array to store the values. 0 is set for the non-numerical token.
+  \param heads array to store the first character of each token
+  \return the number of tokens. it may be greater than MAX_VALUE_TOKEN.
+*/
+inline
+int
+read_values( const char ** tok,
+             double * values,
+             char * heads )
+{
+    const char * p = *tok;
+    int n = 0;
+
+    while ( *p != '\0' && *p != ')' )
+    {
+        if ( *p == ' ' )
+        {
+            ++p;
+            continue;
+        }
+
+        const char head = *p;
+        double v = 0.0;
+        if ( ( '0' <= *p && *p <= '9' )
+             || *p == '-' || *p == '+' || *p == '.' )
+        {
+            v = parse_real( p, &p );
+        }
+
+        if ( n < MAX_VALUE_TOKEN )
+        {
+            values[n] = v;
+            heads[n] = head;
+        }
+        ++n;
+
+        while ( *p != '\0' && *p != ' ' && *p != ')' ) ++p;
+    }
+
+    *tok = p;
+    return n;
+}
+
+}
+
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -169,138 +364,155 @@ VisualSensor::VisualSensor()
     : M_time( -1, 0 )
     , M_opponent_team_name( "" )
 {
-    using namespace rcsc;
-    typedef std::pair< std::string, MarkerID > MarkerPair;
-
-    M_marker_map.insert( MarkerPair( "g l", Goal_L ) );
-    M_marker_map.insert( MarkerPair( "g r", Goal_R ) );
-
-    M_marker_map.insert( MarkerPair( "f c", Flag_C ) );
-    M_marker_map.insert( MarkerPair( "f c t", Flag_CT ) );
-    M_marker_map.insert( MarkerPair( "f c b", Flag_CB ) );
-    M_marker_map.insert( MarkerPair( "f l t", Flag_LT ) );
-    M_marker_map.insert( MarkerPair( "f l b", Flag_LB ) );
-    M_marker_map.insert( MarkerPair( "f r t", Flag_RT ) );
-    M_marker_map.insert( MarkerPair( "f r b", Flag_RB ) );
-
-    M_marker_map.insert( MarkerPair( "f p l t", Flag_PLT ) );
-    M_marker_map.insert( MarkerPair( "f p l c", Flag_PLC ) );
-    M_marker_map.insert( MarkerPair( "f p l b", Flag_PLB ) );
-    M_marker_map.insert( MarkerPair( "f p r t", Flag_PRT ) );
-    M_marker_map.insert( MarkerPair( "f p r c", Flag_PRC ) );
-    M_marker_map.insert( MarkerPair( "f p r b", Flag_PRB ) );
-
-    M_marker_map.insert( MarkerPair( "f g l t", Flag_GLT ) );
-    M_marker_map.insert( MarkerPair( "f g l b", Flag_GLB ) );
-    M_marker_map.insert( MarkerPair( "f g r t", Flag_GRT ) );
-    M_marker_map.insert( MarkerPair( "f g r b", Flag_GRB ) );
-
-    M_marker_map.insert( MarkerPair( "f t l 50", Flag_TL50 ) );
-    M_marker_map.insert( MarkerPair( "f t l 40", Flag_TL40 ) );
-    M_marker_map.insert( MarkerPair( "f t l 30", Flag_TL30 ) );
-    M_marker_map.insert( MarkerPair( "f t l 20", Flag_TL20 ) );
-    M_marker_map.insert( MarkerPair( "f t l 10", Flag_TL10 ) );
-    M_marker_map.insert( MarkerPair( "f t 0", Flag_T0 ) );
-    M_marker_map.insert( MarkerPair( "f t r 10", Flag_TR10 ) );
-    M_marker_map.insert( MarkerPair( "f t r 20", Flag_TR20 ) );
-    M_marker_map.insert( MarkerPair( "f t r 30", Flag_TR30 ) );
-    M_marker_map.insert( MarkerPair( "f t r 40", Flag_TR40 ) );
-    M_marker_map.insert( MarkerPair( "f t r 50", Flag_TR50 ) );
-
-    M_marker_map.insert( MarkerPair( "f b l 50", Flag_BL50 ) );
-    M_marker_map.insert( MarkerPair( "f b l 40", Flag_BL40 ) );
-    M_marker_map.insert( MarkerPair( "f b l 30", Flag_BL30 ) );
-    M_marker_map.insert( MarkerPair( "f b l 20", Flag_BL20 ) );
-    M_marker_map.insert( MarkerPair( "f b l 10", Flag_BL10 ) );
-    M_marker_map.insert( MarkerPair( "f b 0", Flag_B0 ) );
-    M_marker_map.insert( MarkerPair( "f b r 10", Flag_BR10 ) );
-    M_marker_map.insert( MarkerPair( "f b r 20", Flag_BR20 ) );
-    M_marker_map.insert( MarkerPair( "f b r 30", Flag_BR30 ) );
-    M_marker_map.insert( MarkerPair( "f b r 40", Flag_BR40 ) );
-    M_marker_map.insert( MarkerPair( "f b r 50", Flag_BR50 ) );
-
-    M_marker_map.insert( MarkerPair( "f l t 30", Flag_LT30 ) );
-    M_marker_map.insert( MarkerPair( "f l t 20", Flag_LT20 ) );
-    M_marker_map.insert( MarkerPair( "f l t 10", Flag_LT10 ) );
-    M_marker_map.insert( MarkerPair( "f l 0", Flag_L0 ) );
-    M_marker_map.insert( MarkerPair( "f l b 10", Flag_LB10 ) );
-    M_marker_map.insert( MarkerPair( "f l b 20", Flag_LB20 ) );
-    M_marker_map.insert( MarkerPair( "f l b 30", Flag_LB30 ) );
-
-    M_marker_map.insert( MarkerPair( "f r t 30", Flag_RT30 ) );
-    M_marker_map.insert( MarkerPair( "f r t 20", Flag_RT20 ) );
-    M_marker_map.insert( MarkerPair( "f r t 10", Flag_RT10 ) );
-    M_marker_map.insert( MarkerPair( "f r 0", Flag_R0 ) );
-    M_marker_map.insert( MarkerPair( "f r b 10", Flag_RB10 ) );
-    M_marker_map.insert( MarkerPair( "f r b 20", Flag_RB20 ) );
-    M_marker_map.insert( MarkerPair( "f r b 30", Flag_RB30 ) );
+    M_marker_map.reserve( 55 );
+    M_marker_map_old.reserve( 55 );
+
+    M_marker_map.push_back( MarkerPair( "g l", Goal_L ) );
+    M_marker_map.push_back( MarkerPair( "g r", Goal_R ) );
+
+    M_marker_map.push_back( MarkerPair( "f c", Flag_C ) );
+    M_marker_map.push_back( MarkerPair( "f c t", Flag_CT ) );
+    M_marker_map.push_back( MarkerPair( "f c b", Flag_CB ) );
+    M_marker_map.push_back( MarkerPair( "f l t", Flag_LT ) );
+    M_marker_map.push_back( MarkerPair( "f l b", Flag_LB ) );
+    M_marker_map.push_back( MarkerPair( "f r t", Flag_RT ) );
+    M_marker_map.push_back( MarkerPair( "f r b", Flag_RB ) );
+
+    M_marker_map.push_back( MarkerPair( "f p l t", Flag_PLT ) );
+    M_marker_map.push_back( MarkerPair( "f p l c", Flag_PLC ) );
+    M_marker_map.push_back( MarkerPair( "f p l b", Flag_PLB ) );
+    M_marker_map.push_back( MarkerPair( "f p r t", Flag_PRT ) );
+    M_marker_map.push_back( MarkerPair( "f p r c", Flag_PRC ) );
+    M_marker_map.push_back( MarkerPair( "f p r b", Flag_PRB ) );
+
+    M_marker_map.push_back( MarkerPair( "f g l t", Flag_GLT ) );
+    M_marker_map.push_back( MarkerPair( "f g l b", Flag_GLB ) );
+    M_marker_map.push_back( MarkerPair( "f g r t", Flag_GRT ) );
+    M_marker_map.push_back( MarkerPair( "f g r b", Flag_GRB ) );
+
+    M_marker_map.push_back( MarkerPair( "f t l 50", Flag_TL50 ) );
+    M_marker_map.push_back( MarkerPair( "f t l 40", Flag_TL40 ) );
+    M_marker_map.push_back( MarkerPair( "f t l 30", Flag_TL30 ) );
+    M_marker_map.push_back( MarkerPair( "f t l 20", Flag_TL20 ) );
+    M_marker_map.push_back( MarkerPair( "f t l 10", Flag_TL10 ) );
+    M_marker_map.push_back( MarkerPair( "f t 0", Flag_T0 ) );
+    M_marker_map.push_back( MarkerPair( "f t r 10", Flag_TR10 ) );
+    M_marker_map.push_back( MarkerPair( "f t r 20", Flag_TR20 ) );
+    M_marker_map.push_back( MarkerPair( "f t r 30", Flag_TR30 ) );
+    M_marker_map.push_back( MarkerPair( "f t r 40", Flag_TR40 ) );
+    M_marker_map.push_back( MarkerPair( "f t r 50", Flag_TR50 ) );
+
+    M_marker_map.push_back( MarkerPair( "f b l 50", Flag_BL50 ) );
+    M_marker_map.push_back( MarkerPair( "f b l 40", Flag_BL40 ) );
+    M_marker_map.push_back( MarkerPair( "f b l 30", Flag_BL30 ) );
+    M_marker_map.push_back( MarkerPair( "f b l 20", Flag_BL20 ) );
+    M_marker_map.push_back( MarkerPair( "f b l 10", Flag_BL10 ) );
+    M_marker_map.push_back( MarkerPair( "f b 0", Flag_B0 ) );
+    M_marker_map.push_back( MarkerPair( "f b r 10", Flag_BR10 ) );
+    M_marker_map.push_back( MarkerPair( "f b r 20", Flag_BR20 ) );
+    M_marker_map.push_back( MarkerPair( "f b r 30", Flag_BR30 ) );
+    M_marker_map.push_back( MarkerPair( "f b r 40", Flag_BR40 ) );
+    M_marker_map.push_back( MarkerPair( "f b r 50", Flag_BR50 ) );
+
+    M_marker_map.push_back( MarkerPair( "f l t 30", Flag_LT30 ) );
+    M_marker_map.push_back( MarkerPair( "f l t 20", Flag_LT20 ) );
+    M_marker_map.push_back( MarkerPair( "f l t 10", Flag_LT10 ) );
+    M_marker_map.push_back( MarkerPair( "f l 0", Flag_L0 ) );
+    M_marker_map.push_back( MarkerPair( "f l b 10", Flag_LB10 ) );
+    M_marker_map.push_back( MarkerPair( "f l b 20", Flag_LB20 ) );
+    M_marker_map.push_back( MarkerPair( "f l b 30", Flag_LB30 ) );
+
+    M_marker_map.push_back( MarkerPair( "f r t 30", Flag_RT30 ) );
+    M_marker_map.push_back( MarkerPair( "f r t 20", Flag_RT20 ) );
+    M_marker_map.push_back( MarkerPair( "f r t 10", Flag_RT10 ) );
+    M_marker_map.push_back( MarkerPair( "f r 0", Flag_R0 ) );
+    M_marker_map.push_back( MarkerPair( "f r b 10", Flag_RB10 ) );
+    M_marker_map.push_back( MarkerPair( "f r b 20", Flag_RB20 ) );
+    M_marker_map.push_back( MarkerPair( "f r b 30", Flag_RB30 ) );
 
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
 
-    M_marker_map_old.insert( MarkerPair( "goal l", Goal_L ) );
-    M_marker_map_old.insert( MarkerPair( "goal r", Goal_R ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag c", Flag_C ) );
-    M_marker_map_old.insert( MarkerPair( "flag c t", Flag_CT ) );
-    M_marker_map_old.insert( MarkerPair( "flag c b", Flag_CB ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t", Flag_LT ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b", Flag_LB ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t", Flag_RT ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b", Flag_RB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag p l t", Flag_PLT ) );
-    M_marker_map_old.insert( MarkerPair( "flag p l c", Flag_PLC ) );
-    M_marker_map_old.insert( MarkerPair( "flag p l b", Flag_PLB ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r t", Flag_PRT ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r c", Flag_PRC ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r b", Flag_PRB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag g l t", Flag_GLT ) );
-    M_marker_map_old.insert( MarkerPair( "flag g l b", Flag_GLB ) );
-    M_marker_map_old.insert( MarkerPair( "flag g r t", Flag_GRT ) );
-    M_marker_map_old.insert( MarkerPair( "flag g r b", Flag_GRB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag t l 50", Flag_TL50 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 40", Flag_TL40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 30", Flag_TL30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 20", Flag_TL20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 10", Flag_TL10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t 0", Flag_T0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 10", Flag_TR10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 20", Flag_TR20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 30", Flag_TR30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 40", Flag_TR40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 50", Flag_TR50 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag b l 50", Flag_BL50 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 40", Flag_BL40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 30", Flag_BL30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 20", Flag_BL20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 10", Flag_BL10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b 0", Flag_B0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 10", Flag_BR10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 20", Flag_BR20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 30", Flag_BR30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 40", Flag_BR40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 50", Flag_BR50 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag l t 30", Flag_LT30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t 20", Flag_LT20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t 10", Flag_LT10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l 0", Flag_L0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 10", Flag_LB10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 20", Flag_LB20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 30", Flag_LB30 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag r t 30", Flag_RT30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t 20", Flag_RT20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t 10", Flag_RT10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r 0", Flag_R0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 10", Flag_RB10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 20", Flag_RB20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 30", Flag_RB30 ) );
+    M_marker_map_old.push_back( MarkerPair( "goal l", Goal_L ) );
+    M_marker_map_old.push_back( MarkerPair( "goal r", Goal_R ) );
+
+    M_marker_map_old.push_back( MarkerPair( "flag c", Flag_C ) );
+    M_marker_map_old.push_back( MarkerPair( "flag c t", Flag_CT ) );
+    M_marker_map_old.push_back( MarkerPair( "flag c b", Flag_CB ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l t", Flag_LT ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l b", Flag_LB ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r t", Flag_RT ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r b", Flag_RB ) );
+
+    M_marker_map_old.push_back( MarkerPair( "flag p l t", Flag_PLT ) );
+    M_marker_map_old.push_back( MarkerPair( "flag p l c", Flag_PLC ) );
+    M_marker_map_old.push_back( MarkerPair( "flag p l b", Flag_PLB ) );
+    M_marker_map_old.push_back( MarkerPair( "flag p r t", Flag_PRT ) );
+    M_marker_map_old.push_back( MarkerPair( "flag p r c", Flag_PRC ) );
+    M_marker_map_old.push_back( MarkerPair( "flag p r b", Flag_PRB ) );
+
+    M_marker_map_old.push_back( MarkerPair( "flag g l t", Flag_GLT ) );
+    M_marker_map_old.push_back( MarkerPair( "flag g l b", Flag_GLB ) );
+    M_marker_map_old.push_back( MarkerPair( "flag g r t", Flag_GRT ) );
+    M_marker_map_old.push_back( MarkerPair( "flag g r b", Flag_GRB ) );
+
+    M_marker_map_old.push_back( MarkerPair( "flag t l 50", Flag_TL50 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t l 40", Flag_TL40 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t l 30", Flag_TL30 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t l 20", Flag_TL20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t l 10", Flag_TL10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t 0", Flag_T0 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t r 10", Flag_TR10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t r 20", Flag_TR20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t r 30", Flag_TR30 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t r 40", Flag_TR40 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag t r 50", Flag_TR50 ) );
+
+    M_marker_map_old.push_back( MarkerPair( "flag b l 50", Flag_BL50 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b l 40", Flag_BL40 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b l 30", Flag_BL30 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b l 20", Flag_BL20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b l 10", Flag_BL10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b 0", Flag_B0 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b r 10", Flag_BR10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b r 20", Flag_BR20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b r 30", Flag_BR30 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b r 40", Flag_BR40 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag b r 50", Flag_BR50 ) );
+
+    M_marker_map_old.push_back( MarkerPair( "flag l t 30", Flag_LT30 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l t 20", Flag_LT20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l t 10", Flag_LT10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l 0", Flag_L0 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l b 10", Flag_LB10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l b 20", Flag_LB20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag l b 30", Flag_LB30 ) );
+
+    M_marker_map_old.push_back( MarkerPair( "flag r t 30", Flag_RT30 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r t 20", Flag_RT20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r t 10", Flag_RT10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r 0", Flag_R0 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r b 10", Flag_RB10 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r b 20", Flag_RB20 ) );
+    M_marker_map_old.push_back( MarkerPair( "flag r b 30", Flag_RB30 ) );
+
+    std::sort( M_marker_map.begin(), M_marker_map.end() );
+    std::sort( M_marker_map_old.begin(), M_marker_map_old.end() );
+
+    //
+    // reserve the containers to avoid the reallocation in parse()
+    //
+
+    M_balls.reserve( 4 );
+    M_markers.reserve( 64 );
+    M_behind_markers.reserve( 16 );
+    M_lines.reserve( 4 );
+    M_teammates.reserve( 16 );
+    M_unknown_teammates.reserve( 16 );
+    M_opponents.reserve( 16 );
+    M_unknown_opponents.reserve( 16 );
+    M_unknown_players.reserve( 32 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -358,13 +570,14 @@ VisualSensor::parse( const char * msg,
         object_type = getObjectTypeOf( *( msg + 2 ) );
 
         ////////////////////////////////////////
-        // get object info
+        // get object info.
+        // msg is moved to the closing paren of the object if parsed.
         // marker
         if ( object_type == Obj_Marker
              || object_type == Obj_Goal )
         {
             seen_marker.object_type_ = object_type;
-            if ( parseMarker( msg, version, &seen_marker ) )
+            if ( parseMarker( &msg, version, &seen_marker ) )
             {
                 M_markers.push_back( seen_marker );
             }
@@ -375,7 +588,7 @@ VisualSensor::parse( const char * msg,
                   || object_type == Obj_Goal_Behind )
         {
             seen_marker.object_type_ = object_type;
-            if ( parseMarker( msg, version, &seen_marker ) )
+            if ( parseMarker( &msg, version, &seen_marker ) )
             {
                 M_behind_markers.push_back( seen_marker );
             }
@@ -384,7 +597,7 @@ VisualSensor::parse( const char * msg,
         // player
         else if ( object_type == Obj_Player )
         {
-            switch ( parsePlayer( msg, team_name, team_name_len, &seen_player ) ) {
+            switch ( parsePlayer( &msg, team_name, team_name_len, &seen_player ) ) {
             case Player_Teammate:
                 M_teammates.push_back( seen_player );
                 break;
@@ -412,7 +625,7 @@ VisualSensor::parse( const char * msg,
         // line
         else if ( object_type == Obj_Line )
         {
-            if ( parseLine( msg, version, &seen_line ) )
+            if ( parseLine( &msg, version, &seen_line ) )
             {
                 M_lines.push_back( seen_line );
             }
@@ -421,7 +634,7 @@ VisualSensor::parse( const char * msg,
         // ball
         else if ( object_type == Obj_Ball )
         {
-            if ( parseBall( msg, &seen_ball ) )
+            if ( parseBall( &msg, &seen_ball ) )
             {
                 M_balls.push_back( seen_ball );
             }
@@ -433,46 +646,24 @@ VisualSensor::parse( const char * msg,
                       << std::endl;
         }
 
-        // skip object info token
+        // skip the rest of object info token
         while ( *msg != '\0' && *msg != ')' ) ++msg; // skip object info
         while ( *msg != '\0' && *msg != '(' ) ++msg; // skip to next object token
     } // main loop
 
 
     // sort by distance
-#ifdef USE_LIST_VISUAL_OBJECT
-    M_teammates.sort( SeenDistCmp() );
-    M_unknown_teammates.sort( SeenDistCmp() );
-    M_opponents.sort( SeenDistCmp() );
-    M_unknown_opponents.sort( SeenDistCmp() );
-    M_unknown_players.sort( SeenDistCmp() );
+    sort_by_dist( M_teammates );
+    sort_by_dist( M_unknown_teammates );
+    sort_by_dist( M_opponents );
+    sort_by_dist( M_unknown_opponents );
+    sort_by_dist( M_unknown_players );
 
-    M_markers.sort( SeenDistCmp() );
-    M_behind_markers.sort( SeenDistCmp() );
+    sort_by_dist( M_markers );
+    sort_by_dist( M_behind_markers );
 
     // line sort is very important !!
-    M_lines.sort( SeenDistCmp() );
-#else
-    std::sort( M_teammates.begin(), M_teammates.end().
-               SeenDistCmp() );
-    std::sort( M_unknown_teammates.begin(), M_unknown_teammates.end(),
-               SeenDistCmp() );
-    std::sort( M_opponents.begin(), M_opponents.end(),
-               SeenDistCmp() );
-    std::sort( M_unknown_opponents.begin(), M_unknown_opponents.end(),
-               SeenDistCmp() );
-    std::sort( M_unknown_players.begin(), M_unknown_players.end(),
-               SeenDistCmp() );
-
-    std::sort( M_markers.begin(), M_markers.end(),
-               SeenDistCmp() );
-    std::sort( M_behind_markers.begin(), M_behind_markers.end(),
-               SeenDistCmp() );
-
-    // line sort very important!!
-    std::sort( M_lines.begin(), M_lines.end(),
-               SeenDistCmp() );
-#endif
+    sort_by_dist( M_lines );
 
 #if 0
     dlog.addText( Logger::SENSOR,
@@ -499,12 +690,50 @@ VisualSensor::parse( const char * msg,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+MarkerID
+VisualSensor::getMarkerID( const char * name,
+                           const std::size_t len,
+                           const double & version ) const
+{
+    const MarkerMap & marker_map = ( version >= 6.0
+                                     ? M_marker_map
+                                     : M_marker_map_old );
+
+    const std::pair< const char *, std::size_t > key( name, len );
+
+    MarkerMap::const_iterator it = std::lower_bound( marker_map.begin(),
+                                                     marker_map.end(),
+                                                     key,
+                                                     MarkerNameCmp() );
+    if ( it != marker_map.end()
+         && it->first.compare( 0, std::string::npos, name, len ) == 0 )
+    {
+        return it->second;
+    }
+
+    return Marker_Unknown;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
-VisualSensor::parseMarker( const char * tok,
+VisualSensor::parseMarker( const char ** tok,
                            const double & version,
                            MarkerT * info )
 {
+    const char * p = *tok;
+
+    // skip to first of object name
+    while ( *p == '(' ) ++p; // skip to first identifier
+
+    const char * name = p;
+
+    // skip object name
+    while ( *p != ')' ) ++p; // skip all object name
+
     // get marker id
     if ( info->object_type_ == Obj_Marker_Behind
          || info->object_type_ == Obj_Goal_Behind )
@@ -513,80 +742,49 @@ VisualSensor::parseMarker( const char * tok,
     }
     else
     {
-        // skip to first of object name
-        while ( *tok == '(' ) ++tok; // skip to first identifier
-
-        // get marker name
-        int i = 0;
-        std::string marker_name;
-        while ( *( tok + i ) != ')' )
-        {
-            marker_name += *( tok + i );
-            ++i;
-        }
-
-        // search marker id
-        info->id_ = Marker_Unknown;
-        if ( version >= 6.0 )
-        {
-            std::map< std::string, MarkerID >::iterator
-                it = M_marker_map.find( marker_name );
-            if ( it != M_marker_map.end() )
-            {
-                info->id_ = it->second;
-            }
-        }
-        else
-        {
-            std::map< std::string, MarkerID >::iterator
-                it = M_marker_map_old.find( marker_name );
-            if ( it != M_marker_map_old.end() )
-            {
-                info->id_ = it->second;
-            }
-        }
+        info->id_ = getMarkerID( name, p - name, version );
 
         if ( info->id_ == Marker_Unknown )
         {
             std::cerr << "VisualSensor::parseMarker. unknown marker "
-                      << std::string( tok, 16 ) << "]"
+                      << std::string( name, 16 ) << "]"
                       << std::endl;
             return false;
         }
     }
 
-    // skip object name
-    while ( *tok != ')' ) ++tok; // skip all object name
-    tok += 2; // skip paren & space
+    ++p; // skip paren
 
-    char *next;
+    double values[MAX_VALUE_TOKEN];
+    char heads[MAX_VALUE_TOKEN];
+    const int n = read_values( &p, values, heads );
+    *tok = p;
 
     // read dist
-    info->dist_ = std::strtod( tok, &next );
+    info->dist_ = ( n >= 1 ? values[0] : 0.0 );
     if ( info->dist_ == -HUGE_VAL
          || info->dist_ == HUGE_VAL )
     {
         std::cerr << "VisualSensor::parseMarker. distance read error.["
-                  << std::string( tok, 16 ) << "]"
+                  << std::string( name, 16 ) << "]"
                   << std::endl;
         return false;
     }
-    tok = next;
 
     // check view quality
-    if ( *tok == ')' )
+    if ( n < 2 )
     {
         //std::cerr << "VisualSensor:: parseMarker: view quality is LOW ??\n";
         return false;
     }
 
     // read dir
-    info->dir_ = std::strtod( tok, NULL );
+    info->dir_ = values[1];
     if ( info->dir_ == -HUGE_VAL
          || info->dir_ == HUGE_VAL )
     {
         std::cerr << "VisualSensor::parseMarker: dir read error.["
-                  << std::string( tok, 16 ) << "]"
+                  << std::string( name, 16 ) << "]"
                   << std::endl;
         return false;
     }
@@ -600,72 +798,24 @@ VisualSensor::parseMarker( const char * tok,
 
 */
 bool
-VisualSensor::parseLine( const char * tok,
+VisualSensor::parseLine( const char ** tok,
                          const double & version,
                          LineT * info )
 {
-#if 0
     // ((l <side>) <dist> <dir>))
     // ((L <side>) <dist> <dir>))
     // ((line <side>) <dist> <dir>))
     // ((Line <side>) <dist> <dir>))
 
-    char id[8];
-    char side;
-    int n_read = 0;
-    if ( std::sscanf( tok, " ( ( %[^ ] %c ) %lf %lf ) %n",
-                      id, &side,
-                      &(info->dist_),
-                      &(info->dir_),
-                      &n_read  ) == 4 )
-    {
-        // high quality line
-    }
-    else if ( std::sscanf( tok, " ( ( %[^ ] %c) %lf ) %n",
-                           id, &side,
-                           &(info->dir_),
-                           &n_read ) == 3 )
-    {
-        // low quality line
-    }
-    else
-    {
-        std::cerr << "Unsupported line message "
-                  << std::string( tok, 16 ) << std::endl;
-        info->id_ = Line_Unknown;
-        return false;
-    }
-
-    switch ( side ) {
-    case 'l':
-        info->id_ = Line_Left;
-        break;
-    case 'r':
-        info->id_ = Line_Right;
-        break;
-    case 't':
-        info->id_ = Line_Top;
-        break;
-    case 'b':
-        info->id_ = Line_Bottom;
-        break;
-    default:
-        std::cerr << "Unknown line type [" << *( tok + 2 ) << "]"
-                  << std::endl;
-        info->id_ = Line_Unknown;
-        return false;
-    }
+    const char * p = *tok;
 
-    return true;
-
-#else
     // skip to first of object name
-    while ( *tok == '(' ) ++tok;
+    while ( *p == '(' ) ++p;
 
     // check line name
     int i = ( version >= 6.0 ? 2 : 5 );
 
-    switch ( *(tok + i) ) {
+    switch ( *( p + i ) ) {
     case 'l':
         info->id_ = Line_Left;
         break;
@@ -679,50 +829,53 @@ VisualSensor::parseLine( const char * tok,
         info->id_ = Line_Bottom;
         break;
     default:
-        std::cerr << "Unknown line type [" << *( tok + 2 ) << "]"
+        std::cerr << "Unknown line type [" << *( p + 2 ) << "]"
                   << std::endl;
         info->id_ = Line_Unknown;
         return false;
     }
 
     // skip object name
-    while ( *tok != ')' ) ++tok; // skip all object name
-    tok += 2; // skip paren & space
+    while ( *p != ')' ) ++p; // skip all object name
+    ++p; // skip paren
+
+    const char * values_top = p;
 
-    char *next;
+    double values[MAX_VALUE_TOKEN];
+    char heads[MAX_VALUE_TOKEN];
+    const int n = read_values( &p, values, heads );
+    *tok = p;
 
     // read dist
-    info->dist_ = std::strtod( tok, &next );
+    info->dist_ = ( n >= 1 ? values[0] : 0.0 );
     if ( info->dist_ == -HUGE_VAL
          || info->dist_ == HUGE_VAL )
     {
         std::cerr << "VisualSensor:: parseLine: distance read error.["
-                  << std::string( tok, 16 ) << "]"
+                  << std::string( values_top, 16 ) << "]"
                   << std::endl;
         return false;
     }
-    tok = next;
 
     // check view quality
-    if ( *tok == ')' )
+    if ( n < 2 )
     {
         //std::cerr << "VisualSensor:: parseLine: view quality is LOW ??\n";
         return false;
     }
 
     // read dir
-    info->dir_ = std::strtod( tok, NULL );
+    info->dir_ = values[1];
     if ( info->dir_ == -HUGE_VAL
          || info->dir_== HUGE_VAL )
     {
         std::cerr << "VisualSensor::parseLine: dirread error.["
-                  << std::string( tok, 16 ) << "]"
+                  << std::string( values_top, 16 ) << "]"
                   << std::endl;;
         return false;
     }
 
     return true;
-#endif
 }
 
 /*-------------------------------------------------------------------*/
@@ -730,52 +883,56 @@ VisualSensor::parseLine( const char * tok,
 
 */
 bool
-VisualSensor::parseBall( const char * tok,
+VisualSensor::parseBall( const char ** tok,
                          BallT * info )
 {
+    const char * p = *tok;
+
     // skip all object name
-    while ( *tok != ')' ) ++tok;
-    tok += 2; // skip space & paren
+    while ( *p != ')' ) ++p;
+    ++p; // skip paren
+
+    const char * values_top = p;
 
-    char *next;
+    double values[MAX_VALUE_TOKEN];
+    char heads[MAX_VALUE_TOKEN];
+    const int n = read_values( &p, values, heads );
+    *tok = p;
 
     // read dist
-    info->dist_ = std::strtod( tok, &next );
+    info->dist_ = ( n >= 1 ? values[0] : 0.0 );
     if ( info->dist_ == -HUGE_VAL
          || info->dist_ == HUGE_VAL )
     {
         std::cerr << "VisualSensor::parseBall: distance read error.["
-                  << std::string( tok, 16 ) << "]"
+                  << std::string( values_top, 16 ) << "]"
                   << std::endl;
         return false;
     }
-    tok = next;
 
     // check view quality
-    if ( *tok == ')' )
+    if ( n < 2 )
     {
         //std::cerr << "VisualSensor:: parseBall: view quality is LOW ??\n";
         return false;
     }
 
     // read dir
-    info->dir_ = std::strtod( tok, &next );
+    info->dir_ = values[1];
     if ( info->dir_ == -HUGE_VAL
          || info->dir_ == HUGE_VAL )
     {
         std::cerr << "VisualSensor::parseBall: dir read error. ["
-                  << std::string( tok, 16 ) << "]"
+                  << std::string( values_top, 16 ) << "]"
                   << std::endl;
         return false;
     }
-    tok = next;
 
     // read velocity info. order is dist_chg -> dir_chg
-    if ( *tok != ')' )
+    if ( n >= 3 )
     {
-        info->dist_chng_ = std::strtod( tok, &next );
-        tok = next;
-        info->dir_chng_ = std::strtod( tok, NULL );
+        info->dist_chng_ = values[2];
+        info->dir_chng_ = ( n >= 4 ? values[3] : 0.0 );
         info->has_vel_ = true;
         if ( info->dist_chng_ == -HUGE_VAL
              || info->dist_chng_ == HUGE_VAL
@@ -783,7 +940,7 @@ VisualSensor::parseBall( const char * tok,
              || info->dir_chng_ == HUGE_VAL )
         {
             std::cerr << "VisualSensor:: parseBall. chng read error.["
-                      << std::string( tok, 16 ) << "]"
+                      << std::string( values_top, 16 ) << "]"
                       << std::endl;
             info->dist_chng_ = 0.0;
             info->dir_chng_ = 0.0;
@@ -800,26 +957,26 @@ VisualSensor::parseBall( const char * tok,
 
 */
 VisualSensor::PlayerType
-VisualSensor::parsePlayer( const char * tok,
+VisualSensor::parsePlayer( const char ** tok,
                            const char * team_name,
                            const int team_name_len,
                            PlayerT * info )
 {
     PlayerType result_type = Player_Illegal;
 
+    const char * p = *tok;
+
     // skip to first of object name
-    while ( *tok == '(' ) ++tok;
+    while ( *p == '(' ) ++p;
 
     // count the space in object name for player identify
     // (p), (p "TEAMNAME"), (p "TEAMNAME" UNUM), (p "TEAMNAME" UNUM goalie)
-    int i = 1, n_space = 0;
-    //bool quated = false;
-    while ( *(tok + i) != ')' )
+    int n_space = 0;
+    const char * name_end = p + 1;
+    while ( *name_end != ')' )
     {
-        if (*(tok+i) == ' ') ++n_space;
-        //if (*(tok+i) == ' ' && !quated) n_space++;
-        //if (*(tok+i) == '\"') quated = !quated; // "
-        ++i;
+        if ( *name_end == ' ' ) ++n_space;
+        ++name_end;
     }
 
     // check player name
@@ -828,11 +985,11 @@ VisualSensor::parsePlayer( const char * tok,
     // check teamname
     if ( n_space > 0 ) // exist team name
     {
-        while ( *tok != '\"' ) ++tok; // " skip to team name
-        ++tok; // skip '"'
+        while ( *p != '\"' ) ++p; // " skip to team name
+        ++p; // skip '"'
 
-        if ( *( tok + team_name_len ) == '\"' // "
-             && ! std::strncmp( team_name, tok, team_name_len ) )
+        if ( *( p + team_name_len ) == '\"' // "
+             && ! std::strncmp( team_name, p, team_name_len ) )
         {
             result_type = Player_Unknown_Teammate;
         }
@@ -841,7 +998,9 @@ VisualSensor::parsePlayer( const char * tok,
             result_type = Player_Unknown_Opponent;
             if ( M_opponent_team_name.empty() )
             {
-                while (*tok != '\"') M_opponent_team_name += *tok++; // "
+                const char * name_top = p;
+                while ( *p != '\"' ) ++p; // "
+                M_opponent_team_name.assign( name_top, p - name_top );
                 // std::cerr << "copy opponent team name : "
                 // << M_opponent_team_name << std::endl;
             }
@@ -855,8 +1014,8 @@ VisualSensor::parsePlayer( const char * tok,
     // check unum
     if ( n_space > 1 )
     {
-        while ( *tok != ' ' ) ++tok;
-        info->unum_ = std::atoi( tok );
+        while ( *p != ' ' ) ++p;
+        info->unum_ = std::atoi( p );
         // we can get all player identifier
         result_type = ( result_type == Player_Unknown_Teammate
                         ? Player_Teammate
@@ -874,143 +1033,135 @@ VisualSensor::parsePlayer( const char * tok,
     }
 
     // skip all player name
-    while ( *tok != ')' ) ++tok;
-    ++tok;
-
-    // "tok" must point object name next space
+    p = name_end + 1;
 
     // check positional info pattern
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> <TACKLE|KICK>)" : space = 8
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR>)" : space = 7
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <TACKLE|KICK>)" : space = 7
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD>)" : space = 6
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY>)" : space = 5  only sserver-4
-    // " <DIST> <DIR> <DISTCH> <DIRCH>)" : space = 4
-    // " <DIST> <DIR> <POINTDIR> <TACKLE|KICK>)" : space = 4
-    // " <DIST> <DIR> <POINTDIR>)" : space = 3
-    // " <DIST> <DIR> <TACKLE|KICK>)" : space = 3
-    // " <DIST> <DIR>)" : space = 2
-    // " <DIR>)" : space = 1
-
-    // count space in positional info
-    i = n_space = 0;
-    while ( *( tok + i ) != ')' )
-    {
-        if ( *( tok + i ) == ' ' ) ++n_space;
-        ++i;
-    }
-
-    char *next;
-
-    // read each value on each pattern
+    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> <TACKLE|KICK>)" : n = 8
+    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR>)" : n = 7
+    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <TACKLE|KICK>)" : n = 7
+    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD>)" : n = 6
+    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY>)" : n = 5  only sserver-4
+    // " <DIST> <DIR> <DISTCH> <DIRCH>)" : n = 4
+    // " <DIST> <DIR> <POINTDIR> <TACKLE|KICK>)" : n = 4
+    // " <DIST> <DIR> <POINTDIR>)" : n = 3
+    // " <DIST> <DIR> <TACKLE|KICK>)" : n = 3
+    // " <DIST> <DIR>)" : n = 2
+    // " <DIR>)" : n = 1
+
+    // read all values at once
+    double v[MAX_VALUE_TOKEN];
+    char heads[MAX_VALUE_TOKEN];
+    const int n = read_values( &p, v, heads );
+    *tok = p;
+
+    // assign each value on each pattern
 
     // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> <TACKLE>
-    if ( n_space == 8 )
+    if ( n == 8 )
     {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, &next ); tok = next;
-        info->face_ = std::strtod( tok, &next ); tok = next;
-        info->arm_ = std::strtod( tok, &next ); tok = next;
+        info->dist_ = v[0];
+        info->dir_  = v[1];
+        info->dist_chng_ = v[2];
+        info->dir_chng_  = v[3];
+        info->body_ = v[4];
+        info->face_ = v[5];
+        info->arm_ = v[6];
         info->has_vel_ = true;
-        if ( *(tok + 1) == 'k' ) info->kicked_ = true;
-        if ( *(tok + 1) == 't' ) info->tackle_ = true;
+        if ( heads[7] == 'k' ) info->kicked_ = true;
+        if ( heads[7] == 't' ) info->tackle_ = true;
     }
     // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR>
     // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <TACKLE>
-    else if ( n_space == 7 )
+    else if ( n == 7 )
     {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, &next ); tok = next;
-        info->face_ = std::strtod( tok, &next ); tok = next;
+        info->dist_ = v[0];
+        info->dir_  = v[1];
+        info->dist_chng_ = v[2];
+        info->dir_chng_  = v[3];
+        info->body_ = v[4];
+        info->face_ = v[5];
         info->has_vel_ = true;
-        if ( *(tok + 1) == 'k' )
+        if ( heads[6] == 'k' )
         {
             info->kicked_ = true;
         }
-        else if ( *(tok + 1) == 't' )
+        else if ( heads[6] == 't' )
         {
             info->tackle_ = true;
         }
         else
         {
-            info->arm_ = std::strtod( tok, NULL );
+            info->arm_ = v[6];
         }
     }
     // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD>
-    else if ( n_space == 6 )
+    else if ( n == 6 )
     {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, &next ); tok = next;
-        info->face_ = std::strtod( tok, NULL );
+        info->dist_ = v[0];
+        info->dir_  = v[1];
+        info->dist_chng_ = v[2];
+        info->dir_chng_  = v[3];
+        info->body_ = v[4];
+        info->face_ = v[5];
         info->has_vel_ = true;
     }
     // <DIST> <DIR> <DISTCH> <DIRCH> <BODY>
-    else if ( n_space == 5 )
+    else if ( n == 5 )
     {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, NULL );
+        info->dist_ = v[0];
+        info->dir_  = v[1];
+        info->dist_chng_ = v[2];
+        info->dir_chng_  = v[3];
+        info->body_ = v[4];
         info->face_ = 0.0;
         info->has_vel_ = true;
     }
     // <DIST> <DIR> <DISTCH> <DIRCH>
     // <DIST> <DIR> <POINTDIR> <TACKLE>
-    else if ( n_space == 4 )
+    else if ( n == 4 )
     {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        double tmp = std::strtod( tok, &next ); tok = next;
-        if ( *(tok + 1) == 'k' )
+        info->dist_ = v[0];
+        info->dir_  = v[1];
+        if ( heads[3] == 'k' )
         {
-            info->arm_ = tmp;
+            info->arm_ = v[2];
             info->kicked_ = true;
         }
-        else if ( *(tok + 1) == 't' )
+        else if ( heads[3] == 't' )
         {
-            info->arm_ = tmp;
+            info->arm_ = v[2];
             info->tackle_ = true;
         }
         else
         {
-            info->dist_chng_ = tmp;
-            info->dir_chng_ = std::strtod( tok, NULL );
+            info->dist_chng_ = v[2];
+            info->dir_chng_ = v[3];
         }
     }
     // <DIST> <DIR> <POINTDIR>
     // <DIST> <DIR> <TACKLE>
-    else if ( n_space == 3 )
+    else if ( n == 3 )
     {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        if ( *(tok + 1) == 'k' )
+        info->dist_ = v[0];
+        info->dir_  = v[1];
+        if ( heads[2] == 'k' )
         {
             info->kicked_ = true;
         }
-        else if ( *(tok + 1) == 't' )
+        else if ( heads[2] == 't' )
         {
             info->tackle_ = true;
         }
         else
         {
-            info->arm_ = std::strtod( tok, NULL );
+            info->arm_ = v[2];
         }
     }
     // <DIST> <DIR>
-    else if ( n_space == 2 )
+    else if ( n == 2 )
     {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, NULL );
+        info->dist_ = v[0];
+        info->dir_  = v[1];
     }
     else
     {
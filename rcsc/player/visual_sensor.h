@@ -35,8 +35,6 @@
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
 
-#include <map>
-#include <list>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -251,19 +249,10 @@ public:
           }
     };
 
-#define USE_LIST_VISUAL_OBJECT
-
-#ifdef USE_LIST_VISUAL_OBJECT
-    typedef std::vector< BallT > BallCont; //!< observed ball container
-    typedef std::list< MarkerT > MarkerCont; //!< observed marker container
-    typedef std::list< LineT > LineCont; //!< observed line container
-    typedef std::list< PlayerT > PlayerCont; //!< observed player container
-#else
     typedef std::vector< BallT > BallCont; //!< observed ball container
     typedef std::vector< MarkerT > MarkerCont; //!< observed marker container
     typedef std::vector< LineT > LineCont; //!< observed line container
     typedef std::vector< PlayerT > PlayerCont; //!< observed player container
-#endif
 
 private:
 
@@ -271,10 +260,15 @@ private:
 
     std::string M_opponent_team_name; //!< seen opponent team name
 
+    //! marker name and ID pair
+    typedef std::pair< std::string, MarkerID > MarkerPair;
+    //! marker ID table sorted by name
+    typedef std::vector< MarkerPair > MarkerMap;
+
     //! marker ID map
-    std::map< std::string, MarkerID > M_marker_map;
+    MarkerMap M_marker_map;
     //! marker ID map, old name
-    std::map< std::string, MarkerID > M_marker_map_old;
+    MarkerMap M_marker_map_old;
 
     BallCont M_balls; //!< seen ball
     MarkerCont M_markers; //!< seen markers
@@ -439,50 +433,65 @@ private:
           }
       }
 
+    /*!
+      \brief get marker id from the marker name
+      \param name pointer to the top of marker name
+      \param len the length of marker name
+      \param version rcssserver protocol version
+      \return marker id or Marker_Unknown
+    */
+    MarkerID getMarkerID( const char * name,
+                          const std::size_t len,
+                          const double & version ) const;
+
     /*!
       \brief parse marker flag info
-      \param tok pointer to the top of object info
+      \param tok pointer to the top of object info.
+      updated to the closing paren of the object if succeeded.
       \param version rcssserver protocol version
       \param info pointer to the varialbe to store the data.
 
       get positional data from object info token
     */
-    bool parseMarker( const char * tok,
+    bool parseMarker( const char ** tok,
                       const double & version,
                       MarkerT * info );
 
     /*!
       \brief parse line info
-      \param tok pointer to the top of object info
+      \param tok pointer to the top of object info.
+      updated to the closing paren of the object if succeeded.
       \param version rcssserver protocol version
       \param info pointer to the varialbe to store the data.
 
       get positional data from object info token
     */
-    bool parseLine( const char * tok,
+    bool parseLine( const char ** tok,
                     const double & version,
                     LineT * info );
 
     /*!
-      \brief parse line info
-      \param tok pointer to the top of object info
+      \brief parse ball info
+      \param tok pointer to the top of object info.
+      updated to the closing paren of the object if succeeded.
       \param info pointer to the varialbe to store the data.
 
       get positional data from object info token
     */
-    bool parseBall( const char * tok,
+    bool parseBall( const char ** tok,
                     BallT * info );
 
     /*!
       \brief parse player info
-      \param tok pointer to the top of object info
+      \param tok pointer to the top of object info.
+      updated to the closing paren of the object if succeeded.
       \param team_name our team name
       \param team_name_len the length of our team name
       \param info pointer to the varialbe to store the data.
 
       get positional data from object info token
     */
-    PlayerType parsePlayer( const char * tok,
+    PlayerType parsePlayer( const char ** tok,
                             const char * team_name,
                             const int team_name_len,
                             PlayerT * info );
@@ -43,6 +43,7 @@
 #include "debug_client.h"
 #include "intercept_table.h"
 #include "penalty_kick_state.h"
+#include "phase_profiler.h"
 #include "player_command.h"
 #include "player_predicate.h"
 
@@ -246,6 +247,7 @@ WorldModel::WorldModel()
       M_intercept_table( new InterceptTable( *this ) ),
       M_audio_memory( new AudioMemory() ),
       M_penalty_kick_state( new PenaltyKickState() ),
+      M_phase_profiler( static_cast< PhaseProfiler * >( 0 ) ),
       M_our_side( NEUTRAL ),
       M_time( -1, 0 ),
       M_sense_body_time( -1, 0 ),
@@ -257,6 +259,14 @@ WorldModel::WorldModel()
       M_valid( true ),
       M_self(),
       M_ball(),
+      M_ball_trajectory(),
+      M_player_pool( new PlayerObjectPool( 64 ) ),
+      M_teammates( M_player_pool ),
+      M_opponents( M_player_pool ),
+      M_unknown_players( M_player_pool ),
+      M_new_teammates( M_player_pool ),
+      M_new_opponents( M_player_pool ),
+      M_new_unknown_players( M_player_pool ),
       M_our_goalie_unum( Unum_Unknown ),
       M_their_goalie_unum( Unum_Unknown ),
       M_offside_line_x( 0.0 ),
@@ -289,6 +299,13 @@ WorldModel::WorldModel()
         M_dir_count[i] = 1000;
     }
 
+    M_teammates.reserve( 32 );
+    M_opponents.reserve( 32 );
+    M_unknown_players.reserve( 32 );
+    M_new_teammates.reserve( 32 );
+    M_new_opponents.reserve( 32 );
+    M_new_unknown_players.reserve( 32 );
+
     for ( int i = 0; i < 12; ++i )
     {
         M_known_teammates[i] = static_cast< AbstractPlayerObject * >( 0 );
@@ -397,6 +414,9 @@ WorldModel::initTeamInfo( const std::string & teamname,
     M_our_side = ourside;
     M_self.init( ourside, my_unum, my_goalie );
 
+    // independent random stream for each player. see RandomEngine::stream().
+    M_localize->setRandomStreamId( ourside == RIGHT ? my_unum + 11 : my_unum );
+
     if ( my_goalie )
     {
         M_our_goalie_unum = my_unum;
@@ -417,6 +437,36 @@ WorldModel::initTeamInfo( const std::string & teamname,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+WorldModel::setInterceptThreads( const int n_threads )
+{
+    M_intercept_table->setWorkerThreads( n_threads );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldModel::setSelfInterceptMaxSolutions( const int n )
+{
+    M_intercept_table->setSelfMaxSolutions( n );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldModel::setPhaseProfiler( PhaseProfiler * profiler )
+{
+    M_phase_profiler = profiler;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 WorldModel::setAudioMemory( boost::shared_ptr< AudioMemory > memory )
@@ -1743,6 +1793,8 @@ WorldModel::updateJustBeforeDecision( const ActionEffector & act,
 
     updateLastKicker();
 
+    M_ball_trajectory.create( M_ball.pos(), M_ball.vel(), BallTrajectory::MAX_STEP );
+
     updateInterceptTable();
 
     M_ball.updateRecord();
@@ -2330,10 +2382,11 @@ WorldModel::localizePlayers( const VisualSensor & see )
     //           -> assign new data to temporary list
     //   after loop, copy from temporary to memory again
 
-    // temporary data list
-    PlayerCont new_teammates;
-    PlayerCont new_opponents;
-    PlayerCont new_unknown_players;
+    // temporary data list.
+    // member containers are reused to avoid the allocation in every cycle.
+    PlayerCont & new_teammates = M_new_teammates;
+    PlayerCont & new_opponents = M_new_opponents;
+    PlayerCont & new_unknown_players = M_new_unknown_players;
 
     const Vector2D MYPOS = self().pos();
     const Vector2D MYVEL = self().vel();
@@ -4413,7 +4466,10 @@ void
 WorldModel::updateInterceptTable()
 {
     // update interception table
-    M_intercept_table->update();
+    {
+        PhaseProfiler::Scope scope( M_phase_profiler, PhaseProfiler::INTERCEPT );
+        M_intercept_table->update();
+    }
 
     if ( M_audio_memory->ourInterceptTime() == time() )
     {
@@ -34,7 +34,9 @@
 
 #include <rcsc/player/self_object.h>
 #include <rcsc/player/ball_object.h>
+#include <rcsc/player/ball_trajectory.h>
 #include <rcsc/player/player_object.h>
+#include <rcsc/player/player_cont.h>
 #include <rcsc/player/view_area.h>
 #include <rcsc/player/view_grid_map.h>
 
@@ -55,6 +57,7 @@ class BodySensor;
 class FullstateSensor;
 class InterceptTable;
 class Localization;
+class PhaseProfiler;
 class PlayerPredicate;
 class PlayerType;
 class PenaltyKickState;
@@ -80,6 +83,7 @@ private:
     InterceptTable * M_intercept_table; //!< interception info table
     boost::shared_ptr< AudioMemory > M_audio_memory; //!< heard deqinfo memory
     PenaltyKickState * M_penalty_kick_state; //!< penalty kick mode status
+    PhaseProfiler * M_phase_profiler; //!< pointer to the profiler. may be NULL
 
     //////////////////////////////////////////////////
     std::string M_teamname; //!< our teamname
@@ -108,10 +112,16 @@ private:
     // field object instance
     SelfObject M_self; //!< self object
     BallObject M_ball; //!< ball object
+    BallTrajectory M_ball_trajectory; //!< predicted ball trajectory updated just before decision making
+    PlayerCont::PoolPtr M_player_pool; //!< storage of all player objects held by the containers below
     PlayerCont M_teammates; //!< side known teammmates
     PlayerCont M_opponents; //!< side known opponents
     PlayerCont M_unknown_players; //!< unknown players
 
+    PlayerCont M_new_teammates; //!< work space for localizePlayers
+    PlayerCont M_new_opponents; //!< work space for localizePlayers
+    PlayerCont M_new_unknown_players; //!< work space for localizePlayers
+
     //////////////////////////////////////////////////
     // object reference (pointers to each object)
     // these containers are updated just before decision making
@@ -245,6 +255,24 @@ public:
                        const int my_unum,
                        const bool my_goalie );
 
+    /*!
+      \brief set the number of threads used by the intercept prediction of other players
+      \param n_threads the number of threads. if less than 2, the prediction is done serially.
+     */
+    void setInterceptThreads( const int n_threads );
+
+    /*!
+      \brief set the number of the fastest self intercept solutions kept for each stamina mode
+      \param n the number of solutions. if 0, all found solutions are kept.
+     */
+    void setSelfInterceptMaxSolutions( const int n );
+
+    /*!
+      \brief set the profiler that records the elapsed time of the interception update.
+      \param profiler pointer to the profiler. NULL disables the profiling.
+     */
+    void setPhaseProfiler( PhaseProfiler * profiler );
+
     /*!
       \brief set new audio memory
       \param memory pointer to the memory instance. This must be
@@ -652,6 +680,12 @@ public:
     */
     const BallObject & ball() const { return M_ball; }
 
+    /*!
+      \brief get the predicted ball trajectory updated just before decision making
+      \return const reference to the BallTrajectory
+    */
+    const BallTrajectory & ballTrajectory() const { return M_ball_trajectory; }
+
     /*!
       \brief get teammate info
       \return const reference to the PlayerObject container
@@ -0,0 +1,493 @@
+// -*-c++-*-
+
+/*!
+  \file world_snapshot.cpp
+  \brief flat copy of the decision relevant world state Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "world_snapshot.h"
+
+#include "world_model.h"
+#include "player_predicate.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the player nearest to the ball in the range can kick the ball
+*/
+bool
+check_player_kickable( const PlayerObject * first,
+                       const PlayerObject * last )
+{
+    const PlayerObject * nearest = static_cast< const PlayerObject * >( 0 );
+    for ( ; first != last; ++first )
+    {
+        if ( first->isGhost()
+             || first->isTackling() )
+        {
+            continue;
+        }
+
+        if ( ! nearest
+             || first->distFromBall() < nearest->distFromBall() )
+        {
+            nearest = first;
+        }
+    }
+
+    return ( nearest
+             && nearest->isKickable( 0.0 ) );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorldSnapshot::SelfState::SelfState()
+    : side_( NEUTRAL ),
+      unum_( Unum_Unknown ),
+      goalie_( false ),
+      player_type_( static_cast< const PlayerType * >( 0 ) ),
+      pos_( Vector2D::INVALIDATED ),
+      pos_count_( 1000 ),
+      vel_( 0.0, 0.0 ),
+      vel_count_( 1000 ),
+      body_( 0.0 ),
+      neck_( 0.0 ),
+      stamina_(),
+      tackle_expires_( 0 ),
+      kickable_( false ),
+      kick_rate_( 0.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorldSnapshot::BallState::BallState()
+    : pos_( 0.0, 0.0 ),
+      pos_count_( 1000 ),
+      vel_( 0.0, 0.0 ),
+      vel_count_( 1000 ),
+      dist_from_self_( 1000.0 ),
+      angle_from_self_( 0.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorldSnapshot::WorldSnapshot()
+    : M_time( -1, 0 ),
+      M_game_mode(),
+      M_our_side( NEUTRAL ),
+      M_self(),
+      M_ball(),
+      M_teammate_size( 0 ),
+      M_opponent_size( 0 ),
+      M_unknown_size( 0 ),
+      M_our_goalie_unum( Unum_Unknown ),
+      M_their_goalie_unum( Unum_Unknown ),
+      M_offside_line_x( 0.0 ),
+      M_our_offense_line_x( 0.0 ),
+      M_our_defense_line_x( 0.0 ),
+      M_their_offense_line_x( 0.0 ),
+      M_their_defense_line_x( 0.0 ),
+      M_exist_kickable_teammate( false ),
+      M_exist_kickable_opponent( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorldSnapshot::WorldSnapshot( const WorldModel & wm )
+    : M_time( -1, 0 ),
+      M_game_mode(),
+      M_our_side( NEUTRAL ),
+      M_self(),
+      M_ball(),
+      M_teammate_size( 0 ),
+      M_opponent_size( 0 ),
+      M_unknown_size( 0 ),
+      M_our_goalie_unum( Unum_Unknown ),
+      M_their_goalie_unum( Unum_Unknown ),
+      M_offside_line_x( 0.0 ),
+      M_our_offense_line_x( 0.0 ),
+      M_our_defense_line_x( 0.0 ),
+      M_their_offense_line_x( 0.0 ),
+      M_their_defense_line_x( 0.0 ),
+      M_exist_kickable_teammate( false ),
+      M_exist_kickable_opponent( false )
+{
+    assign( wm );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldSnapshot::assign( const WorldModel & wm )
+{
+    M_time = wm.time();
+    M_game_mode = wm.gameMode();
+    M_our_side = wm.ourSide();
+
+    //
+    // self
+    //
+    const SelfObject & self = wm.self();
+    M_self.side_ = self.side();
+    M_self.unum_ = self.unum();
+    M_self.goalie_ = self.goalie();
+    M_self.player_type_ = self.playerTypePtr();
+    M_self.pos_ = self.pos();
+    M_self.pos_count_ = self.posCount();
+    M_self.vel_ = self.vel();
+    M_self.vel_count_ = self.velCount();
+    M_self.body_ = self.body();
+    M_self.neck_ = self.neck();
+    M_self.stamina_ = self.staminaModel();
+    M_self.tackle_expires_ = self.tackleExpires();
+    M_self.kickable_ = self.isKickable();
+    M_self.kick_rate_ = self.kickRate();
+
+    //
+    // ball
+    //
+    const BallObject & ball = wm.ball();
+    M_ball.pos_ = ball.pos();
+    M_ball.pos_count_ = ball.posCount();
+    M_ball.vel_ = ball.vel();
+    M_ball.vel_count_ = ball.velCount();
+    M_ball.dist_from_self_ = ball.distFromSelf();
+    M_ball.angle_from_self_ = ball.angleFromSelf();
+
+    //
+    // players
+    //
+    M_teammate_size = M_opponent_size = M_unknown_size = 0;
+
+    for ( PlayerPtrCont::const_iterator it = wm.teammatesFromSelf().begin(), end = wm.teammatesFromSelf().end();
+          it != end;
+          ++it )
+    {
+        if ( addPlayer( **it ) ) ++M_teammate_size;
+    }
+
+    for ( PlayerPtrCont::const_iterator it = wm.opponentsFromSelf().begin(), end = wm.opponentsFromSelf().end();
+          it != end;
+          ++it )
+    {
+        if ( addPlayer( **it ) ) ++M_opponent_size;
+    }
+
+    for ( PlayerCont::const_iterator it = wm.unknownPlayers().begin(), end = wm.unknownPlayers().end();
+          it != end;
+          ++it )
+    {
+        if ( addPlayer( *it ) ) ++M_unknown_size;
+    }
+
+    M_our_goalie_unum = wm.ourGoalieUnum();
+    M_their_goalie_unum = wm.theirGoalieUnum();
+
+    M_offside_line_x = wm.offsideLineX();
+    M_our_offense_line_x = wm.ourOffenseLineX();
+    M_our_defense_line_x = wm.ourDefenseLineX();
+    M_their_offense_line_x = wm.theirOffenseLineX();
+    M_their_defense_line_x = wm.theirDefenseLineX();
+
+    M_exist_kickable_teammate = wm.existKickableTeammate();
+    M_exist_kickable_opponent = wm.existKickableOpponent();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+WorldSnapshot::addPlayer( const PlayerObject & p )
+{
+    const int size = playerSize();
+    if ( size >= MAX_PLAYER )
+    {
+        return false;
+    }
+
+    M_players[size] = p;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldSnapshot::setSelf( const Vector2D & pos,
+                        const Vector2D & vel,
+                        const AngleDeg & body )
+{
+    M_self.pos_ = pos;
+    M_self.vel_ = vel;
+    M_self.body_ = body;
+
+    updateCache();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldSnapshot::setBall( const Vector2D & pos,
+                        const Vector2D & vel )
+{
+    M_ball.pos_ = pos;
+    M_ball.vel_ = vel;
+
+    updateCache();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldSnapshot::setPlayer( const int index,
+                          const Vector2D & pos,
+                          const Vector2D & vel )
+{
+    PlayerObject & p = M_players[index];
+    p.M_pos = pos;
+    p.M_vel = vel;
+    p.updateSelfBallRelated( M_self.pos_, M_ball.pos_ );
+
+    M_exist_kickable_teammate = check_player_kickable( M_players,
+                                                       M_players + M_teammate_size );
+    M_exist_kickable_opponent = check_player_kickable( M_players + M_teammate_size,
+                                                       M_players + M_teammate_size + M_opponent_size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldSnapshot::advance()
+{
+    const ServerParam & SP = ServerParam::i();
+
+    M_time.addCycle( 1 );
+
+    M_self.pos_ += M_self.vel_;
+    M_self.vel_ *= ( M_self.player_type_
+                     ? M_self.player_type_->playerDecay()
+                     : SP.defaultPlayerDecay() );
+    if ( M_self.tackle_expires_ > 0 )
+    {
+        --M_self.tackle_expires_;
+    }
+
+    M_ball.pos_ += M_ball.vel_;
+    M_ball.vel_ *= SP.ballDecay();
+    M_ball.pos_count_ = std::min( 1000, M_ball.pos_count_ + 1 );
+    M_ball.vel_count_ = std::min( 1000, M_ball.vel_count_ + 1 );
+
+    const int size = playerSize();
+    for ( int i = 0; i < size; ++i )
+    {
+        M_players[i].update();
+    }
+
+    updateCache();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldSnapshot::updateCache()
+{
+    M_ball.dist_from_self_ = M_self.pos_.dist( M_ball.pos_ );
+    M_ball.angle_from_self_ = ( M_ball.pos_ - M_self.pos_ ).th();
+
+    updateSelfKickable();
+
+    const int size = playerSize();
+    for ( int i = 0; i < size; ++i )
+    {
+        M_players[i].updateSelfBallRelated( M_self.pos_, M_ball.pos_ );
+    }
+
+    M_exist_kickable_teammate = check_player_kickable( M_players,
+                                                       M_players + M_teammate_size );
+    M_exist_kickable_opponent = check_player_kickable( M_players + M_teammate_size,
+                                                       M_players + M_teammate_size + M_opponent_size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldSnapshot::updateSelfKickable()
+{
+    if ( ! M_self.player_type_ )
+    {
+        M_self.kickable_ = ( M_ball.dist_from_self_ <= ServerParam::i().defaultKickableArea() );
+        M_self.kick_rate_ = 0.0;
+        return;
+    }
+
+    M_self.kickable_ = ( M_ball.dist_from_self_ <= M_self.player_type_->kickableArea() );
+    M_self.kick_rate_ = ( M_self.kickable_
+                          ? M_self.player_type_->kickRate( M_ball.dist_from_self_,
+                                                           ( M_ball.angle_from_self_ - M_self.body_ ).abs() )
+                          : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+WorldSnapshot::countPlayer( const PlayerPredicate & predicate ) const
+{
+    std::size_t count = 0;
+
+    const int size = playerSize();
+    for ( int i = 0; i < size; ++i )
+    {
+        if ( predicate( M_players[i] ) )
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const PlayerObject *
+WorldSnapshot::getPlayerNearestTo( const Vector2D & point,
+                                   const PlayerPredicate & predicate,
+                                   double * dist_to_point ) const
+{
+    const PlayerObject * nearest = static_cast< const PlayerObject * >( 0 );
+    double min_dist2 = 1000000.0;
+
+    const int size = playerSize();
+    for ( int i = 0; i < size; ++i )
+    {
+        if ( ! predicate( M_players[i] ) )
+        {
+            continue;
+        }
+
+        const double d2 = M_players[i].pos().dist2( point );
+        if ( d2 < min_dist2 )
+        {
+            nearest = &M_players[i];
+            min_dist2 = d2;
+        }
+    }
+
+    if ( nearest
+         && dist_to_point )
+    {
+        *dist_to_point = std::sqrt( min_dist2 );
+    }
+
+    return nearest;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const PlayerObject *
+WorldSnapshot::getNearestTo( const Vector2D & point,
+                             const int first,
+                             const int last,
+                             const int count_thr,
+                             double * dist_to_point ) const
+{
+    const PlayerObject * nearest = static_cast< const PlayerObject * >( 0 );
+    double min_dist2 = 1000000.0;
+
+    for ( int i = first; i < last; ++i )
+    {
+        if ( M_players[i].posCount() > count_thr )
+        {
+            continue;
+        }
+
+        const double d2 = M_players[i].pos().dist2( point );
+        if ( d2 < min_dist2 )
+        {
+            nearest = &M_players[i];
+            min_dist2 = d2;
+        }
+    }
+
+    if ( nearest
+         && dist_to_point )
+    {
+        *dist_to_point = std::sqrt( min_dist2 );
+    }
+
+    return nearest;
+}
+
+}
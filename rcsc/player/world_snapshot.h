@@ -0,0 +1,575 @@
+// -*-c++-*-
+
+/*!
+  \file world_snapshot.h
+  \brief flat copy of the decision relevant world state Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_WORLD_SNAPSHOT_H
+#define RCSC_PLAYER_WORLD_SNAPSHOT_H
+
+#include <rcsc/player/player_object.h>
+#include <rcsc/common/stamina_model.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/angle_deg.h>
+#include <rcsc/game_mode.h>
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <cstddef>
+
+namespace rcsc {
+
+class PlayerPredicate;
+class PlayerType;
+class WorldModel;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class WorldSnapshot
+  \brief flat copy of the decision relevant state of WorldModel.
+
+  All members are stored by value in fixed size arrays, so the copy
+  constructor is the fork operation and requires no heap allocation.
+  A planner can fork the snapshot, modify the self, ball or player
+  states, and query the result with the same kind of functions and
+  PlayerPredicate objects as WorldModel.
+
+  Players are stored in the order of teammatesFromSelf(),
+  opponentsFromSelf() and unknownPlayers(). The self player is not
+  included in the player arrays. If there are more players than
+  MAX_PLAYER, the rest are dropped.
+*/
+class WorldSnapshot {
+public:
+
+    //! the maximum number of stored players except the self
+    static const int MAX_PLAYER = 32;
+
+    /*!
+      \struct SelfState
+      \brief self player state
+    */
+    struct SelfState {
+        SideID side_; //!< team side
+        int unum_; //!< uniform number
+        bool goalie_; //!< goalie flag
+        const PlayerType * player_type_; //!< player type parameter
+        Vector2D pos_; //!< global position
+        int pos_count_; //!< position accuracy count
+        Vector2D vel_; //!< velocity
+        int vel_count_; //!< velocity accuracy count
+        AngleDeg body_; //!< global body angle
+        AngleDeg neck_; //!< relative neck angle
+        StaminaModel stamina_; //!< stamina status
+        int tackle_expires_; //!< the number of cycles frozen by tackle
+        bool kickable_; //!< kickable status. updated with the ball state.
+        double kick_rate_; //!< kick power rate. updated with the ball state.
+
+        /*!
+          \brief initialize all members
+        */
+        SelfState();
+
+        /*!
+          \brief get the global face angle
+          \return global face angle
+        */
+        AngleDeg face() const
+          {
+              return body_ + neck_;
+          }
+    };
+
+    /*!
+      \struct BallState
+      \brief ball state
+    */
+    struct BallState {
+        Vector2D pos_; //!< global position
+        int pos_count_; //!< position accuracy count
+        Vector2D vel_; //!< velocity
+        int vel_count_; //!< velocity accuracy count
+        double dist_from_self_; //!< distance from self
+        AngleDeg angle_from_self_; //!< global angle from self
+
+        /*!
+          \brief initialize all members
+        */
+        BallState();
+    };
+
+private:
+
+    GameTime M_time; //!< current game time
+    GameMode M_game_mode; //!< current game mode
+    SideID M_our_side; //!< our team side
+
+    SelfState M_self; //!< self state
+    BallState M_ball; //!< ball state
+
+    PlayerObject M_players[MAX_PLAYER]; //!< teammates, opponents and unknown players
+    int M_teammate_size; //!< the number of teammates in M_players
+    int M_opponent_size; //!< the number of opponents in M_players
+    int M_unknown_size; //!< the number of unknown players in M_players
+
+    int M_our_goalie_unum; //!< our goalie's uniform number
+    int M_their_goalie_unum; //!< their goalie's uniform number
+
+    double M_offside_line_x; //!< offside line
+    double M_our_offense_line_x; //!< our offense line
+    double M_our_defense_line_x; //!< our defense line
+    double M_their_offense_line_x; //!< their offense line
+    double M_their_defense_line_x; //!< their defense line
+
+    bool M_exist_kickable_teammate; //!< true if some teammate can kick the ball
+    bool M_exist_kickable_opponent; //!< true if some opponent can kick the ball
+
+public:
+
+    /*!
+      \brief create an empty snapshot
+    */
+    WorldSnapshot();
+
+    /*!
+      \brief create the snapshot of the world model
+      \param wm world model
+    */
+    explicit
+    WorldSnapshot( const WorldModel & wm );
+
+    /*!
+      \brief copy the current state of the world model
+      \param wm world model
+    */
+    void assign( const WorldModel & wm );
+
+    //
+    // modifiers
+    //
+
+    /*!
+      \brief set the self state and update the related values
+      \param pos new position
+      \param vel new velocity
+      \param body new body angle
+    */
+    void setSelf( const Vector2D & pos,
+                  const Vector2D & vel,
+                  const AngleDeg & body );
+
+    /*!
+      \brief get the modifiable self stamina
+      \return reference to the stamina model
+    */
+    StaminaModel & selfStamina()
+      {
+          return M_self.stamina_;
+      }
+
+    /*!
+      \brief set the ball state and update the related values
+      \param pos new position
+      \param vel new velocity
+    */
+    void setBall( const Vector2D & pos,
+                  const Vector2D & vel );
+
+    /*!
+      \brief set the player state and update the related values
+      \param index player index in players()
+      \param pos new position
+      \param vel new velocity
+    */
+    void setPlayer( const int index,
+                    const Vector2D & pos,
+                    const Vector2D & vel );
+
+    /*!
+      \brief set the game mode
+      \param game_mode new game mode
+    */
+    void setGameMode( const GameMode & game_mode )
+      {
+          M_game_mode = game_mode;
+      }
+
+    /*!
+      \brief advance the time by one cycle.
+      the ball and players move by their inertia.
+    */
+    void advance();
+
+    //
+    // accessors
+    //
+
+    /*!
+      \brief get the game time
+      \return game time
+    */
+    const GameTime & time() const { return M_time; }
+
+    /*!
+      \brief get the game mode
+      \return game mode
+    */
+    const GameMode & gameMode() const { return M_game_mode; }
+
+    /*!
+      \brief get our team side
+      \return side id
+    */
+    SideID ourSide() const { return M_our_side; }
+
+    /*!
+      \brief get the self state
+      \return const reference to the self state
+    */
+    const SelfState & self() const { return M_self; }
+
+    /*!
+      \brief get the ball state
+      \return const reference to the ball state
+    */
+    const BallState & ball() const { return M_ball; }
+
+    /*!
+      \brief get the number of stored players
+      \return the number of players
+    */
+    int playerSize() const
+      {
+          return M_teammate_size + M_opponent_size + M_unknown_size;
+      }
+
+    /*!
+      \brief get the player
+      \param index player index. [0, playerSize())
+      \return const reference to the player object
+    */
+    const PlayerObject & player( const int index ) const
+      {
+          return M_players[index];
+      }
+
+    /*!
+      \brief get the number of teammates
+      \return the number of teammates
+    */
+    int teammateSize() const { return M_teammate_size; }
+
+    /*!
+      \brief get the teammate in the order of the distance from self
+      \param i teammate index. [0, teammateSize())
+      \return const reference to the player object
+    */
+    const PlayerObject & teammate( const int i ) const
+      {
+          return M_players[i];
+      }
+
+    /*!
+      \brief get the number of opponents
+      \return the number of opponents
+    */
+    int opponentSize() const { return M_opponent_size; }
+
+    /*!
+      \brief get the opponent in the order of the distance from self
+      \param i opponent index. [0, opponentSize())
+      \return const reference to the player object
+    */
+    const PlayerObject & opponent( const int i ) const
+      {
+          return M_players[M_teammate_size + i];
+      }
+
+    /*!
+      \brief get the number of unknown players
+      \return the number of unknown players
+    */
+    int unknownPlayerSize() const { return M_unknown_size; }
+
+    /*!
+      \brief get the unknown player
+      \param i player index. [0, unknownPlayerSize())
+      \return const reference to the player object
+    */
+    const PlayerObject & unknownPlayer( const int i ) const
+      {
+          return M_players[M_teammate_size + M_opponent_size + i];
+      }
+
+    /*!
+      \brief get our goalie's uniform number
+      \return uniform number value or Unum_Unknown
+    */
+    int ourGoalieUnum() const { return M_our_goalie_unum; }
+
+    /*!
+      \brief get their goalie's uniform number
+      \return uniform number value or Unum_Unknown
+    */
+    int theirGoalieUnum() const { return M_their_goalie_unum; }
+
+    /*!
+      \brief get the offside line x
+      \return offside line x
+    */
+    const double & offsideLineX() const { return M_offside_line_x; }
+
+    /*!
+      \brief get our offense line x
+      \return our offense line x
+    */
+    const double & ourOffenseLineX() const { return M_our_offense_line_x; }
+
+    /*!
+      \brief get our defense line x
+      \return our defense line x
+    */
+    const double & ourDefenseLineX() const { return M_our_defense_line_x; }
+
+    /*!
+      \brief get their offense line x
+      \return their offense line x
+    */
+    const double & theirOffenseLineX() const { return M_their_offense_line_x; }
+
+    /*!
+      \brief get their defense line x
+      \return their defense line x
+    */
+    const double & theirDefenseLineX() const { return M_their_defense_line_x; }
+
+    /*!
+      \brief check if some teammate can kick the ball
+      \return checked result
+    */
+    bool existKickableTeammate() const { return M_exist_kickable_teammate; }
+
+    /*!
+      \brief check if some opponent can kick the ball
+      \return checked result
+    */
+    bool existKickableOpponent() const { return M_exist_kickable_opponent; }
+
+    //
+    // queries
+    //
+
+    /*!
+      \brief count the players matched to the predicate
+      \param predicate player predicate
+      \return the number of matched players
+    */
+    std::size_t countPlayer( const PlayerPredicate & predicate ) const;
+
+    /*!
+      \brief get the player nearest to the point and matched to the predicate
+      \param point target point
+      \param predicate player predicate
+      \param dist_to_point variable to store the distance. may be NULL.
+      \return pointer to the player object or NULL
+    */
+    const PlayerObject * getPlayerNearestTo( const Vector2D & point,
+                                             const PlayerPredicate & predicate,
+                                             double * dist_to_point ) const;
+
+    /*!
+      \brief get the teammate nearest to the point
+      \param point target point
+      \param count_thr accuracy count threshold
+      \param dist_to_point variable to store the distance. may be NULL.
+      \return pointer to the player object or NULL
+    */
+    const PlayerObject * getTeammateNearestTo( const Vector2D & point,
+                                               const int count_thr,
+                                               double * dist_to_point ) const
+      {
+          return getNearestTo( point, 0, M_teammate_size, count_thr, dist_to_point );
+      }
+
+    /*!
+      \brief get the opponent nearest to the point
+      \param point target point
+      \param count_thr accuracy count threshold
+      \param dist_to_point variable to store the distance. may be NULL.
+      \return pointer to the player object or NULL
+    */
+    const PlayerObject * getOpponentNearestTo( const Vector2D & point,
+                                               const int count_thr,
+                                               double * dist_to_point ) const
+      {
+          return getNearestTo( point, M_teammate_size, M_teammate_size + M_opponent_size,
+                               count_thr, dist_to_point );
+      }
+
+    /*!
+      \brief template utility. check if teammate exist in the specified region.
+      \param region template parameter. region to be checked
+      \param count_thr confdence count threshold for players
+      \param with_goalie if true, goalie player is cheked.
+      \return true if some teammate exist
+     */
+    template < typename REGION >
+    bool existTeammateIn( const REGION & region,
+                          const int count_thr,
+                          const bool with_goalie ) const
+      {
+          return countPlayersIn( region, 0, M_teammate_size,
+                                 count_thr, with_goalie, true ) > 0;
+      }
+
+    /*!
+      \brief template utility. check if opponent exist in the specified region.
+      \param region template parameter. region to be checked
+      \param count_thr confdence count threshold for players
+      \param with_goalie if true, goalie player is cheked.
+      \return true if some opponent exist
+     */
+    template < typename REGION >
+    bool existOpponentIn( const REGION & region,
+                          const int count_thr,
+                          const bool with_goalie ) const
+      {
+          return countPlayersIn( region, M_teammate_size, M_teammate_size + M_opponent_size,
+                                 count_thr, with_goalie, true ) > 0;
+      }
+
+    /*!
+      \brief template utility. count the teammates in the specified region.
+      \param region template parameter. region to be checked
+      \param count_thr confdence count threshold for players
+      \param with_goalie if true, goalie player is cheked.
+      \return the number of teammates in the region
+     */
+    template < typename REGION >
+    std::size_t countTeammatesIn( const REGION & region,
+                                  const int count_thr,
+                                  const bool with_goalie ) const
+      {
+          return countPlayersIn( region, 0, M_teammate_size,
+                                 count_thr, with_goalie, false );
+      }
+
+    /*!
+      \brief template utility. count the opponents in the specified region.
+      \param region template parameter. region to be checked
+      \param count_thr confdence count threshold for players
+      \param with_goalie if true, goalie player is cheked.
+      \return the number of opponents in the region
+     */
+    template < typename REGION >
+    std::size_t countOpponentsIn( const REGION & region,
+                                  const int count_thr,
+                                  const bool with_goalie ) const
+      {
+          return countPlayersIn( region, M_teammate_size, M_teammate_size + M_opponent_size,
+                                 count_thr, with_goalie, false );
+      }
+
+private:
+
+    /*!
+      \brief add the player to the array if there is a space
+      \param p player object
+      \return true if added
+    */
+    bool addPlayer( const PlayerObject & p );
+
+    /*!
+      \brief update the values depending on the self and ball positions
+    */
+    void updateCache();
+
+    /*!
+      \brief update the self kickable state
+    */
+    void updateSelfKickable();
+
+    /*!
+      \brief get the player nearest to the point in the index range
+      \param point target point
+      \param first first player index
+      \param last last player index (not included)
+      \param count_thr accuracy count threshold
+      \param dist_to_point variable to store the distance. may be NULL.
+      \return pointer to the player object or NULL
+    */
+    const PlayerObject * getNearestTo( const Vector2D & point,
+                                       const int first,
+                                       const int last,
+                                       const int count_thr,
+                                       double * dist_to_point ) const;
+
+    /*!
+      \brief count the players in the region in the index range
+      \param region template parameter. region to be checked
+      \param first first player index
+      \param last last player index (not included)
+      \param count_thr confdence count threshold for players
+      \param with_goalie if true, goalie player is cheked.
+      \param only_first if true, return when the first player is found.
+      \return the number of players in the region
+    */
+    template < typename REGION >
+    std::size_t countPlayersIn( const REGION & region,
+                                const int first,
+                                const int last,
+                                const int count_thr,
+                                const bool with_goalie,
+                                const bool only_first ) const
+      {
+          std::size_t count = 0;
+          for ( int i = first; i < last; ++i )
+          {
+              const PlayerObject & p = M_players[i];
+              if ( p.posCount() > count_thr
+                   || p.isGhost() )
+              {
+                  continue;
+              }
+              if ( p.goalie() && ! with_goalie )
+              {
+                  continue;
+              }
+              if ( region.contains( p.pos() ) )
+              {
+                  ++count;
+                  if ( only_first ) break;
+              }
+          }
+          return count;
+      }
+};
+
+}
+
+#endif
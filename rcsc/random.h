@@ -33,13 +33,230 @@
 #define RCSC_UTIL_RANDOM_H
 
 #include <boost/random.hpp>
+#include <boost/cstdint.hpp>
 
 #include <algorithm> // min, max
 #include <iostream>
+#include <cstddef>
 #include <ctime>
 
 namespace rcsc {
 
+/*-------------------------------------------------------------------*/
+/*!
+  \class RandomStream
+  \brief counter-based random number stream (Philox4x32-10).
+
+  The output is a pure function of the key and the counter, so the
+  streams with different keys are independent of each other, and a
+  stream can be copied, moved to another thread, or recreated from its
+  key and counter without any shared state. The class satisfies the
+  requirements of the boost random engine, and can be used with the
+  boost distributions.
+*/
+class RandomStream {
+public:
+    //! alias of the result value type.
+    typedef boost::uint32_t result_type;
+
+    BOOST_STATIC_CONSTANT( bool, has_fixed_range = false );
+
+private:
+    boost::uint32_t M_key[2]; //!< stream key
+    boost::uint64_t M_counter; //!< index of the next block
+    boost::uint32_t M_block[4]; //!< the last generated block
+    int M_index; //!< index of the next value in M_block. 4 means empty.
+
+public:
+
+    /*!
+      \brief create the stream with the key
+      \param key stream key. usually given by RandomEngine::stream().
+     */
+    explicit
+    RandomStream( const boost::uint64_t key = 0 )
+        : M_counter( 0 ),
+          M_index( 4 )
+      {
+          M_key[0] = static_cast< boost::uint32_t >( key );
+          M_key[1] = static_cast< boost::uint32_t >( key >> 32 );
+      }
+
+    /*!
+      \brief get the minimum value
+      \return minimum value
+     */
+    static
+    result_type min()
+      {
+          return 0;
+      }
+
+    /*!
+      \brief get the maximum value
+      \return maximum value
+     */
+    static
+    result_type max()
+      {
+          return 0xFFFFFFFFu;
+      }
+
+    /*!
+      \brief get the stream key
+      \return key value
+     */
+    boost::uint64_t key() const
+      {
+          return ( static_cast< boost::uint64_t >( M_key[1] ) << 32 ) | M_key[0];
+      }
+
+    /*!
+      \brief get the number of values generated so far
+      \return the number of values
+     */
+    boost::uint64_t position() const
+      {
+          return M_counter * 4 - ( 4 - M_index );
+      }
+
+    /*!
+      \brief move to the specified position of the stream
+      \param pos the number of values to be skipped from the beginning
+     */
+    void seek( const boost::uint64_t pos )
+      {
+          M_counter = pos / 4;
+          M_index = 4;
+          const int rest = static_cast< int >( pos % 4 );
+          if ( rest != 0 )
+          {
+              generate_block( M_key, M_counter++, M_block );
+              M_index = rest;
+          }
+      }
+
+    /*!
+      \brief generate the next value
+      \return random value in [min(), max()]
+     */
+    result_type operator()()
+      {
+          if ( M_index >= 4 )
+          {
+              generate_block( M_key, M_counter++, M_block );
+              M_index = 0;
+          }
+          return M_block[M_index++];
+      }
+
+    /*!
+      \brief generate uniform real numbers in [min, max)
+      \param min minimum value
+      \param max maximum value
+      \param out pointer to the result array
+      \param n the number of values
+
+      The values are the same as the n successive calls of operator().
+      Whole blocks are computed directly into the result array, so the
+      loop has no dependency between iterations.
+     */
+    void generateUniform( const double & min,
+                          const double & max,
+                          double * out,
+                          const std::size_t n )
+      {
+          const double scale = ( max - min ) * ( 1.0 / 4294967296.0 );
+          std::size_t i = 0;
+
+          while ( i < n && M_index < 4 )
+          {
+              out[i++] = min + scale * M_block[M_index++];
+          }
+
+          const std::size_t blocks = ( n - i ) / 4;
+          for ( std::size_t b = 0; b < blocks; ++b )
+          {
+              boost::uint32_t v[4];
+              generate_block( M_key, M_counter + b, v );
+              double * o = out + i + b * 4;
+              o[0] = min + scale * v[0];
+              o[1] = min + scale * v[1];
+              o[2] = min + scale * v[2];
+              o[3] = min + scale * v[3];
+          }
+          M_counter += blocks;
+          i += blocks * 4;
+
+          while ( i < n )
+          {
+              out[i++] = min + scale * (*this)();
+          }
+      }
+
+    /*!
+      \brief generate indices in [0, size)
+      \param size the number of candidates. must be positive.
+      \param out pointer to the result array
+      \param n the number of values
+
+      The multiply-shift mapping is used instead of the modulo. The bias
+      is less than size / 2^32.
+     */
+    void generateIndex( const boost::uint32_t size,
+                        boost::uint32_t * out,
+                        const std::size_t n )
+      {
+          for ( std::size_t i = 0; i < n; ++i )
+          {
+              out[i] = static_cast< boost::uint32_t >
+                  ( ( static_cast< boost::uint64_t >( (*this)() ) * size ) >> 32 );
+          }
+      }
+
+    /*!
+      \brief compute one block of the Philox4x32-10 function
+      \param key 2 words key
+      \param counter block counter
+      \param out result 4 words
+     */
+    static
+    void generate_block( const boost::uint32_t key[2],
+                         const boost::uint64_t counter,
+                         boost::uint32_t out[4] )
+      {
+          boost::uint32_t c0 = static_cast< boost::uint32_t >( counter );
+          boost::uint32_t c1 = static_cast< boost::uint32_t >( counter >> 32 );
+          boost::uint32_t c2 = 0;
+          boost::uint32_t c3 = 0;
+          boost::uint32_t k0 = key[0];
+          boost::uint32_t k1 = key[1];
+
+          for ( int r = 0; r < 10; ++r )
+          {
+              const boost::uint64_t p0 = static_cast< boost::uint64_t >( 0xD2511F53u ) * c0;
+              const boost::uint64_t p1 = static_cast< boost::uint64_t >( 0xCD9E8D57u ) * c2;
+              const boost::uint32_t hi0 = static_cast< boost::uint32_t >( p0 >> 32 );
+              const boost::uint32_t lo0 = static_cast< boost::uint32_t >( p0 );
+              const boost::uint32_t hi1 = static_cast< boost::uint32_t >( p1 >> 32 );
+              const boost::uint32_t lo1 = static_cast< boost::uint32_t >( p1 );
+
+              c0 = hi1 ^ c1 ^ k0;
+              c1 = lo1;
+              c2 = hi0 ^ c3 ^ k1;
+              c3 = lo0;
+
+              k0 += 0x9E3779B9u;
+              k1 += 0xBB67AE85u;
+          }
+
+          out[0] = c0;
+          out[1] = c1;
+          out[2] = c2;
+          out[3] = c3;
+      }
+};
+
 /*-------------------------------------------------------------------*/
 /*!
   \class RandomEngine
@@ -49,18 +266,27 @@ class RandomEngine {
 public:
     //! alias of the randome engine object type.
     typedef boost::mt19937 base_type;
+
+    //! default seed of the random streams
+    static const boost::uint64_t DEFAULT_STREAM_SEED = 0x5EEDC0DEull;
+
 private:
     //! engine object
     base_type M_engine;
 
+    //! global seed of the random streams
+    boost::uint64_t M_stream_seed;
+
     /*!
       \brief default constructor
 
       default constructor is private, because this class is singleton.
       The random engine object is seeded by current time.
+      The random streams use the fixed default seed.
     */
     RandomEngine()
-        : M_engine( std::time( 0 ) )
+        : M_engine( std::time( 0 ) ),
+          M_stream_seed( DEFAULT_STREAM_SEED )
       { }
 
     //! not used for singleton.
@@ -82,12 +308,54 @@ public:
       }
 
     /*!
-      \brief apply new seed to random engine.
+      \brief apply new seed to random engine and all random streams
+      created after this call.
       \param value seed value
     */
     void seed( base_type::result_type value )
       {
           M_engine.seed( value );
+          M_stream_seed = value;
+      }
+
+    /*!
+      \brief get the global seed of the random streams
+      \return seed value
+     */
+    boost::uint64_t streamSeed() const
+      {
+          return M_stream_seed;
+      }
+
+    /*!
+      \brief create the random stream for the component.
+      \param name component name
+      \param id sub stream id, e.g. the thread index or the player number
+      \return new random stream
+
+      The stream is determined only by the global seed, the name and
+      the id. This method does not modify any state, and can be called
+      from any thread.
+
+      The components owned by a player agent must use the player's id,
+      so that the agents started with the same seed draw different
+      values. The id is the uniform number for the left team, and the
+      uniform number + 11 for the right team (see
+      WorldModel::initTeamInfo()). 0 is used by the components not bound
+      to any player.
+     */
+    RandomStream stream( const char * name,
+                         const boost::uint64_t id = 0 ) const
+      {
+          // FNV-1a hash of the name
+          boost::uint64_t h = 0xCBF29CE484222325ull;
+          for ( const char * p = name; *p != '\0'; ++p )
+          {
+              h ^= static_cast< unsigned char >( *p );
+              h *= 0x100000001B3ull;
+          }
+
+          return RandomStream( mix( mix( M_stream_seed ^ h ) + id ) );
       }
 
     /*!
@@ -98,6 +366,22 @@ public:
       {
           return M_engine;
       }
+
+private:
+
+    /*!
+      \brief splitmix64 finalizer
+      \param x input value
+      \return mixed value
+     */
+    static
+    boost::uint64_t mix( boost::uint64_t x )
+      {
+          x += 0x9E3779B97F4A7C15ull;
+          x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+          x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBull;
+          return x ^ ( x >> 31 );
+      }
 };
 
 /*-------------------------------------------------------------------*/
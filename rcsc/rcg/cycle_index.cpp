@@ -0,0 +1,661 @@
+// -*-c++-*-
+
+/*!
+  \file cycle_index.cpp
+  \brief cycle index for the random access to rcg files Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "cycle_index.h"
+
+#include "handler.h"
+#include "parser.h"
+#include "types.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/stat.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+namespace rcsc {
+namespace rcg {
+
+const int CycleIndex::DEFAULT_BLOCK_CYCLES = 100;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the game time of the line
+  \param line a line of the rcg v4/v5 log
+  \param time pointer to the result variable
+  \return 's' for show, 'm' for msg, 'p' for playmode, 't' for team,
+  or 0 if the line has no game time.
+*/
+char
+line_time( const char * line,
+           int * time )
+{
+    while ( *line == ' ' ) ++line;
+    if ( *line != '(' ) return 0;
+    ++line;
+
+    char kind = 0;
+    if ( ! std::strncmp( line, "show ", 5 ) ) kind = 's';
+    else if ( ! std::strncmp( line, "msg ", 4 ) ) kind = 'm';
+    else if ( ! std::strncmp( line, "playmode ", 9 ) ) kind = 'p';
+    else if ( ! std::strncmp( line, "team ", 5 ) ) kind = 't';
+    else return 0;
+
+    while ( *line != ' ' ) ++line;
+
+    char * next;
+    long t = std::strtol( line, &next, 10 );
+    if ( next == line )
+    {
+        return 0;
+    }
+
+    *time = static_cast< int >( t );
+    return kind;
+}
+
+#ifdef HAVE_LIBZ
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compress the data into a gzip member
+*/
+bool
+gzip_member( const std::string & src,
+             std::string * dst )
+{
+    z_stream z;
+    std::memset( &z, 0, sizeof( z ) );
+
+    if ( deflateInit2( &z, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                       MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY ) != Z_OK )
+    {
+        return false;
+    }
+
+    dst->resize( deflateBound( &z, src.size() ) + 32 );
+
+    z.next_in = reinterpret_cast< Bytef * >( const_cast< char * >( src.data() ) );
+    z.avail_in = static_cast< uInt >( src.size() );
+    z.next_out = reinterpret_cast< Bytef * >( &(*dst)[0] );
+    z.avail_out = static_cast< uInt >( dst->size() );
+
+    const int ret = deflate( &z, Z_FINISH );
+    dst->resize( z.total_out );
+    deflateEnd( &z );
+
+    return ret == Z_STREAM_END;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief decompress a gzip member
+*/
+bool
+gunzip_member( const std::string & src,
+               std::string * dst )
+{
+    z_stream z;
+    std::memset( &z, 0, sizeof( z ) );
+
+    if ( inflateInit2( &z, MAX_WBITS + 16 ) != Z_OK )
+    {
+        return false;
+    }
+
+    z.next_in = reinterpret_cast< Bytef * >( const_cast< char * >( src.data() ) );
+    z.avail_in = static_cast< uInt >( src.size() );
+
+    char buf[65536];
+    int ret = Z_OK;
+    while ( ret == Z_OK )
+    {
+        z.next_out = reinterpret_cast< Bytef * >( buf );
+        z.avail_out = sizeof( buf );
+        ret = inflate( &z, Z_NO_FLUSH );
+        dst->append( buf, sizeof( buf ) - z.avail_out );
+    }
+    inflateEnd( &z );
+
+    return ret == Z_STREAM_END;
+}
+#endif
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the block data to the file, and clear the buffer.
+  \param size pointer to the variable that receives the written size
+*/
+bool
+write_block( std::FILE * fout,
+             const bool compressed,
+             std::string & buf,
+             long * size )
+{
+    std::string data;
+#ifdef HAVE_LIBZ
+    if ( compressed )
+    {
+        if ( ! gzip_member( buf, &data ) )
+        {
+            return false;
+        }
+    }
+    else
+#endif
+    {
+        data.swap( buf );
+    }
+    buf.clear();
+
+    *size = static_cast< long >( data.size() );
+    return std::fwrite( data.data(), 1, data.size(), fout ) == data.size();
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CycleIndex::CycleIndex()
+    : M_version( 0 ),
+      M_compressed( false ),
+      M_log_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::string
+CycleIndex::default_path( const std::string & log_path )
+{
+    return log_path + ".idx";
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+CycleIndex::build( std::istream & is,
+                   const std::string & out_path,
+                   const int block_cycles )
+{
+    M_version = 0;
+    M_compressed = false;
+    M_log_size = 0;
+    M_header = Block();
+    M_blocks.clear();
+
+    std::string line;
+    if ( ! std::getline( is, line ) )
+    {
+        return false;
+    }
+
+    if ( line == "ULG4" ) M_version = REC_VERSION_4;
+    else if ( line == "ULG5" ) M_version = REC_VERSION_5;
+    else
+    {
+        std::cerr << "(CycleIndex::build) unsupported log version." << std::endl;
+        return false;
+    }
+
+    const bool copy = ! out_path.empty();
+    M_compressed = ( copy
+                     && out_path.length() > 3
+                     && out_path.compare( out_path.length() - 3, 3, ".gz" ) == 0 );
+#ifndef HAVE_LIBZ
+    if ( M_compressed )
+    {
+        std::cerr << "(CycleIndex::build) zlib is not available." << std::endl;
+        return false;
+    }
+#endif
+
+    std::FILE * fout = 0;
+    if ( copy )
+    {
+        fout = std::fopen( out_path.c_str(), "wb" );
+        if ( ! fout )
+        {
+            std::cerr << "(CycleIndex::build) could not open " << out_path << std::endl;
+            return false;
+        }
+    }
+
+    long offset = 0; // offset of the current block in the output
+    long size = 0; // size of the current block
+    std::string buf; // data of the current block, used only when copied
+
+    const int n_cycles = std::max( 1, block_cycles );
+    Block * block = &M_header;
+    int boundary = 0;
+    std::string last_playmode;
+    std::string last_team;
+    bool result = true;
+
+    while ( true )
+    {
+        int time = -1;
+        const char kind = line_time( line.c_str(), &time );
+
+        if ( kind != 0
+             && ( block == &M_header || time >= boundary ) )
+        {
+            // close the current block
+            if ( copy )
+            {
+                result = write_block( fout, M_compressed, buf, &size );
+            }
+            block->offset_ = offset;
+            block->size_ = size;
+            offset += size;
+            size = 0;
+
+            if ( ! result ) break;
+
+            M_blocks.push_back( Block() );
+            block = &M_blocks.back();
+            block->first_cycle_ = time;
+            block->playmode_ = last_playmode;
+            block->team_ = last_team;
+            boundary = ( time / n_cycles + 1 ) * n_cycles;
+        }
+
+        if ( kind != 0 )
+        {
+            block->last_cycle_ = std::max( block->last_cycle_, time );
+            if ( kind == 'p' ) last_playmode = line;
+            else if ( kind == 't' ) last_team = line;
+        }
+
+        if ( copy )
+        {
+            buf += line;
+            buf += '\n';
+        }
+        else
+        {
+            size += line.length() + ( is.eof() ? 0 : 1 );
+        }
+
+        if ( ! std::getline( is, line ) )
+        {
+            break;
+        }
+    }
+
+    // the last block
+    if ( result )
+    {
+        if ( copy )
+        {
+            result = write_block( fout, M_compressed, buf, &size );
+        }
+        block->offset_ = offset;
+        block->size_ = size;
+        M_log_size = offset + size;
+    }
+
+    if ( fout
+         && std::fclose( fout ) != 0 )
+    {
+        result = false;
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+CycleIndex::load( const std::string & filepath )
+{
+    std::ifstream fin( filepath.c_str() );
+    if ( ! fin )
+    {
+        return false;
+    }
+
+    M_version = 0;
+    M_compressed = false;
+    M_log_size = 0;
+    M_header = Block();
+    M_blocks.clear();
+
+    std::string line;
+    if ( ! std::getline( fin, line )
+         || line != "RCGIDX 1" )
+    {
+        std::cerr << "(CycleIndex::load) unknown index format. " << filepath << std::endl;
+        return false;
+    }
+
+    Block * block = 0;
+    while ( std::getline( fin, line ) )
+    {
+        std::string::size_type pos = line.find( ' ' );
+        if ( pos == std::string::npos )
+        {
+            continue;
+        }
+
+        const std::string tag = line.substr( 0, pos );
+        const char * value = line.c_str() + pos + 1;
+
+        if ( tag == "version" )
+        {
+            M_version = std::atoi( value );
+        }
+        else if ( tag == "compressed" )
+        {
+            M_compressed = ( std::atoi( value ) != 0 );
+        }
+        else if ( tag == "size" )
+        {
+            M_log_size = std::atol( value );
+        }
+        else if ( tag == "header"
+                  || tag == "block" )
+        {
+            if ( tag == "header" )
+            {
+                block = &M_header;
+            }
+            else
+            {
+                M_blocks.push_back( Block() );
+                block = &M_blocks.back();
+            }
+
+            if ( std::sscanf( value, " %d %d %ld %ld ",
+                              &block->first_cycle_, &block->last_cycle_,
+                              &block->offset_, &block->size_ ) != 4 )
+            {
+                std::cerr << "(CycleIndex::load) illegal line [" << line << ']' << std::endl;
+                return false;
+            }
+        }
+        else if ( block
+                  && tag == "playmode" )
+        {
+            block->playmode_ = value;
+        }
+        else if ( block
+                  && tag == "team" )
+        {
+            block->team_ = value;
+        }
+    }
+
+    return M_version != 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+CycleIndex::save( const std::string & filepath ) const
+{
+    std::ofstream fout( filepath.c_str() );
+    if ( ! fout )
+    {
+        return false;
+    }
+
+    fout << "RCGIDX 1\n"
+         << "version " << M_version << '\n'
+         << "compressed " << ( M_compressed ? 1 : 0 ) << '\n'
+         << "size " << M_log_size << '\n'
+         << "header " << M_header.first_cycle_ << ' ' << M_header.last_cycle_
+         << ' ' << M_header.offset_ << ' ' << M_header.size_ << '\n';
+
+    for ( std::vector< Block >::const_iterator b = M_blocks.begin(), end = M_blocks.end();
+          b != end;
+          ++b )
+    {
+        fout << "block " << b->first_cycle_ << ' ' << b->last_cycle_
+             << ' ' << b->offset_ << ' ' << b->size_ << '\n';
+        if ( ! b->playmode_.empty() ) fout << "playmode " << b->playmode_ << '\n';
+        if ( ! b->team_.empty() ) fout << "team " << b->team_ << '\n';
+    }
+
+    fout.flush();
+    return fout.good();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+CycleIndex::isValid( const std::string & log_path,
+                     const std::string & index_path ) const
+{
+    struct stat log_st;
+    struct stat index_st;
+    if ( ::stat( log_path.c_str(), &log_st ) != 0
+         || ::stat( index_path.c_str(), &index_st ) != 0 )
+    {
+        return false;
+    }
+
+    return ( M_log_size > 0
+             && static_cast< long >( log_st.st_size ) == M_log_size
+             && log_st.st_mtime <= index_st.st_mtime );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+CycleIndex::readBlock( std::FILE * fp,
+                       const Block & block,
+                       std::string * text ) const
+{
+    if ( block.size_ <= 0 )
+    {
+        return true;
+    }
+
+    std::string data( block.size_, '\0' );
+    if ( std::fseek( fp, block.offset_, SEEK_SET ) != 0
+         || std::fread( &data[0], 1, data.size(), fp ) != data.size() )
+    {
+        std::cerr << "(CycleIndex::readBlock) could not read the block at "
+                  << block.offset_ << std::endl;
+        return false;
+    }
+
+    if ( ! M_compressed )
+    {
+        text->append( data );
+        return true;
+    }
+
+#ifdef HAVE_LIBZ
+    if ( gunzip_member( data, text ) )
+    {
+        return true;
+    }
+#endif
+
+    std::cerr << "(CycleIndex::readBlock) could not decompress the block at "
+              << block.offset_ << std::endl;
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+CycleIndex::read( const std::string & log_path,
+                  const int from,
+                  const int to,
+                  std::string * text ) const
+{
+    std::FILE * fp = std::fopen( log_path.c_str(), "rb" );
+    if ( ! fp )
+    {
+        std::cerr << "(CycleIndex::read) could not open " << log_path << std::endl;
+        return false;
+    }
+
+    text->clear();
+
+    bool result = readBlock( fp, M_header, text );
+    if ( ! text->empty()
+         && *text->rbegin() != '\n' )
+    {
+        *text += '\n';
+    }
+
+    std::string playmode;
+    std::string team;
+    bool first = true;
+    bool in_range = false;
+    bool finished = false;
+
+    std::string data;
+    for ( std::vector< Block >::const_iterator b = M_blocks.begin(), end = M_blocks.end();
+          b != end && result && ! finished;
+          ++b )
+    {
+        if ( b->last_cycle_ < from ) continue;
+        if ( b->first_cycle_ > to ) break;
+
+        if ( first )
+        {
+            playmode = b->playmode_;
+            team = b->team_;
+            first = false;
+        }
+
+        data.clear();
+        if ( ! readBlock( fp, *b, &data ) )
+        {
+            result = false;
+            break;
+        }
+
+        std::string::size_type pos = 0;
+        while ( pos < data.size() )
+        {
+            std::string::size_type eol = data.find( '\n', pos );
+            if ( eol == std::string::npos ) eol = data.size();
+
+            int time = -1;
+            const char kind = line_time( data.c_str() + pos, &time );
+
+            if ( kind != 0
+                 && time < from )
+            {
+                // keep the context before the range
+                if ( kind == 'p' ) playmode.assign( data, pos, eol - pos );
+                else if ( kind == 't' ) team.assign( data, pos, eol - pos );
+            }
+            else if ( kind != 0
+                      && time > to )
+            {
+                finished = true;
+                break;
+            }
+            else
+            {
+                if ( kind != 0
+                     && ! in_range )
+                {
+                    if ( ! playmode.empty() ) *text += playmode + '\n';
+                    if ( ! team.empty() ) *text += team + '\n';
+                    in_range = true;
+                }
+
+                text->append( data, pos, eol - pos );
+                *text += '\n';
+            }
+
+            pos = eol + 1;
+        }
+    }
+
+    std::fclose( fp );
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+CycleIndex::parse( const std::string & log_path,
+                   const int from,
+                   const int to,
+                   Handler & handler ) const
+{
+    std::string text;
+    if ( ! read( log_path, from, to, &text ) )
+    {
+        return false;
+    }
+
+    std::istringstream is( text );
+    Parser::Ptr parser = Parser::create( is );
+    if ( ! parser )
+    {
+        return false;
+    }
+
+    return parser->parse( is, handler );
+}
+
+} // end of namespace
+} // end of namespace
@@ -0,0 +1,239 @@
+// -*-c++-*-
+
+/*!
+  \file cycle_index.h
+  \brief cycle index for the random access to rcg files Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_CYCLE_INDEX_H
+#define RCSC_RCG_CYCLE_INDEX_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+namespace rcsc {
+namespace rcg {
+
+class Handler;
+
+/*!
+  \class CycleIndex
+  \brief sidecar index that maps game cycles to the blocks of a rcg v4/v5 file.
+
+  A block is a byte range of the log file that contains whole lines
+  of a fixed number of cycles. The lines before the first cycle
+  (the header line and the parameter messages) make the header block.
+  If the log is compressed, every block is an independent gzip member,
+  so that the file is still a valid gzip file and each block can be
+  decompressed alone. A gzip file written by rcssserver consists of
+  one member and must be rewritten by build() to be indexed.
+
+  The index file is a text file usually saved as "<log>.idx".
+*/
+class CycleIndex {
+public:
+
+    /*!
+      \struct Block
+      \brief location and context of the block
+    */
+    struct Block {
+        int first_cycle_; //!< the first cycle in the block
+        int last_cycle_; //!< the last cycle in the block
+        long offset_; //!< byte offset in the log file
+        long size_; //!< byte size in the log file
+        std::string playmode_; //!< the last playmode line before the block
+        std::string team_; //!< the last team line before the block
+
+        Block()
+            : first_cycle_( -1 ),
+              last_cycle_( -1 ),
+              offset_( 0 ),
+              size_( 0 )
+          { }
+    };
+
+    //! default number of cycles in one block
+    static const int DEFAULT_BLOCK_CYCLES;
+
+private:
+
+    //! rcg version
+    int M_version;
+
+    //! true if the blocks are gzip members
+    bool M_compressed;
+
+    //! byte size of the indexed log file
+    long M_log_size;
+
+    //! lines before the first cycle
+    Block M_header;
+
+    //! blocks in the file order
+    std::vector< Block > M_blocks;
+
+public:
+
+    /*!
+      \brief create an empty index
+    */
+    CycleIndex();
+
+    /*!
+      \brief get the default index file path for the log file
+      \param log_path log file path
+      \return index file path
+    */
+    static
+    std::string default_path( const std::string & log_path );
+
+    /*!
+      \brief get the rcg version of the indexed log
+      \return rcg version
+    */
+    int version() const
+      {
+          return M_version;
+      }
+
+    /*!
+      \brief check if the indexed log is compressed
+      \return true if the blocks are gzip members
+    */
+    bool compressed() const
+      {
+          return M_compressed;
+      }
+
+    /*!
+      \brief get the byte size of the indexed log file
+      \return byte size
+    */
+    long logSize() const
+      {
+          return M_log_size;
+      }
+
+    /*!
+      \brief get the header block
+      \return const reference to the header block
+    */
+    const Block & header() const
+      {
+          return M_header;
+      }
+
+    /*!
+      \brief get all blocks
+      \return const reference to the block container
+    */
+    const std::vector< Block > & blocks() const
+      {
+          return M_blocks;
+      }
+
+    /*!
+      \brief create the index of the log.
+      \param is uncompressed input stream of the rcg v4/v5 log
+      \param out_path output log file path. If empty, the input stream
+      itself is indexed, so it must be read from an uncompressed file.
+      Otherwise, the log is copied to out_path. If out_path ends with
+      ".gz", each block is written as a gzip member.
+      \param block_cycles the number of cycles in one block
+      \return true if successfully created
+    */
+    bool build( std::istream & is,
+                const std::string & out_path,
+                const int block_cycles = DEFAULT_BLOCK_CYCLES );
+
+    /*!
+      \brief read the index file
+      \param filepath index file path
+      \return true if successfully read
+    */
+    bool load( const std::string & filepath );
+
+    /*!
+      \brief write the index file
+      \param filepath index file path
+      \return true if successfully written
+    */
+    bool save( const std::string & filepath ) const;
+
+    /*!
+      \brief check if the index still describes the log file.
+      The log must have the indexed size and must not be newer than the index file.
+      \param log_path indexed log file path
+      \param index_path index file path
+      \return true if the index can be used for the log
+    */
+    bool isValid( const std::string & log_path,
+                  const std::string & index_path ) const;
+
+    /*!
+      \brief read the lines of the cycle range from the indexed log.
+      Only the header block and the blocks that overlap the range are read.
+      \param log_path indexed log file path
+      \param from the first cycle of the range
+      \param to the last cycle of the range
+      \param text the result log text that consists of the header block,
+      the last playmode and team lines before the range, and the lines of the range.
+      \return true if successfully read
+    */
+    bool read( const std::string & log_path,
+               const int from,
+               const int to,
+               std::string * text ) const;
+
+    /*!
+      \brief parse the cycle range of the indexed log
+      \param log_path indexed log file path
+      \param from the first cycle of the range
+      \param to the last cycle of the range
+      \param handler reference to the rcg data handler
+      \return true if successfully parsed
+    */
+    bool parse( const std::string & log_path,
+                const int from,
+                const int to,
+                Handler & handler ) const;
+
+private:
+
+    bool readBlock( std::FILE * fp,
+                    const Block & block,
+                    std::string * text ) const;
+
+};
+
+} // end of namespace
+} // end of namespace
+
+#endif
@@ -0,0 +1,876 @@
+// -*-c++-*-
+
+/*!
+  \file parallel_parser.cpp
+  \brief memory mapped multi-threaded rcg parser Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "parallel_parser.h"
+
+#include "handler.h"
+#include "parser.h"
+#include "parser_v4.h"
+#include "parser_v5.h"
+#include "types.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! the number of chunks that workers may parse ahead of the delivery
+const int AHEAD_PER_THREAD = 4;
+
+//! exact powers of ten in float
+const float POW10[] = { 1.0e0f, 1.0e1f, 1.0e2f, 1.0e3f, 1.0e4f, 1.0e5f,
+                        1.0e6f, 1.0e7f, 1.0e8f, 1.0e9f, 1.0e10f };
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class ShowScanner
+  \brief strict show line scanner.
+
+  The scanner accepts only the regular show line written by rcssserver
+  and fails on any other input. A failed line is passed to the normal
+  parser, so the scanner has to produce the same result as
+  ParserV4/ParserV5::parseShow() only for the lines it accepts.
+*/
+class ShowScanner {
+private:
+    const char * M_p; //!< current position
+    const char * const M_end; //!< end of line
+
+public:
+
+    ShowScanner( const char * begin,
+                 const char * end )
+        : M_p( begin ),
+          M_end( end )
+      { }
+
+    bool scan( const int version,
+               long * time,
+               ShowInfoT * show );
+
+private:
+
+    bool expect( const char * str )
+      {
+          for ( ; *str != '\0'; ++str, ++M_p )
+          {
+              if ( M_p == M_end || *M_p != *str ) return false;
+          }
+          return true;
+      }
+
+    void skipSpace()
+      {
+          while ( M_p != M_end && *M_p == ' ' ) ++M_p;
+      }
+
+    bool isDelimiter() const
+      {
+          return M_p != M_end && ( *M_p == ' ' || *M_p == ')' );
+      }
+
+    bool readLong( long * value );
+    bool readHex( long * value );
+    bool readFloat( float * value );
+    bool readFloatSlow( const char * start,
+                        float * value );
+
+    template < typename T >
+    bool readInt( T * value )
+      {
+          long v = 0;
+          if ( ! readLong( &v ) ) return false;
+          *value = static_cast< T >( v );
+          return true;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a decimal integer as strtol() does.
+*/
+bool
+ShowScanner::readLong( long * value )
+{
+    skipSpace();
+
+    bool negative = false;
+    if ( M_p != M_end && ( *M_p == '-' || *M_p == '+' ) )
+    {
+        negative = ( *M_p == '-' );
+        ++M_p;
+    }
+
+    long v = 0;
+    int n_digits = 0;
+    while ( M_p != M_end
+            && '0' <= *M_p && *M_p <= '9' )
+    {
+        v = v * 10 + ( *M_p - '0' );
+        ++M_p;
+        if ( ++n_digits > 18 ) return false;
+    }
+
+    if ( n_digits == 0
+         || ! isDelimiter() )
+    {
+        return false;
+    }
+
+    *value = ( negative ? -v : v );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a hexadecimal integer as strtol( , , 16 ) does.
+*/
+bool
+ShowScanner::readHex( long * value )
+{
+    skipSpace();
+
+    if ( M_end - M_p > 2
+         && M_p[0] == '0'
+         && ( M_p[1] == 'x' || M_p[1] == 'X' ) )
+    {
+        M_p += 2;
+    }
+
+    long v = 0;
+    int n_digits = 0;
+    while ( M_p != M_end )
+    {
+        const char c = *M_p;
+        int d;
+        if ( '0' <= c && c <= '9' ) d = c - '0';
+        else if ( 'a' <= c && c <= 'f' ) d = c - 'a' + 10;
+        else if ( 'A' <= c && c <= 'F' ) d = c - 'A' + 10;
+        else break;
+
+        v = v * 16 + d;
+        ++M_p;
+        if ( ++n_digits > 15 ) return false;
+    }
+
+    if ( n_digits == 0
+         || ! isDelimiter() )
+    {
+        return false;
+    }
+
+    *value = v;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a floating point number as strtof() does.
+
+  If the mantissa and the power of ten are exactly representable in
+  float, one IEEE division gives the correctly rounded result that is
+  the same as strtof(). Other forms are converted by strtof() itself.
+*/
+bool
+ShowScanner::readFloat( float * value )
+{
+    skipSpace();
+
+    const char * start = M_p;
+
+    bool negative = false;
+    if ( M_p != M_end && ( *M_p == '-' || *M_p == '+' ) )
+    {
+        negative = ( *M_p == '-' );
+        ++M_p;
+    }
+
+    unsigned long mantissa = 0;
+    int n_digits = 0;
+    int n_frac = 0;
+    while ( M_p != M_end
+            && '0' <= *M_p && *M_p <= '9' )
+    {
+        mantissa = mantissa * 10 + ( *M_p - '0' );
+        ++M_p;
+        if ( ++n_digits > 9 ) return readFloatSlow( start, value );
+    }
+
+    if ( M_p != M_end && *M_p == '.' )
+    {
+        ++M_p;
+        while ( M_p != M_end
+                && '0' <= *M_p && *M_p <= '9' )
+        {
+            mantissa = mantissa * 10 + ( *M_p - '0' );
+            ++M_p;
+            ++n_frac;
+            if ( ++n_digits > 9 ) return readFloatSlow( start, value );
+        }
+    }
+
+    if ( n_digits == 0
+         || ! isDelimiter()
+         || mantissa >= ( 1ul << 24 )
+         || n_frac > 10 )
+    {
+        return readFloatSlow( start, value );
+    }
+
+    float v = static_cast< float >( mantissa );
+    if ( n_frac > 0 )
+    {
+        v /= POW10[n_frac];
+    }
+
+    *value = ( negative ? -v : v );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a floating point number by strtof().
+  The token is copied because the mapped line is not terminated by '\0'.
+*/
+bool
+ShowScanner::readFloatSlow( const char * start,
+                            float * value )
+{
+    char buf[64];
+    std::size_t len = 0;
+    while ( start + len != M_end
+            && start[len] != ' '
+            && start[len] != ')' )
+    {
+        if ( len >= sizeof( buf ) - 1 ) return false;
+        buf[len] = start[len];
+        ++len;
+    }
+    buf[len] = '\0';
+
+    if ( len == 0 ) return false;
+
+    char * next;
+    *value = std::strtof( buf, &next );
+    if ( next != buf + len )
+    {
+        return false;
+    }
+
+    M_p = start + len;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scan the show line.
+  (show <Time> ((b) x y vx vy) ((side unum) type state x y vx vy body neck [px py]
+  (v quality width) (s stamina effort recovery [capacity]) [(f side unum)] (c counts)) ...)
+*/
+bool
+ShowScanner::scan( const int version,
+                   long * time,
+                   ShowInfoT * show )
+{
+    if ( ! expect( "(show " )
+         || ! readLong( time ) )
+    {
+        return false;
+    }
+    show->time_ = static_cast< UInt32 >( *time );
+
+    // ball
+    skipSpace();
+    BallT & ball = show->ball_;
+    if ( ! expect( "((b)" )
+         || ! readFloat( &ball.x_ )
+         || ! readFloat( &ball.y_ )
+         || ! readFloat( &ball.vx_ )
+         || ! readFloat( &ball.vy_ )
+         || ! expect( ")" )
+         || ball.vy_ == HUGE_VALF )
+    {
+        return false;
+    }
+
+    // players
+    skipSpace();
+    for ( int i = 0; i < MAX_PLAYER*2; ++i )
+    {
+        if ( M_p == M_end || *M_p == ')' ) break;
+
+        // ((side unum)
+        if ( ! expect( "((" )
+             || M_p == M_end
+             || ( *M_p != 'l' && *M_p != 'r' ) )
+        {
+            return false;
+        }
+        const char side = *M_p++;
+
+        long unum = 0;
+        if ( ! readLong( &unum )
+             || unum < 1 || MAX_PLAYER < unum
+             || ! expect( ")" ) )
+        {
+            return false;
+        }
+
+        PlayerT & p = show->player_[side == 'l' ? unum - 1 : unum - 1 + MAX_PLAYER];
+        p.side_ = side;
+        p.unum_ = static_cast< Int16 >( unum );
+
+        // type state x y vx vy body neck [pointx pointy]
+        long state = 0;
+        if ( ! readInt( &p.type_ )
+             || ! readHex( &state )
+             || ! readFloat( &p.x_ )
+             || ! readFloat( &p.y_ )
+             || ! readFloat( &p.vx_ )
+             || ! readFloat( &p.vy_ )
+             || ! readFloat( &p.body_ )
+             || ! readFloat( &p.neck_ ) )
+        {
+            return false;
+        }
+        p.state_ = static_cast< Int32 >( state );
+
+        skipSpace();
+        if ( M_p != M_end && *M_p != '(' )
+        {
+            if ( ! readFloat( &p.point_x_ )
+                 || ! readFloat( &p.point_y_ ) )
+            {
+                return false;
+            }
+            skipSpace();
+        }
+
+        // (v quality width)
+        if ( ! expect( "(v" ) )
+        {
+            return false;
+        }
+        skipSpace();
+        if ( M_p == M_end ) return false;
+        p.view_quality_ = *M_p++;
+        if ( ! readFloat( &p.view_width_ )
+             || ! expect( ")" ) )
+        {
+            return false;
+        }
+
+        // (s stamina effort recovery [capacity])
+        skipSpace();
+        if ( ! expect( "(s" )
+             || ! readFloat( &p.stamina_ )
+             || ! readFloat( &p.effort_ )
+             || ! readFloat( &p.recovery_ )
+             || ( version >= REC_VERSION_5
+                  && ! readFloat( &p.stamina_capacity_ ) )
+             || ! expect( ")" ) )
+        {
+            return false;
+        }
+
+        // (f side unum)
+        skipSpace();
+        if ( M_end - M_p > 2
+             && M_p[1] == 'f' )
+        {
+            if ( ! expect( "(f " ) ) return false;
+            skipSpace();
+            if ( M_p == M_end ) return false;
+            p.focus_side_ = *M_p++;
+            if ( ! readInt( &p.focus_unum_ )
+                 || ! expect( ")" ) )
+            {
+                return false;
+            }
+            skipSpace();
+        }
+
+        // (c kick dash turn catch move tneck cview say tackle pointto atttention)
+        if ( ! expect( "(c" )
+             || ! readInt( &p.kick_count_ )
+             || ! readInt( &p.dash_count_ )
+             || ! readInt( &p.turn_count_ )
+             || ! readInt( &p.catch_count_ )
+             || ! readInt( &p.move_count_ )
+             || ! readInt( &p.turn_neck_count_ )
+             || ! readInt( &p.change_view_count_ )
+             || ! readInt( &p.say_count_ )
+             || ! readInt( &p.tackle_count_ )
+             || ! readInt( &p.pointto_count_ )
+             || ! readInt( &p.attentionto_count_ )
+             || ! expect( "))" ) )
+        {
+            return false;
+        }
+
+        // the original parser also skips the closing parenthesis of the show
+        // and rejects the line that ends before all players are read.
+        while ( M_p != M_end && *M_p == ')' ) ++M_p;
+        skipSpace();
+        if ( M_p == M_end
+             && i != MAX_PLAYER*2 - 1 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Line
+  \brief a line in the chunk
+*/
+struct Line {
+    const char * begin_; //!< head of the line
+    std::size_t length_; //!< line length without the newline
+    int show_; //!< index of the decoded show, or -1 if not decoded
+    long time_; //!< game time of the decoded show
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Chunk
+  \brief line aligned part of the mapped file
+*/
+struct Chunk {
+    const char * begin_; //!< head of the chunk
+    const char * end_; //!< end of the chunk
+    std::vector< Line > lines_; //!< lines in the chunk
+    std::vector< ShowInfoT > shows_; //!< decoded show data
+    bool done_; //!< true if the chunk has been parsed
+
+    Chunk( const char * begin,
+           const char * end )
+        : begin_( begin ),
+          end_( end ),
+          done_( false )
+      { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief split the chunk into lines and decode the show lines.
+*/
+void
+parse_chunk( const int version,
+             Chunk & chunk )
+{
+    const char * p = chunk.begin_;
+    while ( p != chunk.end_ )
+    {
+        const char * eol = static_cast< const char * >( std::memchr( p, '\n', chunk.end_ - p ) );
+        if ( ! eol ) eol = chunk.end_;
+
+        Line line;
+        line.begin_ = p;
+        line.length_ = eol - p;
+        line.show_ = -1;
+        line.time_ = 0;
+
+        if ( line.length_ > 6
+             && ! std::strncmp( p, "(show ", 6 ) )
+        {
+            chunk.shows_.push_back( ShowInfoT() );
+            ShowScanner scanner( p, eol );
+            if ( scanner.scan( version, &line.time_, &chunk.shows_.back() ) )
+            {
+                line.show_ = static_cast< int >( chunk.shows_.size() ) - 1;
+            }
+            else
+            {
+                chunk.shows_.pop_back();
+            }
+        }
+
+        chunk.lines_.push_back( line );
+
+        p = ( eol == chunk.end_ ? eol : eol + 1 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Job
+  \brief shared state between the delivering thread and the worker threads.
+*/
+struct Job {
+    int version_; //!< log version
+    std::vector< Chunk > chunks_; //!< all chunks
+    int max_ahead_; //!< the number of chunks that can be parsed before delivery
+
+    pthread_mutex_t mutex_; //!< protects all variables below
+    pthread_cond_t cond_; //!< signaled when a chunk is parsed or delivered
+    int next_index_; //!< the next chunk index to be parsed
+    int n_delivered_; //!< the number of delivered chunks
+    bool stop_; //!< termination flag
+
+    Job( const int version,
+         const int max_ahead )
+        : version_( version ),
+          max_ahead_( max_ahead ),
+          next_index_( 0 ),
+          n_delivered_( 0 ),
+          stop_( false )
+      {
+          pthread_mutex_init( &mutex_, 0 );
+          pthread_cond_init( &cond_, 0 );
+      }
+
+    ~Job()
+      {
+          pthread_cond_destroy( &cond_ );
+          pthread_mutex_destroy( &mutex_ );
+      }
+
+    /*!
+      \brief parse the chunk. mutex_ must be locked by the caller.
+    */
+    void parse( const int index )
+      {
+          pthread_mutex_unlock( &mutex_ );
+          parse_chunk( version_, chunks_[index] );
+          pthread_mutex_lock( &mutex_ );
+
+          chunks_[index].done_ = true;
+          pthread_cond_broadcast( &cond_ );
+      }
+
+    static
+    void * thread_main( void * arg );
+
+private:
+    // not used
+    Job( const Job & );
+    Job & operator=( const Job & );
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void *
+Job::thread_main( void * arg )
+{
+    Job * job = static_cast< Job * >( arg );
+
+    const int n_chunks = static_cast< int >( job->chunks_.size() );
+
+    pthread_mutex_lock( &job->mutex_ );
+    while ( true )
+    {
+        while ( ! job->stop_
+                && job->next_index_ < n_chunks
+                && job->next_index_ >= job->n_delivered_ + job->max_ahead_ )
+        {
+            pthread_cond_wait( &job->cond_, &job->mutex_ );
+        }
+
+        if ( job->stop_
+             || job->next_index_ >= n_chunks )
+        {
+            break;
+        }
+
+        job->parse( job->next_index_++ );
+    }
+    pthread_mutex_unlock( &job->mutex_ );
+
+    return static_cast< void * >( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class MappedFile
+  \brief read only memory mapped file
+*/
+class MappedFile {
+private:
+    const char * M_data;
+    std::size_t M_size;
+
+    // not used
+    MappedFile( const MappedFile & );
+    MappedFile & operator=( const MappedFile & );
+
+public:
+
+    explicit
+    MappedFile( const std::string & filepath )
+        : M_data( 0 ),
+          M_size( 0 )
+      {
+          const int fd = ::open( filepath.c_str(), O_RDONLY );
+          if ( fd < 0 )
+          {
+              return;
+          }
+
+          struct stat st;
+          if ( ::fstat( fd, &st ) == 0
+               && st.st_size > 0 )
+          {
+              void * addr = ::mmap( 0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+              if ( addr != MAP_FAILED )
+              {
+                  M_data = static_cast< const char * >( addr );
+                  M_size = st.st_size;
+              }
+          }
+
+          ::close( fd );
+      }
+
+    ~MappedFile()
+      {
+          if ( M_data )
+          {
+              ::munmap( const_cast< char * >( M_data ), M_size );
+          }
+      }
+
+    const char * data() const { return M_data; }
+    std::size_t size() const { return M_size; }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ParallelParser::ParallelParser( const int n_threads )
+    : M_n_threads( n_threads ),
+      M_chunk_size( 1024 * 1024 )
+{
+    if ( M_n_threads <= 0 )
+    {
+        long n = ::sysconf( _SC_NPROCESSORS_ONLN );
+        M_n_threads = ( n > 0 ? static_cast< int >( n ) : 1 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ParallelParser::setChunkSize( const std::size_t bytes )
+{
+    M_chunk_size = std::max( static_cast< std::size_t >( 1 ), bytes );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ParallelParser::parse( const std::string & filepath,
+                       Handler & handler ) const
+{
+    MappedFile file( filepath );
+    if ( ! file.data() )
+    {
+        std::cerr << "(ParallelParser) could not map the file " << filepath
+                  << std::endl;
+        return false;
+    }
+
+    const char * const data = file.data();
+    const char * const end = data + file.size();
+
+    if ( file.size() >= 2
+         && static_cast< unsigned char >( data[0] ) == 0x1f
+         && static_cast< unsigned char >( data[1] ) == 0x8b )
+    {
+        std::cerr << "(ParallelParser) compressed file is not supported. "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    //
+    // header
+    //
+    const char * header_end = static_cast< const char * >( std::memchr( data, '\n', file.size() ) );
+    if ( ! header_end ) header_end = end;
+    const std::string header( data, header_end );
+    const char * const body = ( header_end == end ? end : header_end + 1 );
+
+    int version = 0;
+    if ( header == "ULG4" )
+    {
+        version = REC_VERSION_4;
+    }
+    else if ( header == "ULG5" )
+    {
+        version = REC_VERSION_5;
+    }
+    else
+    {
+        // other versions
+        std::ifstream fin( filepath.c_str(), std::ios_base::in | std::ios_base::binary );
+        Parser::Ptr parser = Parser::create( fin );
+        if ( ! parser )
+        {
+            return false;
+        }
+        return parser->parse( fin, handler );
+    }
+
+    if ( ! handler.handleLogVersion( version ) )
+    {
+        return false;
+    }
+
+    //
+    // split into the line aligned chunks
+    //
+    Job job( version, M_n_threads * AHEAD_PER_THREAD );
+
+    for ( const char * p = body; p != end; )
+    {
+        const char * chunk_end = p + std::min( M_chunk_size, static_cast< std::size_t >( end - p ) );
+        if ( chunk_end != end )
+        {
+            const char * eol = static_cast< const char * >( std::memchr( chunk_end - 1, '\n', end - chunk_end + 1 ) );
+            chunk_end = ( eol ? eol + 1 : end );
+        }
+        job.chunks_.push_back( Chunk( p, chunk_end ) );
+        p = chunk_end;
+    }
+
+    const int n_chunks = static_cast< int >( job.chunks_.size() );
+
+    std::vector< pthread_t > threads;
+    for ( int i = 1; i < std::min( M_n_threads, n_chunks ); ++i )
+    {
+        pthread_t th;
+        if ( pthread_create( &th, 0, &Job::thread_main, &job ) != 0 )
+        {
+            break;
+        }
+        threads.push_back( th );
+    }
+
+    //
+    // deliver the chunks in the original order.
+    // the calling thread also parses the chunks while it waits.
+    //
+    const ParserV4 parser_v4;
+    const ParserV5 parser_v5;
+    const ParserV4 & parser = ( version == REC_VERSION_5 ? parser_v5 : parser_v4 );
+
+    bool result = true;
+    int n_line = 1;
+
+    for ( int i = 0; i < n_chunks && result; ++i )
+    {
+        pthread_mutex_lock( &job.mutex_ );
+        while ( ! job.chunks_[i].done_ )
+        {
+            if ( job.next_index_ < n_chunks
+                 && job.next_index_ < job.n_delivered_ + job.max_ahead_ )
+            {
+                job.parse( job.next_index_++ );
+            }
+            else
+            {
+                pthread_cond_wait( &job.cond_, &job.mutex_ );
+            }
+        }
+        pthread_mutex_unlock( &job.mutex_ );
+
+        Chunk & chunk = job.chunks_[i];
+        for ( std::vector< Line >::const_iterator it = chunk.lines_.begin(), line_end = chunk.lines_.end();
+              it != line_end;
+              ++it )
+        {
+            ++n_line;
+            if ( it->show_ >= 0 )
+            {
+                handler.handleShow( it->time_, chunk.shows_[it->show_] );
+            }
+            else if ( ! parser.parseLine( n_line, std::string( it->begin_, it->length_ ), handler ) )
+            {
+                result = false;
+                break;
+            }
+        }
+
+        std::vector< Line >().swap( chunk.lines_ );
+        std::vector< ShowInfoT >().swap( chunk.shows_ );
+
+        pthread_mutex_lock( &job.mutex_ );
+        ++job.n_delivered_;
+        if ( ! result ) job.stop_ = true;
+        pthread_cond_broadcast( &job.cond_ );
+        pthread_mutex_unlock( &job.mutex_ );
+    }
+
+    for ( std::vector< pthread_t >::iterator it = threads.begin(); it != threads.end(); ++it )
+    {
+        pthread_join( *it, 0 );
+    }
+
+    if ( ! result )
+    {
+        return false;
+    }
+
+    return handler.handleEOF();
+}
+
+} // end of namespace
+} // end of namespace
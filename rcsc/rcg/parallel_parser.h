@@ -0,0 +1,117 @@
+// -*-c++-*-
+
+/*!
+  \file parallel_parser.h
+  \brief memory mapped multi-threaded rcg parser Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_PARALLEL_PARSER_H
+#define RCSC_RCG_PARALLEL_PARSER_H
+
+#include <string>
+#include <cstddef>
+
+namespace rcsc {
+namespace rcg {
+
+class Handler;
+
+/*!
+  \class ParallelParser
+  \brief rcg file parser that splits an uncompressed v4/v5 log into
+  line aligned chunks and parses them on several threads.
+
+  The file is mapped into memory. Worker threads decode the show lines
+  of each chunk with a specialized number parser, and the calling
+  thread delivers the results to the handler in the original line
+  order. Other lines, and the show lines that the fast path does not
+  accept, are passed to ParserV4/ParserV5::parseLine() as they are,
+  so the handler receives exactly the same callbacks as the streaming
+  parser.
+
+  The other log versions are parsed by the streaming parser.
+  Compressed logs are not supported, because the file must be mapped.
+*/
+class ParallelParser {
+private:
+
+    //! the number of threads including the calling thread
+    int M_n_threads;
+
+    //! the approximate chunk size in bytes
+    std::size_t M_chunk_size;
+
+public:
+
+    /*!
+      \brief construct with the thread setting
+      \param n_threads the number of threads including the calling thread.
+      if 0, the number of online processors is used.
+    */
+    explicit
+    ParallelParser( const int n_threads = 0 );
+
+    /*!
+      \brief get the number of threads
+      \return the number of threads including the calling thread
+    */
+    int threads() const
+      {
+          return M_n_threads;
+      }
+
+    /*!
+      \brief set the approximate chunk size
+      \param bytes chunk size in bytes
+    */
+    void setChunkSize( const std::size_t bytes );
+
+    /*!
+      \brief get the approximate chunk size
+      \return chunk size in bytes
+    */
+    std::size_t chunkSize() const
+      {
+          return M_chunk_size;
+      }
+
+    /*!
+      \brief parse the rcg file
+      \param filepath path to the uncompressed rcg file
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if the file could not be read or incorrect format is detected.
+    */
+    bool parse( const std::string & filepath,
+                Handler & handler ) const;
+
+};
+
+} // end of namespace
+} // end of namespace
+
+#endif
@@ -0,0 +1,279 @@
+// -*-c++-*-
+
+/*!
+  \file formationbaker.cpp
+  \brief formation grid baker program source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/formation/formation.h>
+#include <rcsc/formation/formation_grid.h>
+#include <rcsc/time/timer.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+///////////////////////////////////////////////////////////
+
+/*---------------------------------------------------------------*/
+/*!
+  compare the grid with the source formation, and print the errors
+  and the query time.
+*/
+static
+void
+check( const rcsc::Formation & formation,
+       const rcsc::FormationGrid & grid,
+       const int n_random )
+{
+    const rcsc::Rect2D & area = grid.area();
+
+    // cell centers, where the bilinear interpolation error is usually largest
+    std::vector< rcsc::Vector2D > points;
+    const double step_x = area.size().length() / ( grid.columns() - 1 );
+    const double step_y = area.size().width() / ( grid.rows() - 1 );
+    for ( int j = 0; j < grid.rows() - 1; ++j )
+    {
+        for ( int i = 0; i < grid.columns() - 1; ++i )
+        {
+            points.push_back( rcsc::Vector2D( area.left() + step_x * ( i + 0.5 ),
+                                              area.top() + step_y * ( j + 0.5 ) ) );
+        }
+    }
+
+    boost::mt19937 rng( 20101001 );
+    boost::uniform_real<> x_dist( area.left(), area.right() );
+    boost::uniform_real<> y_dist( area.top(), area.bottom() );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rand_x( rng, x_dist );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > rand_y( rng, y_dist );
+    for ( int i = 0; i < n_random; ++i )
+    {
+        points.push_back( rcsc::Vector2D( rand_x(), rand_y() ) );
+    }
+
+    std::vector< rcsc::Vector2D > expected;
+    std::vector< rcsc::Vector2D > actual;
+
+    double max_error[11];
+    rcsc::Vector2D max_point[11];
+    double sum_error = 0.0;
+    std::fill( max_error, max_error + 11, 0.0 );
+
+    for ( std::vector< rcsc::Vector2D >::const_iterator p = points.begin(), end = points.end();
+          p != end;
+          ++p )
+    {
+        formation.getPositions( *p, expected );
+        grid.getPositions( *p, actual );
+
+        for ( int i = 0; i < 11; ++i )
+        {
+            const double err = expected[i].dist( actual[i] );
+            sum_error += err;
+            if ( err > max_error[i] )
+            {
+                max_error[i] = err;
+                max_point[i] = *p;
+            }
+        }
+    }
+
+    double total_max = 0.0;
+    for ( int i = 0; i < 11; ++i )
+    {
+        std::cout << "  unum=" << i + 1
+                  << " role=" << grid.getRoleName( i + 1 )
+                  << " max_error=" << max_error[i]
+                  << " at " << max_point[i]
+                  << '\n';
+        total_max = std::max( total_max, max_error[i] );
+    }
+
+    std::cout << "points=" << points.size()
+              << " max_error=" << total_max
+              << " mean_error=" << sum_error / ( points.size() * 11 )
+              << '\n';
+
+    // query time
+    double formation_msec = 0.0;
+    double grid_msec = 0.0;
+    {
+        rcsc::Timer timer;
+        for ( std::vector< rcsc::Vector2D >::const_iterator p = points.begin(), end = points.end();
+              p != end;
+              ++p )
+        {
+            formation.getPositions( *p, expected );
+        }
+        formation_msec = timer.elapsedReal();
+    }
+    {
+        rcsc::Timer timer;
+        for ( std::vector< rcsc::Vector2D >::const_iterator p = points.begin(), end = points.end();
+              p != end;
+              ++p )
+        {
+            grid.getPositions( *p, actual );
+        }
+        grid_msec = timer.elapsedReal();
+    }
+
+    std::cout << "getPositions " << formation.methodName() << "=" << formation_msec * 1000.0 / points.size()
+              << " grid=" << grid_msec * 1000.0 / points.size()
+              << " [usec/query]"
+              << std::endl;
+}
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog << " [options] <FormationFile> [<GridFile>]\n"
+              << "\n"
+              << "  Sample the formation on the grid, write it to <GridFile>,\n"
+              << "  and print the interpolation errors against the source formation.\n"
+              << "\n"
+              << "  --step S    the grid interval (default: "
+              << rcsc::FormationGrid::DEFAULT_STEP << ")\n"
+              << "  --random N  the number of random check points (default: 100000)"
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    double step = rcsc::FormationGrid::DEFAULT_STEP;
+    int n_random = 100000;
+    std::string formation_file;
+    std::string grid_file;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+        if ( arg == "--help" || arg == "-h" )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+
+        if ( arg == "--step" || arg == "--random" )
+        {
+            if ( ++i >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            if ( arg == "--step" ) step = std::atof( argv[i] );
+            else n_random = std::max( 0, std::atoi( argv[i] ) );
+        }
+        else if ( formation_file.empty() )
+        {
+            formation_file = arg;
+        }
+        else if ( grid_file.empty() )
+        {
+            grid_file = arg;
+        }
+        else
+        {
+            usage( argv[0] );
+            return 1;
+        }
+    }
+
+    if ( formation_file.empty()
+         || step <= 0.0 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    std::ifstream fin( formation_file.c_str() );
+    rcsc::Formation::Ptr formation = rcsc::Formation::create( fin );
+    if ( ! formation
+         || ! formation->read( fin ) )
+    {
+        std::cerr << "Failed to read the formation : " << formation_file << std::endl;
+        return 1;
+    }
+
+    rcsc::FormationGrid grid;
+    if ( ! grid.build( *formation, rcsc::FormationGrid::default_area(), step ) )
+    {
+        std::cerr << "Failed to build the grid." << std::endl;
+        return 1;
+    }
+
+    std::ostringstream buf;
+    grid.write( buf );
+
+    if ( ! grid_file.empty() )
+    {
+        std::ofstream fout( grid_file.c_str(), std::ios_base::out | std::ios_base::binary );
+        if ( ! fout.is_open()
+             || ! fout.write( buf.str().data(), buf.str().length() ) )
+        {
+            std::cerr << "Failed to write the grid file : " << grid_file << std::endl;
+            return 1;
+        }
+    }
+
+    // check the data actually written
+    std::istringstream is( buf.str() );
+    rcsc::FormationGrid loaded;
+    if ( ! loaded.read( is ) )
+    {
+        std::cerr << "Failed to read the written grid." << std::endl;
+        return 1;
+    }
+
+    std::cout << "formation=" << formation_file
+              << " method=" << formation->methodName()
+              << " grid=" << loaded.columns() << "x" << loaded.rows()
+              << " bytes=" << buf.str().length()
+              << '\n';
+
+    check( *formation, loaded, n_random );
+
+    return 0;
+}
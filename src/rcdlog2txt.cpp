@@ -0,0 +1,334 @@
+// -*-c++-*-
+
+/*!
+  \file rcdlog2txt.cpp
+  \brief binary debug log to text debug log converter source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <boost/cstdint.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+// see the binary log format in rcsc/common/logger.h
+
+//! binary log format version supported by this program
+static const int BINARY_VERSION = 1;
+
+//! size of the file header
+static const std::size_t FILE_HEADER_SIZE = 8;
+
+//! size of the record header
+static const std::size_t RECORD_HEADER_SIZE = 16;
+
+///////////////////////////////////////////////////////////
+
+/*---------------------------------------------------------------*/
+/*!
+  \class RecordReader
+  \brief sequential reader of the binary records
+*/
+class RecordReader {
+private:
+    FILE * M_fin;
+    bool M_swap; //!< true if the byte order differs from this machine
+    std::vector< char > M_record; //!< the current record
+
+public:
+
+    RecordReader( FILE * fin,
+                  const bool swap )
+        : M_fin( fin ),
+          M_swap( swap )
+      {
+          M_record.reserve( 65536 );
+      }
+
+    /*!
+      \brief read the next record
+      \return false if no more record or the record is broken
+    */
+    bool next()
+      {
+          char size_buf[2];
+          if ( std::fread( size_buf, 1, 2, M_fin ) != 2 )
+          {
+              return false;
+          }
+
+          const boost::uint16_t size = u16( size_buf );
+          if ( size < RECORD_HEADER_SIZE )
+          {
+              std::cerr << "Broken record. size=" << size << std::endl;
+              return false;
+          }
+
+          M_record.resize( size );
+          M_record[0] = size_buf[0];
+          M_record[1] = size_buf[1];
+          if ( std::fread( &M_record[2], 1, size - 2, M_fin ) != size - 2u )
+          {
+              std::cerr << "Truncated record." << std::endl;
+              return false;
+          }
+
+          if ( RECORD_HEADER_SIZE + sizeof( float ) * n() > size )
+          {
+              std::cerr << "Broken record. type=" << type() << std::endl;
+              return false;
+          }
+
+          return true;
+      }
+
+    char type() const { return M_record[2]; }
+    int n() const { return static_cast< unsigned char >( M_record[3] ); }
+    boost::uint16_t color() const { return u16( &M_record[4] ); }
+    long time() const { return static_cast< boost::int32_t >( u32( &M_record[8] ) ); }
+    boost::int32_t level() const { return static_cast< boost::int32_t >( u32( &M_record[12] ) ); }
+
+    float value( const int i ) const
+      {
+          const boost::uint32_t u = u32( &M_record[RECORD_HEADER_SIZE + sizeof( float ) * i] );
+          float v;
+          std::memcpy( &v, &u, sizeof( float ) );
+          return v;
+      }
+
+    const char * text() const
+      {
+          return &M_record[0] + RECORD_HEADER_SIZE + sizeof( float ) * n();
+      }
+
+    std::size_t textLength() const
+      {
+          return M_record.size() - RECORD_HEADER_SIZE - sizeof( float ) * n();
+      }
+
+private:
+
+    boost::uint16_t u16( const char * buf ) const
+      {
+          boost::uint16_t v;
+          std::memcpy( &v, buf, 2 );
+          if ( M_swap )
+          {
+              v = static_cast< boost::uint16_t >( ( v >> 8 ) | ( v << 8 ) );
+          }
+          return v;
+      }
+
+    boost::uint32_t u32( const char * buf ) const
+      {
+          boost::uint32_t v;
+          std::memcpy( &v, buf, 4 );
+          if ( M_swap )
+          {
+              v = ( ( v >> 24 )
+                    | ( ( v >> 8 ) & 0x0000ff00 )
+                    | ( ( v << 8 ) & 0x00ff0000 )
+                    | ( v << 24 ) );
+          }
+          return v;
+      }
+};
+
+/*---------------------------------------------------------------*/
+/*!
+  \brief read the file header
+  \return true if the file is a supported binary log
+*/
+static
+bool
+read_header( FILE * fin,
+             bool * swap )
+{
+    char header[FILE_HEADER_SIZE];
+    if ( std::fread( header, 1, FILE_HEADER_SIZE, fin ) != FILE_HEADER_SIZE
+         || std::strncmp( header, "RCDL", 4 ) != 0 )
+    {
+        std::cerr << "Not a binary debug log file." << std::endl;
+        return false;
+    }
+
+    if ( static_cast< int >( header[4] ) != BINARY_VERSION )
+    {
+        std::cerr << "Unsupported version " << static_cast< int >( header[4] )
+                  << std::endl;
+        return false;
+    }
+
+    const boost::uint16_t endian = 1;
+    const bool little = ( *reinterpret_cast< const char * >( &endian ) == 1 );
+    *swap = ( ( header[5] == 1 ) != little );
+
+    return true;
+}
+
+/*---------------------------------------------------------------*/
+/*!
+  \brief write the record in the text format of rcsc::Logger
+*/
+static
+void
+print_record( FILE * fout,
+              const RecordReader & rec,
+              const std::vector< std::string > & colors )
+{
+    const char * color = ( rec.color() > 0 && rec.color() <= colors.size()
+                           ? colors[rec.color() - 1].c_str()
+                           : 0 );
+
+    std::fprintf( fout, "%ld %d %c ", rec.time(), rec.level(), rec.type() );
+
+    if ( rec.type() == 'M' )
+    {
+        std::fwrite( rec.text(), 1, rec.textLength(), fout );
+        std::fputc( '\n', fout );
+        return;
+    }
+
+    for ( int i = 0; i < rec.n(); ++i )
+    {
+        std::fprintf( fout, "%.4f ", rec.value( i ) );
+    }
+
+    if ( rec.type() == 'm' )
+    {
+        if ( color )
+        {
+            std::fprintf( fout, "(c %s) ", color );
+        }
+        std::fwrite( rec.text(), 1, rec.textLength(), fout );
+    }
+    else if ( color )
+    {
+        std::fputs( color, fout );
+    }
+
+    std::fputc( '\n', fout );
+}
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog <<  " <BinaryLogFile> [<OutputFile>]"
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 2 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    FILE * fin = std::fopen( argv[1], "rb" );
+    if ( ! fin )
+    {
+        std::cerr << "Failed to open file : " << argv[1]
+                  << std::endl;
+        return 1;
+    }
+
+    bool swap = false;
+    if ( ! read_header( fin, &swap ) )
+    {
+        std::fclose( fin );
+        return 1;
+    }
+
+    //
+    // the color definitions may appear after the records that use them.
+    // collect all definitions at first.
+    //
+    std::vector< std::string > colors;
+    {
+        RecordReader rec( fin, swap );
+        while ( rec.next() )
+        {
+            if ( rec.type() != 'K'
+                 || rec.color() == 0 )
+            {
+                continue;
+            }
+
+            if ( colors.size() < rec.color() )
+            {
+                colors.resize( rec.color() );
+            }
+            colors[rec.color() - 1].assign( rec.text(), rec.textLength() );
+        }
+    }
+
+    FILE * fout = stdout;
+    if ( argc > 2 )
+    {
+        fout = std::fopen( argv[2], "w" );
+        if ( ! fout )
+        {
+            std::cerr << "Failed to open file : " << argv[2]
+                      << std::endl;
+            std::fclose( fin );
+            return 1;
+        }
+    }
+
+    std::fseek( fin, FILE_HEADER_SIZE, SEEK_SET );
+
+    RecordReader rec( fin, swap );
+    while ( rec.next() )
+    {
+        if ( rec.type() == 'K' ) continue;
+
+        print_record( fout, rec, colors );
+    }
+
+    std::fclose( fin );
+    if ( fout != stdout )
+    {
+        std::fclose( fout );
+    }
+
+    return 0;
+}
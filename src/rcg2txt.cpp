@@ -8,14 +8,18 @@
 #include <netinet/in.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <fstream>
+#include <limits>
 #include <string>
 
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
+#include <rcsc/rcg/cycle_index.h>
 
 /*
 
@@ -112,6 +116,9 @@ private:
 
     CommandCount M_command_count[rcsc::MAX_PLAYER * 2];
 
+    int M_from; //!< the first cycle to be printed
+    int M_to; //!< the last cycle to be printed
+
     // not used
     TextPrinter();
 public:
@@ -119,6 +126,13 @@ public:
     explicit
     TextPrinter( std::ostream & os );
 
+    void setRange( const int from,
+                   const int to )
+      {
+          M_from = from;
+          M_to = to;
+      }
+
     // v3 or older
     bool handleDispInfo( const rcsc::rcg::dispinfo_t & disp );
     bool handleShowInfo( const rcsc::rcg::showinfo_t & show );
@@ -192,6 +206,8 @@ TextPrinter::TextPrinter( std::ostream & os )
     , M_right_team_name( "" )
     , M_left_score( 0 )
     , M_right_score( 0 )
+    , M_from( 0 )
+    , M_to( std::numeric_limits< int >::max() )
 {
 
 }
@@ -251,6 +267,18 @@ TextPrinter::handleDispInfo( const rcsc::rcg::dispinfo_t & disp )
 bool
 TextPrinter::handleShowInfo( const rcsc::rcg::showinfo_t & show )
 {
+    const int time = static_cast< short >( ntohs( show.time ) );
+    if ( time < M_from
+         || M_to < time )
+    {
+        if ( time < M_from )
+        {
+            handlePlayMode( show.pmode );
+            handleTeamInfo( show.team[0], show.team[1] );
+        }
+        return true;
+    }
+
     if ( ! M_init_written )
     {
         M_init_written = true;
@@ -300,6 +328,17 @@ TextPrinter::handleShowInfo( const rcsc::rcg::showinfo_t & show )
 bool
 TextPrinter::handleShortShowInfo2( const rcsc::rcg::short_showinfo_t2 & show )
 {
+    const int time = static_cast< short >( ntohs( show.time ) );
+    if ( time < M_from
+         || M_to < time )
+    {
+        for ( int i = 0; i < rcsc::MAX_PLAYER * 2; ++i )
+        {
+            M_command_count[i].update( show.pos[i] );
+        }
+        return true;
+    }
+
     if ( ! M_init_written )
     {
         M_init_written = true;
@@ -455,6 +494,17 @@ bool
 TextPrinter::handleShow( const int,
                          const rcsc::rcg::ShowInfoT & show )
 {
+    if ( static_cast< int >( show.time_ ) < M_from
+         || M_to < static_cast< int >( show.time_ ) )
+    {
+        // the command counts are still needed to print the next cycle
+        for ( int i = 0; i < rcsc::MAX_PLAYER*2; ++i )
+        {
+            M_command_count[i].update( show.player_[i] );
+        }
+        return true;
+    }
+
     if ( ! M_init_written )
     {
         M_init_written = true;
@@ -516,10 +566,16 @@ TextPrinter::handlePlayMode( const int,
 
  */
 bool
-TextPrinter::handleTeam( const int,
+TextPrinter::handleTeam( const int time,
                          const rcsc::rcg::TeamT & team_l,
                          const rcsc::rcg::TeamT & team_r )
 {
+    if ( M_to < time )
+    {
+        // keep the score at the end of the range
+        return true;
+    }
+
     if ( M_left_team_name.empty() )
     {
         M_left_team_name = team_l.name_;
@@ -866,24 +922,105 @@ TextPrinter::printPlayer( std::ostream & os,
 }
 
 
+////////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "usage: " << prog << " [options] <RcgFile>[.gz]\n"
+              << "options:\n"
+              << "  --from <cycle>  the first cycle to be printed.\n"
+              << "  --to <cycle>    the last cycle to be printed.\n"
+              << "If <RcgFile>.idx created by rcgindex exists, only the blocks\n"
+              << "of the cycle range are read."
+              << std::endl;
+}
+
 ////////////////////////////////////////////////////////////////////////
 
 int
 main( int argc, char** argv )
 {
-    if ( argc != 2
-         || ! std::strncmp( argv[1], "--help", 6 )
-         || ! std::strncmp( argv[1], "-h", 2 ) )
+    std::string input_file;
+    int from = 0;
+    int to = std::numeric_limits< int >::max();
+
+    for ( int i = 1; i < argc; ++i )
     {
-        std::cerr << "usage: " << argv[0] << " <RcgFile>[.gz]" << std::endl;
+        if ( ! std::strcmp( argv[i], "--help" )
+             || ! std::strcmp( argv[i], "-h" ) )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+        else if ( ! std::strcmp( argv[i], "--from" )
+                  || ! std::strcmp( argv[i], "--to" ) )
+        {
+            if ( i + 1 >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            const int cycle = std::atoi( argv[i + 1] );
+            if ( argv[i][2] == 'f' ) from = cycle;
+            else to = cycle;
+            ++i;
+        }
+        else
+        {
+            input_file = argv[i];
+        }
+    }
+
+    if ( input_file.empty() )
+    {
+        usage( argv[0] );
         return 0;
     }
 
-    rcsc::gzifstream fin( argv[1] );
+    // create rcg handler instance
+    TextPrinter printer( std::cout );
+    printer.setRange( from, to );
+
+    //
+    // read only the needed blocks, if the log is indexed.
+    // the previous cycle is also read to detect the executed commands.
+    //
+    if ( from > 0
+         || to < std::numeric_limits< int >::max() )
+    {
+        const std::string index_path = rcsc::rcg::CycleIndex::default_path( input_file );
+        rcsc::rcg::CycleIndex index;
+        if ( index.load( index_path ) )
+        {
+            if ( ! index.isValid( input_file, index_path ) )
+            {
+                // the log was rewritten after indexing. read the whole log.
+                std::cerr << "The index file is out of date. Run rcgindex again : "
+                          << index_path << std::endl;
+            }
+            else
+            {
+                if ( ! index.parse( input_file, std::max( 0, from - 1 ), to, printer ) )
+                {
+                    std::cerr << "Failed to read the indexed file : " << input_file << std::endl;
+                    return 1;
+                }
+                return 0;
+            }
+        }
+    }
+
+    rcsc::gzifstream fin( input_file.c_str() );
 
     if ( ! fin.is_open() )
     {
-        std::cerr << "Failed to open file : " << argv[1] << std::endl;
+        std::cerr << "Failed to open file : " << input_file << std::endl;
         return 1;
     }
 
@@ -895,9 +1032,6 @@ main( int argc, char** argv )
         return 1;
     }
 
-    // create rcg handler instance
-    TextPrinter printer( std::cout );
-
     parser->parse( fin, printer );
 
     return 0;
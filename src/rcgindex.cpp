@@ -0,0 +1,190 @@
+// -*-c++-*-
+
+/*!
+  \file rcgindex.cpp
+  \brief rcg cycle index builder source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/gz.h>
+#include <rcsc/rcg/cycle_index.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+#include <sys/stat.h>
+
+///////////////////////////////////////////////////////////
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog << " [--cycles N] <RcgFile>[.gz] [<OutputFile>[.gz]]\n"
+              << "\n"
+              << "  Create the cycle index \"<log>.idx\" of the rcg v4/v5 file.\n"
+              << "  If <OutputFile> is omitted, the uncompressed <RcgFile> is indexed in place.\n"
+              << "  Otherwise, <RcgFile> is copied to <OutputFile> and the output is indexed.\n"
+              << "  If <OutputFile> ends with \".gz\", each block is compressed separately.\n"
+              << "\n"
+              << "  --cycles N  the number of cycles in one block (default: "
+              << rcsc::rcg::CycleIndex::DEFAULT_BLOCK_CYCLES << ")"
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    int block_cycles = rcsc::rcg::CycleIndex::DEFAULT_BLOCK_CYCLES;
+    std::string input;
+    std::string output;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+        if ( arg == "--help" || arg == "-h" )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+
+        if ( arg == "--cycles" )
+        {
+            if ( ++i >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            block_cycles = std::atoi( argv[i] );
+        }
+        else if ( input.empty() )
+        {
+            input = arg;
+        }
+        else if ( output.empty() )
+        {
+            output = arg;
+        }
+        else
+        {
+            usage( argv[0] );
+            return 1;
+        }
+    }
+
+    if ( input.empty()
+         || block_cycles <= 0 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    if ( ! output.empty() )
+    {
+        // the input would be truncated before it is read.
+        struct stat in_st;
+        struct stat out_st;
+        if ( output == input
+             || ( ::stat( input.c_str(), &in_st ) == 0
+                  && ::stat( output.c_str(), &out_st ) == 0
+                  && in_st.st_dev == out_st.st_dev
+                  && in_st.st_ino == out_st.st_ino ) )
+        {
+            std::cerr << "The output file must differ from the input file."
+                      << " Omit <OutputFile> to index the file in place." << std::endl;
+            return 1;
+        }
+    }
+
+    rcsc::rcg::CycleIndex index;
+
+    if ( output.empty() )
+    {
+        if ( input.length() > 3
+             && input.compare( input.length() - 3, 3, ".gz" ) == 0 )
+        {
+            std::cerr << "A compressed file cannot be indexed in place."
+                      << " Specify the output file." << std::endl;
+            return 1;
+        }
+
+        std::ifstream fin( input.c_str(), std::ios_base::in | std::ios_base::binary );
+        if ( ! fin.is_open() )
+        {
+            std::cerr << "Failed to open file : " << input << std::endl;
+            return 1;
+        }
+
+        if ( ! index.build( fin, std::string(), block_cycles ) )
+        {
+            std::cerr << "Failed to index the file : " << input << std::endl;
+            return 1;
+        }
+
+        output = input;
+    }
+    else
+    {
+        rcsc::gzifstream fin( input.c_str() );
+        if ( ! fin.is_open() )
+        {
+            std::cerr << "Failed to open file : " << input << std::endl;
+            return 1;
+        }
+
+        if ( ! index.build( fin, output, block_cycles ) )
+        {
+            std::cerr << "Failed to index the file : " << input << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string index_path = rcsc::rcg::CycleIndex::default_path( output );
+    if ( ! index.save( index_path ) )
+    {
+        std::cerr << "Failed to write the index file : " << index_path << std::endl;
+        return 1;
+    }
+
+    std::cout << "log=" << output
+              << " index=" << index_path
+              << " blocks=" << index.blocks().size()
+              << std::endl;
+
+    return 0;
+}
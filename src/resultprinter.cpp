@@ -35,14 +35,24 @@
 
 #include <rcsc/gz/gzfstream.h>
 #include <rcsc/rcg.h>
+#include <rcsc/rcg/parser_v4.h>
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
 
+#include <pthread.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #ifdef HAVE_NETINET_IN_H
 #include <netinet/in.h>
 #endif
@@ -68,6 +78,8 @@ private:
 
     static const double GOAL_POST_RADIUS;
 
+    std::ostream & M_os; //!< result output stream
+
     std::string M_file_path;
     std::time_t M_game_date;
 
@@ -92,6 +104,8 @@ private:
 
     rcsc::SideID M_last_penalty_taker_side;
 
+    Point M_prev_ball_pos; //!< ball position at the last show
+
     // not used
     ResultPrinter();
     ResultPrinter( const ResultPrinter & );
@@ -99,8 +113,8 @@ private:
 
 public:
 
-    explicit
-    ResultPrinter( const std::string & input_file );
+    ResultPrinter( const std::string & input_file,
+                   std::ostream & os );
 
     // v3 or older
     bool handleDispInfo( const rcsc::rcg::dispinfo_t & disp );
@@ -157,8 +171,10 @@ const double ResultPrinter::GOAL_POST_RADIUS = 0.06;
 /*!
 
 */
-ResultPrinter::ResultPrinter( const std::string & input_file )
-    : M_game_date( 0 )
+ResultPrinter::ResultPrinter( const std::string & input_file,
+                              std::ostream & os )
+    : M_os( os )
+    , M_game_date( 0 )
     , M_goal_width( 14.02 )
     , M_ball_size( 0.085 )
     , M_half_time( 3000 )
@@ -183,6 +199,7 @@ ResultPrinter::ResultPrinter( const std::string & input_file )
     if ( strptime( base_name.c_str(), "%Y%m%d%H%M", &t ) )
     {
         t.tm_sec = 0;
+        t.tm_isdst = -1;
         M_game_date = std::mktime( &t );
         //std::cerr << "file=" << argv[i] << std::endl;
         //std::cerr << "date=" << std::asctime( &t ) << std::endl;;
@@ -247,10 +264,8 @@ ResultPrinter::crossGoalLine( const Point & ball_pos,
 void
 ResultPrinter::checkFinalPenaltyGoal( const Point & ball_pos )
 {
-    static Point s_prev_ball_pos;
-
     if ( M_playmode == rcsc::PM_TimeOver
-         && crossGoalLine( ball_pos, s_prev_ball_pos ) )
+         && crossGoalLine( ball_pos, M_prev_ball_pos ) )
     {
         if ( M_last_penalty_taker_side == rcsc::LEFT )
         {
@@ -264,7 +279,7 @@ ResultPrinter::checkFinalPenaltyGoal( const Point & ball_pos )
         }
     }
 
-    s_prev_ball_pos = ball_pos;
+    M_prev_ball_pos = ball_pos;
 }
 
 /*-------------------------------------------------------------------*/
@@ -423,17 +438,18 @@ ResultPrinter::handleEOF()
         incomplete = true;
     }
 
+    tm t;
     char date[256];
-    std::strftime( date, 255, "%Y%m%d%H%M", localtime( &M_game_date ) );
-    std::cout << date << ' ';
+    std::strftime( date, 255, "%Y%m%d%H%M", localtime_r( &M_game_date, &t ) );
+    M_os << date << ' ';
 
-    std::cout << M_left_team_name << " " << M_right_team_name << " "
+    M_os << M_left_team_name << " " << M_right_team_name << " "
               << M_left_score << " " << M_right_score;
 
     if ( M_left_penalty_taken > 0
          && M_right_penalty_taken > 0 )
     {
-        std::cout << " " << M_left_penalty_score
+        M_os << " " << M_left_penalty_score
                   << " " << M_right_penalty_score;
     }
 
@@ -456,11 +472,11 @@ ResultPrinter::handleEOF()
 
     if ( incomplete )
     {
-        std::cout << " (incomplete match : cycle="
+        M_os << " (incomplete match : cycle="
                   << M_cycle << ")";
     }
 
-    std::cout << std::endl;
+    M_os << std::endl;
 
     return true;
 }
@@ -491,6 +507,7 @@ ResultPrinter::handleMsgInfo( rcsc::rcg::Int16,
         if ( strptime( msg.c_str(), "(result %Y%m%d%H%M ", &t ) )
         {
             t.tm_sec = 0;
+            t.tm_isdst = -1;
             M_game_date = std::mktime( &t );
             //std::cerr << "date=" << std::asctime( &t ) << std::endl;;
             //std::cerr << "date=" << std::ctime( &M_game_date ) << std::endl;;
@@ -515,6 +532,7 @@ ResultPrinter::handleMsg( const int,
         if ( strptime( msg.c_str(), "(result %Y%m%d%H%M ", &t ) )
         {
             t.tm_sec = 0;
+            t.tm_isdst = -1;
             M_game_date = std::mktime( &t );
             //std::cerr << "date=" << std::asctime( &t ) << std::endl;;
             //std::cerr << "date=" << std::ctime( &M_game_date ) << std::endl;;
@@ -587,12 +605,250 @@ ResultPrinter::handlePlayerType( const std::string & )
     return true;
 }
 
+
 ////////////////////////////////////////////////////////////////////////
 
+/*-------------------------------------------------------------------*/
+/*!
+  read the text log without parsing show lines.
+  ResultPrinter ignores the show data of v4 or later, so only the show
+  lines that contain the playmode or team information are passed to
+  the parser.
+*/
+static
+bool
+parse_without_show( std::istream & is,
+                    const rcsc::rcg::ParserV4 & parser,
+                    rcsc::rcg::Handler & handler )
+{
+    std::string line;
+    line.reserve( 8192 );
+
+    // skip the rest of header line
+    if ( ! std::getline( is, line )
+         || ! handler.handleLogVersion( parser.version() ) )
+    {
+        return false;
+    }
+
+    int n_line = 1;
+    while ( true )
+    {
+        const int c = is.get();
+        if ( c == std::istream::traits_type::eof() )
+        {
+            break;
+        }
+
+        ++n_line;
+        line.clear();
+
+        if ( c == '\n' )
+        {
+            // empty line
+        }
+        else if ( c == '(' && is.peek() == 's' )
+        {
+            is.get();
+            std::getline( is, line );
+
+            if ( ! line.empty() && line[0] == 'h' )
+            {
+                // show line. (show <Time> [(pm ...)] [(tm ...)] <Ball> <Players>)
+                const std::string::size_type pos = line.find( '(' );
+                if ( pos == std::string::npos
+                     || ( line.compare( pos, 3, "(pm" ) != 0
+                          && line.compare( pos, 3, "(tm" ) != 0 ) )
+                {
+                    continue;
+                }
+            }
+
+            line.insert( 0, "(s" );
+        }
+        else
+        {
+            std::getline( is, line );
+            line.insert( line.begin(), static_cast< char >( c ) );
+        }
+
+        if ( ! parser.parseLine( n_line, line, handler ) )
+        {
+            return false;
+        }
+    }
+
+    return handler.handleEOF();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  print the result of one game log.
+*/
+static
+bool
+print_result( const std::string & file,
+              std::ostream & os,
+              std::ostream & err )
+{
+    rcsc::gzifstream fin( file.c_str() );
+
+    if ( ! fin.is_open() )
+    {
+        err << "Failed to open file : " << file
+            << std::endl;
+        return false;
+    }
+
+    rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
+
+    if ( ! parser )
+    {
+        err << "Failed to create rcg parser for "
+            << file
+            << std::endl;
+        return false;
+    }
+
+    // create rcg handler instance
+    ResultPrinter printer( file, os );
+
+    const rcsc::rcg::ParserV4 * parser_v4
+        = dynamic_cast< const rcsc::rcg::ParserV4 * >( parser.get() );
+
+    const bool result = ( parser_v4
+                          ? parse_without_show( fin, *parser_v4, printer )
+                          : parser->parse( fin, printer ) );
+    if ( ! result )
+    {
+        err << "Failed to parse [" << file << "]"
+            << std::endl;
+    }
+
+    fin.close();
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  add the game log files in the directory in the name order.
+*/
+static
+void
+add_log_files( const std::string & path,
+               std::vector< std::string > & files )
+{
+    struct stat st;
+    if ( ::stat( path.c_str(), &st ) != 0
+         || ! S_ISDIR( st.st_mode ) )
+    {
+        files.push_back( path );
+        return;
+    }
+
+    DIR * dir = ::opendir( path.c_str() );
+    if ( ! dir )
+    {
+        std::cerr << "Failed to open directory : " << path
+                  << std::endl;
+        return;
+    }
+
+    std::vector< std::string > entries;
+    while ( const struct dirent * ent = ::readdir( dir ) )
+    {
+        const std::string name = ent->d_name;
+        const std::string::size_type pos = name.rfind( ".rcg" );
+        if ( pos != std::string::npos
+             && ( pos + 4 == name.length()
+                  || name.compare( pos + 4, std::string::npos, ".gz" ) == 0 ) )
+        {
+            entries.push_back( path + '/' + name );
+        }
+    }
+    ::closedir( dir );
+
+    std::sort( entries.begin(), entries.end() );
+    files.insert( files.end(), entries.begin(), entries.end() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct BatchJob
+  \brief shared state of the worker threads
+*/
+struct BatchJob {
+    const std::vector< std::string > & files_; //!< input files
+    std::vector< std::string > outputs_; //!< result lines in the input order
+    std::vector< std::string > errors_; //!< error messages in the input order
+    std::size_t next_index_; //!< the next file index to be processed
+
+    pthread_mutex_t mutex_;
+
+    explicit
+    BatchJob( const std::vector< std::string > & files )
+        : files_( files ),
+          outputs_( files.size() ),
+          errors_( files.size() ),
+          next_index_( 0 )
+      {
+          pthread_mutex_init( &mutex_, 0 );
+      }
+
+    ~BatchJob()
+      {
+          pthread_mutex_destroy( &mutex_ );
+      }
+
+    void run()
+      {
+          while ( true )
+          {
+              pthread_mutex_lock( &mutex_ );
+              const std::size_t i = next_index_++;
+              pthread_mutex_unlock( &mutex_ );
+
+              if ( i >= files_.size() )
+              {
+                  break;
+              }
+
+              std::ostringstream os;
+              std::ostringstream err;
+              print_result( files_[i], os, err );
+              outputs_[i] = os.str();
+              errors_[i] = err.str();
+          }
+      }
+
+    static
+    void * thread_main( void * arg )
+      {
+          static_cast< BatchJob * >( arg )->run();
+          return static_cast< void * >( 0 );
+      }
+
+private:
+    // not used
+    BatchJob( const BatchJob & );
+    BatchJob & operator=( const BatchJob & );
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+static
 void
 usage( const char * prog )
 {
-    std::cerr << "Usage: " << prog << " <RcgFile>[.gz]"
+    std::cerr << "Usage: " << prog << " [-j <N>] <RcgFile>[.gz]|<Directory> ...\n"
+              << "\n"
+              << "  Print the result of each game log in the input order.\n"
+              << "  All *.rcg and *.rcg.gz files in the directory are processed.\n"
+              << "\n"
+              << "  -j, --jobs N  the number of worker threads (default: the number of CPUs)"
               << std::endl;
 }
 
@@ -608,45 +864,71 @@ main( int argc, char** argv )
         return 1;
     }
 
+    int n_threads = 0;
+    std::vector< std::string > files;
+
     for ( int i = 1; i < argc; ++i )
     {
-        if ( argv[i][0] == '-' )
+        const std::string arg = argv[i];
+        if ( arg == "--help" || arg == "-h" )
         {
-            continue;
+            usage( argv[0] );
+            return 0;
         }
 
-        const std::string file = argv[i];
-
-        rcsc::gzifstream fin( file.c_str() );
-
-        if ( ! fin.is_open() )
+        if ( arg == "--jobs" || arg == "-j" )
         {
-            std::cerr << "Failed to open file : " << file
-                      << std::endl;
+            if ( ++i >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            n_threads = std::atoi( argv[i] );
             continue;
         }
 
-        rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
-
-        if ( ! parser )
+        if ( argv[i][0] == '-' )
         {
-            std::cerr << "Failed to create rcg parser for "
-                      << argv[i]
-                      << std::endl;
             continue;
         }
 
-        // create rcg handler instance
-        ResultPrinter printer( file );
+        add_log_files( arg, files );
+    }
+
+    if ( n_threads <= 0 )
+    {
+        long n = ::sysconf( _SC_NPROCESSORS_ONLN );
+        n_threads = ( n > 0 ? static_cast< int >( n ) : 1 );
+    }
+    n_threads = std::min( n_threads, static_cast< int >( files.size() ) );
+
+    BatchJob job( files );
 
-        if ( ! parser->parse( fin, printer ) )
+    std::vector< pthread_t > threads;
+    for ( int i = 1; i < n_threads; ++i )
+    {
+        pthread_t th;
+        if ( pthread_create( &th, 0, &BatchJob::thread_main, &job ) != 0 )
         {
-            std::cerr << "Failed to parse [" << argv[i] << "]"
-                      << std::endl;
+            break;
         }
+        threads.push_back( th );
+    }
 
-        fin.close();
+    // the main thread also works
+    job.run();
+
+    for ( std::vector< pthread_t >::iterator th = threads.begin(); th != threads.end(); ++th )
+    {
+        pthread_join( *th, 0 );
+    }
+
+    for ( std::size_t i = 0; i < files.size(); ++i )
+    {
+        std::cerr << job.errors_[i];
+        std::cout << job.outputs_[i];
     }
+    std::cout << std::flush;
 
     return 0;
 }